@@ -0,0 +1,132 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 Alec Jacobson <alecjacobson@gmail.com>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#pragma once
+
+// Minimal benchmark harness for libigl_benchmarks. Each benchmark group is a
+// function registered with IGL_BENCHMARK(group) that receives a synthetic
+// mesh of a given size and times one or more kernels on it through
+// Runner::measure. Results are collected and written as JSON by main.cpp.
+
+#include <Eigen/Core>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace igl_benchmark
+{
+  /// Synthetic input: a closed, manifold, unit-sphere triangle mesh.
+  struct Mesh
+  {
+    /// subdivision level (#F = 20*4^level)
+    int level;
+    Eigen::MatrixXd V;
+    Eigen::MatrixXi F;
+  };
+
+  /// Single timing result
+  struct Result
+  {
+    std::string name;
+    int level;
+    std::int64_t num_vertices;
+    std::int64_t num_faces;
+    /// Number of "items" processed per repetition (e.g., query points),
+    /// used to report throughput
+    std::int64_t items;
+    int repetitions;
+    double min_seconds;
+    double median_seconds;
+    double mean_seconds;
+  };
+
+  /// Options shared by all benchmarks
+  struct Options
+  {
+    /// Only run benchmarks whose name contains this substring
+    std::string filter;
+    /// Minimum accumulated time per benchmark (seconds)
+    double min_time = 0.2;
+    /// Maximum number of timed repetitions per benchmark
+    int max_repetitions = 50;
+    /// Scratch directory for I/O benchmarks
+    std::string tmp_dir = ".";
+  };
+
+  class Runner
+  {
+    public:
+      Runner(const Options & options_): options(options_) {}
+      const Options & options;
+      std::vector<Result> results;
+      /// @return true iff a benchmark with this name should run
+      bool enabled(const std::string & name) const
+      {
+        return options.filter.empty() ||
+          name.find(options.filter) != std::string::npos;
+      }
+      /// Time `body` (after one untimed warm-up run) until either
+      /// options.min_time seconds have accumulated or
+      /// options.max_repetitions runs have been made.
+      ///
+      /// @param[in] name  benchmark name, e.g., "AABB::init"
+      /// @param[in] mesh  mesh the kernel runs on (for reporting)
+      /// @param[in] items  number of items processed per run
+      /// @param[in] body  kernel to time
+      void measure(
+        const std::string & name,
+        const Mesh & mesh,
+        const std::int64_t items,
+        const std::function<void()> & body);
+  };
+
+  using Function = void(*)(const Mesh &, Runner &);
+  struct Registration
+  {
+    std::string group;
+    Function function;
+  };
+  /// @return all registered benchmark groups
+  inline std::vector<Registration> & registry()
+  {
+    static std::vector<Registration> r;
+    return r;
+  }
+  struct Registrar
+  {
+    Registrar(const char * group, Function function)
+    {
+      registry().push_back({group,function});
+    }
+  };
+
+  /// Prevent the optimizer from discarding a result (or the computation
+  /// that produced it). Call on each kernel output inside Runner::measure.
+  template <typename T>
+  inline void do_not_optimize(const T & value)
+  {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const void * sink;
+    sink = &value;
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+#endif
+  }
+}
+
+#define IGL_BENCHMARK(group) \
+  static void igl_benchmark_##group( \
+    const igl_benchmark::Mesh & mesh, igl_benchmark::Runner & runner); \
+  static igl_benchmark::Registrar igl_benchmark_registrar_##group( \
+    #group, igl_benchmark_##group); \
+  static void igl_benchmark_##group( \
+    const igl_benchmark::Mesh & mesh, igl_benchmark::Runner & runner)
@@ -0,0 +1,50 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 Alec Jacobson <alecjacobson@gmail.com>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#include "benchmark_common.h"
+
+#include <igl/remove_duplicate_vertices.h>
+#include <igl/sort.h>
+#include <igl/unique_rows.h>
+
+IGL_BENCHMARK(unique)
+{
+  // Undirected edges with duplicates: the typical input to unique_rows
+  Eigen::MatrixXi E(mesh.F.rows()*3,2);
+  E << mesh.F.col(0),mesh.F.col(1),
+       mesh.F.col(1),mesh.F.col(2),
+       mesh.F.col(2),mesh.F.col(0);
+  Eigen::MatrixXi sE,_;
+  igl::sort(E,2,true,sE,_);
+  Eigen::MatrixXi uE;
+  Eigen::VectorXi IA,IC;
+  runner.measure("unique_rows",mesh,sE.rows(),[&]()
+  {
+    igl::unique_rows(sE,uE,IA,IC);
+    igl_benchmark::do_not_optimize(uE);
+  });
+
+  // Triangle soup as read from an STL file
+  Eigen::MatrixXd SV(mesh.F.rows()*3,3);
+  Eigen::MatrixXi SF(mesh.F.rows(),3);
+  for(int f = 0;f<mesh.F.rows();f++)
+  {
+    for(int c = 0;c<3;c++)
+    {
+      SV.row(3*f+c) = mesh.V.row(mesh.F(f,c));
+      SF(f,c) = 3*f+c;
+    }
+  }
+  Eigen::MatrixXd W;
+  Eigen::VectorXi SVI,SVJ;
+  Eigen::MatrixXi G;
+  runner.measure("remove_duplicate_vertices",mesh,SV.rows(),[&]()
+  {
+    igl::remove_duplicate_vertices(SV,SF,1e-7,W,SVI,SVJ,G);
+    igl_benchmark::do_not_optimize(W);
+  });
+}
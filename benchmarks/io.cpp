@@ -0,0 +1,59 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 Alec Jacobson <alecjacobson@gmail.com>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#include "benchmark_common.h"
+
+#include <igl/readOBJ.h>
+#include <igl/readPLY.h>
+#include <igl/readSTL.h>
+#include <igl/writeOBJ.h>
+#include <igl/writePLY.h>
+#include <igl/writeSTL.h>
+
+#include <cstdio>
+#include <fstream>
+
+IGL_BENCHMARK(io)
+{
+  const std::string prefix = runner.options.tmp_dir + "/igl_benchmark_mesh";
+  Eigen::MatrixXd V,N;
+  Eigen::MatrixXi F;
+  if(runner.enabled("readOBJ"))
+  {
+    const std::string path = prefix + ".obj";
+    igl::writeOBJ(path,mesh.V,mesh.F);
+    runner.measure("readOBJ",mesh,mesh.F.rows(),[&]()
+    {
+      igl::readOBJ(path,V,F);
+      igl_benchmark::do_not_optimize(V);
+    });
+    std::remove(path.c_str());
+  }
+  if(runner.enabled("readPLY"))
+  {
+    const std::string path = prefix + ".ply";
+    igl::writePLY(path,mesh.V,mesh.F);
+    runner.measure("readPLY",mesh,mesh.F.rows(),[&]()
+    {
+      igl::readPLY(path,V,F);
+      igl_benchmark::do_not_optimize(V);
+    });
+    std::remove(path.c_str());
+  }
+  if(runner.enabled("readSTL"))
+  {
+    const std::string path = prefix + ".stl";
+    igl::writeSTL(path,mesh.V,mesh.F,igl::FileEncoding::Binary);
+    runner.measure("readSTL",mesh,mesh.F.rows(),[&]()
+    {
+      std::ifstream input(path,std::ios::binary);
+      igl::readSTL(input,V,F,N);
+      igl_benchmark::do_not_optimize(V);
+    });
+    std::remove(path.c_str());
+  }
+}
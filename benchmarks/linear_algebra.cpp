@@ -0,0 +1,68 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 Alec Jacobson <alecjacobson@gmail.com>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#include "benchmark_common.h"
+
+#include <igl/colon.h>
+#include <igl/cotmatrix.h>
+#include <igl/massmatrix.h>
+#include <igl/min_quad_with_fixed.h>
+
+#include <Eigen/Sparse>
+
+IGL_BENCHMARK(laplacian)
+{
+  Eigen::SparseMatrix<double> L,M;
+  runner.measure("cotmatrix",mesh,mesh.F.rows(),[&]()
+  {
+    igl::cotmatrix(mesh.V,mesh.F,L);
+    igl_benchmark::do_not_optimize(L);
+  });
+  runner.measure("massmatrix",mesh,mesh.F.rows(),[&]()
+  {
+    igl::massmatrix(mesh.V,mesh.F,igl::MASSMATRIX_TYPE_VORONOI,M);
+    igl_benchmark::do_not_optimize(M);
+  });
+  // Values-only refresh with a cached sparsity pattern
+  igl::SparseAssemblyData L_data,M_data;
+  runner.measure("cotmatrix_refresh",mesh,mesh.F.rows(),[&]()
+  {
+    igl::cotmatrix(mesh.V,mesh.F,L_data,L);
+    igl_benchmark::do_not_optimize(L);
+  });
+  runner.measure("massmatrix_refresh",mesh,mesh.F.rows(),[&]()
+  {
+    igl::massmatrix(mesh.V,mesh.F,igl::MASSMATRIX_TYPE_VORONOI,M_data,M);
+    igl_benchmark::do_not_optimize(M);
+  });
+}
+
+IGL_BENCHMARK(min_quad_with_fixed)
+{
+  Eigen::SparseMatrix<double> L;
+  igl::cotmatrix(mesh.V,mesh.F,L);
+  const Eigen::SparseMatrix<double> Q = -L;
+  // Fix every 100th vertex
+  Eigen::VectorXi b;
+  igl::colon<int>(0,100,mesh.V.rows()-1,b);
+  const Eigen::MatrixXd bc = mesh.V(b,Eigen::all);
+  const Eigen::MatrixXd B = Eigen::MatrixXd::Zero(mesh.V.rows(),3);
+  const Eigen::MatrixXd Beq;
+  igl::min_quad_with_fixed_data<double> data;
+  runner.measure("min_quad_with_fixed_precompute",mesh,mesh.V.rows(),[&]()
+  {
+    igl::min_quad_with_fixed_precompute(
+      Q,b,Eigen::SparseMatrix<double>(),true,data);
+    igl_benchmark::do_not_optimize(data);
+  });
+  Eigen::MatrixXd Z;
+  runner.measure("min_quad_with_fixed_solve",mesh,mesh.V.rows(),[&]()
+  {
+    igl::min_quad_with_fixed_solve(data,B,bc,Beq,Z);
+    igl_benchmark::do_not_optimize(Z);
+  });
+}
@@ -0,0 +1,189 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 Alec Jacobson <alecjacobson@gmail.com>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#include "benchmark_common.h"
+
+#include <igl/default_num_threads.h>
+#include <igl/icosahedron.h>
+#include <igl/upsample.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <thread>
+
+void igl_benchmark::Runner::measure(
+  const std::string & name,
+  const Mesh & mesh,
+  const std::int64_t items,
+  const std::function<void()> & body)
+{
+  if(!enabled(name)) { return; }
+  using clock = std::chrono::steady_clock;
+  // warm up caches, lazily built structures, the thread pool, ...
+  body();
+  std::vector<double> times;
+  double total = 0;
+  while(
+    (int)times.size() < options.max_repetitions &&
+    (times.empty() || total < options.min_time))
+  {
+    const auto t0 = clock::now();
+    body();
+    const double t = std::chrono::duration<double>(clock::now()-t0).count();
+    times.push_back(t);
+    total += t;
+  }
+  std::vector<double> sorted = times;
+  std::sort(sorted.begin(),sorted.end());
+  Result r;
+  r.name = name;
+  r.level = mesh.level;
+  r.num_vertices = mesh.V.rows();
+  r.num_faces = mesh.F.rows();
+  r.items = items;
+  r.repetitions = (int)times.size();
+  r.min_seconds = sorted.front();
+  r.median_seconds = sorted[sorted.size()/2];
+  r.mean_seconds = total/times.size();
+  results.push_back(r);
+  std::cerr<<name<<" [level "<<mesh.level<<", #F "<<mesh.F.rows()<<"]: "<<
+    r.median_seconds*1e3<<" ms"<<std::endl;
+}
+
+static std::string json_escape(const std::string & s)
+{
+  std::string e;
+  for(const char c : s)
+  {
+    if(c == '"' || c == '\\') { e += '\\'; }
+    e += c;
+  }
+  return e;
+}
+
+static void write_json(
+  std::ostream & out,
+  const unsigned int num_threads,
+  const std::vector<igl_benchmark::Result> & results)
+{
+  const std::time_t now = std::time(nullptr);
+  char date[64];
+  std::strftime(date,sizeof(date),"%Y-%m-%dT%H:%M:%S",std::localtime(&now));
+  out.precision(9);
+  out<<"{\n";
+  out<<"  \"context\": {\n";
+  out<<"    \"date\": \""<<date<<"\",\n";
+  out<<"    \"num_threads\": "<<num_threads<<",\n";
+  out<<"    \"hardware_concurrency\": "<<
+    std::thread::hardware_concurrency()<<",\n";
+#ifdef NDEBUG
+  out<<"    \"build_type\": \"release\"\n";
+#else
+  out<<"    \"build_type\": \"debug\"\n";
+#endif
+  out<<"  },\n";
+  out<<"  \"benchmarks\": [";
+  for(size_t i = 0;i<results.size();i++)
+  {
+    const auto & r = results[i];
+    out<<(i?",":"")<<"\n    {";
+    out<<"\"name\": \""<<json_escape(r.name)<<"\", ";
+    out<<"\"level\": "<<r.level<<", ";
+    out<<"\"num_vertices\": "<<r.num_vertices<<", ";
+    out<<"\"num_faces\": "<<r.num_faces<<", ";
+    out<<"\"items\": "<<r.items<<", ";
+    out<<"\"repetitions\": "<<r.repetitions<<", ";
+    out<<"\"min_seconds\": "<<r.min_seconds<<", ";
+    out<<"\"median_seconds\": "<<r.median_seconds<<", ";
+    out<<"\"mean_seconds\": "<<r.mean_seconds<<", ";
+    out<<"\"items_per_second\": "<<r.items/r.median_seconds<<"}";
+  }
+  out<<"\n  ]\n}\n";
+}
+
+static void usage(const char * argv0)
+{
+  std::cerr<<
+    "Usage: "<<argv0<<" [options]\n"
+    "  --threads N       number of threads (default: IGL_NUM_THREADS or\n"
+    "                    hardware concurrency)\n"
+    "  --filter S        only run benchmarks whose name contains S\n"
+    "  --min-level L     smallest sphere subdivision level (default 2)\n"
+    "  --max-level L     largest sphere subdivision level (default 6)\n"
+    "  --min-time T      minimum seconds spent per benchmark (default 0.2)\n"
+    "  --max-reps N      maximum repetitions per benchmark (default 50)\n"
+    "  --tmp-dir D       scratch directory for I/O benchmarks (default .)\n"
+    "  --out FILE        write JSON to FILE instead of stdout\n";
+}
+
+int main(int argc, char * argv[])
+{
+  igl_benchmark::Options options;
+  unsigned int num_threads = 0;
+  int min_level = 2;
+  int max_level = 6;
+  std::string out_path;
+  for(int a = 1;a<argc;a++)
+  {
+    const std::string arg = argv[a];
+    const auto next = [&]()->std::string
+    {
+      if(a+1 >= argc) { usage(argv[0]); std::exit(EXIT_FAILURE); }
+      return argv[++a];
+    };
+    if(arg == "--threads") { num_threads = std::stoi(next()); }
+    else if(arg == "--filter") { options.filter = next(); }
+    else if(arg == "--min-level") { min_level = std::stoi(next()); }
+    else if(arg == "--max-level") { max_level = std::stoi(next()); }
+    else if(arg == "--min-time") { options.min_time = std::stod(next()); }
+    else if(arg == "--max-reps") { options.max_repetitions = std::stoi(next()); }
+    else if(arg == "--tmp-dir") { options.tmp_dir = next(); }
+    else if(arg == "--out") { out_path = next(); }
+    else { usage(argv[0]); return arg=="--help" ? EXIT_SUCCESS : EXIT_FAILURE; }
+  }
+  // First call fixes the value for the whole process
+  num_threads = igl::default_num_threads(num_threads);
+
+  igl_benchmark::Runner runner(options);
+  igl_benchmark::Mesh mesh;
+  igl::icosahedron(mesh.V,mesh.F);
+  mesh.level = 0;
+  for(;mesh.level<=max_level;mesh.level++)
+  {
+    if(mesh.level > 0)
+    {
+      Eigen::MatrixXd U;
+      Eigen::MatrixXi G;
+      igl::upsample(mesh.V,mesh.F,U,G);
+      mesh.V = U.rowwise().normalized();
+      mesh.F = G;
+    }
+    if(mesh.level < min_level) { continue; }
+    for(const auto & reg : igl_benchmark::registry())
+    {
+      reg.function(mesh,runner);
+    }
+  }
+
+  if(out_path.empty())
+  {
+    write_json(std::cout,num_threads,runner.results);
+  }else
+  {
+    std::ofstream out(out_path);
+    if(!out)
+    {
+      std::cerr<<"Could not open "<<out_path<<std::endl;
+      return EXIT_FAILURE;
+    }
+    write_json(out,num_threads,runner.results);
+  }
+  return EXIT_SUCCESS;
+}
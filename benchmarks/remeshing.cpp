@@ -0,0 +1,29 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 Alec Jacobson <alecjacobson@gmail.com>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#include "benchmark_common.h"
+
+#include <igl/decimate.h>
+#include <igl/qslim.h>
+
+IGL_BENCHMARK(decimation)
+{
+  const int m = mesh.F.rows()/10;
+  Eigen::MatrixXd U;
+  Eigen::MatrixXi G;
+  Eigen::VectorXi J,I;
+  runner.measure("decimate",mesh,mesh.F.rows()-m,[&]()
+  {
+    igl::decimate(mesh.V,mesh.F,m,false,U,G,J,I);
+    igl_benchmark::do_not_optimize(U);
+  });
+  runner.measure("qslim",mesh,mesh.F.rows()-m,[&]()
+  {
+    igl::qslim(mesh.V,mesh.F,m,false,U,G,J,I);
+    igl_benchmark::do_not_optimize(U);
+  });
+}
@@ -0,0 +1,203 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 Alec Jacobson <alecjacobson@gmail.com>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#include "benchmark_common.h"
+
+#include <igl/AABB.h>
+#include <igl/ambient_occlusion.h>
+#include <igl/adjacency_list.h>
+#include <igl/dijkstra.h>
+#include <igl/fast_winding_number.h>
+#include <igl/marching_cubes.h>
+#include <igl/per_vertex_normals.h>
+#include <igl/signed_distance.h>
+
+#include <Eigen/Core>
+#include <limits>
+
+namespace
+{
+  // Query points scattered uniformly in [-1.5,1.5]³ (deterministic)
+  Eigen::MatrixXd query_points(const int n)
+  {
+    std::srand(0);
+    return 1.5*Eigen::MatrixXd::Random(n,3);
+  }
+}
+
+IGL_BENCHMARK(aabb)
+{
+  igl::AABB<Eigen::MatrixXd,3> tree;
+  runner.measure("AABB::init",mesh,mesh.F.rows(),[&]()
+  {
+    tree.init(mesh.V,mesh.F);
+    igl_benchmark::do_not_optimize(tree);
+  });
+  runner.measure("AABB::init_sah",mesh,mesh.F.rows(),[&]()
+  {
+    tree.init(mesh.V,mesh.F,igl::AABB_BUILD_METHOD_SAH);
+    igl_benchmark::do_not_optimize(tree);
+  });
+  runner.measure("AABB::init_lbvh",mesh,mesh.F.rows(),[&]()
+  {
+    tree.init(mesh.V,mesh.F,igl::AABB_BUILD_METHOD_LBVH);
+    igl_benchmark::do_not_optimize(tree);
+  });
+  tree.init(mesh.V,mesh.F);
+  const Eigen::MatrixXd P = query_points(10000);
+  Eigen::VectorXd sqrD;
+  Eigen::VectorXi I;
+  Eigen::MatrixXd C;
+  runner.measure("AABB::squared_distance",mesh,P.rows(),[&]()
+  {
+    tree.squared_distance(mesh.V,mesh.F,P,sqrD,I,C);
+    igl_benchmark::do_not_optimize(sqrD);
+  });
+  // Rays from the query points through the origin
+  const Eigen::MatrixXd dir = -P;
+  Eigen::MatrixXd R(P.rows(),6);
+  R<<P,dir;
+  const double inf = std::numeric_limits<double>::infinity();
+  Eigen::VectorXd T;
+  Eigen::MatrixXd UV;
+  runner.measure("AABB::intersect_ray",mesh,P.rows(),[&]()
+  {
+    tree.intersect_ray(mesh.V,mesh.F,P,dir,inf,I,T,UV);
+    igl_benchmark::do_not_optimize(T);
+  });
+  runner.measure("AABB::intersect_rays",mesh,P.rows(),[&]()
+  {
+    tree.intersect_rays(mesh.V,mesh.F,R,inf,I,T,UV);
+    igl_benchmark::do_not_optimize(T);
+  });
+  tree.freeze();
+  runner.measure("AABB::squared_distance_frozen",mesh,P.rows(),[&]()
+  {
+    tree.squared_distance(mesh.V,mesh.F,P,sqrD,I,C);
+    igl_benchmark::do_not_optimize(sqrD);
+  });
+}
+
+IGL_BENCHMARK(ambient_occlusion)
+{
+  igl::AABB<Eigen::MatrixXd,3> tree;
+  tree.init(mesh.V,mesh.F);
+  Eigen::MatrixXd N;
+  igl::per_vertex_normals(mesh.V,mesh.F,N);
+  const int num_samples = 64;
+  Eigen::VectorXd S;
+  runner.measure(
+    "ambient_occlusion",mesh,mesh.V.rows()*num_samples,[&]()
+  {
+    igl::ambient_occlusion(tree,mesh.V,mesh.F,mesh.V,N,num_samples,S);
+    igl_benchmark::do_not_optimize(S);
+  });
+}
+
+IGL_BENCHMARK(signed_distance)
+{
+  const Eigen::MatrixXd P = query_points(10000);
+  Eigen::VectorXd S;
+  Eigen::VectorXi I;
+  Eigen::MatrixXd C,N;
+  runner.measure("signed_distance_pseudonormal",mesh,P.rows(),[&]()
+  {
+    igl::signed_distance(
+      P,mesh.V,mesh.F,igl::SIGNED_DISTANCE_TYPE_PSEUDONORMAL,S,I,C,N);
+    igl_benchmark::do_not_optimize(S);
+  });
+  runner.measure("signed_distance_fast_winding_number",mesh,P.rows(),[&]()
+  {
+    igl::signed_distance(
+      P,mesh.V,mesh.F,igl::SIGNED_DISTANCE_TYPE_FAST_WINDING_NUMBER,S,I,C,N);
+    igl_benchmark::do_not_optimize(S);
+  });
+}
+
+IGL_BENCHMARK(fast_winding_number)
+{
+  igl::FastWindingNumberBVH fwn_bvh;
+  runner.measure("fast_winding_number_precompute",mesh,mesh.F.rows(),[&]()
+  {
+    igl::fast_winding_number(mesh.V,mesh.F,2,fwn_bvh);
+    igl_benchmark::do_not_optimize(fwn_bvh);
+  });
+  igl::fast_winding_number(mesh.V,mesh.F,2,fwn_bvh);
+  const Eigen::MatrixXd P = query_points(100000);
+  Eigen::VectorXd W;
+  runner.measure("fast_winding_number",mesh,P.rows(),[&]()
+  {
+    igl::fast_winding_number(fwn_bvh,2.f,P,W);
+    igl_benchmark::do_not_optimize(W);
+  });
+}
+
+IGL_BENCHMARK(marching_cubes)
+{
+  // Grid resolution grows with the mesh level so the output surface has
+  // roughly the same complexity as the input sphere.
+  const int n = 4<<mesh.level;
+  Eigen::MatrixXd GV(n*n*n,3);
+  Eigen::VectorXd S(n*n*n);
+  for(int z = 0;z<n;z++)
+  {
+    for(int y = 0;y<n;y++)
+    {
+      for(int x = 0;x<n;x++)
+      {
+        const int i = x+n*(y+n*z);
+        GV.row(i) =
+          Eigen::RowVector3d(x,y,z)*(2.5/(n-1)) - Eigen::RowVector3d::Constant(1.25);
+        S(i) = GV.row(i).norm()-1.0;
+      }
+    }
+  }
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  runner.measure("marching_cubes",mesh,S.size(),[&]()
+  {
+    igl::marching_cubes(S,GV,n,n,n,0.0,V,F);
+    igl_benchmark::do_not_optimize(V);
+  });
+}
+
+IGL_BENCHMARK(dijkstra)
+{
+  std::vector<std::vector<int> > VV;
+  igl::adjacency_list(mesh.F,VV);
+  std::vector<Eigen::Triplet<double> > IJV;
+  for(int u = 0;u<int(VV.size());u++)
+  {
+    for(const int v : VV[u])
+    {
+      IJV.emplace_back(v,u,(mesh.V.row(u)-mesh.V.row(v)).norm());
+    }
+  }
+  Eigen::SparseMatrix<double> A(mesh.V.rows(),mesh.V.rows());
+  A.setFromTriplets(IJV.begin(),IJV.end());
+  Eigen::VectorXd D;
+  Eigen::VectorXi P;
+  runner.measure("dijkstra_adjacency_list",mesh,mesh.V.rows(),[&]()
+  {
+    igl::dijkstra(mesh.V,VV,0,std::set<int>{},D,P);
+    igl_benchmark::do_not_optimize(D);
+  });
+  igl::DijkstraWorkspace<double> ws;
+  const double inf = std::numeric_limits<double>::infinity();
+  runner.measure("dijkstra_workspace",mesh,mesh.V.rows(),[&]()
+  {
+    igl::dijkstra(A,Eigen::VectorXi::Zero(1),inf,ws);
+    igl_benchmark::do_not_optimize(ws);
+  });
+  const Eigen::VectorXi S = Eigen::VectorXi::LinSpaced(64,0,mesh.V.rows()-1);
+  Eigen::MatrixXd DS;
+  runner.measure("dijkstra_batch",mesh,S.size(),[&]()
+  {
+    igl::dijkstra(A,S,inf,DS);
+    igl_benchmark::do_not_optimize(DS);
+  });
+}
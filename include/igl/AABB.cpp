@@ -8,7 +8,6 @@
 #include "AABB.h"
 #include "EPS.h"
 #include "barycenter.h"
-#include "colon.h"
 #include "doublearea.h"
 #include "increment_ulp.h"
 #include "point_simplex_squared_distance.h"
@@ -17,16 +16,23 @@
 #include "volume.h"
 #include "ray_box_intersect.h"
 #include "parallel_for.h"
+#include "default_num_threads.h"
 #include "ray_mesh_intersect.h"
 #include "box_surface_area.h"
 #include "pad_box.h"
+#include <algorithm>
+#include <array>
+#include <cstdint>
 #include <iostream>
 #include <iomanip>
+#include <cmath>
 #include <limits>
 #include <list>
 #include <queue>
 #include <stack>
 #include <string>
+#include <type_traits>
+#include <utility>
 #include <stdio.h>
 
 // This would be so much better with C++17 if constexpr
@@ -135,6 +141,376 @@ namespace
 
 }
 
+namespace igl
+{
+  namespace AABB_internal
+  {
+    // Top-down construction of an AABB tree from per-primitive boxes. Each
+    // node owns a contiguous range of `order`, which split() reorders so that
+    // the left child owns its first part.
+    template <typename DerivedV, int DIM>
+    struct Builder
+    {
+      typedef igl::AABB<DerivedV,DIM> Node;
+      typedef typename DerivedV::Scalar Scalar;
+      typedef Eigen::Matrix<Scalar,Eigen::Dynamic,DIM> MatrixXS;
+      typedef Eigen::AlignedBox<Scalar,DIM> Box;
+      // Number of SAH bins per axis
+      static constexpr int num_bins = 16;
+      // Ranges smaller than this are processed serially
+      static constexpr int min_parallel = 10000;
+      AABBBuildMethod method;
+      // #Ele by DIM primitive box corners and centroids
+      MatrixXS box_min,box_max,centroid;
+      // AABB_BUILD_METHOD_MEDIAN: #Ele by DIM rank of each primitive's
+      // barycenter along each coordinate
+      Eigen::MatrixXi rank;
+      // AABB_BUILD_METHOD_LBVH: Morton codes aligned with order
+      std::vector<std::uint64_t> code;
+      std::vector<int> order;
+
+      template <typename DerivedEle>
+      Builder(
+        const Eigen::MatrixBase<DerivedV> & V,
+        const Eigen::MatrixBase<DerivedEle> & Ele,
+        const AABBBuildMethod method_):
+        method(method_)
+      {
+        const int m = Ele.rows();
+        box_min.resize(m,DIM);
+        box_max.resize(m,DIM);
+        igl::parallel_for(m,[&](const int i)
+        {
+          Box box;
+          for(int c = 0;c<Ele.cols();c++)
+          {
+            box.extend(V.row(Ele(i,c)).transpose());
+          }
+          box_min.row(i) = box.min().transpose();
+          box_max.row(i) = box.max().transpose();
+        },min_parallel);
+        order.resize(m);
+        for(int i = 0;i<m;i++) { order[i] = i; }
+        switch(method)
+        {
+          case AABB_BUILD_METHOD_MEDIAN:
+          {
+            // Same ranks as the serial median builder: median of sorted
+            // barycenter indices rather than of (possibly equal) values
+            MatrixXS BC;
+            if(Ele.cols() == 1)
+            {
+              BC = V;
+            }else
+            {
+              barycenter(V,Ele,BC);
+            }
+            MatrixXS _;
+            Eigen::MatrixXi IS;
+            igl::sort(BC,1,true,_,IS);
+            rank.resize(m,DIM);
+            for(int i = 0;i<m;i++)
+            {
+              for(int d = 0;d<DIM;d++)
+              {
+                rank(IS(i,d),d) = i;
+              }
+            }
+            break;
+          }
+          case AABB_BUILD_METHOD_SAH:
+          case AABB_BUILD_METHOD_LBVH:
+          default:
+          {
+            centroid = 0.5*(box_min+box_max);
+            if(method == AABB_BUILD_METHOD_LBVH)
+            {
+              sort_by_morton_code();
+            }
+            break;
+          }
+        }
+      }
+
+      void sort_by_morton_code()
+      {
+        const int m = order.size();
+        const Eigen::Matrix<Scalar,1,DIM> lo = centroid.colwise().minCoeff();
+        const Eigen::Matrix<Scalar,1,DIM> extent =
+          centroid.colwise().maxCoeff() - lo;
+        // Bits per coordinate
+        const int bits = 64/DIM;
+        const Scalar cells = Scalar(std::uint64_t(1)<<bits);
+        std::vector<std::pair<std::uint64_t,int> > code_order(m);
+        igl::parallel_for(m,[&](const int i)
+        {
+          std::uint64_t q[DIM];
+          for(int d = 0;d<DIM;d++)
+          {
+            const Scalar t = extent(d) > 0 ? (centroid(i,d)-lo(d))/extent(d) : 0;
+            q[d] = std::uint64_t(
+              std::min(std::max(t*cells,Scalar(0)),cells-1));
+          }
+          // Interleave bits, most significant first
+          std::uint64_t c = 0;
+          for(int b = bits-1;b>=0;b--)
+          {
+            for(int d = 0;d<DIM;d++)
+            {
+              c = (c<<1) | ((q[d]>>b) & 1);
+            }
+          }
+          code_order[i] = {c,i};
+        },min_parallel);
+        std::sort(code_order.begin(),code_order.end());
+        code.resize(m);
+        for(int i = 0;i<m;i++)
+        {
+          code[i] = code_order[i].first;
+          order[i] = code_order[i].second;
+        }
+      }
+
+      // Bounding box of primitives order[begin,end) and of their centroids
+      void range_box(
+        const int begin,
+        const int end,
+        Box & box,
+        Box & centroid_box) const
+      {
+        std::vector<Box> boxes,centroid_boxes;
+        igl::parallel_for(
+          end-begin,
+          [&](const size_t n){ boxes.resize(n); centroid_boxes.resize(n); },
+          [&](const int k, const size_t t)
+          {
+            const int i = order[begin+k];
+            boxes[t].extend(box_min.row(i).transpose());
+            boxes[t].extend(box_max.row(i).transpose());
+            if(centroid.size() > 0)
+            {
+              centroid_boxes[t].extend(centroid.row(i).transpose());
+            }
+          },
+          [&](const size_t t)
+          {
+            box.extend(boxes[t]);
+            centroid_box.extend(centroid_boxes[t]);
+          },
+          min_parallel);
+      }
+
+      // Reorder order[begin,end) so that the left child gets order[begin,mid)
+      // and return mid
+      int split(const int begin, const int end, const Box & box, const Box & centroid_box)
+      {
+        const int n = end-begin;
+        // Split in two halves by rank/coordinate along d
+        const auto split_half = [&](const int d)->int
+        {
+          const auto less = [&](const int i, const int j)
+          {
+            return method == AABB_BUILD_METHOD_MEDIAN ?
+              rank(i,d) < rank(j,d) :
+              (centroid(i,d) < centroid(j,d) ||
+                (centroid(i,d) == centroid(j,d) && i < j));
+          };
+          std::nth_element(
+            order.begin()+begin,order.begin()+begin+(n-1)/2,order.begin()+end,
+            less);
+          return begin+(n+1)/2;
+        };
+        switch(method)
+        {
+          case AABB_BUILD_METHOD_MEDIAN:
+          default:
+          {
+            int max_d = -1;
+            box.diagonal().maxCoeff(&max_d);
+            return split_half(max_d);
+          }
+          case AABB_BUILD_METHOD_LBVH:
+          {
+            const std::uint64_t first = code[begin];
+            const std::uint64_t diff = first ^ code[end-1];
+            if(diff == 0)
+            {
+              return begin+(n+1)/2;
+            }
+            int bit = 63;
+            while(!((diff>>bit) & 1)) { bit--; }
+            const std::uint64_t mask = std::uint64_t(1)<<bit;
+            return int(std::partition_point(
+              code.begin()+begin,code.begin()+end,
+              [mask](const std::uint64_t c){ return (c & mask) == 0; })
+              - code.begin());
+          }
+          case AABB_BUILD_METHOD_SAH:
+          {
+            return split_sah(begin,end,centroid_box,split_half);
+          }
+        }
+      }
+
+      template <typename SplitHalf>
+      int split_sah(
+        const int begin,
+        const int end,
+        const Box & centroid_box,
+        const SplitHalf & split_half)
+      {
+        const auto lo = centroid_box.min();
+        const auto extent = centroid_box.diagonal();
+        int max_d = -1;
+        extent.maxCoeff(&max_d);
+        if(!(extent(max_d) > 0))
+        {
+          // All centroids coincide
+          return split_half(max_d);
+        }
+        const auto bin = [&](const int i, const int d)->int
+        {
+          const int b = int(num_bins*((centroid(i,d)-lo(d))/extent(d)));
+          return std::min(std::max(b,0),num_bins-1);
+        };
+        // Per-thread bins: count and box of each bin along each axis
+        typedef std::array<std::array<std::pair<int,Box>,num_bins>,DIM> Bins;
+        std::vector<Bins> thread_bins;
+        Bins bins;
+        for(auto & axis : bins) { for(auto & b : axis) { b.first = 0; } }
+        igl::parallel_for(
+          end-begin,
+          [&](const size_t n){ thread_bins.assign(n,bins); },
+          [&](const int k, const size_t t)
+          {
+            const int i = order[begin+k];
+            for(int d = 0;d<DIM;d++)
+            {
+              if(!(extent(d) > 0)) { continue; }
+              auto & b = thread_bins[t][d][bin(i,d)];
+              b.first++;
+              b.second.extend(box_min.row(i).transpose());
+              b.second.extend(box_max.row(i).transpose());
+            }
+          },
+          [&](const size_t t)
+          {
+            for(int d = 0;d<DIM;d++)
+            {
+              for(int b = 0;b<num_bins;b++)
+              {
+                bins[d][b].first += thread_bins[t][d][b].first;
+                bins[d][b].second.extend(thread_bins[t][d][b].second);
+              }
+            }
+          },
+          min_parallel);
+        // Sweep: cost of splitting before bin b is
+        //   #left * area(left) + #right * area(right)
+        Scalar best_cost = std::numeric_limits<Scalar>::infinity();
+        int best_d = -1;
+        int best_b = -1;
+        for(int d = 0;d<DIM;d++)
+        {
+          if(!(extent(d) > 0)) { continue; }
+          Scalar right_cost[num_bins];
+          {
+            Box right;
+            int count = 0;
+            for(int b = num_bins-1;b>0;b--)
+            {
+              right.extend(bins[d][b].second);
+              count += bins[d][b].first;
+              right_cost[b] = count == 0 ? 0 : count*box_surface_area(right);
+            }
+          }
+          Box left;
+          int count = 0;
+          for(int b = 1;b<num_bins;b++)
+          {
+            left.extend(bins[d][b-1].second);
+            count += bins[d][b-1].first;
+            if(count == 0 || count == end-begin) { continue; }
+            const Scalar cost = count*box_surface_area(left) + right_cost[b];
+            if(cost < best_cost)
+            {
+              best_cost = cost;
+              best_d = d;
+              best_b = b;
+            }
+          }
+        }
+        if(best_d < 0)
+        {
+          return split_half(max_d);
+        }
+        return int(std::partition(
+          order.begin()+begin,order.begin()+end,
+          [&](const int i){ return bin(i,best_d) < best_b; })
+          - order.begin());
+      }
+
+      // Set box of node owning order[begin,end) and split it unless it's a
+      // leaf. Returns false for leaves.
+      bool expand(Node * node, const int begin, const int end, int & mid)
+      {
+        Box centroid_box;
+        node->m_box = Box();
+        range_box(begin,end,node->m_box,centroid_box);
+        if(end-begin == 1)
+        {
+          node->m_primitive = order[begin];
+          return false;
+        }
+        mid = split(begin,end,node->m_box,centroid_box);
+        assert(mid > begin && mid < end);
+        node->m_left = new Node();
+        node->m_left->m_parent = node;
+        node->m_right = new Node();
+        node->m_right->m_parent = node;
+        return true;
+      }
+
+      void build(Node * node, const int begin, const int end)
+      {
+        int mid;
+        if(expand(node,begin,end,mid))
+        {
+          build(node->m_left,begin,mid);
+          build(node->m_right,mid,end);
+        }
+      }
+
+      void build(Node * root)
+      {
+        struct Range { Node * node; int begin; int end; };
+        std::vector<Range> frontier(1,{root,0,int(order.size())});
+        // Split top levels (with parallel loops over primitives) until there
+        // are enough independent subtrees to keep all threads busy
+        const size_t num_subtrees = 4*igl::default_num_threads();
+        while(!frontier.empty() && frontier.size() < num_subtrees)
+        {
+          std::vector<Range> next;
+          for(const Range & range : frontier)
+          {
+            int mid;
+            if(expand(range.node,range.begin,range.end,mid))
+            {
+              next.push_back({range.node->m_left,range.begin,mid});
+              next.push_back({range.node->m_right,mid,range.end});
+            }
+          }
+          frontier.swap(next);
+        }
+        igl::parallel_for(frontier.size(),[&](const size_t k)
+        {
+          build(frontier[k].node,frontier[k].begin,frontier[k].end);
+        },2);
+      }
+    };
+  }
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // Non-templated member functions
 ///////////////////////////////////////////////////////////////////////////////
@@ -161,6 +537,7 @@ IGL_INLINE igl::AABB<DerivedV,DIM>* igl::AABB<DerivedV,DIM>::root() const
 template <typename DerivedV, int DIM>
 IGL_INLINE igl::AABB<DerivedV,DIM>* igl::AABB<DerivedV,DIM>::detach()
 {
+  assert(!is_frozen() && "Pointer-based methods require thaw() first");
   if(!this->m_parent)
   {
     // Before
@@ -220,6 +597,7 @@ IGL_INLINE igl::AABB<DerivedV,DIM>* igl::AABB<DerivedV,DIM>::detach()
 template <typename DerivedV, int DIM>
 IGL_INLINE void igl::AABB<DerivedV,DIM>::refit_lineage()
 {
+  assert(!is_frozen() && "Pointer-based methods require thaw() first");
   const decltype(m_box) old_box = m_box;
   if(!is_leaf())
   {
@@ -238,6 +616,7 @@ template <typename DerivedV, int DIM>
 IGL_INLINE std::vector<igl::AABB<DerivedV,DIM>*>
   igl::AABB<DerivedV,DIM>::gather_leaves(const int m)
 {
+  assert(!is_frozen() && "Pointer-based methods require thaw() first");
   auto * tree = this;
   std::vector<igl::AABB<DerivedV,DIM>*> leaves(m,nullptr);
   {
@@ -264,6 +643,7 @@ template <typename DerivedV, int DIM>
 IGL_INLINE std::vector<igl::AABB<DerivedV,DIM>*>
   igl::AABB<DerivedV,DIM>::gather_leaves()
 {
+  assert(!is_frozen() && "Pointer-based methods require thaw() first");
   int max_primitive = -1;
   {
     std::vector<igl::AABB<DerivedV,DIM>* > stack;
@@ -287,6 +667,7 @@ IGL_INLINE igl::AABB<DerivedV,DIM>* igl::AABB<DerivedV,DIM>::pad(
   const igl::AABB<DerivedV,DIM>::Scalar pad,
   const int polish_rotate_passes)
 {
+  assert(!is_frozen() && "Pointer-based methods require thaw() first");
   // Will get reset to root below anyway. This does _not_ operate on subtrees.
   auto * tree = this->root();
   for(auto * leaf : leaves)
@@ -320,6 +701,7 @@ IGL_INLINE igl::AABB<DerivedV,DIM>* igl::AABB<DerivedV,DIM>::update(
     const Eigen::AlignedBox<Scalar,DIM> & new_box,
     const Scalar pad)
 {
+  assert(!is_frozen() && "Pointer-based methods require thaw() first");
   auto * leaf = this;
   if(leaf->m_box.contains(new_box)) { return leaf; }
   leaf->m_box = new_box;
@@ -336,6 +718,8 @@ IGL_INLINE igl::AABB<DerivedV,DIM>* igl::AABB<DerivedV,DIM>::update(
 template <typename DerivedV, int DIM>
 IGL_INLINE igl::AABB<DerivedV,DIM>* igl::AABB<DerivedV,DIM>::insert_as_sibling(AABB * other)
 {
+  assert(!is_frozen() && "Pointer-based methods require thaw() first");
+  assert(!other->is_frozen() && "Pointer-based methods require thaw() first");
   // Before
   //        parent
   //          |
@@ -376,6 +760,7 @@ IGL_INLINE igl::AABB<DerivedV,DIM>* igl::AABB<DerivedV,DIM>::insert_as_sibling(A
 template <typename DerivedV, int DIM>
 IGL_INLINE typename DerivedV::Scalar igl::AABB<DerivedV,DIM>::rotate(const bool dry_run)
 {
+  assert(!is_frozen() && "Pointer-based methods require thaw() first");
   if(is_root()) { return false; }
   // Biased order.
   //
@@ -416,6 +801,7 @@ IGL_INLINE typename DerivedV::Scalar igl::AABB<DerivedV,DIM>::rotate(const bool
 template <typename DerivedV, int DIM>
 IGL_INLINE typename DerivedV::Scalar igl::AABB<DerivedV,DIM>::rotate_across(const bool dry_run)
 {
+  assert(!is_frozen() && "Pointer-based methods require thaw() first");
   // Before
   //        grandparent
   //        ╱         ╲
@@ -512,6 +898,7 @@ IGL_INLINE typename DerivedV::Scalar igl::AABB<DerivedV,DIM>::rotate_across(cons
 template <typename DerivedV, int DIM>
 IGL_INLINE typename DerivedV::Scalar igl::AABB<DerivedV,DIM>::rotate_up(const bool dry_run)
 {
+  assert(!is_frozen() && "Pointer-based methods require thaw() first");
   // Before
   //    grandparent
   //       ╱    ╲
@@ -542,6 +929,7 @@ IGL_INLINE typename DerivedV::Scalar igl::AABB<DerivedV,DIM>::rotate_up(const bo
 template <typename DerivedV, int DIM>
 IGL_INLINE typename DerivedV::Scalar igl::AABB<DerivedV,DIM>::rotate_down(const bool dry_run)
 {
+  assert(!is_frozen() && "Pointer-based methods require thaw() first");
   // Before
   //       parent
   //       ╱    ╲
@@ -651,6 +1039,7 @@ IGL_INLINE typename DerivedV::Scalar igl::AABB<DerivedV,DIM>::rotate_up(
 template <typename DerivedV, int DIM>
 IGL_INLINE int igl::AABB<DerivedV,DIM>::subtree_size() const
 {
+  assert(!is_frozen() && "Pointer-based methods require thaw() first");
   // 1 for self
   int n = 1;
   int n_left = 0,n_right = 0;
@@ -669,6 +1058,7 @@ IGL_INLINE int igl::AABB<DerivedV,DIM>::subtree_size() const
 template <typename DerivedV, int DIM>
 IGL_INLINE void igl::AABB<DerivedV,DIM>::rotate_lineage()
 {
+  assert(!is_frozen() && "Pointer-based methods require thaw() first");
   std::vector<igl::AABB<DerivedV, DIM> *> lineage;
   {
     auto * node = this;
@@ -693,6 +1083,7 @@ IGL_INLINE bool igl::AABB<DerivedV,DIM>::append_intersecting_leaves(
     const Eigen::AlignedBox<igl::AABB<DerivedV,DIM>::Scalar,DIM> & box,
     std::vector<const igl::AABB<DerivedV,DIM>*> & leaves) const
 {
+  assert(!is_frozen() && "Pointer-based methods require thaw() first");
   if(!box.intersects(m_box)){ return false;}
 
   if(is_leaf())
@@ -710,6 +1101,18 @@ IGL_INLINE typename DerivedV::Scalar igl::AABB<DerivedV,DIM>::internal_surface_a
 {
   // Don't include self (parent's call will add me if I'm not a root or leaf)
   Scalar surface_area = 0;
+  if(m_frozen)
+  {
+    const Frozen & frozen = *m_frozen;
+    for(int k = 1;k<frozen.next.size();k++)
+    {
+      if(frozen.next(k) >= 0)
+      {
+        surface_area += box_surface_area(frozen_box(k));
+      }
+    }
+    return surface_area;
+  }
   if(m_left && !m_left->is_leaf())
   {
     surface_area += box_surface_area(m_left->m_box);
@@ -723,9 +1126,17 @@ IGL_INLINE typename DerivedV::Scalar igl::AABB<DerivedV,DIM>::internal_surface_a
   return surface_area;
 }
 
+template <typename DerivedV, int DIM>
+IGL_INLINE typename DerivedV::Scalar igl::AABB<DerivedV,DIM>::sah_cost() const
+{
+  const Scalar root_surface_area = box_surface_area(m_box);
+  return root_surface_area > 0 ? internal_surface_area()/root_surface_area : 0;
+}
+
 template <typename DerivedV, int DIM>
 IGL_INLINE void igl::AABB<DerivedV,DIM>::validate() const
 {
+  assert(!is_frozen() && "Pointer-based methods require thaw() first");
   if(this->is_leaf())
   {
     assert(this->m_primitive >= 0 || this->is_root());
@@ -747,6 +1158,7 @@ IGL_INLINE void igl::AABB<DerivedV,DIM>::validate() const
 template <typename DerivedV, int DIM>
 IGL_INLINE void igl::AABB<DerivedV,DIM>::print(const int depth) const
 {
+  assert(!is_frozen() && "Pointer-based methods require thaw() first");
   const auto indent = std::string(depth*2,' ');
   printf("%s%p",indent.c_str(),this);
   if(this->is_leaf())
@@ -771,6 +1183,10 @@ IGL_INLINE void igl::AABB<DerivedV,DIM>::print(const int depth) const
 template <typename DerivedV, int DIM>
 IGL_INLINE int igl::AABB<DerivedV,DIM>::size() const
 {
+  if(m_frozen)
+  {
+    return std::max(int(m_frozen->next.size()),1);
+  }
   return 1 +
     (this->m_left ? this->m_left ->size():0) +
     (this->m_right? this->m_right->size():0);
@@ -778,6 +1194,25 @@ IGL_INLINE int igl::AABB<DerivedV,DIM>::size() const
 template <typename DerivedV, int DIM>
 IGL_INLINE int igl::AABB<DerivedV,DIM>::height() const
 {
+  if(m_frozen)
+  {
+    // Depth-first walk with explicit stack of (node,depth)
+    int h = 1;
+    std::vector<std::pair<int,int> > stack;
+    if(m_frozen->next.size() > 0) { stack.emplace_back(0,1); }
+    while(!stack.empty())
+    {
+      const auto [node,depth] = stack.back();
+      stack.pop_back();
+      h = std::max(h,depth);
+      if(m_frozen->next(node) >= 0)
+      {
+        stack.emplace_back(node+1,depth+1);
+        stack.emplace_back(m_frozen->next(node),depth+1);
+      }
+    }
+    return h;
+  }
   return 1 + std::max(
     (this->m_left ?this->m_left ->height():0),
     (this->m_right?this->m_right->height():0));
@@ -802,6 +1237,217 @@ IGL_INLINE void igl::AABB<DerivedV,DIM>::set_min(
 }
 
 
+template <typename DerivedV, int DIM>
+IGL_INLINE void igl::AABB<DerivedV,DIM>::freeze()
+{
+  assert(is_root() && "Only a root can be frozen");
+  if(m_frozen)
+  {
+    return;
+  }
+  // Internal nodes with a single child are skipped
+  const auto skip = [](const AABB * node)
+  {
+    while(!node->is_leaf() && !(node->m_left && node->m_right))
+    {
+      node = node->m_left ? node->m_left : node->m_right;
+    }
+    return node;
+  };
+  const auto round_down = [](const Scalar x)->float
+  {
+    const float f = float(x);
+    return Scalar(f) > x ?
+      std::nextafter(f,-std::numeric_limits<float>::infinity()) : f;
+  };
+  const auto round_up = [](const Scalar x)->float
+  {
+    const float f = float(x);
+    return Scalar(f) < x ?
+      std::nextafter(f,std::numeric_limits<float>::infinity()) : f;
+  };
+  std::vector<const AABB *> order;
+  // Pre-order (node,parent) stack so left children follow their parents and
+  // right children can be patched into their parent's `next`
+  std::vector<std::pair<const AABB *,int> > stack;
+  const AABB * root = skip(this);
+  if(!(root->is_leaf() && root->m_primitive < 0))
+  {
+    stack.emplace_back(root,-1);
+  }
+  std::vector<int> next;
+  while(!stack.empty())
+  {
+    const auto [node,parent] = stack.back();
+    stack.pop_back();
+    const int k = int(order.size());
+    order.push_back(node);
+    next.push_back(node->is_leaf() ? -1-node->m_primitive : -1);
+    if(parent >= 0)
+    {
+      next[parent] = k;
+    }
+    if(!node->is_leaf())
+    {
+      stack.emplace_back(skip(node->m_right),k);
+      stack.emplace_back(skip(node->m_left),-1);
+    }
+  }
+  const int n = int(order.size());
+  typename Frozen::MatrixXDf box_min(n,DIM),box_max(n,DIM);
+  Eigen::VectorXi frozen_next(n);
+  for(int k = 0;k<n;k++)
+  {
+    for(int d = 0;d<DIM;d++)
+    {
+      box_min(k,d) = round_down(order[k]->m_box.min()(d));
+      box_max(k,d) = round_up(order[k]->m_box.max()(d));
+    }
+    frozen_next(k) = next[k];
+  }
+  // Free the pointer tree (children detach themselves from this)
+  delete m_left;
+  m_left = nullptr;
+  delete m_right;
+  m_right = nullptr;
+  m_frozen = std::make_shared<const Frozen>(
+    std::move(box_min),std::move(box_max),std::move(frozen_next));
+}
+
+template <typename DerivedV, int DIM>
+IGL_INLINE void igl::AABB<DerivedV,DIM>::freeze(
+  std::shared_ptr<const Frozen> frozen)
+{
+  assert(is_root() && "Only a root can be frozen");
+  assert(frozen);
+  delete m_left;
+  m_left = nullptr;
+  delete m_right;
+  m_right = nullptr;
+  m_primitive = -1;
+  m_frozen = std::move(frozen);
+  m_box = m_frozen->next.size() > 0 ?
+    frozen_box(0) : Eigen::AlignedBox<Scalar,DIM>();
+}
+
+template <typename DerivedV, int DIM>
+template <typename DerivedEle>
+IGL_INLINE void igl::AABB<DerivedV,DIM>::freeze(
+  const Eigen::MatrixBase<DerivedV> & V,
+  const Eigen::MatrixBase<DerivedEle> & Ele)
+{
+  freeze();
+  // Clusters hold 3d triangles
+  if constexpr(DIM == 3)
+  {
+    if(Ele.cols() > 3 || !m_frozen->clusters.empty())
+    {
+      return;
+    }
+    const Frozen & frozen = *m_frozen;
+    const int n = frozen.next.size();
+    constexpr int capacity = igl::TriangleCluster<Scalar>::capacity;
+    // Number of leaves below each node. Children come after their parents.
+    std::vector<int> count(n);
+    for(int k = n-1;k>=0;k--)
+    {
+      count[k] = frozen.next(k) < 0 ? 1 : count[k+1] + count[frozen.next(k)];
+    }
+    auto clustered = std::make_shared<Frozen>(
+      typename Frozen::MatrixXDf(frozen.box_min),
+      typename Frozen::MatrixXDf(frozen.box_max),
+      Eigen::VectorXi(frozen.next));
+    clustered->cluster.setConstant(n,-1);
+    std::vector<int> stack;
+    if(n > 0)
+    {
+      stack.push_back(0);
+    }
+    while(!stack.empty())
+    {
+      const int k = stack.back();
+      stack.pop_back();
+      if(count[k] > capacity)
+      {
+        stack.push_back(frozen.next(k));
+        stack.push_back(k+1);
+        continue;
+      }
+      if(count[k] == 1)
+      {
+        // A lone leaf gains nothing
+        continue;
+      }
+      // Leaves of a subtree are contiguous: a full binary tree with count[k]
+      // leaves has 2*count[k]-1 nodes
+      igl::TriangleCluster<Scalar> cluster;
+      for(int j = k;j<k+2*count[k]-1;j++)
+      {
+        if(frozen.next(j) < 0)
+        {
+          const int primitive = -1-frozen.next(j);
+          // Same HACK as point_simplex_squared_distance for points and segments
+          cluster.push_back(
+            V.row(Ele(primitive,0)),
+            V.row(Ele(primitive,1%Ele.cols())),
+            V.row(Ele(primitive,2%Ele.cols())),
+            primitive);
+        }
+      }
+      assert(cluster.size == count[k]);
+      clustered->cluster(k) = int(clustered->clusters.size());
+      clustered->clusters.push_back(cluster);
+    }
+    m_frozen = std::move(clustered);
+  }
+}
+
+template <typename DerivedV, int DIM>
+IGL_INLINE void igl::AABB<DerivedV,DIM>::thaw()
+{
+  if(!m_frozen)
+  {
+    return;
+  }
+  const Frozen & frozen = *m_frozen;
+  if(frozen.next.size() > 0)
+  {
+    std::vector<std::pair<AABB *,int> > stack(1,{this,0});
+    while(!stack.empty())
+    {
+      const auto [node,k] = stack.back();
+      stack.pop_back();
+      if(node != this)
+      {
+        node->m_box = frozen_box(k);
+      }
+      if(frozen.next(k) < 0)
+      {
+        node->m_primitive = -1-frozen.next(k);
+        continue;
+      }
+      node->m_primitive = -1;
+      node->m_left = new AABB();
+      node->m_left->m_parent = node;
+      node->m_right = new AABB();
+      node->m_right->m_parent = node;
+      stack.emplace_back(node->m_right,frozen.next(k));
+      stack.emplace_back(node->m_left,k+1);
+    }
+  }
+  m_frozen.reset();
+}
+
+template <typename DerivedV, int DIM>
+IGL_INLINE Eigen::AlignedBox<typename igl::AABB<DerivedV,DIM>::Scalar,DIM>
+igl::AABB<DerivedV,DIM>::frozen_box(const int node) const
+{
+  return Eigen::AlignedBox<Scalar,DIM>(
+    m_frozen->box_min.row(node).transpose().template cast<Scalar>(),
+    m_frozen->box_max.row(node).transpose().template cast<Scalar>());
+}
+
+
 ///////////////////////////////////////////////////////////////////////////////
 // Templated member functions
 ///////////////////////////////////////////////////////////////////////////////
@@ -842,33 +1488,7 @@ IGL_INLINE void igl::AABB<DerivedV,DIM>::init(
     }
   }else
   {
-    Eigen::VectorXi allI = colon<int>(0,Ele.rows()-1);
-    MatrixXDIMS BC;
-    if(Ele.cols() == 1)
-    {
-      // points
-      BC = V;
-    }else
-    {
-      // Simplices
-      barycenter(V,Ele,BC);
-    }
-    Eigen::MatrixXi SI(BC.rows(),BC.cols());
-    {
-      MatrixXDIMS _;
-      Eigen::MatrixXi IS;
-      igl::sort(BC,1,true,_,IS);
-      // Need SI(i) to tell which place i would be sorted into
-      const int dim = IS.cols();
-      for(int i = 0;i<IS.rows();i++)
-      {
-        for(int d = 0;d<dim;d++)
-        {
-          SI(IS(i,d),d) = i;
-        }
-      }
-    }
-    init(V,Ele,SI,allI);
+    init(V,Ele,AABB_BUILD_METHOD_MEDIAN);
   }
 }
 
@@ -882,6 +1502,23 @@ void igl::AABB<DerivedV,DIM>::init(
   return init(V,Ele,MatrixXDIMS(),MatrixXDIMS(),Eigen::VectorXi(),0);
 }
 
+template <typename DerivedV, int DIM>
+template <typename DerivedEle>
+IGL_INLINE void igl::AABB<DerivedV,DIM>::init(
+    const Eigen::MatrixBase<DerivedV> & V,
+    const Eigen::MatrixBase<DerivedEle> & Ele,
+    const AABBBuildMethod method)
+{
+  clear();
+  if(V.size() == 0 || Ele.size() == 0)
+  {
+    return;
+  }
+  assert(DIM == V.cols() && "V.cols() should matched declared dimension");
+  AABB_internal::Builder<DerivedV,DIM> builder(V,Ele,method);
+  builder.build(this);
+}
+
   template <typename DerivedV, int DIM>
 template <
   typename DerivedEle,
@@ -985,6 +1622,7 @@ IGL_INLINE igl::AABB<DerivedV,DIM>* igl::AABB<DerivedV,DIM>::update_primitive(
     const Eigen::MatrixBase<DerivedEle> & Ele,
     const Scalar pad)
 {
+  assert(!is_frozen() && "Pointer-based methods require thaw() first");
   assert(this->is_leaf());
   assert(this->m_primitive >= 0 && this->m_primitive < Ele.rows());
   Eigen::AlignedBox<double, 3> new_box;
@@ -998,6 +1636,8 @@ IGL_INLINE igl::AABB<DerivedV,DIM>* igl::AABB<DerivedV,DIM>::update_primitive(
 template <typename DerivedV, int DIM>
 IGL_INLINE igl::AABB<DerivedV,DIM>* igl::AABB<DerivedV,DIM>::insert(AABB * other)
 {
+  assert(!is_frozen() && "Pointer-based methods require thaw() first");
+  assert(!other->is_frozen() && "Pointer-based methods require thaw() first");
   // test if this is the same pointer as other
   if(this == other)
   {
@@ -1050,6 +1690,15 @@ IGL_INLINE std::vector<int> igl::AABB<DerivedV,DIM>::find(
       "Query dimension should match aabb dimension");
   assert(Ele.cols() == V.cols()+1 &&
       "AABB::find only makes sense for (d+1)-simplices");
+  if(m_frozen)
+  {
+    std::vector<int> found;
+    if(m_frozen->next.size() > 0)
+    {
+      frozen_find(V,Ele,q,first,0,found);
+    }
+    return found;
+  }
   // Check if outside bounding box
   bool inside = m_box.contains(q.transpose());
   if(!inside)
@@ -1092,6 +1741,7 @@ IGL_INLINE void igl::AABB<DerivedV,DIM>::serialize(
     Eigen::PlainObjectBase<Derivedelements> & elements,
     const int i) const
 {
+  assert(!is_frozen() && "Pointer-based methods require thaw() first");
   // Calling for root then resize output
   if(i==0)
   {
@@ -1146,6 +1796,11 @@ igl::AABB<DerivedV,DIM>::squared_distance(
   {
     return low_sqr_d;
   }
+  if(m_frozen)
+  {
+    return m_frozen->next.size() == 0 ? up_sqr_d :
+      frozen_squared_distance(V,Ele,p,low_sqr_d,up_sqr_d,0,i,c);
+  }
   Scalar sqr_d = up_sqr_d;
   //assert(DIM == 3 && "Code has only been tested for DIM == 3");
   assert((Ele.cols() == 3 || Ele.cols() == 2 || Ele.cols() == 1)
@@ -1285,9 +1940,24 @@ IGL_INLINE void igl::AABB<DerivedV,DIM>::squared_distance(
   assert(other_Ele.cols() == 1 &&
     "Only implemented for other as list of points");
   assert(other_V.cols() == V.cols() && "other must match this dimension");
+  assert(!other.is_frozen() && "other must not be frozen");
   sqrD.setConstant(other_Ele.rows(),1,std::numeric_limits<double>::infinity());
   I.resize(other_Ele.rows(),1);
   C.resize(other_Ele.rows(),other_V.cols());
+  if(m_frozen)
+  {
+    // No dual traversal on the flat layout: query each point
+    igl::parallel_for(other_Ele.rows(),[&](const int j)
+    {
+      const RowVectorDIMS p = other_V.row(j);
+      RowVectorDIMS c;
+      int i = -1;
+      sqrD(j) = squared_distance(V,Ele,p,i,c);
+      I(j) = i;
+      C.row(j) = c;
+    },10000);
+    return;
+  }
   // All points in other_V currently think they need to check against root of
   // this. The point of using another AABB is to quickly prune chunks of
   // other_V so that most points just check some subtree of this.
@@ -1459,6 +2129,12 @@ igl::AABB<DerivedV,DIM>::intersect_ray(
   RowVectorDIMS inv_dir = dir.cwiseInverse();
   RowVectorDIMS inv_dir_pad = inv_dir;
   igl::increment_ulp(inv_dir_pad, 2);
+  if(m_frozen)
+  {
+    hits.clear();
+    return m_frozen->next.size() > 0 &&
+      frozen_intersect_ray(V, Ele, origin, dir, inv_dir, inv_dir_pad, 0, hits);
+  }
   return intersect_ray_opt(V, Ele, origin, dir, inv_dir, inv_dir_pad, hits);
 }
 
@@ -1534,6 +2210,11 @@ igl::AABB<DerivedV,DIM>::intersect_ray(
   RowVectorDIMS inv_dir = dir.cwiseInverse();
   RowVectorDIMS inv_dir_pad = inv_dir;
   igl::increment_ulp(inv_dir_pad, 2);
+  if(m_frozen)
+  {
+    return m_frozen->next.size() > 0 && frozen_intersect_ray(
+      V, Ele, origin, dir, inv_dir, inv_dir_pad, _min_t, 0, hit);
+  }
   return intersect_ray_opt(V, Ele, origin, dir, inv_dir, inv_dir_pad, _min_t, hit);
 }
 
@@ -1599,6 +2280,342 @@ IGL_INLINE void igl::AABB<DerivedV,DIM>::intersect_ray(
   10000);
 }
 
+template <typename DerivedV, int DIM>
+template <int PacketSize, typename DerivedEle>
+IGL_INLINE int igl::AABB<DerivedV,DIM>::intersect_ray_packet(
+  const Eigen::MatrixBase<DerivedV> & V,
+  const Eigen::MatrixBase<DerivedEle> & Ele,
+  const Eigen::Matrix<Scalar,PacketSize,DIM> & origin,
+  const Eigen::Matrix<Scalar,PacketSize,DIM> & dir,
+  const Scalar max_t,
+  const bool any_hit,
+  std::array<igl::Hit<typename DerivedV::Scalar>,PacketSize> & hits) const
+{
+  static_assert(DIM == 3,"Ray packets need DIM == 3");
+  static_assert(PacketSize > 0 && PacketSize <= 32,"One bit per ray");
+  assert((Ele.size() == 0 || Ele.cols() == 3) && "Elements should be triangles");
+  // Rays are lanes of fixed-size arrays and sets of rays are bit masks. The
+  // per-lane tests are branch-free so that loops over lanes vectorize.
+  typedef std::uint32_t Mask;
+  // Same (padded) reciprocal directions as the single ray traversal
+  const Eigen::Array<Scalar,PacketSize,DIM> inv_dir = dir.cwiseInverse();
+  Eigen::Array<Scalar,PacketSize,DIM> inv_dir_pad;
+  for(int r = 0;r<PacketSize;r++)
+  {
+    RowVectorDIMS inv_dir_r = inv_dir.row(r);
+    igl::increment_ulp(inv_dir_r,2);
+    inv_dir_pad.row(r) = inv_dir_r;
+  }
+  const Eigen::Array<Scalar,PacketSize,DIM> o = origin;
+  // Triangle tests run in double like ray_triangle_intersect
+  const Eigen::Array<double,PacketSize,DIM> o_d = origin.template cast<double>();
+  const Eigen::Array<double,PacketSize,DIM> dir_d = dir.template cast<double>();
+  // Rays are done once min_t is -∞ (any_hit)
+  Eigen::Array<Scalar,PacketSize,1> min_t =
+    Eigen::Array<Scalar,PacketSize,1>::Constant(max_t);
+  Mask active = PacketSize == 32 ? ~Mask(0) : (Mask(1)<<PacketSize)-1;
+  for(auto & hit : hits)
+  {
+    hit = {-1,-1,0,0,std::numeric_limits<Scalar>::infinity()};
+  }
+
+  // ray_box_intersect(origin,inv_dir,inv_dir_pad,box,0,min_t) for ray r
+  // (with the near and far slab picked after multiplying, so the loop over
+  // rays in box_mask has no branches)
+  const auto box_hit = [&](
+    const Eigen::AlignedBox<Scalar,DIM> & box,
+    const int r)->bool
+  {
+    const auto slab = [&](const int d, Scalar & t_near, Scalar & t_far)
+    {
+      const Scalar to_min = box.min()(d) - o(r,d);
+      const Scalar to_max = box.max()(d) - o(r,d);
+      const bool negative = inv_dir(r,d) < Scalar(0);
+      t_near = negative ? to_max*inv_dir(r,d) : to_min*inv_dir(r,d);
+      t_far = negative ? to_min*inv_dir_pad(r,d) : to_max*inv_dir_pad(r,d);
+    };
+    Scalar tmin,tmax;
+    slab(0,tmin,tmax);
+    bool inside = true;
+    const auto intersect = [&](const int d)
+    {
+      Scalar t_near,t_far;
+      slab(d,t_near,t_far);
+      inside = inside & !(tmin > t_far) & !(t_near > tmax);
+      // NaN-safe min and max
+      tmin = tmin > t_near ? tmin : t_near;
+      tmax = tmax < t_far ? tmax : t_far;
+    };
+    intersect(1);
+    intersect(2);
+    return inside & (tmin < min_t(r)) & (tmax > Scalar(0));
+  };
+  const auto box_mask = [&](
+    const Eigen::AlignedBox<Scalar,DIM> & box,
+    const Mask mask)->Mask
+  {
+    bool hit[PacketSize];
+    for(int r = 0;r<PacketSize;r++)
+    {
+      hit[r] = box_hit(box,r);
+    }
+    Mask bits = 0;
+    for(int r = 0;r<PacketSize;r++)
+    {
+      bits |= Mask(hit[r])<<r;
+    }
+    return bits & mask;
+  };
+
+  // intersect_triangle1 of raytri.c for ray r: returns whether it hits and
+  // (if so) the unnormalized t, u, v and the determinant
+  struct Triangle { Eigen::RowVector3d v0,edge1,edge2; };
+  const auto triangle = [&](const int f)->Triangle
+  {
+    const Eigen::RowVector3d v0 = V.row(Ele(f,0)).template cast<double>();
+    return {
+      v0,
+      V.row(Ele(f,1)).template cast<double>() - v0,
+      V.row(Ele(f,2)).template cast<double>() - v0};
+  };
+  const auto triangle_hit = [&](
+    const Triangle & T,
+    const int r,
+    double & det,
+    double & t,
+    double & u,
+    double & v)->bool
+  {
+    const double eps = 0.000001;
+    const double px = dir_d(r,1)*T.edge2(2) - dir_d(r,2)*T.edge2(1);
+    const double py = dir_d(r,2)*T.edge2(0) - dir_d(r,0)*T.edge2(2);
+    const double pz = dir_d(r,0)*T.edge2(1) - dir_d(r,1)*T.edge2(0);
+    det = T.edge1(0)*px + T.edge1(1)*py + T.edge1(2)*pz;
+    const double tx = o_d(r,0) - T.v0(0);
+    const double ty = o_d(r,1) - T.v0(1);
+    const double tz = o_d(r,2) - T.v0(2);
+    u = tx*px + ty*py + tz*pz;
+    const double qx = ty*T.edge1(2) - tz*T.edge1(1);
+    const double qy = tz*T.edge1(0) - tx*T.edge1(2);
+    const double qz = tx*T.edge1(1) - ty*T.edge1(0);
+    v = dir_d(r,0)*qx + dir_d(r,1)*qy + dir_d(r,2)*qz;
+    t = T.edge2(0)*qx + T.edge2(1)*qy + T.edge2(2)*qz;
+    return
+      ((det > eps) &
+        !((u < 0.0) | (u > det)) & !((v < 0.0) | (u + v > det))) |
+      ((det < -eps) &
+        !((u > 0.0) | (u < det)) & !((v > 0.0) | (u + v < det)));
+  };
+  // Keep the hit if it is the nearest so far (as in ray_triangle_intersect
+  // and intersect_ray)
+  const auto record = [&](
+    const int f,
+    const int r,
+    const double det,
+    const double t,
+    const double u,
+    const double v)
+  {
+    const double inv_det = 1.0/det;
+    if(!(t*inv_det > 0))
+    {
+      return;
+    }
+    const igl::Hit<Scalar> hit = {f,-1,
+      static_cast<float>(u*inv_det),
+      static_cast<float>(v*inv_det),
+      static_cast<float>(t*inv_det)};
+    if(hit.t < min_t(r))
+    {
+      hits[r] = hit;
+      min_t(r) = hit.t;
+      if(any_hit)
+      {
+        min_t(r) = -std::numeric_limits<Scalar>::infinity();
+        active &= ~(Mask(1)<<r);
+      }
+    }
+  };
+  const auto packet_leaf = [&](const int f, const Mask mask)
+  {
+    const Triangle T = triangle(f);
+    double det[PacketSize],t[PacketSize],u[PacketSize],v[PacketSize];
+    bool valid[PacketSize];
+    for(int r = 0;r<PacketSize;r++)
+    {
+      valid[r] = triangle_hit(T,r,det[r],t[r],u[r],v[r]);
+    }
+    for(int r = 0;r<PacketSize;r++)
+    {
+      if(((mask>>r)&1) && valid[r])
+      {
+        record(f,r,det[r],t[r],u[r],v[r]);
+      }
+    }
+  };
+
+  // Depth-first, left before right, each node tested against the rays that
+  // reached it (with their current nearest hit). Rays diverge further down,
+  // so once few rays reach a node its subtree is traced one ray at a time.
+  const auto traverse = [&](
+    const auto root,
+    const auto & box_of,
+    const auto & children)
+  {
+    typedef typename std::decay<decltype(root)>::type Node;
+    std::vector<Node> single_stack;
+    const auto trace_single = [&](const Node node, const int r)
+    {
+      single_stack.assign(1,node);
+      while(!single_stack.empty())
+      {
+        const Node n = single_stack.back();
+        single_stack.pop_back();
+        if(!box_hit(box_of(n),r))
+        {
+          continue;
+        }
+        Node left,right;
+        int f;
+        if(children(n,left,right,f))
+        {
+          single_stack.push_back(right);
+          single_stack.push_back(left);
+        }else if(f >= 0)
+        {
+          double det,t,u,v;
+          if(triangle_hit(triangle(f),r,det,t,u,v))
+          {
+            record(f,r,det,t,u,v);
+          }
+        }
+      }
+    };
+    std::vector<std::pair<Node,Mask> > stack(1,{root,active});
+    while(!stack.empty() && active)
+    {
+      const Node node = stack.back().first;
+      const Mask mask = box_mask(box_of(node),stack.back().second & active);
+      stack.pop_back();
+      int num_rays = 0;
+      for(Mask m = mask;m;m &= m-1) { num_rays++; }
+      if(num_rays == 0)
+      {
+        continue;
+      }
+      if(num_rays*4 <= PacketSize)
+      {
+        for(int r = 0;r<PacketSize;r++)
+        {
+          if((mask>>r)&1)
+          {
+            trace_single(node,r);
+          }
+        }
+        continue;
+      }
+      Node left,right;
+      int f;
+      if(children(node,left,right,f))
+      {
+        stack.emplace_back(right,mask);
+        stack.emplace_back(left,mask);
+      }else if(f >= 0)
+      {
+        packet_leaf(f,mask);
+      }
+    }
+  };
+  if(m_frozen)
+  {
+    if(m_frozen->next.size() > 0)
+    {
+      traverse(
+        0,
+        [&](const int node){ return frozen_box(node); },
+        [&](const int node, int & left, int & right, int & primitive)->bool
+        {
+          const int next = m_frozen->next(node);
+          primitive = -1-next;
+          left = node+1;
+          right = next;
+          return next >= 0;
+        });
+    }
+  }else
+  {
+    traverse(
+      this,
+      [](const AABB * node)->const Eigen::AlignedBox<Scalar,DIM> &
+        { return node->m_box; },
+      [](
+        const AABB * node,
+        const AABB *& left,
+        const AABB *& right,
+        int & primitive)->bool
+      {
+        primitive = node->m_primitive;
+        left = node->m_left;
+        right = node->m_right;
+        return !node->is_leaf();
+      });
+  }
+  int num_hits = 0;
+  for(const auto & hit : hits)
+  {
+    num_hits += hit.id >= 0;
+  }
+  return num_hits;
+}
+
+template <typename DerivedV, int DIM>
+template <
+  typename DerivedEle,
+  typename DerivedR,
+  typename DerivedI,
+  typename DerivedT,
+  typename DerivedUV>
+IGL_INLINE void igl::AABB<DerivedV,DIM>::intersect_rays(
+  const Eigen::MatrixBase<DerivedV> & V,
+  const Eigen::MatrixBase<DerivedEle> & Ele,
+  const Eigen::MatrixBase<DerivedR> & R,
+  const Scalar max_t,
+  Eigen::PlainObjectBase<DerivedI> & I,
+  Eigen::PlainObjectBase<DerivedT> & T,
+  Eigen::PlainObjectBase<DerivedUV> & UV) const
+{
+  assert(R.cols() == 2*DIM);
+  constexpr int PacketSize = 8;
+  const int num_rays = R.rows();
+  I.setConstant(num_rays,1,-1);
+  T.setConstant(num_rays,1,std::numeric_limits<Scalar>::quiet_NaN());
+  UV.setZero(num_rays,2);
+  const int num_packets = (num_rays+PacketSize-1)/PacketSize;
+  igl::parallel_for(num_packets,[&](const int p)
+  {
+    // Pad the last packet by repeating its last ray
+    Eigen::Matrix<Scalar,PacketSize,DIM> origin,dir;
+    for(int k = 0;k<PacketSize;k++)
+    {
+      const int r = std::min(p*PacketSize+k,num_rays-1);
+      origin.row(k) = R.row(r).template head<DIM>().template cast<Scalar>();
+      dir.row(k) = R.row(r).template tail<DIM>().template cast<Scalar>();
+    }
+    std::array<igl::Hit<Scalar>,PacketSize> hits;
+    intersect_ray_packet<PacketSize>(V,Ele,origin,dir,max_t,false,hits);
+    for(int k = 0;k<PacketSize && p*PacketSize+k<num_rays;k++)
+    {
+      const int r = p*PacketSize+k;
+      if(hits[k].id >= 0)
+      {
+        I(r) = hits[k].id;
+        T(r) = hits[k].t;
+        UV.row(r) << hits[k].u, hits[k].v;
+      }
+    }
+  },1000);
+}
+
 template <typename DerivedV, int DIM>
 template <typename DerivedEle>
 IGL_INLINE bool
@@ -1706,10 +2723,261 @@ igl::AABB<DerivedV,DIM>::intersect_ray_opt(
   return left_ret || right_ret;
 }
 
+template <typename DerivedV, int DIM>
+template <typename DerivedEle>
+IGL_INLINE typename igl::AABB<DerivedV,DIM>::Scalar
+igl::AABB<DerivedV,DIM>::frozen_squared_distance(
+  const Eigen::MatrixBase<DerivedV> & V,
+  const Eigen::MatrixBase<DerivedEle> & Ele,
+  const RowVectorDIMS & p,
+  const Scalar low_sqr_d,
+  const Scalar up_sqr_d,
+  const int node,
+  int & i,
+  Eigen::PlainObjectBase<RowVectorDIMS> & c) const
+{
+  if(low_sqr_d > up_sqr_d)
+  {
+    return low_sqr_d;
+  }
+  Scalar sqr_d = up_sqr_d;
+  if constexpr(DIM == 3)
+  {
+    if(m_frozen->cluster.size() > 0 && m_frozen->cluster(node) >= 0)
+    {
+      int i_candidate;
+      RowVectorDIMS c_candidate;
+      Scalar sqr_d_candidate;
+      igl::point_triangle_cluster_squared_distance(
+        p.data(),m_frozen->clusters[m_frozen->cluster(node)],
+        sqr_d_candidate,i_candidate,c_candidate.data());
+      set_min(p,sqr_d_candidate,i_candidate,c_candidate,sqr_d,i,c);
+      return sqr_d;
+    }
+  }
+  const int next = m_frozen->next(node);
+  if(next < 0)
+  {
+    const int primitive = -1-next;
+    RowVectorDIMS c_candidate;
+    Scalar sqr_d_candidate;
+    igl::point_simplex_squared_distance<DIM>(
+      p,V,Ele,primitive,sqr_d_candidate,c_candidate);
+    set_min(p,sqr_d_candidate,primitive,c_candidate,sqr_d,i,c);
+    return sqr_d;
+  }
+  const int left = node+1;
+  const int right = next;
+  bool looked_left = false;
+  bool looked_right = false;
+  const auto & look = [&](const int child, bool & looked)
+  {
+    int i_child;
+    RowVectorDIMS c_child = c;
+    Scalar sqr_d_child = frozen_squared_distance(
+      V,Ele,p,low_sqr_d,sqr_d,child,i_child,c_child);
+    this->set_min(p,sqr_d_child,i_child,c_child,sqr_d,i,c);
+    looked = true;
+  };
+  // Squared distance from p to a child's box (0 if inside), straight from the
+  // flat arrays
+  const auto box_sqr_d = [&](const int child)->Scalar
+  {
+    Scalar sqr_d_box = 0;
+    for(int d = 0;d<DIM;d++)
+    {
+      const Scalar lo = Scalar(m_frozen->box_min(child,d));
+      const Scalar hi = Scalar(m_frozen->box_max(child,d));
+      const Scalar e = p(d) < lo ? lo-p(d) : (p(d) > hi ? p(d)-hi : Scalar(0));
+      sqr_d_box += e*e;
+    }
+    return sqr_d_box;
+  };
+  const auto contains = [&](const int child)->bool
+  {
+    for(int d = 0;d<DIM;d++)
+    {
+      if(!(Scalar(m_frozen->box_min(child,d)) <= p(d) &&
+           p(d) <= Scalar(m_frozen->box_max(child,d))))
+      {
+        return false;
+      }
+    }
+    return true;
+  };
+  // must look left or right if in box
+  if(contains(left))
+  {
+    look(left,looked_left);
+  }
+  if(contains(right))
+  {
+    look(right,looked_right);
+  }
+  // if haven't looked left and could be less than current min, then look
+  const Scalar left_up_sqr_d = box_sqr_d(left);
+  const Scalar right_up_sqr_d = box_sqr_d(right);
+  if(left_up_sqr_d < right_up_sqr_d)
+  {
+    if(!looked_left && left_up_sqr_d<sqr_d) { look(left,looked_left); }
+    if(!looked_right && right_up_sqr_d<sqr_d) { look(right,looked_right); }
+  }else
+  {
+    if(!looked_right && right_up_sqr_d<sqr_d) { look(right,looked_right); }
+    if(!looked_left && left_up_sqr_d<sqr_d) { look(left,looked_left); }
+  }
+  return sqr_d;
+}
+
+template <typename DerivedV, int DIM>
+template <typename DerivedEle>
+IGL_INLINE bool
+igl::AABB<DerivedV,DIM>::frozen_intersect_ray(
+  const Eigen::MatrixBase<DerivedV> & V,
+  const Eigen::MatrixBase<DerivedEle> & Ele,
+  const RowVectorDIMS & origin,
+  const RowVectorDIMS & dir,
+  const RowVectorDIMS & inv_dir,
+  const RowVectorDIMS & inv_dir_pad,
+  const int node,
+  std::vector<igl::Hit<typename DerivedV::Scalar>> & hits) const
+{
+  {
+    Scalar _1,_2;
+    if(!ray_box_intersect(
+      origin,inv_dir,inv_dir_pad,frozen_box(node),
+      Scalar(0),std::numeric_limits<Scalar>::infinity(),_1,_2))
+    {
+      return false;
+    }
+  }
+  const int next = m_frozen->next(node);
+  if(next < 0)
+  {
+    assert((Ele.size() == 0 || Ele.cols() == 3) && "Elements should be triangles");
+    const int primitive = -1-next;
+    std::vector<igl::Hit<typename DerivedV::Scalar>> leaf_hits;
+    const bool ret =
+      ray_mesh_intersect(origin,dir,V,Ele.row(primitive),leaf_hits);
+    for(auto & hit : leaf_hits)
+    {
+      hit.id = primitive;
+      hits.push_back(hit);
+    }
+    return ret;
+  }
+  // Appends left hits before right hits
+  const bool left_ret = frozen_intersect_ray(
+    V,Ele,origin,dir,inv_dir,inv_dir_pad,node+1,hits);
+  const bool right_ret = frozen_intersect_ray(
+    V,Ele,origin,dir,inv_dir,inv_dir_pad,next,hits);
+  return left_ret || right_ret;
+}
+
+template <typename DerivedV, int DIM>
+template <typename DerivedEle>
+IGL_INLINE bool
+igl::AABB<DerivedV,DIM>::frozen_intersect_ray(
+  const Eigen::MatrixBase<DerivedV> & V,
+  const Eigen::MatrixBase<DerivedEle> & Ele,
+  const RowVectorDIMS & origin,
+  const RowVectorDIMS & dir,
+  const RowVectorDIMS & inv_dir,
+  const RowVectorDIMS & inv_dir_pad,
+  const Scalar _min_t,
+  const int node,
+  igl::Hit<typename DerivedV::Scalar> & hit) const
+{
+  Scalar min_t = _min_t;
+  {
+    Scalar _1,_2;
+    if(!ray_box_intersect(
+      origin,inv_dir,inv_dir_pad,frozen_box(node),Scalar(0),min_t,_1,_2))
+    {
+      return false;
+    }
+  }
+  const int next = m_frozen->next(node);
+  if(next < 0)
+  {
+    assert((Ele.size() == 0 || Ele.cols() == 3) && "Elements should be triangles");
+    const int primitive = -1-next;
+    const bool ret = ray_mesh_intersect(origin,dir,V,Ele.row(primitive),hit);
+    hit.id = primitive;
+    return ret;
+  }
+  igl::Hit<typename DerivedV::Scalar> left_hit;
+  igl::Hit<typename DerivedV::Scalar> right_hit;
+  bool left_ret = frozen_intersect_ray(
+    V,Ele,origin,dir,inv_dir,inv_dir_pad,min_t,node+1,left_hit);
+  if(left_ret && left_hit.t<min_t)
+  {
+    min_t = left_hit.t;
+    hit = left_hit;
+  }else
+  {
+    left_ret = false;
+  }
+  bool right_ret = frozen_intersect_ray(
+    V,Ele,origin,dir,inv_dir,inv_dir_pad,min_t,next,right_hit);
+  if(right_ret && right_hit.t<min_t)
+  {
+    hit = right_hit;
+  }else
+  {
+    right_ret = false;
+  }
+  return left_ret || right_ret;
+}
+
+template <typename DerivedV, int DIM>
+template <typename DerivedEle, typename Derivedq>
+IGL_INLINE bool igl::AABB<DerivedV,DIM>::frozen_find(
+  const Eigen::MatrixBase<DerivedV> & V,
+  const Eigen::MatrixBase<DerivedEle> & Ele,
+  const Eigen::MatrixBase<Derivedq> & q,
+  const bool first,
+  const int node,
+  std::vector<int> & found) const
+{
+  if(!frozen_box(node).contains(q.transpose()))
+  {
+    return false;
+  }
+  const int next = m_frozen->next(node);
+  if(next < 0)
+  {
+    const int primitive = -1-next;
+    if(AABB_all_positive_barycentric_coordinates_helper<
+        DerivedV,DerivedEle,Derivedq, DIM>::compute(V,Ele,primitive,q))
+    {
+      found.push_back(primitive);
+      return true;
+    }
+    return false;
+  }
+  const bool left = frozen_find(V,Ele,q,first,node+1,found);
+  if(first && left)
+  {
+    return true;
+  }
+  const bool right = frozen_find(V,Ele,q,first,next,found);
+  return left || right;
+}
+
 
 #ifdef IGL_STATIC_LIBRARY
 // Explicit template instantiation
+template void igl::AABB<Eigen::Matrix<double, -1, -1, 0, -1, -1>, 2>::freeze<Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&);
+template void igl::AABB<Eigen::Matrix<double, -1, -1, 0, -1, -1>, 2>::freeze<Eigen::Matrix<int, -1, 1, 0, -1, 1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> > const&);
+template void igl::AABB<Eigen::Matrix<double, -1, -1, 0, -1, -1>, 3>::freeze<Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&);
+template void igl::AABB<Eigen::Matrix<double, -1, -1, 0, -1, -1>, 3>::freeze<Eigen::Matrix<int, -1, 1, 0, -1, 1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> > const&);
+template void igl::AABB<Eigen::Matrix<double, -1, 3, 0, -1, 3>, 3>::freeze<Eigen::Matrix<int, -1, 3, 0, -1, 3> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, 3, 0, -1, 3> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 3, 0, -1, 3> > const&);
+template void igl::AABB<Eigen::Matrix<float, -1, 3, 0, -1, 3>, 3>::freeze<Eigen::Matrix<int, -1, 3, 0, -1, 3> >(Eigen::MatrixBase<Eigen::Matrix<float, -1, 3, 0, -1, 3> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 3, 0, -1, 3> > const&);
 // generated by autoexplicit.sh
+template int igl::AABB<Eigen::Matrix<double, -1, -1, 0, -1, -1>, 3>::intersect_ray_packet<8, Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::Matrix<double, 8, 3, 0, 8, 3> const&, Eigen::Matrix<double, 8, 3, 0, 8, 3> const&, double, bool, std::array<igl::Hit<double>, 8>&) const;
+template int igl::AABB<Eigen::Matrix<double, -1, -1, 0, -1, -1>, 3>::intersect_ray_packet<4, Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::Matrix<double, 4, 3, 0, 4, 3> const&, Eigen::Matrix<double, 4, 3, 0, 4, 3> const&, double, bool, std::array<igl::Hit<double>, 4>&) const;
+template void igl::AABB<Eigen::Matrix<double, -1, -1, 0, -1, -1>, 3>::intersect_rays<Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, double, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&) const;
 template bool igl::AABB<Eigen::Matrix<double, -1, -1, 0, -1, -1>, 3>::intersect_ray<Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::Matrix<double, 1, 3, 1, 1, 3> const&, Eigen::Matrix<double, 1, 3, 1, 1, 3> const&, std::vector<igl::Hit<double>, std::allocator<igl::Hit<double>> >&) const;
 
 template class igl::AABB<Eigen::Matrix<double, -1, -1, 0, -1, -1>, 3>;
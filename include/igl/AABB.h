@@ -8,11 +8,16 @@
 #ifndef IGL_AABB_H
 #define IGL_AABB_H
 
+#include "AABBBuildMethod.h"
 #include "Hit.h"
+#include "point_triangle_cluster_squared_distance.h"
 #include "igl_inline.h"
 #include <cassert>
 #include <Eigen/Core>
 #include <Eigen/Geometry>
+#include <array>
+#include <memory>
+#include <utility>
 #include <vector>
 namespace igl
 {
@@ -52,6 +57,66 @@ public:
       Eigen::AlignedBox<Scalar,DIM> m_box;
       /// Index of single primitive in this node if full leaf, otherwise -1 for non-leaf
       int m_primitive;
+      /// Flat, pointer-free layout of a frozen tree (see freeze()). Nodes are
+      /// stored in depth-first order so that the left child of an internal
+      /// node immediately follows it.
+      ///
+      /// The node arrays are viewed through maps so that they may live in
+      /// memory owned elsewhere (e.g., a mapped igl::BinaryCache file).
+      struct Frozen
+      {
+        typedef Eigen::Matrix<float,Eigen::Dynamic,DIM> MatrixXDf;
+        /// Node arrays owned by this layout (empty if viewing external
+        /// memory)
+        MatrixXDf owned_box_min;
+        MatrixXDf owned_box_max;
+        Eigen::VectorXi owned_next;
+        /// Keeps external memory viewed by the maps below alive
+        std::shared_ptr<const void> external;
+        /// #nodes by DIM lists of box corners, one column per coordinate,
+        /// rounded outward to float
+        Eigen::Map<const MatrixXDf> box_min;
+        Eigen::Map<const MatrixXDf> box_max;
+        /// #nodes list of index of right child for internal nodes, or
+        /// -1-primitive for leaves
+        Eigen::Map<const Eigen::VectorXi> next;
+        /// Take ownership of node arrays
+        Frozen(MatrixXDf && min, MatrixXDf && max, Eigen::VectorXi && nxt):
+          owned_box_min(std::move(min)),
+          owned_box_max(std::move(max)),
+          owned_next(std::move(nxt)),
+          box_min(owned_box_min.data(),owned_box_min.rows(),DIM),
+          box_max(owned_box_max.data(),owned_box_max.rows(),DIM),
+          next(owned_next.data(),owned_next.size())
+        {}
+        /// View n nodes stored (column-major) in external memory
+        ///
+        /// @param[in] external_  keeps the memory alive as long as needed
+        Frozen(
+          const float * min,
+          const float * max,
+          const int * nxt,
+          const int n,
+          std::shared_ptr<const void> external_):
+          external(std::move(external_)),
+          box_min(min,n,DIM),
+          box_max(max,n,DIM),
+          next(nxt,n)
+        {}
+        Frozen(const Frozen &) = delete;
+        Frozen & operator=(const Frozen &) = delete;
+        /// Triangles of small subtrees gathered for
+        /// point_triangle_cluster_squared_distance (empty unless built by
+        /// freeze(V,Ele))
+        std::vector<igl::TriangleCluster<Scalar> > clusters;
+        /// #nodes list of index into clusters of the cluster replacing the
+        /// subtree at each node in squared distance queries, -1 if none
+        /// (empty if no clusters)
+        Eigen::VectorXi cluster;
+      };
+      /// Immutable flat copy of this tree (only set on a frozen root, shared
+      /// between copies)
+      std::shared_ptr<const Frozen> m_frozen;
 ///////////////////////////////////////////////////////////////////////////////
 // Non-templated member functions
 ///////////////////////////////////////////////////////////////////////////////
@@ -73,7 +138,8 @@ public:
         m_right(other.m_right ? new AABB(*other.m_right) : nullptr),
         m_parent(other.m_parent),
         m_box(other.m_box),
-        m_primitive(other.m_primitive)
+        m_primitive(other.m_primitive),
+        m_frozen(other.m_frozen)
         //m_low_sqr_d(other.m_low_sqr_d),
         //m_depth(std::max(
         //   m_left ? m_left->m_depth + 1 : 0,
@@ -93,6 +159,7 @@ public:
         swap(first.m_parent,second.m_parent);
         swap(first.m_box,second.m_box);
         swap(first.m_primitive,second.m_primitive);
+        swap(first.m_frozen,second.m_frozen);
         //swap(first.m_low_sqr_d,second.m_low_sqr_d);
         //swap(first.m_depth,second.m_depth);
       }
@@ -117,6 +184,7 @@ public:
       {
         m_primitive = -1;
         m_box = Eigen::AlignedBox<Scalar,DIM>();
+        m_frozen.reset();
         delete m_left;
         m_left = nullptr;
         delete m_right;
@@ -420,6 +488,11 @@ public:
         std::vector<const AABB<DerivedV,DIM>*> & leaves) const;
       /// Compute sum of surface area of all internal (non-root, non-leaf) boxes
       IGL_INLINE typename DerivedV::Scalar internal_surface_area() const;
+      /// Quality measure of the tree for queries: internal_surface_area()
+      /// relative to the surface area of the root box. By the surface area
+      /// heuristic this is the expected number of internal boxes hit by a
+      /// random ray through the root box (lower is better).
+      IGL_INLINE typename DerivedV::Scalar sah_cost() const;
       /// Validate the subtree under this node by running a bunch of assertions.
       /// Does nothing when not in debug mode
       IGL_INLINE void validate() const;
@@ -432,6 +505,42 @@ public:
       IGL_INLINE int size() const;
       /// @returns Height of the tree. A singleton root has height 1.
       IGL_INLINE int height() const;
+      /// Replace the tree under this root by a flat, contiguous copy (see
+      /// Frozen) and free all other nodes. Point queries (squared_distance,
+      /// intersect_ray, find) run on the flat copy, which needs about a
+      /// quarter of the memory of the pointer tree and avoids chasing
+      /// pointers. Copying a frozen tree shares its (immutable) nodes.
+      ///
+      /// Methods that edit or walk the node pointers (insert, update,
+      /// rotate, serialize, append_intersecting_leaves, ...) assert an
+      /// unfrozen tree, see thaw().
+      IGL_INLINE void freeze();
+      /// Replace the tree under this root by an existing flat layout (e.g.,
+      /// one viewing a tree stored in an igl::BinaryCache). The root box
+      /// becomes the (float rounded) box of the layout's first node.
+      ///
+      /// @param[in] frozen  flat layout of a tree over the same primitives
+      IGL_INLINE void freeze(std::shared_ptr<const Frozen> frozen);
+      /// Freeze (see freeze()) and additionally copy the triangles of each
+      /// maximal subtree with at most TriangleCluster::capacity leaves into a
+      /// cluster, so that squared_distance tests a point against all of them
+      /// at once (see point_triangle_cluster_squared_distance) instead of
+      /// descending further. Only affects 3d trees over simplices with at
+      /// most 3 vertices; otherwise the same as freeze().
+      ///
+      /// @param[in] V  #V by dim list of vertex positions. Triangle corners
+      ///   are copied into the clusters, so V need not outlive the tree, but
+      ///   later changes to V are not seen until the tree is frozen again.
+      /// @param[in] Ele  #Ele by dim list of simplex indices
+      template <typename DerivedEle>
+      IGL_INLINE void freeze(
+        const Eigen::MatrixBase<DerivedV> & V,
+        const Eigen::MatrixBase<DerivedEle> & Ele);
+      /// Rebuild the pointer tree of a frozen root. Boxes below the root keep
+      /// their outward float rounding.
+      IGL_INLINE void thaw();
+      /// @return true iff this is a frozen root
+      bool is_frozen() const { return bool(m_frozen); }
 private:
       /// If new distance (sqr_d_candidate) is less than current distance
       /// (sqr_d), then update this distance and its associated values
@@ -485,8 +594,8 @@ public:
             const Eigen::MatrixBase<Derivedbb_maxs> & bb_maxs,
             const Eigen::MatrixBase<Derivedelements> & elements,
             const int i = 0);
-      /// Build an Axis-Aligned Bounding Box tree for a given mesh and given
-      /// serialization of a previous AABB tree.
+      /// Build an Axis-Aligned Bounding Box tree for a given mesh by median
+      /// splits (see AABB_BUILD_METHOD_MEDIAN).
       ///
       /// @param[in] V  #V by dim list of mesh vertex positions.
       /// @param[in] Ele  #Ele by dim+1 list of mesh indices into #V.
@@ -494,6 +603,21 @@ public:
       IGL_INLINE void init(
           const Eigen::MatrixBase<DerivedV> & V,
           const Eigen::MatrixBase<DerivedEle> & Ele);
+      /// Build an Axis-Aligned Bounding Box tree for a given mesh using a
+      /// given split strategy. The top levels are split with parallel loops
+      /// over primitives, then independent subtrees are built in parallel on
+      /// the thread pool.
+      ///
+      /// @param[in] V  #V by dim list of mesh vertex positions.
+      /// @param[in] Ele  #Ele by dim+1 list of mesh indices into #V.
+      /// @param[in] method  split strategy
+      ///
+      /// \see sah_cost
+      template <typename DerivedEle>
+      IGL_INLINE void init(
+          const Eigen::MatrixBase<DerivedV> & V,
+          const Eigen::MatrixBase<DerivedEle> & Ele,
+          const AABBBuildMethod method);
       /// Build an Axis-Aligned Bounding Box tree for a given mesh.
       ///
       /// @param[in] V  #V by dim list of mesh vertex positions.
@@ -703,6 +827,61 @@ public:
         const Eigen::MatrixBase<DerivedOrigin> & origin,
         const Eigen::MatrixBase<DerivedDir> & dir,
         std::vector<std::vector<igl::Hit<typename DerivedV::Scalar>>> & hits);
+      /// Intersect a packet of rays with the mesh and return the first hit of
+      /// each. The rays share one traversal of the tree: a node is visited if
+      /// any ray of the packet reaching it hits its box, and box and triangle
+      /// tests run on all rays of the packet at once as fixed-size Eigen
+      /// arrays (which map onto SSE/AVX lanes). Hits are identical to those
+      /// of intersect_ray(V,Ele,origin.row(r),dir.row(r),max_t,hit) for each
+      /// ray r. Coherent packets (e.g., rays sharing an origin) are fastest.
+      ///
+      /// @tparam PacketSize  number of rays traced together (e.g., 4, 8 or 16)
+      /// @param[in]  V  #V by dim list of vertex positions
+      /// @param[in]  Ele  #Ele by 3 list of triangle indices
+      /// @param[in]  origin  PacketSize by dim list of ray origins
+      /// @param[in]  dir  PacketSize by dim list of ray directions
+      /// @param[in]  max_t  only hits with t less than max_t are considered
+      /// @param[in]  any_hit  whether to stop each ray at the first hit found
+      ///   rather than the nearest one (enough for occlusion queries)
+      /// @param[out]  hits  PacketSize list of first hits (id = -1 indicates
+      ///   no hit)
+      /// @return  number of rays with a hit
+      template <int PacketSize, typename DerivedEle>
+      IGL_INLINE int intersect_ray_packet(
+        const Eigen::MatrixBase<DerivedV> & V,
+        const Eigen::MatrixBase<DerivedEle> & Ele,
+        const Eigen::Matrix<Scalar,PacketSize,DIM> & origin,
+        const Eigen::Matrix<Scalar,PacketSize,DIM> & dir,
+        const Scalar max_t,
+        const bool any_hit,
+        std::array<igl::Hit<typename DerivedV::Scalar>,PacketSize> & hits) const;
+      /// Intersect a stream of rays with the mesh and return the first hit of
+      /// each. Consecutive rays are traced together in packets (see
+      /// intersect_ray_packet) and packets are traced in parallel, so rays
+      /// should be ordered to keep coherent rays next to each other.
+      ///
+      /// @param[in]  V  #V by dim list of vertex positions
+      /// @param[in]  Ele  #Ele by 3 list of triangle indices
+      /// @param[in]  R  #R by 2*dim list of rays, each row [origin dir]
+      /// @param[in]  max_t  only hits with t less than max_t are considered
+      /// @param[out]  I #R list of indices into Ele of first hit primitives
+      ///   (-1 indicates no hit)
+      /// @param[out]  T #R list of t values (nan indicates no hit)
+      /// @param[out]  UV #R by 2 list of barycentric coordinates
+      template <
+        typename DerivedEle,
+        typename DerivedR,
+        typename DerivedI,
+        typename DerivedT,
+        typename DerivedUV>
+      IGL_INLINE void intersect_rays(
+        const Eigen::MatrixBase<DerivedV> & V,
+        const Eigen::MatrixBase<DerivedEle> & Ele,
+        const Eigen::MatrixBase<DerivedR> & R,
+        const Scalar max_t,
+        Eigen::PlainObjectBase<DerivedI> & I,
+        Eigen::PlainObjectBase<DerivedT> & T,
+        Eigen::PlainObjectBase<DerivedUV> & UV) const;
       /// Compute the squared distance from all query points in P to the
       /// _closest_ points on the primitives stored in the AABB hierarchy for
       /// the mesh (V,Ele).
@@ -842,6 +1021,48 @@ private:
         const RowVectorDIMS & inv_dir_pad,
         const Scalar min_t,
         igl::Hit<typename DerivedV::Scalar> & hit) const;
+      // Queries on the frozen layout starting at a given node. Same
+      // traversal as their pointer counterparts.
+      IGL_INLINE Eigen::AlignedBox<Scalar,DIM> frozen_box(const int node) const;
+      template <typename DerivedEle>
+      IGL_INLINE Scalar frozen_squared_distance(
+        const Eigen::MatrixBase<DerivedV> & V,
+        const Eigen::MatrixBase<DerivedEle> & Ele,
+        const RowVectorDIMS & p,
+        const Scalar low_sqr_d,
+        const Scalar up_sqr_d,
+        const int node,
+        int & i,
+        Eigen::PlainObjectBase<RowVectorDIMS> & c) const;
+      template <typename DerivedEle>
+      IGL_INLINE bool frozen_intersect_ray(
+        const Eigen::MatrixBase<DerivedV> & V,
+        const Eigen::MatrixBase<DerivedEle> & Ele,
+        const RowVectorDIMS & origin,
+        const RowVectorDIMS & dir,
+        const RowVectorDIMS & inv_dir,
+        const RowVectorDIMS & inv_dir_pad,
+        const int node,
+        std::vector<igl::Hit<typename DerivedV::Scalar>> & hits) const;
+      template <typename DerivedEle>
+      IGL_INLINE bool frozen_intersect_ray(
+        const Eigen::MatrixBase<DerivedV> & V,
+        const Eigen::MatrixBase<DerivedEle> & Ele,
+        const RowVectorDIMS & origin,
+        const RowVectorDIMS & dir,
+        const RowVectorDIMS & inv_dir,
+        const RowVectorDIMS & inv_dir_pad,
+        const Scalar min_t,
+        const int node,
+        igl::Hit<typename DerivedV::Scalar> & hit) const;
+      template <typename DerivedEle, typename Derivedq>
+      IGL_INLINE bool frozen_find(
+        const Eigen::MatrixBase<DerivedV> & V,
+        const Eigen::MatrixBase<DerivedEle> & Ele,
+        const Eigen::MatrixBase<Derivedq> & q,
+        const bool first,
+        const int node,
+        std::vector<int> & found) const;
 public:
       EIGEN_MAKE_ALIGNED_OPERATOR_NEW
     };
@@ -0,0 +1,28 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 Alec Jacobson <alecjacobson@gmail.com>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#ifndef IGL_AABBBUILDMETHOD_H
+#define IGL_AABBBUILDMETHOD_H
+namespace igl
+{
+  /// How igl::AABB::init splits the primitives of a node between its children
+  enum AABBBuildMethod
+  {
+    /// Split at the median element barycenter along the longest axis of the
+    /// node's box (balanced tree)
+    AABB_BUILD_METHOD_MEDIAN = 0,
+    /// Split minimizing the surface area heuristic, evaluated on binned
+    /// primitive centroids along each axis (best query performance)
+    AABB_BUILD_METHOD_SAH = 1,
+    /// Split sorted Morton codes of primitive centroids at their highest
+    /// differing bit (linear BVH, fastest build)
+    AABB_BUILD_METHOD_LBVH = 2,
+    /// Number of build methods
+    NUM_AABB_BUILD_METHODS = 3
+  };
+}
+#endif
@@ -0,0 +1,363 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 Alec Jacobson <alecjacobson@gmail.com>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#include "BinaryCache.h"
+#include <cassert>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace igl
+{
+  namespace binary_cache
+  {
+    static const char MAGIC[8] = {'I','G','L','C','A','C','H','E'};
+    static const std::uint32_t BYTE_ORDER_MARK = 0x01020304;
+    static_assert(sizeof(BinaryCache::Header) == 64,"Header is 64 bytes");
+    static_assert(sizeof(BinaryCache::Section) == 128,"Section is 128 bytes");
+    inline std::uint64_t align(const std::uint64_t x)
+    {
+      return (x+BinaryCache::ALIGNMENT-1) & ~(BinaryCache::ALIGNMENT-1);
+    }
+    // @return true iff a*b*c overflows
+    inline bool product_overflows(
+      const std::uint64_t a,
+      const std::uint64_t b,
+      const std::uint64_t c)
+    {
+      const std::uint64_t max = std::numeric_limits<std::uint64_t>::max();
+      return a && b && c && (b > max/a || c > max/(a*b));
+    }
+    // Check the index arrays of a sparse or tree section whose layout is
+    // valid and lies within the file, so that views of it can be traversed
+    // without reading out of bounds.
+    //
+    // @return nullptr if valid, otherwise the reason it is not
+    inline const char * check_indices(
+      const BinaryCache::Section & section,
+      const char * data,
+      const std::uint64_t offsets[3])
+    {
+      switch(section.kind)
+      {
+        case BinaryCache::KIND_SPARSE:
+        {
+          const int * outer = reinterpret_cast<const int *>(data+offsets[0]);
+          const int * inner = reinterpret_cast<const int *>(data+offsets[1]);
+          if(outer[0] != 0 || outer[section.cols] != section.nnz)
+          {
+            return "bad sparse outer index";
+          }
+          for(std::int64_t c = 0;c<section.cols;c++)
+          {
+            if(outer[c+1] < outer[c])
+            {
+              return "bad sparse outer index";
+            }
+            for(int k = outer[c];k<outer[c+1];k++)
+            {
+              if(inner[k] < 0 || inner[k] >= section.rows ||
+                (k > outer[c] && inner[k] <= inner[k-1]))
+              {
+                return "bad sparse inner index";
+              }
+            }
+          }
+          return nullptr;
+        }
+        case BinaryCache::KIND_AABB:
+        {
+          // Pre-order layout: the subtree of node k spans [k,end) where an
+          // internal node's left child is k+1 and its right child next(k)
+          const int * next = reinterpret_cast<const int *>(data+offsets[2]);
+          const int n = int(section.rows);
+          const int num_leaves = (n+1)/2;
+          std::vector<std::pair<int,int> > stack;
+          if(n > 0) { stack.emplace_back(0,n); }
+          while(!stack.empty())
+          {
+            const auto [k,end] = stack.back();
+            stack.pop_back();
+            if(next[k] < 0)
+            {
+              if(end != k+1 || -1-next[k] >= num_leaves)
+              {
+                return "bad tree leaf";
+              }
+            }else
+            {
+              if(next[k] <= k+1 || next[k] >= end)
+              {
+                return "bad tree node";
+              }
+              stack.emplace_back(next[k],end);
+              stack.emplace_back(k+1,next[k]);
+            }
+          }
+          return nullptr;
+        }
+        default:
+          return nullptr;
+      }
+    }
+  }
+}
+
+IGL_INLINE bool igl::BinaryCache::layout(
+  const Section & section,
+  std::uint64_t offsets[3],
+  std::uint64_t & bytes)
+{
+  std::uint64_t scalar_size = 0;
+  switch(section.scalar)
+  {
+    case SCALAR_INT32: scalar_size = 4; break;
+    case SCALAR_INT64: scalar_size = 8; break;
+    case SCALAR_FLOAT: scalar_size = 4; break;
+    case SCALAR_DOUBLE: scalar_size = 8; break;
+    default: return false;
+  }
+  if(section.rows < 0 || section.cols < 0 || section.nnz < 0)
+  {
+    return false;
+  }
+  const std::uint64_t rows = section.rows;
+  const std::uint64_t cols = section.cols;
+  const std::uint64_t nnz = section.nnz;
+  // Sizes of arrays
+  std::uint64_t sizes[3] = {0,0,0};
+  switch(section.kind)
+  {
+    case KIND_DENSE:
+      if(binary_cache::product_overflows(scalar_size,rows,cols))
+      {
+        return false;
+      }
+      sizes[0] = scalar_size*rows*cols;
+      break;
+    case KIND_SPARSE:
+      if(rows > 0x7fffffff || cols > 0x7fffffff || nnz > 0x7fffffff)
+      {
+        return false;
+      }
+      sizes[0] = sizeof(int)*(cols+1);
+      sizes[1] = sizeof(int)*nnz;
+      sizes[2] = scalar_size*nnz;
+      break;
+    case KIND_AABB:
+      if(section.scalar != SCALAR_FLOAT || rows > 0x7fffffff ||
+        binary_cache::product_overflows(sizeof(float),rows,cols))
+      {
+        return false;
+      }
+      sizes[0] = sizeof(float)*rows*cols;
+      sizes[1] = sizeof(float)*rows*cols;
+      sizes[2] = sizeof(int)*rows;
+      break;
+    default:
+      return false;
+  }
+  bytes = 0;
+  for(int i = 0;i<3;i++)
+  {
+    if(sizes[i] > std::numeric_limits<std::uint64_t>::max() - ALIGNMENT - bytes)
+    {
+      return false;
+    }
+    offsets[i] = bytes;
+    bytes = binary_cache::align(bytes + sizes[i]);
+  }
+  return true;
+}
+
+IGL_INLINE bool igl::BinaryCache::open(const std::string & path)
+{
+  close();
+  auto file = std::make_shared<igl::MappedFile>();
+  if(!file->open(path))
+  {
+    fprintf(stderr,"IOError: %s could not be opened...\n",path.c_str());
+    return false;
+  }
+  const auto invalid = [&path](const char * reason)
+  {
+    fprintf(stderr,"IOError: %s is not a valid cache (%s)\n",
+      path.c_str(),reason);
+    return false;
+  };
+  Header header;
+  if(file->size() < sizeof(Header))
+  {
+    return invalid("truncated header");
+  }
+  std::memcpy(&header,file->data(),sizeof(Header));
+  if(std::memcmp(header.magic,binary_cache::MAGIC,sizeof(header.magic)) != 0)
+  {
+    return invalid("bad magic");
+  }
+  if(header.byte_order != binary_cache::BYTE_ORDER_MARK)
+  {
+    return invalid("byte order differs");
+  }
+  if(header.version == 0 || header.version > VERSION)
+  {
+    return invalid("unsupported version");
+  }
+  if(header.num_sections >
+    (file->size() - sizeof(Header)) / sizeof(Section))
+  {
+    return invalid("truncated section table");
+  }
+  std::vector<Section> sections(header.num_sections);
+  if(!sections.empty())
+  {
+    std::memcpy(
+      sections.data(),file->data()+sizeof(Header),
+      sizeof(Section)*sections.size());
+  }
+  for(const Section & section : sections)
+  {
+    std::uint64_t offsets[3],bytes;
+    if(std::memchr(section.name,'\0',sizeof(section.name)) == nullptr)
+    {
+      return invalid("unterminated section name");
+    }
+    if(!layout(section,offsets,bytes) || section.bytes != bytes)
+    {
+      return invalid("bad section type or size");
+    }
+    if(section.offset % ALIGNMENT != 0 ||
+      section.offset > file->size() ||
+      bytes > file->size() - section.offset)
+    {
+      return invalid("section out of bounds");
+    }
+    if(const char * reason = binary_cache::check_indices(
+      section,file->data()+section.offset,offsets))
+    {
+      return invalid(reason);
+    }
+  }
+  m_file = std::move(file);
+  m_sections = std::move(sections);
+  return true;
+}
+
+IGL_INLINE void igl::BinaryCache::close()
+{
+  m_file.reset();
+  m_sections.clear();
+}
+
+IGL_INLINE std::vector<std::string> igl::BinaryCache::names() const
+{
+  std::vector<std::string> names;
+  names.reserve(m_sections.size());
+  for(const Section & section : m_sections)
+  {
+    names.emplace_back(section.name);
+  }
+  return names;
+}
+
+IGL_INLINE const igl::BinaryCache::Section * igl::BinaryCache::find(
+  const std::string & name) const
+{
+  for(const Section & section : m_sections)
+  {
+    if(name == section.name)
+    {
+      return &section;
+    }
+  }
+  return nullptr;
+}
+
+IGL_INLINE void igl::BinaryCacheWriter::add(
+  const std::string & name,
+  BinaryCache::Section section,
+  const std::vector<std::pair<const void *,std::uint64_t> > & arrays)
+{
+  assert(name.size() < sizeof(section.name) && "name is too long");
+  std::strncpy(section.name,name.c_str(),sizeof(section.name)-1);
+  std::uint64_t offsets[3];
+  const bool valid = BinaryCache::layout(section,offsets,section.bytes);
+  assert(valid);
+  (void)valid;
+  std::vector<char> payload(section.bytes,0);
+  for(std::size_t i = 0;i<arrays.size();i++)
+  {
+    if(arrays[i].second > 0)
+    {
+      std::memcpy(
+        payload.data()+offsets[i],arrays[i].first,arrays[i].second);
+    }
+  }
+  // Replace existing section of the same name
+  for(std::size_t s = 0;s<m_sections.size();s++)
+  {
+    if(std::strncmp(m_sections[s].name,section.name,sizeof(section.name)) == 0)
+    {
+      m_sections[s] = section;
+      m_payloads[s] = std::move(payload);
+      return;
+    }
+  }
+  m_sections.push_back(section);
+  m_payloads.push_back(std::move(payload));
+}
+
+IGL_INLINE bool igl::BinaryCacheWriter::write(const std::string & path) const
+{
+  std::ofstream out(path,std::ios::binary | std::ios::trunc);
+  if(!out)
+  {
+    fprintf(stderr,"IOError: %s could not be opened...\n",path.c_str());
+    return false;
+  }
+  BinaryCache::Header header = {};
+  std::memcpy(header.magic,binary_cache::MAGIC,sizeof(header.magic));
+  header.version = BinaryCache::VERSION;
+  header.byte_order = binary_cache::BYTE_ORDER_MARK;
+  header.num_sections = m_sections.size();
+  // Lay out sections after the table
+  std::vector<BinaryCache::Section> sections = m_sections;
+  std::uint64_t offset = binary_cache::align(
+    sizeof(BinaryCache::Header) +
+    sizeof(BinaryCache::Section)*sections.size());
+  for(auto & section : sections)
+  {
+    section.offset = offset;
+    offset = binary_cache::align(offset + section.bytes);
+  }
+  out.write(reinterpret_cast<const char *>(&header),sizeof(header));
+  if(!sections.empty())
+  {
+    out.write(
+      reinterpret_cast<const char *>(sections.data()),
+      sizeof(BinaryCache::Section)*sections.size());
+  }
+  std::uint64_t position =
+    sizeof(BinaryCache::Header) +
+    sizeof(BinaryCache::Section)*sections.size();
+  const char zeros[BinaryCache::ALIGNMENT] = {};
+  for(std::size_t s = 0;s<sections.size();s++)
+  {
+    out.write(zeros,sections[s].offset - position);
+    out.write(m_payloads[s].data(),m_payloads[s].size());
+    position = sections[s].offset + sections[s].bytes;
+  }
+  if(!out)
+  {
+    fprintf(stderr,"IOError: writing %s failed\n",path.c_str());
+    return false;
+  }
+  return true;
+}
@@ -0,0 +1,387 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 Alec Jacobson <alecjacobson@gmail.com>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#ifndef IGL_BINARY_CACHE_H
+#define IGL_BINARY_CACHE_H
+#include "igl_inline.h"
+#include "AABB.h"
+#include "MappedFile.h"
+#include <Eigen/Core>
+#include <Eigen/Sparse>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace igl
+{
+  /// Read-only view of a libigl binary cache file: a versioned container of
+  /// named sections (dense matrices, compressed sparse column matrices and
+  /// frozen AABB trees) written by igl::BinaryCacheWriter. The file is memory
+  /// mapped (see igl::MappedFile) and every section is 64-byte aligned, so
+  /// sections are accessed in place through Eigen::Map without parsing or
+  /// copying.
+  ///
+  /// Mapped data remain valid as long as this object is open, except for
+  /// trees, which keep the file mapped for as long as they need it.
+  ///
+  /// #### Example:
+  ///
+  /// \code{cpp}
+  ///     igl::BinaryCacheWriter writer;
+  ///     writer.add("V",V);
+  ///     writer.add("F",F);
+  ///     writer.add("L",L);
+  ///     writer.add("tree",tree);
+  ///     writer.write("mesh.iglcache");
+  ///     ...
+  ///     igl::BinaryCache cache("mesh.iglcache");
+  ///     Eigen::Map<const Eigen::MatrixXd> V(nullptr,0,0);
+  ///     Eigen::Map<const Eigen::MatrixXi> F(nullptr,0,0);
+  ///     Eigen::Map<const Eigen::SparseMatrix<double> > L(0,0,0,nullptr,nullptr,nullptr);
+  ///     igl::AABB<Eigen::MatrixXd,3> tree;
+  ///     if(!cache.map("V",V) || !cache.map("F",F) ||
+  ///        !cache.map("L",L) || !cache.map("tree",tree)) { ... }
+  /// \endcode
+  class BinaryCache
+  {
+    public:
+      /// Format version written by igl::BinaryCacheWriter
+      static constexpr std::uint32_t VERSION = 1;
+      /// Alignment (in bytes) of every section and of the arrays within it
+      static constexpr std::uint64_t ALIGNMENT = 64;
+      /// Kind of data stored in a section
+      enum Kind : std::uint32_t
+      {
+        /// rows by cols matrix
+        KIND_DENSE = 0,
+        /// rows by cols compressed column matrix with nnz nonzeros: cols+1
+        /// int outer offsets, nnz int row indices, nnz values
+        KIND_SPARSE = 1,
+        /// Frozen AABB tree (see igl::AABB::Frozen) with rows nodes in cols
+        /// dimensions: rows by cols float box_min, the same for box_max, rows
+        /// int next
+        KIND_AABB = 2
+      };
+      /// Scalar type of a section's values
+      enum ScalarType : std::uint32_t
+      {
+        SCALAR_INT32 = 1,
+        SCALAR_INT64 = 2,
+        SCALAR_FLOAT = 3,
+        SCALAR_DOUBLE = 4
+      };
+      /// File header
+      struct Header
+      {
+        char magic[8];
+        std::uint32_t version;
+        /// 0x01020304 in the writer's byte order
+        std::uint32_t byte_order;
+        std::uint64_t num_sections;
+        char padding[40];
+      };
+      /// Section table entry (the table immediately follows the header)
+      struct Section
+      {
+        /// Null-terminated name
+        char name[64];
+        std::uint32_t kind;
+        std::uint32_t scalar;
+        /// Whether dense values are stored row by row
+        std::uint32_t row_major;
+        std::uint32_t reserved;
+        std::int64_t rows;
+        std::int64_t cols;
+        std::int64_t nnz;
+        /// Offset of the section from the start of the file, and its size
+        std::uint64_t offset;
+        std::uint64_t bytes;
+        char padding[8];
+      };
+      /// @tparam Scalar  value type
+      /// @return ScalarType of Scalar (0 if not supported)
+      template <typename Scalar>
+      static constexpr std::uint32_t scalar_type()
+      {
+        return
+          std::is_same<Scalar,std::int32_t>::value ? SCALAR_INT32 :
+          std::is_same<Scalar,std::int64_t>::value ? SCALAR_INT64 :
+          std::is_same<Scalar,float>::value ? SCALAR_FLOAT :
+          std::is_same<Scalar,double>::value ? SCALAR_DOUBLE : 0;
+      }
+      /// Compute offsets of the (up to 3) arrays of a section relative to
+      /// its start and its total size
+      ///
+      /// @param[in] section  section with valid kind, scalar, rows, cols, nnz
+      /// @param[out] offsets  offsets of arrays in section
+      /// @param[out] bytes  size of section
+      /// @return false if section's kind, type or sizes are invalid
+      IGL_INLINE static bool layout(
+        const Section & section,
+        std::uint64_t offsets[3],
+        std::uint64_t & bytes);
+
+      BinaryCache() {}
+      /// @param[in] path  path to cache file
+      explicit BinaryCache(const std::string & path) { open(path); }
+      /// Map a cache file and validate its header, section table and the
+      /// index arrays of sparse and tree sections (closing any previously
+      /// open file)
+      ///
+      /// @param[in] path  path to cache file
+      /// @return true on success
+      IGL_INLINE bool open(const std::string & path);
+      /// Unmap the file. Views obtained from map() become invalid (mapped
+      /// trees keep their data alive).
+      IGL_INLINE void close();
+      /// @return true iff a file is open
+      bool is_open() const { return bool(m_file); }
+      /// @return names of all sections in file order
+      IGL_INLINE std::vector<std::string> names() const;
+      /// @param[in] name  section name
+      /// @return pointer to section's table entry or nullptr if there is no
+      ///   such section
+      IGL_INLINE const Section * find(const std::string & name) const;
+      /// View a dense section in place
+      ///
+      /// @tparam Derived  Eigen matrix type with the section's scalar type,
+      ///   storage order (unless a vector) and compatible sizes
+      /// @param[in] name  section name
+      /// @param[out] M  view of section's matrix
+      /// @return false if there is no such section or types do not match
+      template <typename Derived>
+      bool map(const std::string & name, Eigen::Map<const Derived> & M) const;
+      /// View a sparse section in place
+      ///
+      /// @tparam Scalar  section's value type
+      /// @param[in] name  section name
+      /// @param[out] A  view of section's compressed column matrix
+      /// @return false if there is no such section or types do not match
+      template <typename Scalar>
+      bool map(
+        const std::string & name,
+        Eigen::Map<const Eigen::SparseMatrix<Scalar> > & A) const;
+      /// Replace a tree by a frozen view of a tree section (see
+      /// igl::AABB::freeze). The tree shares ownership of the mapped file, so
+      /// it stays valid after this cache is closed.
+      /// Leaves refer to primitives in [0,#leaves), as for any tree built by
+      /// igl::AABB::init.
+      ///
+      /// @param[in] name  section name
+      /// @param[in,out] tree  root to be replaced by the stored tree
+      /// @return false if there is no such section or dimensions do not match
+      template <typename DerivedV, int DIM>
+      bool map(const std::string & name, igl::AABB<DerivedV,DIM> & tree) const;
+    private:
+      /// Pointer to start of section's i-th array
+      const char * array(const Section & section, const int i) const
+      {
+        std::uint64_t offsets[3],bytes;
+        layout(section,offsets,bytes);
+        return m_file->data() + section.offset + offsets[i];
+      }
+      std::shared_ptr<const igl::MappedFile> m_file;
+      std::vector<Section> m_sections;
+  };
+
+  /// Collects named sections and writes them to a file readable by
+  /// igl::BinaryCache. Section data are copied when added.
+  class BinaryCacheWriter
+  {
+    public:
+      /// Add (or replace) a dense matrix section. Values are stored in M's
+      /// storage order.
+      ///
+      /// @param[in] name  section name (at most 63 characters)
+      /// @param[in] M  matrix of int32, int64, float or double
+      template <typename Derived>
+      void add(const std::string & name, const Eigen::DenseBase<Derived> & M);
+      /// Add (or replace) a sparse matrix section
+      ///
+      /// @param[in] name  section name (at most 63 characters)
+      /// @param[in] A  (column-major) sparse matrix
+      template <typename Scalar>
+      void add(const std::string & name, const Eigen::SparseMatrix<Scalar> & A);
+      /// Add (or replace) a tree section. The tree's frozen layout is stored
+      /// (a frozen copy is made if the tree is not frozen).
+      ///
+      /// @param[in] name  section name (at most 63 characters)
+      /// @param[in] tree  root of tree
+      template <typename DerivedV, int DIM>
+      void add(const std::string & name, const igl::AABB<DerivedV,DIM> & tree);
+      /// Write all sections
+      ///
+      /// @param[in] path  path to cache file
+      /// @return true on success
+      IGL_INLINE bool write(const std::string & path) const;
+    private:
+      /// Add a section whose arrays are given as (pointer,bytes) pairs
+      IGL_INLINE void add(
+        const std::string & name,
+        BinaryCache::Section section,
+        const std::vector<std::pair<const void *,std::uint64_t> > & arrays);
+      std::vector<BinaryCache::Section> m_sections;
+      std::vector<std::vector<char> > m_payloads;
+  };
+}
+
+// Implementation
+
+#include <cstring>
+#include <new>
+
+template <typename Derived>
+bool igl::BinaryCache::map(
+  const std::string & name,
+  Eigen::Map<const Derived> & M) const
+{
+  typedef typename Derived::Scalar Scalar;
+  const Section * section = find(name);
+  if(!section ||
+    section->kind != KIND_DENSE ||
+    section->scalar != scalar_type<Scalar>())
+  {
+    return false;
+  }
+  const bool vector = section->rows == 1 || section->cols == 1;
+  if(!vector && bool(section->row_major) != bool(Derived::IsRowMajor))
+  {
+    return false;
+  }
+  if(
+    (Derived::RowsAtCompileTime != Eigen::Dynamic &&
+      Derived::RowsAtCompileTime != section->rows) ||
+    (Derived::ColsAtCompileTime != Eigen::Dynamic &&
+      Derived::ColsAtCompileTime != section->cols))
+  {
+    return false;
+  }
+  new (&M) Eigen::Map<const Derived>(
+    reinterpret_cast<const Scalar *>(array(*section,0)),
+    section->rows,section->cols);
+  return true;
+}
+
+template <typename Scalar>
+bool igl::BinaryCache::map(
+  const std::string & name,
+  Eigen::Map<const Eigen::SparseMatrix<Scalar> > & A) const
+{
+  const Section * section = find(name);
+  if(!section ||
+    section->kind != KIND_SPARSE ||
+    section->scalar != scalar_type<Scalar>())
+  {
+    return false;
+  }
+  new (&A) Eigen::Map<const Eigen::SparseMatrix<Scalar> >(
+    section->rows,section->cols,section->nnz,
+    reinterpret_cast<const int *>(array(*section,0)),
+    reinterpret_cast<const int *>(array(*section,1)),
+    reinterpret_cast<const Scalar *>(array(*section,2)));
+  return true;
+}
+
+template <typename DerivedV, int DIM>
+bool igl::BinaryCache::map(
+  const std::string & name,
+  igl::AABB<DerivedV,DIM> & tree) const
+{
+  typedef typename igl::AABB<DerivedV,DIM>::Frozen Frozen;
+  const Section * section = find(name);
+  if(!section || section->kind != KIND_AABB || section->cols != DIM)
+  {
+    return false;
+  }
+  tree.freeze(std::make_shared<const Frozen>(
+    reinterpret_cast<const float *>(array(*section,0)),
+    reinterpret_cast<const float *>(array(*section,1)),
+    reinterpret_cast<const int *>(array(*section,2)),
+    int(section->rows),
+    m_file));
+  return true;
+}
+
+template <typename Derived>
+void igl::BinaryCacheWriter::add(
+  const std::string & name,
+  const Eigen::DenseBase<Derived> & M)
+{
+  typedef typename Derived::Scalar Scalar;
+  static_assert(
+    BinaryCache::scalar_type<Scalar>() != 0,
+    "Scalar must be int32, int64, float or double");
+  const int Options = Derived::IsRowMajor ? Eigen::RowMajor : Eigen::ColMajor;
+  const Eigen::Matrix<Scalar,Eigen::Dynamic,Eigen::Dynamic,Options> E = M;
+  BinaryCache::Section section = {};
+  section.kind = BinaryCache::KIND_DENSE;
+  section.scalar = BinaryCache::scalar_type<Scalar>();
+  section.row_major = Derived::IsRowMajor;
+  section.rows = E.rows();
+  section.cols = E.cols();
+  add(name,section,{{E.data(),sizeof(Scalar)*E.size()}});
+}
+
+template <typename Scalar>
+void igl::BinaryCacheWriter::add(
+  const std::string & name,
+  const Eigen::SparseMatrix<Scalar> & A)
+{
+  static_assert(
+    BinaryCache::scalar_type<Scalar>() != 0,
+    "Scalar must be int32, int64, float or double");
+  Eigen::SparseMatrix<Scalar> compressed;
+  const Eigen::SparseMatrix<Scalar> * C = &A;
+  if(!A.isCompressed())
+  {
+    compressed = A;
+    compressed.makeCompressed();
+    C = &compressed;
+  }
+  BinaryCache::Section section = {};
+  section.kind = BinaryCache::KIND_SPARSE;
+  section.scalar = BinaryCache::scalar_type<Scalar>();
+  section.rows = C->rows();
+  section.cols = C->cols();
+  section.nnz = C->nonZeros();
+  add(name,section,{
+    {C->outerIndexPtr(),sizeof(int)*(C->cols()+1)},
+    {C->innerIndexPtr(),sizeof(int)*C->nonZeros()},
+    {C->valuePtr(),sizeof(Scalar)*C->nonZeros()}});
+}
+
+template <typename DerivedV, int DIM>
+void igl::BinaryCacheWriter::add(
+  const std::string & name,
+  const igl::AABB<DerivedV,DIM> & tree)
+{
+  if(!tree.is_frozen())
+  {
+    igl::AABB<DerivedV,DIM> frozen = tree;
+    frozen.freeze();
+    return add(name,frozen);
+  }
+  const auto & frozen = *tree.m_frozen;
+  const std::int64_t n = frozen.next.size();
+  BinaryCache::Section section = {};
+  section.kind = BinaryCache::KIND_AABB;
+  section.scalar = BinaryCache::SCALAR_FLOAT;
+  section.rows = n;
+  section.cols = DIM;
+  add(name,section,{
+    {frozen.box_min.data(),sizeof(float)*n*DIM},
+    {frozen.box_max.data(),sizeof(float)*n*DIM},
+    {frozen.next.data(),sizeof(int)*n}});
+}
+
+#ifndef IGL_STATIC_LIBRARY
+#  include "BinaryCache.cpp"
+#endif
+
+#endif
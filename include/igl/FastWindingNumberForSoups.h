@@ -332,6 +332,9 @@ static inline fpreal32 SYSatan2(fpreal32 a, fpreal32 b)
 static inline fpreal32 SYSabs(fpreal32 a) { return ::fabsf(a); }
 static inline fpreal64 SYSabs(fpreal64 a) { return ::fabs(a); }
 
+static inline bool SYSisFinite(fpreal32 a) { return isfinite(a); }
+static inline bool SYSisFinite(fpreal64 a) { return isfinite(a); }
+
 }}
 
 #endif
@@ -6251,6 +6254,12 @@ public:
         const UT_Vector3T<S> *const positions,
         const int order = 2);
 
+    /// Update the bounding boxes and expansions bottom-up for new positions
+    /// of the same points, keeping the tree (so the triangles must stay the
+    /// same). Cheaper than init, but the tree may fit moved triangles worse.
+    /// NOTE: As for init, positions must stay in scope.
+    inline void refit(const UT_Vector3T<S> *const positions);
+
     /// Frees myTree and myData, and clears the rest.
     inline void clear();
 
@@ -6265,6 +6274,12 @@ public:
 private:
     struct BoxData;
 
+    /// Bounding box of each triangle at myPositions
+    inline void computeTriangleBoxes(UT_SmallArray<UT::Box<S,3>> &triangle_boxes) const;
+    /// Fill myData from the triangles at myPositions, in parallel over
+    /// subtrees
+    inline void computeBoxData(const UT::Box<S,3> *const triangle_boxes);
+
     static constexpr uint BVH_N = 4;
     UT_BVH<BVH_N> myTree;
     int myNBoxes;
@@ -6564,6 +6579,52 @@ inline void UT_SolidAngle<T,S>::init(
     timer.start();
 #endif
     UT_SmallArray<UT::Box<S,3>> triangle_boxes;
+    computeTriangleBoxes(triangle_boxes);
+#if SOLID_ANGLE_TIME_PRECOMPUTE
+    double time = timer.stop();
+    UTdebugFormat("{} s to create bounding boxes.", time);
+    timer.start();
+#endif
+    myTree.template init<UT::BVH_Heuristic::BOX_AREA,S,3>(triangle_boxes.array(), ntriangles);
+#if SOLID_ANGLE_TIME_PRECOMPUTE
+    time = timer.stop();
+    UTdebugFormat("{} s to initialize UT_BVH structure.  {} nodes", time, myTree.getNumNodes());
+#endif
+
+    //myTree.debugDump();
+
+    const int nnodes = myTree.getNumNodes();
+
+    myNBoxes = nnodes;
+    BoxData *box_data = new BoxData[nnodes];
+    myData.reset(box_data);
+
+#if SOLID_ANGLE_TIME_PRECOMPUTE
+    timer.start();
+#endif
+    computeBoxData(triangle_boxes.array());
+#if SOLID_ANGLE_TIME_PRECOMPUTE
+    time = timer.stop();
+    UTdebugFormat("{} s to precompute coefficients.", time);
+#endif
+}
+
+template<typename T,typename S>
+inline void UT_SolidAngle<T,S>::refit(const UT_Vector3T<S> *const positions)
+{
+    UT_IGL_ASSERT_MSG_P(!isClear(), "init must be called before refit");
+    myPositions = positions;
+    UT_SmallArray<UT::Box<S,3>> triangle_boxes;
+    computeTriangleBoxes(triangle_boxes);
+    computeBoxData(triangle_boxes.array());
+}
+
+template<typename T,typename S>
+inline void UT_SolidAngle<T,S>::computeTriangleBoxes(UT_SmallArray<UT::Box<S,3>> &triangle_boxes) const
+{
+    const int ntriangles = myNTriangles;
+    const int *const triangle_points = myTrianglePoints;
+    const UT_Vector3T<S> *const positions = myPositions;
     triangle_boxes.setSizeNoInit(ntriangles);
     if (ntriangles < 16*1024)
     {
@@ -6588,26 +6649,12 @@ inline void UT_SolidAngle<T,S>::init(
           box.enlargeBounds(positions[cur_triangle_points[2]]);
         });
     }
-#if SOLID_ANGLE_TIME_PRECOMPUTE
-    double time = timer.stop();
-    UTdebugFormat("{} s to create bounding boxes.", time);
-    timer.start();
-#endif
-    myTree.template init<UT::BVH_Heuristic::BOX_AREA,S,3>(triangle_boxes.array(), ntriangles);
-#if SOLID_ANGLE_TIME_PRECOMPUTE
-    time = timer.stop();
-    UTdebugFormat("{} s to initialize UT_BVH structure.  {} nodes", time, myTree.getNumNodes());
-#endif
-
-    //myTree.debugDump();
-
-    const int nnodes = myTree.getNumNodes();
-
-    myNBoxes = nnodes;
-    BoxData *box_data = new BoxData[nnodes];
-    myData.reset(box_data);
+}
 
-    // Some data are only needed during initialization.
+template<typename T,typename S>
+inline void UT_SolidAngle<T,S>::computeBoxData(const UT::Box<S,3> *const triangle_boxes)
+{
+    // Some data are only needed during initialization (or refitting).
     struct LocalData
     {
         // Bounding box
@@ -7118,18 +7165,11 @@ inline void UT_SolidAngle<T,S>::init(
         }
     };
 
-#if SOLID_ANGLE_TIME_PRECOMPUTE
-    timer.start();
-#endif
-    const PrecomputeFunctors functors(box_data, triangle_boxes.array(), triangle_points, positions, order);
+    const PrecomputeFunctors functors(myData.get(), triangle_boxes, myTrianglePoints, myPositions, myOrder);
     // NOTE: post-functor relies on non-null data_for_parent, so we have to pass one.
     LocalData local_data;
     myTree.template traverseParallel<LocalData>(4096, functors, &local_data);
     //myTree.template traverse<LocalData>(functors);
-#if SOLID_ANGLE_TIME_PRECOMPUTE
-    time = timer.stop();
-    UTdebugFormat("{} s to precompute coefficients.", time);
-#endif
 }
 
 template<typename T,typename S>
@@ -7176,86 +7216,163 @@ inline T UT_SolidAngle<T, S>::computeSolidAngle(const UT_Vector3T<T> &query_poin
         uint pre(const int nodei, T *data_for_parent) const
         {
             const BoxData &data = myBoxData[nodei];
-            const typename BoxData::Type maxP2 = data.myMaxPDist2;
-            UT_FixedVector<typename BoxData::Type,3> q;
-            q[0] = typename BoxData::Type(myQueryPoint[0]);
-            q[1] = typename BoxData::Type(myQueryPoint[1]);
-            q[2] = typename BoxData::Type(myQueryPoint[2]);
-            q -= data.myAverageP;
-            const typename BoxData::Type qlength2 = q[0]*q[0] + q[1]*q[1] + q[2]*q[2];
-
-            // If the query point is within a factor of accuracy_scale of the box radius,
-            // it's assumed to be not a good enough approximation, so it needs to descend.
-            // TODO: Is there a way to estimate the error?
-            static_assert((std::is_same<typename BoxData::Type,v4uf>::value), "FIXME: Implement support for other tuple types!");
-            v4uu descend_mask = (qlength2 <= maxP2*myAccuracyScale2);
-            uint descend_bitmask = _mm_movemask_ps(V4SF(descend_mask.vector));
-            constexpr uint allchildbits = ((uint(1)<<BVH_N)-1);
-            if (descend_bitmask == allchildbits)
+            if constexpr (std::is_same<typename BoxData::Type,v4uf>::value)
             {
-                *data_for_parent = 0;
-                return allchildbits;
-            }
+                const typename BoxData::Type maxP2 = data.myMaxPDist2;
+                UT_FixedVector<typename BoxData::Type,3> q;
+                q[0] = typename BoxData::Type(myQueryPoint[0]);
+                q[1] = typename BoxData::Type(myQueryPoint[1]);
+                q[2] = typename BoxData::Type(myQueryPoint[2]);
+                q -= data.myAverageP;
+                const typename BoxData::Type qlength2 = q[0]*q[0] + q[1]*q[1] + q[2]*q[2];
+
+                // If the query point is within a factor of accuracy_scale of the box radius,
+                // it's assumed to be not a good enough approximation, so it needs to descend.
+                // TODO: Is there a way to estimate the error?
+                v4uu descend_mask = (qlength2 <= maxP2*myAccuracyScale2);
+                uint descend_bitmask = _mm_movemask_ps(V4SF(descend_mask.vector));
+                constexpr uint allchildbits = ((uint(1)<<BVH_N)-1);
+                if (descend_bitmask == allchildbits)
+                {
+                    *data_for_parent = 0;
+                    return allchildbits;
+                }
 
-            // qlength2 must be non-zero, since it's strictly greater than something.
-            // We still need to be careful for NaNs, though, because the 4th power might cause problems.
-            const typename BoxData::Type qlength_m2 = typename BoxData::Type(1.0)/qlength2;
-            const typename BoxData::Type qlength_m1 = sqrt(qlength_m2);
+                // qlength2 must be non-zero, since it's strictly greater than something.
+                // We still need to be careful for NaNs, though, because the 4th power might cause problems.
+                const typename BoxData::Type qlength_m2 = typename BoxData::Type(1.0)/qlength2;
+                const typename BoxData::Type qlength_m1 = sqrt(qlength_m2);
 
-            // Normalize q to reduce issues with overflow/underflow, since we'd need the 7th power
-            // if we didn't normalize, and (1e-6)^-7 = 1e42, which overflows single-precision.
-            q *= qlength_m1;
+                // Normalize q to reduce issues with overflow/underflow, since we'd need the 7th power
+                // if we didn't normalize, and (1e-6)^-7 = 1e42, which overflows single-precision.
+                q *= qlength_m1;
 
-            typename BoxData::Type Omega_approx = -qlength_m2*dot(q,data.myN);
-#if TAYLOR_SERIES_ORDER >= 1
-            const int order = myOrder;
-            if (order >= 1)
-            {
-                const UT_FixedVector<typename BoxData::Type,3> q2 = q*q;
-                const typename BoxData::Type qlength_m3 = qlength_m2*qlength_m1;
-                const typename BoxData::Type Omega_1 =
-                    qlength_m3*(data.myNijDiag[0] + data.myNijDiag[1] + data.myNijDiag[2]
-                        -typename BoxData::Type(3.0)*(dot(q2,data.myNijDiag) +
-                            q[0]*q[1]*data.myNxy_Nyx +
-                            q[0]*q[2]*data.myNzx_Nxz +
-                            q[1]*q[2]*data.myNyz_Nzy));
-                Omega_approx += Omega_1;
-#if TAYLOR_SERIES_ORDER >= 2
-                if (order >= 2)
+                typename BoxData::Type Omega_approx = -qlength_m2*dot(q,data.myN);
+    #if TAYLOR_SERIES_ORDER >= 1
+                const int order = myOrder;
+                if (order >= 1)
                 {
-                    const UT_FixedVector<typename BoxData::Type,3> q3 = q2*q;
-                    const typename BoxData::Type qlength_m4 = qlength_m2*qlength_m2;
-                    typename BoxData::Type temp0[3] = {
-                        data.my2Nyyx_Nxyy+data.my2Nzzx_Nxzz,
-                        data.my2Nzzy_Nyzz+data.my2Nxxy_Nyxx,
-                        data.my2Nxxz_Nzxx+data.my2Nyyz_Nzyy
-                    };
-                    typename BoxData::Type temp1[3] = {
-                        q[1]*data.my2Nxxy_Nyxx + q[2]*data.my2Nxxz_Nzxx,
-                        q[2]*data.my2Nyyz_Nzyy + q[0]*data.my2Nyyx_Nxyy,
-                        q[0]*data.my2Nzzx_Nxzz + q[1]*data.my2Nzzy_Nyzz
-                    };
-                    const typename BoxData::Type Omega_2 =
-                        qlength_m4*(typename BoxData::Type(1.5)*dot(q, typename BoxData::Type(3)*data.myNijkDiag + UT_FixedVector<typename BoxData::Type,3>(temp0))
-                            -typename BoxData::Type(7.5)*(dot(q3,data.myNijkDiag) + q[0]*q[1]*q[2]*data.mySumPermuteNxyz + dot(q2, UT_FixedVector<typename BoxData::Type,3>(temp1))));
-                    Omega_approx += Omega_2;
+                    const UT_FixedVector<typename BoxData::Type,3> q2 = q*q;
+                    const typename BoxData::Type qlength_m3 = qlength_m2*qlength_m1;
+                    const typename BoxData::Type Omega_1 =
+                        qlength_m3*(data.myNijDiag[0] + data.myNijDiag[1] + data.myNijDiag[2]
+                            -typename BoxData::Type(3.0)*(dot(q2,data.myNijDiag) +
+                                q[0]*q[1]*data.myNxy_Nyx +
+                                q[0]*q[2]*data.myNzx_Nxz +
+                                q[1]*q[2]*data.myNyz_Nzy));
+                    Omega_approx += Omega_1;
+    #if TAYLOR_SERIES_ORDER >= 2
+                    if (order >= 2)
+                    {
+                        const UT_FixedVector<typename BoxData::Type,3> q3 = q2*q;
+                        const typename BoxData::Type qlength_m4 = qlength_m2*qlength_m2;
+                        typename BoxData::Type temp0[3] = {
+                            data.my2Nyyx_Nxyy+data.my2Nzzx_Nxzz,
+                            data.my2Nzzy_Nyzz+data.my2Nxxy_Nyxx,
+                            data.my2Nxxz_Nzxx+data.my2Nyyz_Nzyy
+                        };
+                        typename BoxData::Type temp1[3] = {
+                            q[1]*data.my2Nxxy_Nyxx + q[2]*data.my2Nxxz_Nzxx,
+                            q[2]*data.my2Nyyz_Nzyy + q[0]*data.my2Nyyx_Nxyy,
+                            q[0]*data.my2Nzzx_Nxzz + q[1]*data.my2Nzzy_Nyzz
+                        };
+                        const typename BoxData::Type Omega_2 =
+                            qlength_m4*(typename BoxData::Type(1.5)*dot(q, typename BoxData::Type(3)*data.myNijkDiag + UT_FixedVector<typename BoxData::Type,3>(temp0))
+                                -typename BoxData::Type(7.5)*(dot(q3,data.myNijkDiag) + q[0]*q[1]*q[2]*data.mySumPermuteNxyz + dot(q2, UT_FixedVector<typename BoxData::Type,3>(temp1))));
+                        Omega_approx += Omega_2;
+                    }
+    #endif
                 }
-#endif
-            }
-#endif
+    #endif
 
-            // If q is so small that we got NaNs and we just have a
-            // small bounding box, it needs to descend.
-            const v4uu mask = Omega_approx.isFinite() & ~descend_mask;
-            Omega_approx = Omega_approx & mask;
-            descend_bitmask = (~_mm_movemask_ps(V4SF(mask.vector))) & allchildbits;
+                // If q is so small that we got NaNs and we just have a
+                // small bounding box, it needs to descend.
+                const v4uu mask = Omega_approx.isFinite() & ~descend_mask;
+                Omega_approx = Omega_approx & mask;
+                descend_bitmask = (~_mm_movemask_ps(V4SF(mask.vector))) & allchildbits;
 
-            T sum = Omega_approx[0];
-            for (int i = 1; i < BVH_N; ++i)
-                sum += Omega_approx[i];
-            *data_for_parent = sum;
+                T sum = Omega_approx[0];
+                for (int i = 1; i < BVH_N; ++i)
+                    sum += Omega_approx[i];
+                *data_for_parent = sum;
 
-            return descend_bitmask;
+                return descend_bitmask;
+            }
+            else
+            {
+                // One child at a time for tuple types without SIMD
+                // comparisons (e.g., when T is double)
+                constexpr uint allchildbits = ((uint(1)<<BVH_N)-1);
+                uint descend_bitmask = 0;
+                T sum = 0;
+                const auto lane = [](const UT_FixedVector<typename BoxData::Type,3> &v, const uint i)
+                {
+                    UT_Vector3T<T> vi;
+                    for (int j = 0; j < 3; ++j)
+                        vi[j] = v[j][i];
+                    return vi;
+                };
+                for (uint i = 0; i < BVH_N; ++i)
+                {
+                    UT_Vector3T<T> q = myQueryPoint - lane(data.myAverageP,i);
+                    const T qlength2 = q.length2();
+                    if (qlength2 <= data.myMaxPDist2[i]*myAccuracyScale2)
+                    {
+                        descend_bitmask |= (uint(1)<<i);
+                        continue;
+                    }
+                    const T qlength_m2 = T(1.0)/qlength2;
+                    const T qlength_m1 = SYSsqrt(qlength_m2);
+                    q *= qlength_m1;
+                    T Omega_approx = -qlength_m2*dot(q,lane(data.myN,i));
+#if TAYLOR_SERIES_ORDER >= 1
+                    const int order = myOrder;
+                    if (order >= 1)
+                    {
+                        const UT_Vector3T<T> q2 = q*q;
+                        const T qlength_m3 = qlength_m2*qlength_m1;
+                        const UT_Vector3T<T> NijDiag = lane(data.myNijDiag,i);
+                        const T Omega_1 =
+                            qlength_m3*(NijDiag[0] + NijDiag[1] + NijDiag[2]
+                                -T(3.0)*(dot(q2,NijDiag) +
+                                    q[0]*q[1]*data.myNxy_Nyx[i] +
+                                    q[0]*q[2]*data.myNzx_Nxz[i] +
+                                    q[1]*q[2]*data.myNyz_Nzy[i]));
+                        Omega_approx += Omega_1;
+#if TAYLOR_SERIES_ORDER >= 2
+                        if (order >= 2)
+                        {
+                            const UT_Vector3T<T> q3 = q2*q;
+                            const T qlength_m4 = qlength_m2*qlength_m2;
+                            const UT_Vector3T<T> NijkDiag = lane(data.myNijkDiag,i);
+                            UT_Vector3T<T> temp0;
+                            temp0[0] = data.my2Nyyx_Nxyy[i]+data.my2Nzzx_Nxzz[i];
+                            temp0[1] = data.my2Nzzy_Nyzz[i]+data.my2Nxxy_Nyxx[i];
+                            temp0[2] = data.my2Nxxz_Nzxx[i]+data.my2Nyyz_Nzyy[i];
+                            UT_Vector3T<T> temp1;
+                            temp1[0] = q[1]*data.my2Nxxy_Nyxx[i] + q[2]*data.my2Nxxz_Nzxx[i];
+                            temp1[1] = q[2]*data.my2Nyyz_Nzyy[i] + q[0]*data.my2Nyyx_Nxyy[i];
+                            temp1[2] = q[0]*data.my2Nzzx_Nxzz[i] + q[1]*data.my2Nzzy_Nyzz[i];
+                            const T Omega_2 =
+                                qlength_m4*(T(1.5)*dot(q, T(3)*NijkDiag + temp0)
+                                    -T(7.5)*(dot(q3,NijkDiag) + q[0]*q[1]*q[2]*data.mySumPermuteNxyz[i] + dot(q2, temp1)));
+                            Omega_approx += Omega_2;
+                        }
+#endif
+                    }
+#endif
+                    // If q is so small that we got NaNs and we just have a
+                    // small bounding box, it needs to descend.
+                    if (!SYSisFinite(Omega_approx))
+                    {
+                        descend_bitmask |= (uint(1)<<i);
+                        continue;
+                    }
+                    sum += Omega_approx;
+                }
+                *data_for_parent = (descend_bitmask == allchildbits) ? T(0) : sum;
+                return descend_bitmask;
+            }
         }
         void item(const int itemi, const int /*parent_nodei*/, T &data_for_parent) const
         {
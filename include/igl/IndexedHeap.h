@@ -0,0 +1,167 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 Alec Jacobson <alecjacobson@gmail.com>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#ifndef IGL_INDEXED_HEAP_H
+#define IGL_INDEXED_HEAP_H
+
+#include <cassert>
+#include <utility>
+#include <vector>
+
+namespace igl
+{
+  /// Min-priority queue of (key,id) pairs with ids in [0,n), at most one entry
+  /// per id. Unlike std::priority_queue it supports changing the key of (or
+  /// removing) any entry by id in O(log n), and unlike a std::set it stores
+  /// entries contiguously (a 4-ary heap) and never allocates after resize().
+  ///
+  /// Entries are ordered by key and then by id, so the pop order is
+  /// deterministic and identical to that of a
+  /// std::set<std::pair<Scalar,int>>.
+  ///
+  /// @tparam Scalar  key type
+  ///
+  /// #### Example:
+  ///
+  /// \code{cpp}
+  ///     igl::IndexedHeap<double> Q(n);
+  ///     Q.update(s,0);
+  ///     while(!Q.empty())
+  ///     {
+  ///       const auto [d,u] = Q.pop();
+  ///       ...
+  ///       Q.update(v,d+w); // insert or change key
+  ///     }
+  /// \endcode
+  template <typename Scalar>
+  class IndexedHeap
+  {
+    public:
+      /// @param[in] n  ids must be in [0,n)
+      IndexedHeap(const int n = 0) { resize(n); }
+      /// Remove all entries and allow ids in [0,n)
+      void resize(const int n)
+      {
+        m_heap.clear();
+        m_heap.reserve(n);
+        m_position.assign(n,-1);
+      }
+      /// @return n (ids must be in [0,n))
+      int capacity() const { return int(m_position.size()); }
+      /// Remove all entries in O(size())
+      void clear()
+      {
+        for(const auto & entry : m_heap) { m_position[entry.second] = -1; }
+        m_heap.clear();
+      }
+      bool empty() const { return m_heap.empty(); }
+      int size() const { return int(m_heap.size()); }
+      /// @return true iff id has an entry
+      bool contains(const int id) const { return m_position[id] >= 0; }
+      /// @return key of id's entry (id must be contained)
+      Scalar key(const int id) const
+      {
+        assert(contains(id));
+        return m_heap[m_position[id]].first;
+      }
+      /// @return (key,id) of the minimum entry
+      const std::pair<Scalar,int> & top() const { return m_heap.front(); }
+      /// Remove and return the minimum entry
+      std::pair<Scalar,int> pop()
+      {
+        assert(!empty());
+        const std::pair<Scalar,int> min = m_heap.front();
+        remove_at(0);
+        return min;
+      }
+      /// Insert id with key or, if id already has an entry, change its key
+      void update(const int id, const Scalar key)
+      {
+        assert(id >= 0 && id < capacity());
+        int i = m_position[id];
+        if(i < 0)
+        {
+          i = int(m_heap.size());
+          m_heap.emplace_back(key,id);
+          m_position[id] = i;
+          sift_up(i);
+        }else
+        {
+          const Scalar old = m_heap[i].first;
+          m_heap[i].first = key;
+          if(key < old) { sift_up(i); }else { sift_down(i); }
+        }
+      }
+      /// Remove id's entry if it has one
+      void remove(const int id)
+      {
+        const int i = m_position[id];
+        if(i >= 0) { remove_at(i); }
+      }
+    private:
+      static constexpr int D = 4;
+      static bool less(
+        const std::pair<Scalar,int> & a,
+        const std::pair<Scalar,int> & b)
+      {
+        return a.first < b.first || (!(b.first < a.first) && a.second < b.second);
+      }
+      void place(const int i, const std::pair<Scalar,int> & entry)
+      {
+        m_heap[i] = entry;
+        m_position[entry.second] = i;
+      }
+      void remove_at(const int i)
+      {
+        m_position[m_heap[i].second] = -1;
+        const std::pair<Scalar,int> last = m_heap.back();
+        m_heap.pop_back();
+        if(i < int(m_heap.size()))
+        {
+          place(i,last);
+          if(i > 0 && less(last,m_heap[(i-1)/D])) { sift_up(i); }
+          else { sift_down(i); }
+        }
+      }
+      void sift_up(int i)
+      {
+        const std::pair<Scalar,int> entry = m_heap[i];
+        while(i > 0)
+        {
+          const int parent = (i-1)/D;
+          if(!less(entry,m_heap[parent])) { break; }
+          place(i,m_heap[parent]);
+          i = parent;
+        }
+        place(i,entry);
+      }
+      void sift_down(int i)
+      {
+        const std::pair<Scalar,int> entry = m_heap[i];
+        const int n = int(m_heap.size());
+        while(true)
+        {
+          const int first = D*i+1;
+          if(first >= n) { break; }
+          const int last = first+D < n ? first+D : n;
+          int min_child = first;
+          for(int c = first+1;c<last;c++)
+          {
+            if(less(m_heap[c],m_heap[min_child])) { min_child = c; }
+          }
+          if(!less(m_heap[min_child],entry)) { break; }
+          place(i,m_heap[min_child]);
+          i = min_child;
+        }
+        place(i,entry);
+      }
+      std::vector<std::pair<Scalar,int> > m_heap;
+      std::vector<int> m_position;
+  };
+}
+
+#endif
@@ -0,0 +1,115 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 Alec Jacobson <alecjacobson@gmail.com>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#include "MappedFile.h"
+
+#include <fstream>
+#include <iterator>
+
+#if defined(_WIN32)
+#  ifndef NOMINMAX
+#    define NOMINMAX
+#  endif
+#  include <windows.h>
+#elif defined(__unix__) || defined(__APPLE__)
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#  define IGL_MAPPED_FILE_POSIX
+#endif
+
+IGL_INLINE bool igl::MappedFile::open(const std::string & path)
+{
+  close();
+#if defined(_WIN32)
+  HANDLE file = CreateFileA(
+    path.c_str(),GENERIC_READ,FILE_SHARE_READ,NULL,OPEN_EXISTING,
+    FILE_ATTRIBUTE_NORMAL|FILE_FLAG_SEQUENTIAL_SCAN,NULL);
+  if(file != INVALID_HANDLE_VALUE)
+  {
+    LARGE_INTEGER size;
+    if(GetFileSizeEx(file,&size))
+    {
+      m_size = static_cast<std::size_t>(size.QuadPart);
+      m_open = true;
+      if(m_size > 0)
+      {
+        HANDLE mapping = CreateFileMappingA(file,NULL,PAGE_READONLY,0,0,NULL);
+        if(mapping != NULL)
+        {
+          m_mapping = MapViewOfFile(mapping,FILE_MAP_READ,0,0,0);
+          // The view keeps the mapping alive
+          CloseHandle(mapping);
+        }
+      }
+    }
+    CloseHandle(file);
+    if(m_open && m_size == 0) { return true; }
+    if(m_mapping)
+    {
+      m_data = static_cast<const char *>(m_mapping);
+      return true;
+    }
+    m_open = false;
+  }
+#elif defined(IGL_MAPPED_FILE_POSIX)
+  const int fd = ::open(path.c_str(),O_RDONLY);
+  if(fd < 0) { return false; }
+  struct stat st;
+  if(fstat(fd,&st) == 0 && S_ISREG(st.st_mode))
+  {
+    m_size = static_cast<std::size_t>(st.st_size);
+    m_open = true;
+    if(m_size > 0)
+    {
+      void * map = mmap(nullptr,m_size,PROT_READ,MAP_PRIVATE,fd,0);
+      if(map != MAP_FAILED)
+      {
+        m_mapping = map;
+        m_data = static_cast<const char *>(map);
+#  ifdef POSIX_MADV_SEQUENTIAL
+        posix_madvise(map,m_size,POSIX_MADV_SEQUENTIAL);
+#  endif
+      }
+    }
+  }
+  ::close(fd);
+  if(m_open && (m_size == 0 || m_mapping)) { return true; }
+  m_open = false;
+  m_size = 0;
+#endif
+  // Fallback: read whole file into memory (also handles non-regular files)
+  std::ifstream in(path,std::ios::binary);
+  if(!in) { return false; }
+  m_buffer.assign(
+    std::istreambuf_iterator<char>(in),std::istreambuf_iterator<char>());
+  m_data = m_buffer.empty() ? nullptr : m_buffer.data();
+  m_size = m_buffer.size();
+  m_open = true;
+  return true;
+}
+
+IGL_INLINE void igl::MappedFile::close()
+{
+  if(m_mapping)
+  {
+#if defined(_WIN32)
+    UnmapViewOfFile(m_mapping);
+#elif defined(IGL_MAPPED_FILE_POSIX)
+    munmap(m_mapping,m_size);
+#endif
+  }
+  m_mapping = nullptr;
+  m_data = nullptr;
+  m_size = 0;
+  m_buffer.clear();
+  m_buffer.shrink_to_fit();
+  m_open = false;
+}
+
+#undef IGL_MAPPED_FILE_POSIX
@@ -0,0 +1,67 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 Alec Jacobson <alecjacobson@gmail.com>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#ifndef IGL_MAPPED_FILE_H
+#define IGL_MAPPED_FILE_H
+#include "igl_inline.h"
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace igl
+{
+  /// Read-only view of a whole file's contents. The file is memory mapped
+  /// when the platform supports it (POSIX mmap or Windows file mappings);
+  /// otherwise its contents are read into an internal buffer. Either way
+  /// data() points to size() contiguous bytes that remain valid until the
+  /// object is closed or destroyed. The data is *not* null terminated.
+  ///
+  /// \code{cpp}
+  ///     igl::MappedFile file(path);
+  ///     if(!file.is_open()) { return false; }
+  ///     parse(file.data(),file.data()+file.size());
+  /// \endcode
+  class MappedFile
+  {
+    public:
+      MappedFile() {}
+      /// @param[in] path  path to file
+      explicit MappedFile(const std::string & path) { open(path); }
+      ~MappedFile() { close(); }
+      MappedFile(const MappedFile &) = delete;
+      MappedFile & operator=(const MappedFile &) = delete;
+      /// Open and map a file (closing any previously open file)
+      ///
+      /// @param[in] path  path to file
+      /// @return true on success
+      IGL_INLINE bool open(const std::string & path);
+      /// Unmap and close the file
+      IGL_INLINE void close();
+      /// @return true iff a file is open
+      bool is_open() const { return m_open; }
+      /// @return true iff contents are memory mapped (rather than copied)
+      bool is_mapped() const { return m_mapping != nullptr; }
+      /// @return pointer to first byte of file (nullptr if empty)
+      const char * data() const { return m_data; }
+      /// @return number of bytes in file
+      std::size_t size() const { return m_size; }
+    private:
+      bool m_open = false;
+      const char * m_data = nullptr;
+      std::size_t m_size = 0;
+      /// Start of mapped region (nullptr if not mapped)
+      void * m_mapping = nullptr;
+      /// Fallback storage when mapping is unavailable
+      std::vector<char> m_buffer;
+  };
+}
+
+#ifndef IGL_STATIC_LIBRARY
+#include "MappedFile.cpp"
+#endif
+
+#endif
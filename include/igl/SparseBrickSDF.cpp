@@ -0,0 +1,308 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 Alec Jacobson <alecjacobson@gmail.com>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#include "SparseBrickSDF.h"
+#include "AABB.h"
+#include "fast_winding_number.h"
+#include "lipschitz_octree.h"
+#include "parallel_for.h"
+#include "signed_distance.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <memory>
+
+template <typename Scalar>
+IGL_INLINE void igl::SparseBrickSDF<Scalar>::init(
+  const RowVector3S & _origin,
+  const Scalar _h,
+  const Scalar _band,
+  const BatchedFunction & _sdf)
+{
+  assert(_h > 0 && "h should be positive");
+  assert(_band >= 0 && "band should be non-negative");
+  origin = _origin;
+  h = _h;
+  band = _band;
+  sdf = _sdf;
+  bricks.clear();
+  samples.clear();
+}
+
+template <typename Scalar>
+template <typename DerivedV, typename DerivedF>
+IGL_INLINE void igl::SparseBrickSDF<Scalar>::init(
+  const Eigen::MatrixBase<DerivedV> & V,
+  const Eigen::MatrixBase<DerivedF> & F,
+  const Scalar h,
+  const Scalar band)
+{
+  assert(V.cols() == 3 && "V should be 3D");
+  assert(F.cols() == 3 && "F should contain triangles");
+  typedef Eigen::Matrix<Scalar,Eigen::Dynamic,Eigen::Dynamic> MatrixXS;
+  // Shared by all copies of the function
+  struct Mesh
+  {
+    MatrixXS V;
+    Eigen::MatrixXi F;
+    igl::AABB<MatrixXS,3> tree;
+    igl::FastWindingNumberBVH fwn_bvh;
+  };
+  const auto mesh = std::make_shared<Mesh>();
+  mesh->V = V.template cast<Scalar>();
+  mesh->F = F.template cast<int>();
+  mesh->tree.init(mesh->V,mesh->F);
+  igl::fast_winding_number(
+    mesh->V.template cast<float>().eval(),mesh->F,2,mesh->fwn_bvh);
+  init(
+    RowVector3S(mesh->V.colwise().minCoeff()),
+    h,
+    band,
+    [mesh](const MatrixX3SR & P)->VectorXS
+    {
+      VectorXS S;
+      igl::signed_distance_fast_winding_number(
+        MatrixXS(P),mesh->V,mesh->F,mesh->tree,mesh->fwn_bvh,S);
+      return S;
+    });
+}
+
+template <typename Scalar>
+IGL_INLINE void igl::SparseBrickSDF<Scalar>::fill(
+  const RowVector3S & min_corner,
+  const RowVector3S & max_corner)
+{
+  const Scalar brick_h = h*brick_size;
+  Eigen::RowVector3i lo,hi;
+  for(int d = 0;d<3;d++)
+  {
+    lo(d) = int(std::floor((min_corner(d)-origin(d))/brick_h));
+    hi(d) = int(std::floor((max_corner(d)-origin(d))/brick_h));
+  }
+  // Smallest octree whose leaves are bricks and which covers [lo,hi]
+  const int n = (hi-lo).maxCoeff()+1;
+  int depth = 0;
+  while((1<<depth) < n) { depth++; }
+  const RowVector3S root_origin = origin + brick_h*lo.template cast<Scalar>();
+  // Zero within the band and still 1-Lipschitz
+  const BatchedFunction udf = [this](const MatrixX3SR & X)->VectorXS
+  {
+    return (sdf(X).array().abs()-band).max(Scalar(0)).matrix();
+  };
+  Eigen::Matrix<int,Eigen::Dynamic,3,Eigen::RowMajor> ijk;
+  igl::lipschitz_octree<true>(root_origin,brick_h*(1<<depth),depth,udf,ijk);
+  std::vector<std::int64_t> keys;
+  keys.reserve(ijk.rows());
+  for(int c = 0;c<ijk.rows();c++)
+  {
+    // lipschitz_octree subscripts are (y,x,z)
+    const Eigen::RowVector3i b = lo + Eigen::RowVector3i(ijk(c,1),ijk(c,0),ijk(c,2));
+    if((b.array() <= hi.array()).all() && bricks.find(key(b)) == bricks.end())
+    {
+      keys.push_back(key(b));
+    }
+  }
+  fill_bricks(keys);
+}
+
+template <typename Scalar>
+template <typename DerivedP, typename DerivedS, typename DerivedG>
+IGL_INLINE void igl::SparseBrickSDF<Scalar>::query(
+  const Eigen::MatrixBase<DerivedP> & P,
+  Eigen::PlainObjectBase<DerivedS> & S,
+  Eigen::PlainObjectBase<DerivedG> & G)
+{
+  assert(P.cols() == 3 && "P should be 3D");
+  const int n = P.rows();
+  // Grid coordinates and brick of each query
+  MatrixX3SR X(n,3);
+  Eigen::Matrix<int,Eigen::Dynamic,3,Eigen::RowMajor> B(n,3);
+  std::vector<std::int64_t> K(n);
+  igl::parallel_for(n,[&](const int p)
+  {
+    for(int d = 0;d<3;d++)
+    {
+      X(p,d) = (Scalar(P(p,d))-origin(d))/h;
+      B(p,d) = int(std::floor(X(p,d)/brick_size));
+    }
+    K[p] = key(B.row(p));
+  },10000);
+
+  // Lazily fill missing bricks
+  {
+    std::vector<std::int64_t> missing;
+    for(int p = 0;p<n;p++)
+    {
+      if(bricks.find(K[p]) == bricks.end())
+      {
+        missing.push_back(K[p]);
+      }
+    }
+    std::sort(missing.begin(),missing.end());
+    missing.erase(std::unique(missing.begin(),missing.end()),missing.end());
+    fill_bricks(missing);
+  }
+
+  S.resize(n,1);
+  G.resize(n,3);
+  constexpr int m = brick_samples;
+  igl::parallel_for(n,[&](const int p)
+  {
+    const int b = bricks.find(K[p])->second;
+    if(b < 0)
+    {
+      S(p) = b == far_inside ? -band : band;
+      G.row(p).setZero();
+      return;
+    }
+    const Scalar * s = samples.data() + std::size_t(b)*m*m*m;
+    // Cell within brick and position within cell
+    int c[3];
+    Scalar t[3];
+    for(int d = 0;d<3;d++)
+    {
+      const Scalar l = X(p,d) - Scalar(brick_size*B(p,d));
+      c[d] = std::min(std::max(int(std::floor(l)),0),brick_size-1);
+      t[d] = std::min(std::max(l-Scalar(c[d]),Scalar(0)),Scalar(1));
+    }
+    Scalar value = 0;
+    Scalar grad[3] = {0,0,0};
+    for(int corner = 0;corner<8;corner++)
+    {
+      const int o[3] = {corner&1,(corner>>1)&1,(corner>>2)&1};
+      const Scalar v = s[(c[0]+o[0]) + m*((c[1]+o[1]) + m*(c[2]+o[2]))];
+      Scalar w[3],dw[3];
+      for(int d = 0;d<3;d++)
+      {
+        w[d] = o[d] ? t[d] : 1-t[d];
+        dw[d] = o[d] ? 1 : -1;
+      }
+      value += w[0]*w[1]*w[2]*v;
+      grad[0] += dw[0]*w[1]*w[2]*v;
+      grad[1] += w[0]*dw[1]*w[2]*v;
+      grad[2] += w[0]*w[1]*dw[2]*v;
+    }
+    S(p) = value;
+    for(int d = 0;d<3;d++)
+    {
+      G(p,d) = grad[d]/h;
+    }
+  },1000);
+}
+
+template <typename Scalar>
+template <typename DerivedP, typename DerivedS>
+IGL_INLINE void igl::SparseBrickSDF<Scalar>::query(
+  const Eigen::MatrixBase<DerivedP> & P,
+  Eigen::PlainObjectBase<DerivedS> & S)
+{
+  MatrixX3SR G;
+  query(P,S,G);
+}
+
+template <typename Scalar>
+IGL_INLINE int igl::SparseBrickSDF<Scalar>::num_stored_bricks() const
+{
+  return int(samples.size()/(brick_samples*brick_samples*brick_samples));
+}
+
+template <typename Scalar>
+IGL_INLINE std::int64_t igl::SparseBrickSDF<Scalar>::key(
+  const Eigen::RowVector3i & b)
+{
+  // 21 bits per (biased) subscript
+  constexpr std::int64_t bias = std::int64_t(1)<<20;
+  constexpr std::int64_t mask = (std::int64_t(1)<<21)-1;
+  assert((b.array().abs() < bias).all() && "brick subscripts out of range");
+  return
+    (((b(0)+bias)&mask)<<42) | (((b(1)+bias)&mask)<<21) | ((b(2)+bias)&mask);
+}
+
+template <typename Scalar>
+IGL_INLINE Eigen::RowVector3i igl::SparseBrickSDF<Scalar>::subscripts(
+  const std::int64_t key)
+{
+  constexpr std::int64_t bias = std::int64_t(1)<<20;
+  constexpr std::int64_t mask = (std::int64_t(1)<<21)-1;
+  return Eigen::RowVector3i(
+    int(((key>>42)&mask)-bias),
+    int(((key>>21)&mask)-bias),
+    int((key&mask)-bias));
+}
+
+template <typename Scalar>
+IGL_INLINE void igl::SparseBrickSDF<Scalar>::fill_bricks(
+  const std::vector<std::int64_t> & keys)
+{
+  constexpr int m = brick_samples;
+  constexpr int m3 = m*m*m;
+  const Scalar brick_h = h*brick_size;
+  // A brick whose center is farther than this from the level set cannot
+  // reach into the band
+  const Scalar far = band + brick_h*std::sqrt(Scalar(3))/2;
+  // Bound the size of temporary sample positions
+  const int max_chunk = 256;
+  for(int first = 0;first<int(keys.size());first += max_chunk)
+  {
+    const int num = std::min(max_chunk,int(keys.size())-first);
+    MatrixX3SR C(num,3);
+    for(int k = 0;k<num;k++)
+    {
+      C.row(k) = origin + brick_h*
+        (subscripts(keys[first+k]).template cast<Scalar>().array()+Scalar(0.5)).matrix();
+    }
+    const VectorXS SC = sdf(C);
+    std::vector<int> near;
+    for(int k = 0;k<num;k++)
+    {
+      if(std::abs(SC(k)) > far)
+      {
+        bricks[keys[first+k]] = SC(k) < 0 ? far_inside : far_outside;
+      }else
+      {
+        near.push_back(k);
+      }
+    }
+    if(near.empty())
+    {
+      continue;
+    }
+    MatrixX3SR X(near.size()*m3,3);
+    igl::parallel_for(near.size(),[&](const int k)
+    {
+      const RowVector3S corner =
+        origin + brick_h*subscripts(keys[first+near[k]]).template cast<Scalar>();
+      for(int z = 0;z<m;z++)
+      {
+        for(int y = 0;y<m;y++)
+        {
+          for(int x = 0;x<m;x++)
+          {
+            X.row(std::size_t(k)*m3 + x + m*(y + m*z)) =
+              corner + h*RowVector3S(Scalar(x),Scalar(y),Scalar(z));
+          }
+        }
+      }
+    },16);
+    const VectorXS SX = sdf(X);
+    assert(SX.size() == X.rows() && "sdf should return one value per row");
+    const int num_stored = num_stored_bricks();
+    samples.insert(samples.end(),SX.data(),SX.data()+SX.size());
+    for(int k = 0;k<int(near.size());k++)
+    {
+      bricks[keys[first+near[k]]] = num_stored + k;
+    }
+  }
+}
+
+#ifdef IGL_STATIC_LIBRARY
+// Explicit template instantiation
+template class igl::SparseBrickSDF<double>;
+template void igl::SparseBrickSDF<double>::init<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, double, double);
+template void igl::SparseBrickSDF<double>::query<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&);
+template void igl::SparseBrickSDF<double>::query<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, 1, 0, -1, 1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> >&);
+#endif
@@ -0,0 +1,143 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 Alec Jacobson <alecjacobson@gmail.com>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#ifndef IGL_SPARSEBRICKSDF_H
+#define IGL_SPARSEBRICKSDF_H
+#include "igl_inline.h"
+#include <Eigen/Core>
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+namespace igl
+{
+  /// Narrow-band cache of a signed distance function sampled on a regular
+  /// grid, stored sparsely as bricks of 8×8×8 cells in a hash map.
+  ///
+  /// Bricks are filled on demand: a query falling into a brick that has not
+  /// been seen yet first evaluates the signed distance function at the brick
+  /// center. If the brick cannot reach within `band` of the zero level set,
+  /// only its sign is remembered. Otherwise all of its 9×9×9 corner samples
+  /// are evaluated (in one batched call) and stored. Memory therefore scales
+  /// with the area of the level set rather than the volume of the domain.
+  ///
+  /// Inside stored bricks, values and gradients are trilinearly interpolated
+  /// from the samples. Outside of them, values are ±band (like the
+  /// background value of a narrow-band level set) with zero gradient.
+  ///
+  /// #### Example:
+  ///     igl::SparseBrickSDF<double> sdf;
+  ///     sdf.init(V,F,h,4*h);
+  ///     // optional: fill whole band up front, otherwise filled by queries
+  ///     sdf.fill(V.colwise().minCoeff(),V.colwise().maxCoeff());
+  ///     sdf.query(Q,S,G);
+  ///
+  /// @tparam Scalar  type of positions and distances (e.g., `double`)
+  template <typename Scalar>
+  class SparseBrickSDF
+  {
+  public:
+    /// Number of cells along each side of a brick
+    static constexpr int brick_size = 8;
+    /// Number of samples along each side of a brick
+    static constexpr int brick_samples = brick_size+1;
+    /// Fixed-size RowVector type using `Scalar`
+    typedef Eigen::Matrix<Scalar,1,3> RowVector3S;
+    /// List of positions, one per row
+    typedef Eigen::Matrix<Scalar,Eigen::Dynamic,3,Eigen::RowMajor> MatrixX3SR;
+    /// List of values
+    typedef Eigen::Matrix<Scalar,Eigen::Dynamic,1> VectorXS;
+    /// Batched signed distance function: #P by 3 positions to #P values
+    /// (negative inside), same convention as lipschitz_octree<true>
+    typedef std::function<VectorXS(const MatrixX3SR &)> BatchedFunction;
+    /// Position of the grid sample (0,0,0)
+    RowVector3S origin;
+    /// Grid spacing
+    Scalar h = 0;
+    /// Half-width of the narrow band
+    Scalar band = 0;
+    /// Signed distance function being cached
+    BatchedFunction sdf;
+    /// Map from brick key to index into samples (≥0), or to far_inside /
+    /// far_outside for bricks entirely outside the band
+    std::unordered_map<std::int64_t,int> bricks;
+    /// brick_samples³ values per stored brick, x varies fastest
+    std::vector<Scalar> samples;
+    /// Special values in bricks
+    static constexpr int far_inside = -1;
+    static constexpr int far_outside = -2;
+
+    /// Prepare an empty cache of a signed distance function.
+    ///
+    /// @param[in] origin  3-vector position of the grid sample (0,0,0)
+    /// @param[in] h  grid spacing
+    /// @param[in] band  half-width of narrow band (e.g., a few h)
+    /// @param[in] sdf  batched signed distance function, should be
+    ///   1-Lipschitz (or underestimate distances) for the culling of far
+    ///   bricks to be valid
+    IGL_INLINE void init(
+      const RowVector3S & origin,
+      const Scalar h,
+      const Scalar band,
+      const BatchedFunction & sdf);
+    /// Prepare an empty cache of the signed distance to a closed triangle
+    /// mesh, evaluated by signed_distance_fast_winding_number. The grid is
+    /// anchored at the minimum corner of the mesh's bounding box.
+    ///
+    /// @param[in] V  #V by 3 list of mesh vertex positions (copied)
+    /// @param[in] F  #F by 3 list of triangle indices into V (copied)
+    /// @param[in] h  grid spacing
+    /// @param[in] band  half-width of narrow band (e.g., a few h)
+    template <typename DerivedV, typename DerivedF>
+    IGL_INLINE void init(
+      const Eigen::MatrixBase<DerivedV> & V,
+      const Eigen::MatrixBase<DerivedF> & F,
+      const Scalar h,
+      const Scalar band);
+    /// Fill all bricks which may intersect the band within a box, using
+    /// lipschitz_octree to skip empty space without visiting every brick.
+    ///
+    /// @param[in] min_corner  3-vector minimum corner of box
+    /// @param[in] max_corner  3-vector maximum corner of box
+    IGL_INLINE void fill(
+      const RowVector3S & min_corner,
+      const RowVector3S & max_corner);
+    /// Interpolate the cached signed distance and its gradient at many
+    /// points, first filling (in parallel) any bricks they need.
+    ///
+    /// @param[in] P  #P by 3 list of query positions
+    /// @param[out] S  #P list of signed distances
+    /// @param[out] G  #P by 3 list of gradients of S
+    template <typename DerivedP, typename DerivedS, typename DerivedG>
+    IGL_INLINE void query(
+      const Eigen::MatrixBase<DerivedP> & P,
+      Eigen::PlainObjectBase<DerivedS> & S,
+      Eigen::PlainObjectBase<DerivedG> & G);
+    /// \overload
+    template <typename DerivedP, typename DerivedS>
+    IGL_INLINE void query(
+      const Eigen::MatrixBase<DerivedP> & P,
+      Eigen::PlainObjectBase<DerivedS> & S);
+    /// @return number of bricks storing samples
+    IGL_INLINE int num_stored_bricks() const;
+  private:
+    /// Key of brick with subscripts b (brick b covers grid cells
+    /// brick_size*b to brick_size*(b+1) along each axis)
+    IGL_INLINE static std::int64_t key(const Eigen::RowVector3i & b);
+    /// Subscripts of brick with key
+    IGL_INLINE static Eigen::RowVector3i subscripts(const std::int64_t key);
+    /// Evaluate and insert bricks which are not yet in bricks
+    ///
+    /// @param[in] keys  unique keys of missing bricks
+    IGL_INLINE void fill_bricks(const std::vector<std::int64_t> & keys);
+  };
+}
+
+#ifndef IGL_STATIC_LIBRARY
+#  include "SparseBrickSDF.cpp"
+#endif
+#endif
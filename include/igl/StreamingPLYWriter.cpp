@@ -0,0 +1,136 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 Alec Jacobson <alecjacobson@gmail.com>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#include "StreamingPLYWriter.h"
+#include <cassert>
+#include <cstring>
+#include <vector>
+
+IGL_INLINE igl::StreamingPLYWriter::~StreamingPLYWriter()
+{
+  close();
+}
+
+IGL_INLINE bool igl::StreamingPLYWriter::open(const std::string & filename)
+{
+  close();
+  m_file = std::fopen(filename.c_str(),"wb");
+  if(!m_file)
+  {
+    fprintf(stderr,"IOError: %s could not be opened...\n",filename.c_str());
+    return false;
+  }
+  m_faces = std::tmpfile();
+  if(!m_faces)
+  {
+    fprintf(stderr,"IOError: temporary file for %s could not be opened...\n",
+      filename.c_str());
+    std::fclose(m_file);
+    m_file = nullptr;
+    return false;
+  }
+  m_filename = filename;
+  m_num_vertices = 0;
+  m_num_faces = 0;
+  m_failed = false;
+  // Counts are written as fixed-width placeholders and filled in on close()
+  const std::uint16_t one = 1;
+  const bool little_endian = *reinterpret_cast<const unsigned char *>(&one);
+  fprintf(m_file,"ply\nformat %s 1.0\nelement vertex ",
+    little_endian ? "binary_little_endian" : "binary_big_endian");
+  m_vertex_count_offset = std::ftell(m_file);
+  fprintf(m_file,"%20d\n",0);
+  fprintf(m_file,
+    "property double x\nproperty double y\nproperty double z\n"
+    "element face ");
+  m_face_count_offset = std::ftell(m_file);
+  fprintf(m_file,"%20d\n",0);
+  fprintf(m_file,"property list uchar int vertex_indices\nend_header\n");
+  return true;
+}
+
+template <typename DerivedV, typename DerivedF>
+IGL_INLINE bool igl::StreamingPLYWriter::append(
+  const Eigen::MatrixBase<DerivedV> & V,
+  const Eigen::MatrixBase<DerivedF> & F)
+{
+  if(!is_open())
+  {
+    return false;
+  }
+  assert((V.rows() == 0 || V.cols() == 3) && "V should be #V by 3");
+  assert(F.cols() < 256 && "faces should have fewer than 256 corners");
+  std::vector<double> vertices(3*V.rows());
+  for(Eigen::Index v = 0;v<V.rows();v++)
+  {
+    for(int c = 0;c<3;c++)
+    {
+      vertices[3*v+c] = double(V(v,c));
+    }
+  }
+  m_failed |= 
+    std::fwrite(vertices.data(),sizeof(double),vertices.size(),m_file) != 
+    vertices.size();
+  m_num_vertices += V.rows();
+  const std::size_t record = 1 + sizeof(std::int32_t)*F.cols();
+  std::vector<char> faces(record*F.rows());
+  for(Eigen::Index f = 0;f<F.rows();f++)
+  {
+    char * p = faces.data() + record*f;
+    *p++ = char(static_cast<unsigned char>(F.cols()));
+    for(Eigen::Index c = 0;c<F.cols();c++)
+    {
+      assert(F(f,c) >= 0 && F(f,c) < m_num_vertices);
+      const std::int32_t i = std::int32_t(F(f,c));
+      std::memcpy(p,&i,sizeof(i));
+      p += sizeof(i);
+    }
+  }
+  m_failed |= 
+    std::fwrite(faces.data(),1,faces.size(),m_faces) != faces.size();
+  m_num_faces += F.rows();
+  return !m_failed;
+}
+
+IGL_INLINE bool igl::StreamingPLYWriter::close()
+{
+  if(!is_open())
+  {
+    return false;
+  }
+  // Append faces
+  std::rewind(m_faces);
+  std::vector<char> buffer(1<<20);
+  std::size_t read;
+  std::fseek(m_file,0,SEEK_END);
+  while((read = std::fread(buffer.data(),1,buffer.size(),m_faces)) > 0)
+  {
+    m_failed |= std::fwrite(buffer.data(),1,read,m_file) != read;
+  }
+  m_failed |= std::ferror(m_faces) != 0;
+  // Fill in counts
+  std::fseek(m_file,m_vertex_count_offset,SEEK_SET);
+  fprintf(m_file,"%20lld",static_cast<long long>(m_num_vertices));
+  std::fseek(m_file,m_face_count_offset,SEEK_SET);
+  fprintf(m_file,"%20lld",static_cast<long long>(m_num_faces));
+  m_failed |= std::ferror(m_file) != 0;
+  std::fclose(m_faces);
+  m_failed |= std::fclose(m_file) != 0;
+  m_faces = nullptr;
+  m_file = nullptr;
+  if(m_failed)
+  {
+    fprintf(stderr,"IOError: writing %s failed\n",m_filename.c_str());
+  }
+  return !m_failed;
+}
+
+#ifdef IGL_STATIC_LIBRARY
+// Explicit template instantiation
+template bool igl::StreamingPLYWriter::append<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&);
+template bool igl::StreamingPLYWriter::append<Eigen::Matrix<double, -1, 3, 0, -1, 3>, Eigen::Matrix<int, -1, 3, 0, -1, 3> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, 3, 0, -1, 3> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 3, 0, -1, 3> > const&);
+#endif
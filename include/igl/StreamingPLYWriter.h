@@ -0,0 +1,84 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 Alec Jacobson <alecjacobson@gmail.com>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#ifndef IGL_STREAMING_PLY_WRITER_H
+#define IGL_STREAMING_PLY_WRITER_H
+#include "igl_inline.h"
+#include <Eigen/Core>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+namespace igl
+{
+  /// Write a binary .ply mesh incrementally, one chunk of vertices and faces
+  /// at a time, without ever holding the whole mesh in memory (e.g., as the
+  /// sink of igl::marching_cubes_streaming).
+  ///
+  /// Vertices are written straight to the file and faces to a temporary file
+  /// that is appended on close(), when the element counts in the header are
+  /// filled in.
+  ///
+  /// #### Example:
+  ///
+  /// \code{cpp}
+  ///     igl::StreamingPLYWriter writer;
+  ///     writer.open("mesh.ply");
+  ///     for(...)
+  ///     {
+  ///       // F indexes all vertices appended so far
+  ///       writer.append(V,F);
+  ///     }
+  ///     writer.close();
+  /// \endcode
+  class StreamingPLYWriter
+  {
+    public:
+      StreamingPLYWriter() {}
+      /// Calls close()
+      ~StreamingPLYWriter();
+      StreamingPLYWriter(const StreamingPLYWriter &) = delete;
+      StreamingPLYWriter & operator=(const StreamingPLYWriter &) = delete;
+      /// Start writing a new file (closing any current one)
+      ///
+      /// @param[in] filename  path to .ply file
+      /// @return true on success
+      IGL_INLINE bool open(const std::string & filename);
+      /// Append a chunk of vertices and faces
+      ///
+      /// @param[in] V  #V by 3 list of new vertex positions
+      /// @param[in] F  #F by ss list of new faces indexing all vertices
+      ///   appended so far (including V)
+      /// @return true on success
+      template <typename DerivedV, typename DerivedF>
+      IGL_INLINE bool append(
+        const Eigen::MatrixBase<DerivedV> & V,
+        const Eigen::MatrixBase<DerivedF> & F);
+      /// Finish the file
+      ///
+      /// @return true on success
+      IGL_INLINE bool close();
+      bool is_open() const { return m_file != nullptr; }
+      std::int64_t num_vertices() const { return m_num_vertices; }
+      std::int64_t num_faces() const { return m_num_faces; }
+    private:
+      std::string m_filename;
+      std::FILE * m_file = nullptr;
+      std::FILE * m_faces = nullptr;
+      long m_vertex_count_offset = 0;
+      long m_face_count_offset = 0;
+      std::int64_t m_num_vertices = 0;
+      std::int64_t m_num_faces = 0;
+      bool m_failed = false;
+  };
+}
+
+#ifndef IGL_STATIC_LIBRARY
+#  include "StreamingPLYWriter.cpp"
+#endif
+
+#endif
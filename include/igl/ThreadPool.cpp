@@ -0,0 +1,114 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 Alec Jacobson <alecjacobson@gmail.com>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#include "ThreadPool.h"
+#include "default_num_threads.h"
+
+IGL_INLINE igl::ThreadPool::ThreadPool(const unsigned int num_threads):
+  m_num_threads(num_threads ? num_threads : igl::default_num_threads()),
+  m_nested_policy(NESTED_SERIAL),
+  m_stop(false)
+{
+  // The calling thread always participates, so spawn one less worker
+  m_workers.reserve(m_num_threads-1);
+  for(unsigned int w = 0;w+1<m_num_threads;w++)
+  {
+    m_workers.emplace_back([this](){ worker_loop(); });
+  }
+}
+
+IGL_INLINE igl::ThreadPool::~ThreadPool()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stop = true;
+  }
+  m_cv.notify_all();
+  for(auto & w : m_workers) { if(w.joinable()) { w.join(); } }
+}
+
+IGL_INLINE igl::ThreadPool & igl::ThreadPool::global()
+{
+  // Leaked on purpose: joining threads during static destruction is fragile
+  // (e.g., inside DLL unloading) and loops may still be issued then.
+  static ThreadPool * pool = new ThreadPool(igl::default_num_threads());
+  return *pool;
+}
+
+IGL_INLINE int & igl::ThreadPool::region_depth()
+{
+  static thread_local int depth = 0;
+  return depth;
+}
+
+IGL_INLINE bool igl::ThreadPool::in_parallel_region()
+{
+  return region_depth() > 0;
+}
+
+IGL_INLINE void igl::ThreadPool::run(Job & job)
+{
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_jobs.push_back(&job);
+  }
+  if(job.max_participants > 2)
+  {
+    m_cv.notify_all();
+  }else
+  {
+    m_cv.notify_one();
+  }
+  region_depth()++;
+  job.participate(0);
+  region_depth()--;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const auto it = std::find(m_jobs.begin(),m_jobs.end(),&job);
+    if(it != m_jobs.end()) { m_jobs.erase(it); }
+  }
+  // Remaining workers are finishing their last chunk
+  while(job.active.load(std::memory_order_acquire) > 0)
+  {
+    std::this_thread::yield();
+  }
+}
+
+IGL_INLINE void igl::ThreadPool::worker_loop()
+{
+  while(true)
+  {
+    Job * job = nullptr;
+    unsigned int t = 0;
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_cv.wait(lock,[this]()
+      {
+        // Drop jobs that cannot take more threads
+        while(!m_jobs.empty() &&
+          m_jobs.front()->next_id >= m_jobs.front()->max_participants)
+        {
+          m_jobs.pop_front();
+        }
+        return m_stop || !m_jobs.empty();
+      });
+      if(m_jobs.empty())
+      {
+        // m_stop
+        return;
+      }
+      job = m_jobs.front();
+      t = job->next_id++;
+      job->active.fetch_add(1,std::memory_order_relaxed);
+    }
+    region_depth()++;
+    job->participate(t);
+    region_depth()--;
+    // job may be destroyed by its owner right after this
+    job->active.fetch_sub(1,std::memory_order_release);
+  }
+}
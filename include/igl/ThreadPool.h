@@ -0,0 +1,318 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 Alec Jacobson <alecjacobson@gmail.com>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#ifndef IGL_THREAD_POOL_H
+#define IGL_THREAD_POOL_H
+#include "igl_inline.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace igl
+{
+  /// Persistent pool of worker threads used to execute parallel for loops.
+  ///
+  /// Threads are created once (at construction) and sleep between loops, so
+  /// issuing many small loops does not pay for thread creation. Each loop is
+  /// split into one contiguous slice per participating thread. A thread
+  /// consumes its own slice in guided (halving) chunks and, once empty,
+  /// steals the back half of another thread's remaining slice. The calling
+  /// thread always participates, so a loop completes even if no worker is
+  /// free (e.g., when several threads issue loops concurrently).
+  ///
+  /// All of libigl's parallel loops go through the process-wide pool returned
+  /// by `ThreadPool::global()` (see igl::parallel_for). Its size is given by
+  /// igl::default_num_threads (and hence the `IGL_NUM_THREADS` environment
+  /// variable).
+  ///
+  /// \code{cpp}
+  ///     igl::ThreadPool pool(4);
+  ///     pool.parallel_for(n,[&](int i){ Y(i) = f(X(i)); },1000);
+  /// \endcode
+  ///
+  /// \see parallel_for, default_num_threads
+  class ThreadPool
+  {
+    public:
+      /// How to treat a parallel loop issued from inside the body of another
+      /// parallel loop.
+      enum NestedPolicy
+      {
+        /// Run nested loops serially on the calling thread (default).
+        NESTED_SERIAL = 0,
+        /// Let idle workers help with nested loops.
+        NESTED_PARALLEL = 1
+      };
+      /// @param[in] num_threads  total number of threads used by a loop
+      ///   (including the calling thread). 0 means igl::default_num_threads().
+      IGL_INLINE explicit ThreadPool(const unsigned int num_threads = 0);
+      IGL_INLINE ~ThreadPool();
+      ThreadPool(const ThreadPool &) = delete;
+      ThreadPool & operator=(const ThreadPool &) = delete;
+      /// @return total number of threads participating in a loop
+      unsigned int num_threads() const { return m_num_threads; }
+      /// @param[in] policy  how nested loops should be handled
+      void set_nested_policy(const NestedPolicy policy){ m_nested_policy = policy; }
+      /// @return current nested loop policy
+      NestedPolicy nested_policy() const { return m_nested_policy; }
+      /// Parallel for loop with per-thread preparation and accumulation. See
+      /// igl::parallel_for for a description of the arguments.
+      ///
+      /// @param[in] loop_size  number of iterations
+      /// @param[in] prep_func  called once with n >= number of thread ids
+      /// @param[in] func  called as func(i,t) for every iteration i with
+      ///   thread id t < n
+      /// @param[in] accum_func  called as accum_func(t) for every t < n after
+      ///   all iterations
+      /// @param[in] min_parallel  minimum loop_size to attempt parallel
+      ///   execution {0}
+      /// @param[in] grain_size  minimum number of iterations per chunk {1}
+      /// @return true iff the loop was executed in parallel
+      ///
+      /// @note An exception thrown by func is rethrown on the calling thread
+      /// after all other iterations finished (the remainder of the throwing
+      /// chunk is skipped).
+      template<
+        typename Index,
+        typename PrepFunctionType,
+        typename FunctionType,
+        typename AccumFunctionType>
+      inline bool parallel_for(
+        const Index loop_size,
+        const PrepFunctionType & prep_func,
+        const FunctionType & func,
+        const AccumFunctionType & accum_func,
+        const size_t min_parallel=0,
+        const size_t grain_size=1);
+      /// Parallel for loop calling func(i) for every iteration i.
+      ///
+      /// @param[in] loop_size  number of iterations
+      /// @param[in] func  called as func(i)
+      /// @param[in] min_parallel  minimum loop_size to attempt parallel
+      ///   execution {0}
+      /// @param[in] grain_size  minimum number of iterations per chunk {1}
+      /// @return true iff the loop was executed in parallel
+      template<typename Index, typename FunctionType>
+      inline bool parallel_for(
+        const Index loop_size,
+        const FunctionType & func,
+        const size_t min_parallel=0,
+        const size_t grain_size=1);
+      /// Process-wide pool sized by igl::default_num_threads(). Created on
+      /// first use and intentionally never destroyed so that loops issued
+      /// during static destruction remain valid.
+      IGL_INLINE static ThreadPool & global();
+      /// @return true iff the calling thread is currently executing the body
+      /// of a parallel loop of any pool.
+      IGL_INLINE static bool in_parallel_region();
+    private:
+      /// Type-erased loop shared between the calling thread and workers.
+      struct Job
+      {
+        /// Maximum number of participating threads (thread ids)
+        unsigned int max_participants = 1;
+        /// Next thread id to hand out (0 is reserved for the caller).
+        /// Guarded by m_mutex.
+        unsigned int next_id = 1;
+        /// Number of workers currently inside participate()
+        std::atomic<unsigned int> active{0};
+        virtual ~Job() {}
+        /// Execute iterations as thread id t until no work is left.
+        virtual void participate(const unsigned int t) = 0;
+      };
+      /// Publish job, participate as thread 0 and wait for all workers that
+      /// joined to leave it.
+      IGL_INLINE void run(Job & job);
+      IGL_INLINE void worker_loop();
+      /// @return reference to the calling thread's loop nesting depth
+      IGL_INLINE static int & region_depth();
+      template<typename FunctionType>
+      struct ForJob;
+      unsigned int m_num_threads;
+      NestedPolicy m_nested_policy;
+      std::vector<std::thread> m_workers;
+      std::deque<Job*> m_jobs;
+      std::mutex m_mutex;
+      std::condition_variable m_cv;
+      bool m_stop;
+  };
+}
+
+// Implementation
+
+#include <algorithm>
+#include <cassert>
+
+template<typename FunctionType>
+struct igl::ThreadPool::ForJob : public igl::ThreadPool::Job
+{
+  /// Remaining iterations [begin,end) of one thread's slice
+  struct alignas(64) Range
+  {
+    std::mutex mutex;
+    std::int64_t begin = 0;
+    std::int64_t end = 0;
+  };
+  const FunctionType & func;
+  const std::int64_t grain;
+  std::unique_ptr<Range[]> ranges;
+  std::mutex exception_mutex;
+  std::exception_ptr exception;
+
+  ForJob(
+    const FunctionType & func_,
+    const std::int64_t loop_size,
+    const unsigned int nthreads,
+    const std::int64_t grain_):
+    func(func_),
+    grain(std::max<std::int64_t>(grain_,1)),
+    ranges(new Range[nthreads])
+  {
+    max_participants = nthreads;
+    // Static even split as starting point for stealing
+    for(unsigned int t = 0;t<nthreads;t++)
+    {
+      ranges[t].begin = (loop_size*t)/nthreads;
+      ranges[t].end = (loop_size*(t+1))/nthreads;
+    }
+  }
+
+  // Pop a guided chunk off the front of own slice
+  bool take(const unsigned int t, std::int64_t & b, std::int64_t & e)
+  {
+    Range & r = ranges[t];
+    std::lock_guard<std::mutex> lock(r.mutex);
+    const std::int64_t rem = r.end - r.begin;
+    if(rem <= 0) { return false; }
+    const std::int64_t c = std::min(rem,std::max(grain,rem/2));
+    b = r.begin;
+    e = b + c;
+    r.begin = e;
+    return true;
+  }
+
+  // Move the back half of some other slice into own slice
+  bool steal(const unsigned int t)
+  {
+    for(unsigned int k = 1;k<max_participants;k++)
+    {
+      Range & v = ranges[(t+k)%max_participants];
+      std::int64_t b,e;
+      {
+        std::lock_guard<std::mutex> lock(v.mutex);
+        const std::int64_t rem = v.end - v.begin;
+        if(rem <= 0) { continue; }
+        const std::int64_t c = rem <= grain ? rem : std::max(grain,rem/2);
+        e = v.end;
+        b = e - c;
+        v.end = b;
+      }
+      Range & r = ranges[t];
+      std::lock_guard<std::mutex> lock(r.mutex);
+      r.begin = b;
+      r.end = e;
+      return true;
+    }
+    return false;
+  }
+
+  void participate(const unsigned int t) override
+  {
+    std::int64_t b,e;
+    do
+    {
+      while(take(t,b,e))
+      {
+        try
+        {
+          for(std::int64_t i = b;i<e;i++) { func(i,t); }
+        }catch(...)
+        {
+          std::lock_guard<std::mutex> lock(exception_mutex);
+          if(!exception) { exception = std::current_exception(); }
+        }
+      }
+    }while(steal(t));
+  }
+};
+
+template<
+  typename Index,
+  typename PrepFunctionType,
+  typename FunctionType,
+  typename AccumFunctionType>
+inline bool igl::ThreadPool::parallel_for(
+  const Index loop_size,
+  const PrepFunctionType & prep_func,
+  const FunctionType & func,
+  const AccumFunctionType & accum_func,
+  const size_t min_parallel,
+  const size_t grain_size)
+{
+  assert(loop_size>=0);
+  if(loop_size==0) return false;
+  const size_t nthreads = std::min<size_t>(
+    m_num_threads,
+    (static_cast<size_t>(loop_size)+std::max<size_t>(grain_size,1)-1)/
+      std::max<size_t>(grain_size,1));
+  if(
+    static_cast<size_t>(loop_size)<min_parallel ||
+    nthreads<=1 ||
+    (m_nested_policy == NESTED_SERIAL && in_parallel_region()))
+  {
+    // serial
+    prep_func(1);
+    for(Index i = 0;i<loop_size;i++) func(i,0);
+    accum_func(0);
+    return false;
+  }
+  const auto & wrapper = [&func](const std::int64_t i,const unsigned int t)
+  {
+    func(static_cast<Index>(i),static_cast<size_t>(t));
+  };
+  prep_func(nthreads);
+  ForJob<decltype(wrapper)> job(
+    wrapper,
+    static_cast<std::int64_t>(loop_size),
+    static_cast<unsigned int>(nthreads),
+    static_cast<std::int64_t>(grain_size));
+  run(job);
+  if(job.exception) { std::rethrow_exception(job.exception); }
+  // Accumulate across threads
+  for(size_t t = 0;t<nthreads;t++)
+  {
+    accum_func(t);
+  }
+  return true;
+}
+
+template<typename Index, typename FunctionType>
+inline bool igl::ThreadPool::parallel_for(
+  const Index loop_size,
+  const FunctionType & func,
+  const size_t min_parallel,
+  const size_t grain_size)
+{
+  // no op preparation/accumulation
+  const auto & no_op = [](const size_t /*n/t*/){};
+  // two-parameter wrapper ignoring thread id
+  const auto & wrapper = [&func](Index i,size_t /*t*/){ func(i); };
+  return parallel_for(loop_size,no_op,wrapper,no_op,min_parallel,grain_size);
+}
+
+#ifndef IGL_STATIC_LIBRARY
+#include "ThreadPool.cpp"
+#endif
+
+#endif
@@ -11,7 +11,9 @@
 #include "EPS.h"
 #include "Hit.h"
 #include "parallel_for.h"
+#include <array>
 #include <functional>
+#include <limits>
 #include <vector>
 #include <algorithm>
 
@@ -80,21 +82,43 @@ IGL_INLINE void igl::ambient_occlusion(
 {
   typedef typename DerivedV::Scalar Scalar;
   using Vector3S = Eigen::Matrix<Scalar,3,1>;
-  const auto & shoot_ray = [&aabb,&V,&F](
-    const Eigen::Matrix<Scalar,3,1> & _s,
-    const Eigen::Matrix<Scalar,3,1> & dir)->bool
+  // Trace each point's rays (which share an origin) in packets
+  constexpr int PacketSize = 8;
+  const int n = P.rows();
+  S.resize(n,1);
+  const Eigen::Matrix<Scalar,Eigen::Dynamic,3> D =
+    random_dir_stratified(num_samples).cast<Scalar>();
+  parallel_for(n,[&](const int p)
   {
-    Vector3S s = _s+1e-4*dir;
-    igl::Hit<Scalar> hit;
-    return aabb.intersect_ray(
-      V,
-      F,
-      s,
-      dir,
-      hit);
-  };
-  return ambient_occlusion(shoot_ray,P,N,num_samples,S);
-
+    const Vector3S origin = P.row(p).template cast<Scalar>();
+    const Vector3S normal = N.row(p).template cast<Scalar>();
+    int num_hits = 0;
+    for(int s0 = 0;s0<num_samples;s0+=PacketSize)
+    {
+      Eigen::Matrix<Scalar,PacketSize,3> packet_origin,packet_dir;
+      for(int k = 0;k<PacketSize;k++)
+      {
+        // Pad the last packet by repeating its last ray
+        Vector3S d = D.row(std::min(s0+k,num_samples-1));
+        if(d.dot(normal) < 0)
+        {
+          // reverse ray
+          d *= -1;
+        }
+        packet_origin.row(k) = origin+1e-4*d;
+        packet_dir.row(k) = d;
+      }
+      std::array<igl::Hit<Scalar>,PacketSize> hits;
+      aabb.template intersect_ray_packet<PacketSize>(
+        V,F,packet_origin,packet_dir,
+        std::numeric_limits<Scalar>::infinity(),true,hits);
+      for(int k = 0;k<PacketSize && s0+k<num_samples;k++)
+      {
+        num_hits += hits[k].id >= 0;
+      }
+    }
+    S(p) = (double)num_hits/(double)num_samples;
+  },1000);
 }
 
 template <
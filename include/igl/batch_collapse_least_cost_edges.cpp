@@ -0,0 +1,179 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 Alec Jacobson <alecjacobson@gmail.com>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#include "batch_collapse_least_cost_edges.h"
+#include "collapse_edge.h"
+#include "circulation.h"
+#include "parallel_for.h"
+
+#include <algorithm>
+#include <cassert>
+#include <limits>
+#include <vector>
+
+IGL_INLINE int igl::batch_collapse_least_cost_edges(
+  const decimate_cost_and_placement_callback & cost_and_placement,
+  const decimate_pre_collapse_callback       & pre_collapse,
+  const decimate_post_collapse_callback      & post_collapse,
+  const decimate_stopping_condition_callback & stopping_condition,
+  Eigen::MatrixXd & V,
+  Eigen::MatrixXi & F,
+  Eigen::MatrixXi & E,
+  Eigen::VectorXi & EMAP,
+  Eigen::MatrixXi & EF,
+  Eigen::MatrixXi & EI,
+  igl::IndexedHeap<double> & Q,
+  Eigen::VectorXi & EQ,
+  Eigen::MatrixXd & C,
+  bool & stop)
+{
+  stop = false;
+  // Consider a small fraction of the cheapest edges per round: large enough
+  // to keep threads busy, small enough that collapses stay close to the
+  // serial greedy order.
+  const int max_candidates = std::max(64,Q.size()/32);
+  std::vector<std::pair<double,int> > candidates;
+  candidates.reserve(max_candidates);
+  while(!Q.empty() && int(candidates.size()) < max_candidates &&
+    Q.top().first != std::numeric_limits<double>::infinity())
+  {
+    candidates.push_back(Q.pop());
+  }
+  if(candidates.empty())
+  {
+    return 0;
+  }
+
+  // Gather neighborhoods (read-only)
+  struct Neighborhood
+  {
+    std::vector<int> Nsv,Nsf,Ndv,Ndf;
+  };
+  std::vector<Neighborhood> N(candidates.size());
+  igl::parallel_for(candidates.size(),[&](const size_t c)
+  {
+    const int e = candidates[c].second;
+    circulation(e, true,F,EMAP,EF,EI,N[c].Nsv,N[c].Nsf);
+    circulation(e,false,F,EMAP,EF,EI,N[c].Ndv,N[c].Ndf);
+  },64);
+
+  // Greedily select candidates whose closed one-rings are disjoint from those
+  // of candidates selected before
+  std::vector<bool> taken(V.rows(),false);
+  std::vector<int> selected;
+  selected.reserve(candidates.size());
+  const auto free = [&taken](const std::vector<int> & Nv)
+  {
+    return std::none_of(
+      Nv.begin(),Nv.end(),[&taken](const int v){ return taken[v]; });
+  };
+  for(size_t c = 0;c<candidates.size();c++)
+  {
+    const int e = candidates[c].second;
+    if(!taken[E(e,0)] && !taken[E(e,1)] && free(N[c].Nsv) && free(N[c].Ndv))
+    {
+      taken[E(e,0)] = taken[E(e,1)] = true;
+      for(const int v : N[c].Nsv) { taken[v] = true; }
+      for(const int v : N[c].Ndv) { taken[v] = true; }
+      selected.push_back(int(c));
+    }else
+    {
+      // Try again next round
+      Q.update(e,candidates[c].first);
+    }
+  }
+
+  // Collapse selected edges in order of cost
+  std::vector<int> Nf;
+  int num_attempted = 0;
+  for(const int c : selected)
+  {
+    const int e = candidates[c].second;
+    if(stop)
+    {
+      // Not attempted: put back
+      Q.update(e,candidates[c].first);
+      continue;
+    }
+    num_attempted++;
+    int e1,e2,f1,f2;
+    bool collapsed = true;
+    if(pre_collapse(V,F,E,EMAP,EF,EI,Q,EQ,C,e))
+    {
+      collapsed = collapse_edge(
+        e,C.row(e),
+        N[c].Nsv,N[c].Nsf,N[c].Ndv,N[c].Ndf,
+        V,F,E,EMAP,EF,EI,e1,e2,f1,f2);
+    }else
+    {
+      // Aborted by pre collapse callback
+      collapsed = false;
+    }
+    post_collapse(V,F,E,EMAP,EF,EI,Q,EQ,C,e,e1,e2,f1,f2,collapsed);
+    if(collapsed)
+    {
+      // Erase the center edge (already popped) and the two, other collapsed
+      // edges
+      EQ(e) = -1;
+      EQ(e1) = -1;
+      EQ(e2) = -1;
+      Q.remove(e1);
+      Q.remove(e2);
+      Nf.insert(Nf.end(),N[c].Nsf.begin(),N[c].Nsf.end());
+      Nf.insert(Nf.end(),N[c].Ndf.begin(),N[c].Ndf.end());
+      stop = stopping_condition(V,F,E,EMAP,EF,EI,Q,EQ,C,e,e1,e2,f1,f2);
+    }else
+    {
+      // reinsert with infinite weight (the provided cost function must
+      // **not** have given this un-collapsable edge inf cost already)
+      EQ(e)++;
+      Q.update(e,std::numeric_limits<double>::infinity());
+    }
+  }
+
+  // Collect all edges that must be updated
+  std::sort(Nf.begin(),Nf.end());
+  Nf.erase(std::unique(Nf.begin(),Nf.end()),Nf.end());
+  std::vector<int> Ne;
+  Ne.reserve(3*Nf.size());
+  for(const int n : Nf)
+  {
+    if(F(n,0) != IGL_COLLAPSE_EDGE_NULL ||
+        F(n,1) != IGL_COLLAPSE_EDGE_NULL ||
+        F(n,2) != IGL_COLLAPSE_EDGE_NULL)
+    {
+      for(int v = 0;v<3;v++)
+      {
+        Ne.push_back(EMAP(v*F.rows()+n));
+      }
+    }
+  }
+  std::sort(Ne.begin(),Ne.end());
+  Ne.erase(std::unique(Ne.begin(),Ne.end()),Ne.end());
+  // compute cost and potential placement
+  Eigen::VectorXd costs(Ne.size());
+  Eigen::MatrixXd places(Ne.size(),C.cols());
+  igl::parallel_for(Ne.size(),[&](const size_t k)
+  {
+    double cost;
+    Eigen::RowVectorXd place;
+    cost_and_placement(Ne[k],V,F,E,EMAP,EF,EI,cost,place);
+    costs(k) = cost;
+    places.row(k) = place;
+  },256);
+  for(size_t k = 0;k<Ne.size();k++)
+  {
+    const int ei = Ne[k];
+    assert(EQ(ei) != -1);
+    // Increment timestamp
+    EQ(ei)++;
+    // Change key in queue
+    Q.update(ei,costs(k));
+    C.row(ei) = places.row(k);
+  }
+  return num_attempted;
+}
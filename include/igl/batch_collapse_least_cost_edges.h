@@ -0,0 +1,81 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 Alec Jacobson <alecjacobson@gmail.com>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#ifndef IGL_BATCH_COLLAPSE_LEAST_COST_EDGES_H
+#define IGL_BATCH_COLLAPSE_LEAST_COST_EDGES_H
+#include "igl_inline.h"
+#include "IndexedHeap.h"
+#include "decimate_callback_types.h"
+#include "COLLAPSE_EDGE_NULL.h"
+#include <Eigen/Core>
+namespace igl
+{
+  /// Collapse a round of low-cost edges from a priority queue and update the
+  /// queue.
+  ///
+  /// The cheapest edges in Q are considered in order of cost and an edge is
+  /// selected if no vertex of its endpoints' one-rings belongs to the one-ring
+  /// of an edge already selected in this round. Collapses of selected edges
+  /// touch disjoint parts of the flap data-structures, so their neighborhoods
+  /// are gathered before any collapse, in parallel. The collapses are then
+  /// carried out in order of cost, each followed by its callbacks and the
+  /// stopping condition (so callbacks are never called concurrently and may
+  /// keep state across calls as in igl::qslim). Finally, the costs of all edges
+  /// near collapsed edges are recomputed in parallel.
+  ///
+  /// Unselected candidates stay in Q for the next round.
+  ///
+  /// See decimate.h and collapse_least_cost_edge.h for more details.
+  ///
+  /// @param[in] cost_and_placement  function computing cost of collapsing an
+  ///   edge and the position where it should be placed (will be called
+  ///   concurrently)
+  /// @param[in] pre_collapse  callback called with index of edge whose collapse
+  ///   is about to be attempted
+  /// @param[in] post_collapse  callback called with index of edge whose
+  ///   collapse was just attempted and a flag revealing whether this was
+  ///   successful
+  /// @param[in] stopping_condition  function returning whether to stop
+  ///   collapsing edges, called after each successful collapse. Costs of edges
+  ///   near collapses earlier in this round are not yet updated in Q.
+  /// @param[in,out] V  #V by dim list of vertex positions
+  /// @param[in,out] F  #F by 3 list of face indices into V.
+  /// @param[in,out] E  #E by 2 list of edge indices into V.
+  /// @param[in,out] EMAP #F*3 list of indices into E, mapping each directed
+  ///   edge to unique edge in E
+  /// @param[in,out] EF  #E by 2 list of edge flaps
+  /// @param[in,out] EI  #E by 2 list of edge flap corners
+  /// @param[in,out] Q  queue of costs keyed by edge index
+  /// @param[in,out] EQ  #E list of number of times each edge's cost was
+  ///   updated (-1 for collapsed edges)
+  /// @param[in,out] C  #E by dim list of stored placements
+  /// @param[out] stop  whether stopping_condition returned true
+  /// @return number of attempted collapses (0 if Q is empty or contains only
+  ///   infinite cost edges)
+  ///
+  /// \see collapse_least_cost_edge, decimate
+  IGL_INLINE int batch_collapse_least_cost_edges(
+    const decimate_cost_and_placement_callback & cost_and_placement,
+    const decimate_pre_collapse_callback       & pre_collapse,
+    const decimate_post_collapse_callback      & post_collapse,
+    const decimate_stopping_condition_callback & stopping_condition,
+    Eigen::MatrixXd & V,
+    Eigen::MatrixXi & F,
+    Eigen::MatrixXi & E,
+    Eigen::VectorXi & EMAP,
+    Eigen::MatrixXi & EF,
+    Eigen::MatrixXi & EI,
+    igl::IndexedHeap<double> & Q,
+    Eigen::VectorXi & EQ,
+    Eigen::MatrixXd & C,
+    bool & stop);
+}
+
+#ifndef IGL_STATIC_LIBRARY
+#  include "batch_collapse_least_cost_edges.cpp"
+#endif
+#endif
@@ -12,8 +12,11 @@
 #include "placeholders.h"
 #include "PI.h"
 #include "get_seconds.h"
+#include "parallel_for.h"
 #include <unordered_map>
 #include <algorithm>
+#include <array>
+#include <numeric>
 #include <vector>
 #include <random>
 #include <cstdint>
@@ -48,6 +51,121 @@ namespace igl
   {
     return x+w*(y+w*z);
   }
+  // Flat open-addressing (linear probing) hash table from cell key to cell
+  // index
+  class BlueNoiseCellTable
+  {
+  public:
+    // Inputs:
+    //   n  number of cells that will be inserted
+    BlueNoiseCellTable(const int n)
+    {
+      // at most half full
+      bits = 1;
+      while((std::size_t(1)<<bits) < 2*std::size_t(n)) { bits++; }
+      keys.assign(std::size_t(1)<<bits,-1);
+      values.resize(keys.size());
+    }
+    // Inputs:
+    //   k  non-negative key (not yet inserted)
+    //   c  cell index
+    void insert(const BlueNoiseKeyType k, const int c)
+    {
+      assert(k >= 0);
+      std::size_t h = slot(k);
+      while(keys[h] >= 0) { h = (h+1) & (keys.size()-1); }
+      keys[h] = k;
+      values[h] = c;
+    }
+    // Returns cell index of key k or -1 if not found
+    int find(const BlueNoiseKeyType k) const
+    {
+      std::size_t h = slot(k);
+      while(keys[h] >= 0)
+      {
+        if(keys[h] == k) { return values[h]; }
+        h = (h+1) & (keys.size()-1);
+      }
+      return -1;
+    }
+  private:
+    std::size_t slot(const BlueNoiseKeyType k) const
+    {
+      // Fibonacci hashing
+      return (std::uint64_t(k)*UINT64_C(0x9E3779B97F4A7C15)) >> (64-bits);
+    }
+    int bits;
+    std::vector<BlueNoiseKeyType> keys;
+    std::vector<int> values;
+  };
+  // Generate candidate samples: a uniform random sampling of the mesh with
+  // 30 times the expected number of samples, sorted by integer cell
+  // subscripts.
+  //
+  // Inputs:
+  //   V  #V by 3 list of mesh vertex positions
+  //   F  #F by 3 list of mesh triangle indices into rows of V
+  //   r  Poisson disk radius
+  //   urbg  random number generator
+  // Outputs:
+  //   X  #X by 3 list of raw candidate positions
+  //   XB  #X by 3 list of barycentric coordinates of candidates
+  //   XFI  #X list of indices into F of candidates
+  //   Xs  #X by 3 list of corresponding integer cell subscripts
+  //   w  side length of w×w×w integer cube lattice (into which Xs subscripts)
+  // Returns expected number of samples
+  template <
+    typename DerivedV,
+    typename DerivedF,
+    typename URBG>
+  inline double blue_noise_candidates(
+    const Eigen::MatrixBase<DerivedV> & V,
+    const Eigen::MatrixBase<DerivedF> & F,
+    const typename DerivedV::Scalar r,
+    URBG && urbg,
+    Eigen::Matrix<typename DerivedV::Scalar,Eigen::Dynamic,3,Eigen::RowMajor> & X,
+    Eigen::Matrix<typename DerivedV::Scalar,Eigen::Dynamic,3,Eigen::RowMajor> & XB,
+    Eigen::VectorXi & XFI,
+    Eigen::Matrix<int,Eigen::Dynamic,3,Eigen::RowMajor> & Xs,
+    int & w)
+  {
+    typedef typename DerivedV::Scalar Scalar;
+    // minimum radius
+    const Scalar min_r = r;
+    // cell size based on 3D distance
+    // It works reasonably well (but is probably biased to use s=2*r/√3 here and
+    // g=1 in the outer loop below.
+    //
+    // One thing to try would be to store a list in S (rather than a single point)
+    // or equivalently a mask over M and just use M as a generic spatial hash
+    // (with arbitrary size) and then tune its size (being careful to make g a
+    // function of r and s; and removing the `if S=-1 checks`)
+    const Scalar s = r/sqrt(3.0);
+
+    const double area =
+      [&](){Eigen::VectorXd A;igl::doublearea(V,F,A);return A.array().sum()/2;}();
+    // Circle packing in the plane has igl::PI*sqrt(3)/6 efficiency
+    const double expected_number_of_points =
+      area * (igl::PI * sqrt(3.0) / 6.0) / (igl::PI * min_r * min_r / 4.0);
+
+    // Make a uniform random sampling with 30*expected_number_of_points.
+    const int nx = 30.0*expected_number_of_points;
+    igl::random_points_on_mesh(nx,V,F,XB,XFI,X,urbg);
+
+    // Rescale so that s = 1
+    Xs = ((X.rowwise()-X.colwise().minCoeff())/s).template cast<int>();
+    w = Xs.maxCoeff()+1;
+    {
+      Eigen::VectorXi I;
+      igl::sortrows(
+        Eigen::Matrix<int,Eigen::Dynamic,3,Eigen::RowMajor>(Xs),true,Xs,I);
+      X = X(I,igl::placeholders::all).eval();
+      // These two could be spun off in their own thread.
+      XB = XB(I,igl::placeholders::all).eval();
+      XFI = XFI(I,igl::placeholders::all).eval();
+    }
+    return expected_number_of_points;
+  }
   // Determine if a query candidate at position X.row(i) is too close to already
   // selected sites (stored in S).
   //
@@ -261,42 +379,12 @@ IGL_INLINE void igl::blue_noise(
   // float+RowMajor is faster...
   typedef Eigen::Matrix<Scalar,Eigen::Dynamic,3,Eigen::RowMajor> MatrixX3S;
   assert(V.cols() == 3 && "Only 3D embeddings allowed");
-  // minimum radius
-  const Scalar min_r = r;
-  // cell size based on 3D distance
-  // It works reasonably well (but is probably biased to use s=2*r/√3 here and
-  // g=1 in the outer loop below.
-  //
-  // One thing to try would be to store a list in S (rather than a single point)
-  // or equivalently a mask over M and just use M as a generic spatial hash
-  // (with arbitrary size) and then tune its size (being careful to make g a
-  // function of r and s; and removing the `if S=-1 checks`)
-  const Scalar s = r/sqrt(3.0);
-
-  const double area =
-    [&](){Eigen::VectorXd A;igl::doublearea(V,F,A);return A.array().sum()/2;}();
-  // Circle packing in the plane has igl::PI*sqrt(3)/6 efficiency
-  const double expected_number_of_points =
-    area * (igl::PI * sqrt(3.0) / 6.0) / (igl::PI * min_r * min_r / 4.0);
-
-  // Make a uniform random sampling with 30*expected_number_of_points.
-  const int nx = 30.0*expected_number_of_points;
   MatrixX3S X,XB;
   Eigen::VectorXi XFI;
-  igl::random_points_on_mesh(nx,V,F,XB,XFI,X,urbg);
-
-  // Rescale so that s = 1
-  Eigen::Matrix<int,Eigen::Dynamic,3,Eigen::RowMajor> Xs =
-    ((X.rowwise()-X.colwise().minCoeff())/s).template cast<int>();
-  const int w = Xs.maxCoeff()+1;
-  {
-    Eigen::VectorXi I;
-    igl::sortrows(decltype(Xs)(Xs),true,Xs,I);
-    X = X(I,igl::placeholders::all).eval();
-    // These two could be spun off in their own thread.
-    XB = XB(I,igl::placeholders::all).eval();
-    XFI = XFI(I,igl::placeholders::all).eval();
-  }
+  Eigen::Matrix<int,Eigen::Dynamic,3,Eigen::RowMajor> Xs;
+  int w;
+  const double expected_number_of_points =
+    blue_noise_candidates(V,F,r,urbg,X,XB,XFI,Xs,w);
   // Initialization
   std::unordered_map<BlueNoiseKeyType,std::vector<int> > M;
   std::unordered_map<BlueNoiseKeyType, int > S;
@@ -372,8 +460,131 @@ IGL_INLINE void igl::blue_noise(
   }
 }
 
+template <
+  typename DerivedV,
+  typename DerivedF,
+  typename DerivedB,
+  typename DerivedFI,
+  typename DerivedP,
+  typename URBG>
+IGL_INLINE void igl::blue_noise_parallel(
+    const Eigen::MatrixBase<DerivedV> & V,
+    const Eigen::MatrixBase<DerivedF> & F,
+    const typename DerivedV::Scalar r,
+    Eigen::PlainObjectBase<DerivedB> & B,
+    Eigen::PlainObjectBase<DerivedFI> & FI,
+    Eigen::PlainObjectBase<DerivedP> & P,
+    URBG && urbg)
+{
+  typedef typename DerivedV::Scalar Scalar;
+  typedef Eigen::Matrix<Scalar,Eigen::Dynamic,3,Eigen::RowMajor> MatrixX3S;
+  assert(V.cols() == 3 && "Only 3D embeddings allowed");
+  MatrixX3S X,XB;
+  Eigen::VectorXi XFI;
+  Eigen::Matrix<int,Eigen::Dynamic,3,Eigen::RowMajor> Xs;
+  int w;
+  blue_noise_candidates(V,F,r,urbg,X,XB,XFI,Xs,w);
+
+  // Candidates are sorted by cell so each cell is a contiguous range
+  // C(c):C(c+1)-1 of candidates
+  std::vector<int> C;
+  for(int i = 0;i<Xs.rows();i++)
+  {
+    if(i == 0 || Xs.row(i) != Xs.row(i-1)) { C.push_back(i); }
+  }
+  const int nc = C.size();
+  C.push_back(Xs.rows());
+  BlueNoiseCellTable table(nc);
+  // Bucket cells into phase groups according to subscripts modulo 3
+  std::array<int,28> phase_offsets;
+  phase_offsets.fill(0);
+  std::vector<int> phase(nc);
+  for(int c = 0;c<nc;c++)
+  {
+    const int i = C[c];
+    table.insert(blue_noise_key(w,Xs(i,0),Xs(i,1),Xs(i,2)),c);
+    phase[c] = Xs(i,0)%3 + 3*(Xs(i,1)%3) + 9*(Xs(i,2)%3);
+    phase_offsets[phase[c]+1]++;
+  }
+  std::partial_sum(
+    phase_offsets.begin(),phase_offsets.end(),phase_offsets.begin());
+  std::vector<int> phase_cells(nc);
+  {
+    std::array<int,27> next;
+    std::copy(phase_offsets.begin(),phase_offsets.end()-1,next.begin());
+    for(int c = 0;c<nc;c++) { phase_cells[next[phase[c]]++] = c; }
+  }
+  std::array<int,27> order;
+  std::iota(order.begin(),order.end(),0);
+  std::shuffle(order.begin(),order.end(),urbg);
+
+  // index into X of sample selected in each cell (or -1 if none)
+  std::vector<int> S(nc,-1);
+  const double rr = r*r;
+  // Cells of the same phase group are at least 3 cells apart, more than the
+  // g=2 cells searched for conflicts, so they can be processed concurrently.
+  for(const int p : order)
+  {
+    igl::parallel_for(
+      phase_offsets[p+1]-phase_offsets[p],
+      [&](const int j)
+      {
+        const int c = phase_cells[phase_offsets[p]+j];
+        const int xi = Xs(C[c],0);
+        const int yi = Xs(C[c],1);
+        const int zi = Xs(C[c],2);
+        // Samples in neighboring cells (belonging to other phase groups, so
+        // these don't change while processing this group)
+        std::array<int,124> N;
+        int nn = 0;
+        const int g = 2;
+        for(int x = std::max(xi-g,0);x<=std::min(xi+g,w-1);x++)
+        for(int y = std::max(yi-g,0);y<=std::min(yi+g,w-1);y++)
+        for(int z = std::max(zi-g,0);z<=std::min(zi+g,w-1);z++)
+        {
+          if(x!=xi || y!=yi || z!=zi)
+          {
+            const int k = table.find(blue_noise_key(w,x,y,z));
+            if(k >= 0 && S[k] >= 0) { N[nn++] = S[k]; }
+          }
+        }
+        // Select first candidate far enough from all of them
+        for(int i = C[c];i<C[c+1];i++)
+        {
+          bool far_enough = true;
+          for(int n = 0;n<nn && far_enough;n++)
+          {
+            far_enough = (X.row(i)-X.row(N[n])).squaredNorm() >= rr;
+          }
+          if(far_enough)
+          {
+            S[c] = i;
+            break;
+          }
+        }
+      },1000);
+  }
+  {
+    std::vector<int> collected;
+    for(int c = 0;c<nc;c++) { if(S[c] >= 0) { collected.push_back(S[c]); } }
+    const int n = collected.size();
+    P.resize(n,3);
+    B.resize(n,3);
+    FI.resize(n);
+    for(int i = 0;i<n;i++)
+    {
+      const int c = collected[i];
+      P.row(i) = X.row(c).template cast<typename DerivedP::Scalar>();
+      B.row(i) = XB.row(c).template cast<typename DerivedB::Scalar>();
+      FI(i) = XFI(c);
+    }
+  }
+}
+
 #ifdef IGL_STATIC_LIBRARY
 // Explicit template instantiation
 template void igl::blue_noise<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, std::mt19937_64 >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::Matrix<double, -1, -1, 0, -1, -1>::Scalar, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&, std::mt19937_64&&);
 template void igl::blue_noise<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, std::mt19937 >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::Matrix<double, -1, -1, 0, -1, -1>::Scalar, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&, std::mt19937&&);
+template void igl::blue_noise_parallel<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, std::mt19937_64 >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::Matrix<double, -1, -1, 0, -1, -1>::Scalar, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&, std::mt19937_64&&);
+template void igl::blue_noise_parallel<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, std::mt19937 >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::Matrix<double, -1, -1, 0, -1, -1>::Scalar, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&, std::mt19937&&);
 #endif
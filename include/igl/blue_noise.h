@@ -44,6 +44,45 @@ namespace igl
       Eigen::PlainObjectBase<DerivedFI> & FI,
       Eigen::PlainObjectBase<DerivedP> & P,
       URBG && urbg = igl::generate_default_urbg());
+  /// Parallel Poisson disk sampling by phase-group dart throwing ("Parallel
+  /// Poisson Disk Sampling" [Wei 2008]) over the same kind of candidate set
+  /// as blue_noise.
+  ///
+  /// Candidates are bucketed in a grid of cells of size r/√3 (so each cell
+  /// holds at most one sample). Cells are split into 27 phase groups by their
+  /// subscripts modulo 3: cells of the same group are too far apart to
+  /// conflict, so each group's cells are processed concurrently. Groups are
+  /// processed one after another in a random order. The output is
+  /// deterministic for a given urbg state (regardless of the number of
+  /// threads), but differs from blue_noise's.
+  ///
+  /// @param[in] V  #V by dim list of mesh vertex positions
+  /// @param[in] F  #F by 3 list of mesh triangle indices into rows of V
+  /// @param[in] r  Poisson disk radius (evaluated according to Euclidean distance on V)
+  /// @param[out] B  #P by 3 list of barycentric coordinates, ith row are coordinates of
+  ///               ith sampled point in face FI(i)
+  /// @param[out] FI  #P list of indices into F 
+  /// @param[out] P  #P by dim list of sample positions.
+  /// @param[in,out] urbg An instance of UnformRandomBitGenerator (e.g.,
+  ///  `std::minstd_rand(0)`)
+  ///
+  /// \see blue_noise
+  template <
+    typename DerivedV,
+    typename DerivedF,
+    typename DerivedB,
+    typename DerivedFI,
+    typename DerivedP,
+    typename URBG = DEFAULT_URBG
+      >
+  IGL_INLINE void blue_noise_parallel(
+      const Eigen::MatrixBase<DerivedV> & V,
+      const Eigen::MatrixBase<DerivedF> & F,
+      const typename DerivedV::Scalar r,
+      Eigen::PlainObjectBase<DerivedB> & B,
+      Eigen::PlainObjectBase<DerivedFI> & FI,
+      Eigen::PlainObjectBase<DerivedP> & P,
+      URBG && urbg = igl::generate_default_urbg());
 }
 
 #ifndef IGL_STATIC_LIBRARY
@@ -10,6 +10,7 @@
 #include "circulation.h"
 
 #include <cassert>
+#include <limits>
 
 IGL_INLINE bool igl::collapse_least_cost_edge(
   const decimate_cost_and_placement_callback & cost_and_placement,
@@ -21,7 +22,7 @@ IGL_INLINE bool igl::collapse_least_cost_edge(
   Eigen::VectorXi & EMAP,
   Eigen::MatrixXi & EF,
   Eigen::MatrixXi & EI,
-  igl::min_heap< std::tuple<double,int,int> > & Q,
+  igl::IndexedHeap<double> & Q,
   Eigen::VectorXi & EQ,
   Eigen::MatrixXd & C,
   int & e,
@@ -31,35 +32,22 @@ IGL_INLINE bool igl::collapse_least_cost_edge(
   int & f2)
 {
   using namespace igl;
-  std::tuple<double,int,int> p;
-  while(true)
+  // Check if Q is empty
+  if(Q.empty())
   {
-    // Check if Q is empty
-    if(Q.empty())
-    {
-      // no edges to collapse
-      e = -1;
-      return false;
-    }
-    // pop from Q
-    p = Q.top();
-    if(std::get<0>(p) == std::numeric_limits<double>::infinity())
-    {
-      e = -1;
-      // min cost edge is infinite cost
-      return false;
-    }
-    Q.pop();
-    e = std::get<1>(p);
-    // Check if matches timestamp
-    if(std::get<2>(p) == EQ(e))
-    {
-      break;
-    }
-    // must be stale or dead.
-    assert(std::get<2>(p)  < EQ(e) || EQ(e) == -1);
-    // try again.
+    // no edges to collapse
+    e = -1;
+    return false;
+  }
+  if(Q.top().first == std::numeric_limits<double>::infinity())
+  {
+    e = -1;
+    // min cost edge is infinite cost
+    return false;
   }
+  // pop from Q
+  e = Q.pop().second;
+  assert(EQ(e) != -1);
 
   // Why is this computed up here?
   // If we just need original face neighbors of edge, could we gather that more
@@ -85,11 +73,13 @@ IGL_INLINE bool igl::collapse_least_cost_edge(
   post_collapse(V,F,E,EMAP,EF,EI,Q,EQ,C,e,e1,e2,f1,f2,collapsed);
   if(collapsed)
   {
-    // Erase the center edge, marking its timestamp as -1
+    // Erase the center edge (already popped), marking its timestamp as -1
     EQ(e) = -1;
-    // Erase the two, other collapsed edges by marking their timestamps as -1
+    // Erase the two, other collapsed edges
     EQ(e1) = -1;
     EQ(e2) = -1;
+    Q.remove(e1);
+    Q.remove(e2);
     // TODO: visits edges multiple times, ~150% more updates than should
     //
     // update local neighbors
@@ -132,8 +122,8 @@ IGL_INLINE bool igl::collapse_least_cost_edge(
        cost_and_placement(ei,V,F,E,EMAP,EF,EI,cost,place);
        // Increment timestamp
        EQ(ei)++;
-       // Replace in queue
-       Q.emplace(cost,ei,EQ(ei));
+       // Change key in queue
+       Q.update(ei,cost);
        C.row(ei) = place;
     }
   }else
@@ -142,8 +132,8 @@ IGL_INLINE bool igl::collapse_least_cost_edge(
     // have given this un-collapsable edge inf cost already)
     // Increment timestamp
     EQ(e)++;
-    // Replace in queue
-    Q.emplace(std::numeric_limits<double>::infinity(),e,EQ(e));
+    // Reinsert into queue
+    Q.update(e,std::numeric_limits<double>::infinity());
   }
   return collapsed;
 }
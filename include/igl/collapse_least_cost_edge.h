@@ -8,7 +8,7 @@
 #ifndef IGL_COLLAPSE_LEAST_COST_EDGE_H
 #define IGL_COLLAPSE_LEAST_COST_EDGE_H
 #include "igl_inline.h"
-#include "min_heap.h"
+#include "IndexedHeap.h"
 #include "decimate_callback_types.h"
 #include "COLLAPSE_EDGE_NULL.h"
 #include <Eigen/Core>
@@ -42,8 +42,10 @@ namespace igl
   ///     F(f,:) opposite the vth corner, where EI(e,0)=v. Similarly EF(e,1)
   ///     e=(j->i)
   /// @param[in,out] EI  #E by 2 list of edge flap corners (see above).
-  /// @param[in] Q  queue containing pairs of costs and edge indices and insertion "time"
-  /// @param[in] EQ  #E list of "time" of last time pushed into Q
+  /// @param[in] Q  queue of costs keyed by edge index (collapsed edges are
+  ///   removed)
+  /// @param[in] EQ  #E list of number of times each edge's cost was updated
+  ///   (-1 for collapsed edges)
   /// @param[in] C  #E by dim list of stored placements
   /// @param[out] e  index into E of attempted collapsed edge. Set to -1 if Q is empty or
   ///               contains only infinite cost edges.
@@ -65,7 +67,7 @@ namespace igl
     Eigen::VectorXi & EMAP,
     Eigen::MatrixXi & EF,
     Eigen::MatrixXi & EI,
-    igl::min_heap< std::tuple<double,int,int> > & Q,
+    igl::IndexedHeap<double> & Q,
     Eigen::VectorXi & EQ,
     Eigen::MatrixXd & C,
     int & e,
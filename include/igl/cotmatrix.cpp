@@ -6,6 +6,7 @@
 // v. 2.0. If a copy of the MPL was not distributed with this file, You can 
 // obtain one at http://mozilla.org/MPL/2.0/.
 #include "cotmatrix.h"
+#include "parallel_for.h"
 #include <vector>
 
 // For error printing
@@ -23,17 +24,23 @@ IGL_INLINE void igl::cotmatrix(
   const Eigen::MatrixBase<DerivedF> & F, 
   Eigen::SparseMatrix<Scalar>& L)
 {
-  L.resize(V.rows(),V.rows());
+  SparseAssemblyData data;
+  return cotmatrix(V,F,data,L);
+}
+
+template <typename DerivedV, typename DerivedF, typename Scalar>
+IGL_INLINE void igl::cotmatrix(
+  const Eigen::MatrixBase<DerivedV> & V, 
+  const Eigen::MatrixBase<DerivedF> & F, 
+  SparseAssemblyData & data,
+  Eigen::SparseMatrix<Scalar>& L)
+{
   Eigen::Matrix<int ,Eigen::Dynamic,2> edges;
   int simplex_size = F.cols();
   // 3 for triangles, 4 for tets
   assert(simplex_size == 3 || simplex_size == 4);
   if(simplex_size == 3)
   {
-    // This is important! it could decrease the comptuation time by a factor of 2
-    // Laplacian for a closed 2d manifold mesh will have on average 7 entries per
-    // row
-    L.reserve(10*V.rows());
     edges.resize(3,2);
     edges << 
       1,2,
@@ -41,7 +48,6 @@ IGL_INLINE void igl::cotmatrix(
       0,1;
   }else if(simplex_size == 4)
   {
-    L.reserve(17*V.rows());
     edges.resize(6,2);
     edges << 
       1,2,
@@ -54,27 +60,41 @@ IGL_INLINE void igl::cotmatrix(
   {
     return;
   }
-  // Gather cotangents
-  Eigen::Matrix<Scalar ,Eigen::Dynamic ,Eigen::Dynamic> C;
+  // Gather cotangents (row-major so that entry (i,e) is at i*#edges+e)
+  Eigen::Matrix<Scalar,Eigen::Dynamic,Eigen::Dynamic,Eigen::RowMajor> C;
   cotmatrix_entries(V,F,C);
-  
-  std::vector<Eigen::Triplet<Scalar> > IJV;
-  IJV.reserve(F.rows()*edges.rows()*4);
-  // Loop over triangles
-  for(int i = 0; i < F.rows(); i++)
+
+  const int num_edges = edges.rows();
+  const std::uint64_t F_hash = SparseAssemblyData::hash(F);
+  if(!data.matches(V.rows(),V.rows(),F.rows(),4*num_edges,F_hash))
   {
-    // loop over edges of element
-    for(int e = 0;e<edges.rows();e++)
+    // Edge e of element i with weight C(i,e) contributes, in order,
+    //   (source,dest,C(i,e)), (dest,source,C(i,e)),
+    //   (source,source,-C(i,e)), (dest,dest,-C(i,e))
+    // as contributions 4*(i*#edges+e)+{0,1,2,3}
+    Eigen::VectorXi I(F.rows()*num_edges*4);
+    Eigen::VectorXi J(I.size());
+    parallel_for(F.rows(),[&](const int i)
     {
-      int source = F(i,edges(e,0));
-      int dest = F(i,edges(e,1));
-      IJV.push_back(Eigen::Triplet<Scalar>(source,dest,C(i,e)));
-      IJV.push_back(Eigen::Triplet<Scalar>(dest,source,C(i,e)));
-      IJV.push_back(Eigen::Triplet<Scalar>(source,source,-C(i,e)));
-      IJV.push_back(Eigen::Triplet<Scalar>(dest,dest,-C(i,e)));
-    }
+      for(int e = 0;e<num_edges;e++)
+      {
+        const int source = F(i,edges(e,0));
+        const int dest = F(i,edges(e,1));
+        const int t = 4*(i*num_edges+e);
+        I(t+0) = source; J(t+0) = dest;
+        I(t+1) = dest;   J(t+1) = source;
+        I(t+2) = source; J(t+2) = source;
+        I(t+3) = dest;   J(t+3) = dest;
+      }
+    },1000);
+    sparse_assembly_precompute(
+      I,J,V.rows(),V.rows(),F.rows(),4*num_edges,F_hash,data);
   }
-  L.setFromTriplets(IJV.begin(),IJV.end());
+  const Scalar * c = C.data();
+  sparse_assembly(data,[c](const int t)->Scalar
+  {
+    return (t & 2) ? -c[t>>2] : c[t>>2];
+  },L);
 }
 
 #include "massmatrix.h"
@@ -226,4 +246,6 @@ template void igl::cotmatrix<Eigen::Matrix<double, -1, -1, 1, -1, -1>, Eigen::Ma
 template void igl::cotmatrix<Eigen::Matrix<double, -1, 3, 0, -1, 3>, Eigen::Matrix<int, -1, 4, 0, -1, 4>, double>(Eigen::MatrixBase<Eigen::Matrix<double, -1, 3, 0, -1, 3> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 4, 0, -1, 4> > const&, Eigen::SparseMatrix<double, 0, int>&);
 template void igl::cotmatrix<Eigen::Matrix<double, -1, 3, 0, -1, 3>, Eigen::Matrix<int, -1, 3, 0, -1, 3>, double>(Eigen::MatrixBase<Eigen::Matrix<double, -1, 3, 0, -1, 3> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 3, 0, -1, 3> > const&, Eigen::SparseMatrix<double, 0, int>&);
 template void igl::cotmatrix<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, double>(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::SparseMatrix<double, 0, int>&);
+template void igl::cotmatrix<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, double>(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, igl::SparseAssemblyData&, Eigen::SparseMatrix<double, 0, int>&);
+template void igl::cotmatrix<Eigen::Matrix<double, -1, 3, 0, -1, 3>, Eigen::Matrix<int, -1, 3, 0, -1, 3>, double>(Eigen::MatrixBase<Eigen::Matrix<double, -1, 3, 0, -1, 3> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 3, 0, -1, 3> > const&, igl::SparseAssemblyData&, Eigen::SparseMatrix<double, 0, int>&);
 #endif
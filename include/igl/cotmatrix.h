@@ -8,6 +8,7 @@
 #ifndef IGL_COTMATRIX_H
 #define IGL_COTMATRIX_H
 #include "igl_inline.h"
+#include "sparse_assembly.h"
 
 #include <Eigen/Dense>
 #include <Eigen/Sparse>
@@ -46,6 +47,29 @@ namespace igl
     const Eigen::MatrixBase<DerivedV> & V, 
     const Eigen::MatrixBase<DerivedF> & F, 
     Eigen::SparseMatrix<Scalar>& L);
+  /// \overload
+  /// \brief Reuses the sparsity pattern of L across calls with the same F
+  /// (e.g., when only V changes), so that repeated calls only recompute and
+  /// scatter values.
+  ///
+  /// @param[in,out] data  sparsity pattern of L; (re)computed from F if
+  ///     empty or if the output size, #F, entries per element or the hash of
+  ///     F's indices differ from the stored ones
+  ///
+  /// #### Example:
+  ///
+  /// \code{cpp}
+  ///     igl::SparseAssemblyData data;
+  ///     igl::cotmatrix(V,F,data,L);
+  ///     // ... move vertices ...
+  ///     igl::cotmatrix(V,F,data,L); // values-only refresh
+  /// \endcode
+  template <typename DerivedV, typename DerivedF, typename Scalar>
+  IGL_INLINE void cotmatrix(
+    const Eigen::MatrixBase<DerivedV> & V, 
+    const Eigen::MatrixBase<DerivedF> & F, 
+    SparseAssemblyData & data,
+    Eigen::SparseMatrix<Scalar>& L);
   /// Cotangent Laplacian (and mass matrix) for polygon meshes according to
   /// "Polygon Laplacian Made Simple" [Bunge et al.\ 2020]
   ///
@@ -8,6 +8,7 @@
 #include "cotmatrix_intrinsic.h"
 #include "cotmatrix_entries.h"
 #include "IGL_ASSERT.h"
+#include "parallel_for.h"
 #include <iostream>
 
 template <typename Derivedl, typename DerivedF, typename Scalar>
@@ -15,45 +16,62 @@ IGL_INLINE void igl::cotmatrix_intrinsic(
   const Eigen::MatrixBase<Derivedl> & l, 
   const Eigen::MatrixBase<DerivedF> & F, 
   Eigen::SparseMatrix<Scalar>& L)
+{
+  SparseAssemblyData data;
+  return cotmatrix_intrinsic(l,F,data,L);
+}
+
+template <typename Derivedl, typename DerivedF, typename Scalar>
+IGL_INLINE void igl::cotmatrix_intrinsic(
+  const Eigen::MatrixBase<Derivedl> & l, 
+  const Eigen::MatrixBase<DerivedF> & F, 
+  SparseAssemblyData & data,
+  Eigen::SparseMatrix<Scalar>& L)
 {
   // Cribbed from cotmatrix
 
-  const int nverts = F.maxCoeff()+1;
-  L.resize(nverts,nverts);
   Eigen::Matrix<int ,Eigen::Dynamic,2> edges;
   int simplex_size = F.cols();
   // 3 for triangles, 4 for tets
   IGL_ASSERT(simplex_size == 3);
-  // This is important! it could decrease the comptuation time by a factor of 2
-  // Laplacian for a closed 2d manifold mesh will have on average 7 entries per
-  // row
-  L.reserve(10*nverts);
   edges.resize(3,2);
   edges << 
     1,2,
     2,0,
     0,1;
-  // Gather cotangents
-  Eigen::Matrix<Scalar ,Eigen::Dynamic ,Eigen::Dynamic> C;
+  // Gather cotangents (row-major so that entry (i,e) is at i*3+e)
+  Eigen::Matrix<Scalar,Eigen::Dynamic,Eigen::Dynamic,Eigen::RowMajor> C;
   cotmatrix_entries(l,C);
-  
-  std::vector<Eigen::Triplet<Scalar> > IJV;
-  IJV.reserve(F.rows()*edges.rows()*4);
-  // Loop over triangles
-  for(int i = 0; i < F.rows(); i++)
+
+  const int nverts = F.maxCoeff()+1;
+  const std::uint64_t F_hash = SparseAssemblyData::hash(F);
+  if(!data.matches(nverts,nverts,F.rows(),4*edges.rows(),F_hash))
   {
-    // loop over edges of element
-    for(int e = 0;e<edges.rows();e++)
+    // Edge e of face i contributes (source,dest), (dest,source),
+    // (source,source), (dest,dest) as contributions 4*(i*3+e)+{0,1,2,3}
+    Eigen::VectorXi I(F.rows()*edges.rows()*4);
+    Eigen::VectorXi J(I.size());
+    parallel_for(F.rows(),[&](const int i)
     {
-      int source = F(i,edges(e,0));
-      int dest = F(i,edges(e,1));
-      IJV.push_back(Eigen::Triplet<Scalar>(source,dest,C(i,e)));
-      IJV.push_back(Eigen::Triplet<Scalar>(dest,source,C(i,e)));
-      IJV.push_back(Eigen::Triplet<Scalar>(source,source,-C(i,e)));
-      IJV.push_back(Eigen::Triplet<Scalar>(dest,dest,-C(i,e)));
-    }
+      for(int e = 0;e<edges.rows();e++)
+      {
+        const int source = F(i,edges(e,0));
+        const int dest = F(i,edges(e,1));
+        const int t = 4*(i*edges.rows()+e);
+        I(t+0) = source; J(t+0) = dest;
+        I(t+1) = dest;   J(t+1) = source;
+        I(t+2) = source; J(t+2) = source;
+        I(t+3) = dest;   J(t+3) = dest;
+      }
+    },1000);
+    sparse_assembly_precompute(
+      I,J,nverts,nverts,F.rows(),4*edges.rows(),F_hash,data);
   }
-  L.setFromTriplets(IJV.begin(),IJV.end());
+  const Scalar * c = C.data();
+  sparse_assembly(data,[c](const int t)->Scalar
+  {
+    return (t & 2) ? -c[t>>2] : c[t>>2];
+  },L);
 }
 
 #ifdef IGL_STATIC_LIBRARY
@@ -63,4 +81,6 @@ template void igl::cotmatrix_intrinsic<Eigen::Matrix<double, -1, -1, 1, -1, -1>,
 template void igl::cotmatrix_intrinsic<Eigen::Matrix<double, -1, 3, 0, -1, 3>, Eigen::Matrix<int, -1, 4, 0, -1, 4>, double>(Eigen::MatrixBase<Eigen::Matrix<double, -1, 3, 0, -1, 3> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 4, 0, -1, 4> > const&, Eigen::SparseMatrix<double, 0, int>&);
 template void igl::cotmatrix_intrinsic<Eigen::Matrix<double, -1, 3, 0, -1, 3>, Eigen::Matrix<int, -1, 3, 0, -1, 3>, double>(Eigen::MatrixBase<Eigen::Matrix<double, -1, 3, 0, -1, 3> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 3, 0, -1, 3> > const&, Eigen::SparseMatrix<double, 0, int>&);
 template void igl::cotmatrix_intrinsic<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, double>(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::SparseMatrix<double, 0, int>&);
+template void igl::cotmatrix_intrinsic<Eigen::Matrix<double, -1, 3, 0, -1, 3>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, double>(Eigen::MatrixBase<Eigen::Matrix<double, -1, 3, 0, -1, 3> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, igl::SparseAssemblyData&, Eigen::SparseMatrix<double, 0, int>&);
+template void igl::cotmatrix_intrinsic<Eigen::Matrix<double, -1, 3, 0, -1, 3>, Eigen::Matrix<int, -1, 3, 0, -1, 3>, double>(Eigen::MatrixBase<Eigen::Matrix<double, -1, 3, 0, -1, 3> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 3, 0, -1, 3> > const&, igl::SparseAssemblyData&, Eigen::SparseMatrix<double, 0, int>&);
 #endif
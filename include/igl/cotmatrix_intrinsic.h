@@ -8,6 +8,7 @@
 #ifndef IGL_COTMATRIX_INTRINSIC_H
 #define IGL_COTMATRIX_INTRINSIC_H
 #include "igl_inline.h"
+#include "sparse_assembly.h"
 
 #include <Eigen/Dense>
 #include <Eigen/Sparse>
@@ -29,6 +30,19 @@ namespace igl
     const Eigen::MatrixBase<Derivedl> & l, 
     const Eigen::MatrixBase<DerivedF> & F, 
     Eigen::SparseMatrix<Scalar>& L);
+  /// \overload
+  /// \brief Reuses the sparsity pattern of L across calls with the same F
+  /// (e.g., when only l changes).
+  ///
+  /// @param[in,out] data  sparsity pattern of L; (re)computed from F if
+  ///     empty or if the output size, #F, entries per element or the hash of
+  ///     F's indices differ from the stored ones
+  template <typename Derivedl, typename DerivedF, typename Scalar>
+  IGL_INLINE void cotmatrix_intrinsic(
+    const Eigen::MatrixBase<Derivedl> & l, 
+    const Eigen::MatrixBase<DerivedF> & F, 
+    SparseAssemblyData & data,
+    Eigen::SparseMatrix<Scalar>& L);
 }
 
 #ifndef IGL_STATIC_LIBRARY
@@ -7,6 +7,7 @@
 // obtain one at http://mozilla.org/MPL/2.0/.
 #include "decimate.h"
 #include "collapse_least_cost_edge.h"
+#include "batch_collapse_least_cost_edges.h"
 #include "edge_flaps.h"
 #include "decimate_trivial_callbacks.h"
 #include "AABB.h"
@@ -30,6 +31,20 @@ IGL_INLINE bool igl::decimate(
   Eigen::MatrixXi & G,
   Eigen::VectorXi & J,
   Eigen::VectorXi & I)
+{
+  return igl::decimate(V,F,max_m,block_intersections,false,U,G,J,I);
+}
+
+IGL_INLINE bool igl::decimate(
+  const Eigen::MatrixXd & V,
+  const Eigen::MatrixXi & F,
+  const int max_m,
+  const bool block_intersections,
+  const bool parallel,
+  Eigen::MatrixXd & U,
+  Eigen::MatrixXi & G,
+  Eigen::VectorXi & J,
+  Eigen::VectorXi & I)
 {
   igl::AABB<Eigen::MatrixXd, 3> * tree = nullptr;
   if(block_intersections)
@@ -78,6 +93,7 @@ IGL_INLINE bool igl::decimate(
     max_faces_stopping_condition(m,orig_m,max_m),
     pre_collapse,
     post_collapse,
+    parallel,
     U,
     G,
     J,
@@ -105,6 +121,25 @@ IGL_INLINE bool igl::decimate(
   Eigen::VectorXi & J,
   Eigen::VectorXi & I
   )
+{
+  return igl::decimate(
+    OV,OF,cost_and_placement,stopping_condition,pre_collapse,post_collapse,
+    false,U,G,J,I);
+}
+
+IGL_INLINE bool igl::decimate(
+  const Eigen::MatrixXd & OV,
+  const Eigen::MatrixXi & OF,
+  const decimate_cost_and_placement_callback & cost_and_placement,
+  const decimate_stopping_condition_callback & stopping_condition,
+  const decimate_pre_collapse_callback       & pre_collapse,
+  const decimate_post_collapse_callback      & post_collapse,
+  const bool parallel,
+  Eigen::MatrixXd & U,
+  Eigen::MatrixXi & G,
+  Eigen::VectorXi & J,
+  Eigen::VectorXi & I
+  )
 {
   // Decimate 1
   // Working copies
@@ -123,14 +158,12 @@ IGL_INLINE bool igl::decimate(
     }
   }
 
-  igl::min_heap<std::tuple<double,int,int> > Q;
-  // Could reserve with https://stackoverflow.com/a/29236236/148668
+  // Indexed by edge so that updated costs replace old ones in place: Q never
+  // holds more than #E entries
+  igl::IndexedHeap<double> Q(E.rows());
   Eigen::VectorXi EQ = Eigen::VectorXi::Zero(E.rows());
   // If an edge were collapsed, we'd collapse it to these points:
   Eigen::MatrixXd C(E.rows(),V.cols());
-  // Pushing into a vector then using constructor was slower. Maybe using
-  // std::move + make_heap would squeeze out something?
-  
   // Separating the cost/placement evaluation from the Q filling is a
   // performance hit for serial but faster if we can parallelize the
   // cost/placement.
@@ -154,7 +187,7 @@ IGL_INLINE bool igl::decimate(
     );
     for(int e = 0;e<E.rows();e++)
     {
-      Q.emplace(costs(e),e,0);
+      Q.update(e,costs(e));
     }
   }
 
@@ -162,34 +195,56 @@ IGL_INLINE bool igl::decimate(
   int prev_e = -1;
   bool clean_finish = false;
 
-  while(true)
+  if(parallel)
   {
-    int e,e1,e2,f1,f2;
-    if(collapse_least_cost_edge(
-      cost_and_placement, pre_collapse, post_collapse,
-      V,F,E,EMAP,EF,EI,Q,EQ,C,e,e1,e2,f1,f2))
+    while(true)
     {
-      if(stopping_condition(V,F,E,EMAP,EF,EI,Q,EQ,C,e,e1,e2,f1,f2))
+      bool stop;
+      const int num_attempted = batch_collapse_least_cost_edges(
+        cost_and_placement, pre_collapse, post_collapse, stopping_condition,
+        V,F,E,EMAP,EF,EI,Q,EQ,C,stop);
+      if(stop)
       {
         clean_finish = true;
         break;
       }
-    }else
-    {
-      if(e == -1)
+      if(num_attempted == 0)
       {
-        // a candidate edge was not even found in Q.
+        // no finite cost edges left in Q
         break;
       }
-      if(prev_e == e)
+    }
+  }else
+  {
+    while(true)
+    {
+      int e,e1,e2,f1,f2;
+      if(collapse_least_cost_edge(
+        cost_and_placement, pre_collapse, post_collapse,
+        V,F,E,EMAP,EF,EI,Q,EQ,C,e,e1,e2,f1,f2))
       {
-        assert(false && "Edge collapse no progress... bad stopping condition?");
-        break;
+        if(stopping_condition(V,F,E,EMAP,EF,EI,Q,EQ,C,e,e1,e2,f1,f2))
+        {
+          clean_finish = true;
+          break;
+        }
+      }else
+      {
+        if(e == -1)
+        {
+          // a candidate edge was not even found in Q.
+          break;
+        }
+        if(prev_e == e)
+        {
+          assert(false && "Edge collapse no progress... bad stopping condition?");
+          break;
+        }
+        // Edge was not collapsed... must have been invalid. collapse_edge should
+        // have updated its cost to inf... continue
       }
-      // Edge was not collapsed... must have been invalid. collapse_edge should
-      // have updated its cost to inf... continue
+      prev_e = e;
     }
-    prev_e = e;
   }
   // remove all IGL_COLLAPSE_EDGE_NULL faces
   Eigen::MatrixXi F2(F.rows(),3);
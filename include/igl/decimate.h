@@ -68,8 +68,13 @@
 /// queue-processing ends (e.g., if the number of remaining faces is below a
 /// user’s threshold).
 ///
+/// In parallel mode, each round instead pops a batch of the cheapest edges,
+/// keeps those whose one-rings do not overlap, collapses them in order of cost
+/// and then recomputes all affected costs in parallel.
+///
 /// \see
 ///   collapse_least_cost_edge
+///   batch_collapse_least_cost_edges
 ///   collapse_edge
 ///   qslim
 
@@ -100,6 +105,22 @@ namespace igl
     Eigen::MatrixXi & G,
     Eigen::VectorXi & J,
     Eigen::VectorXi & I);
+  /// \overload
+  ///
+  /// @param[in] parallel  whether to collapse edges in rounds of independent
+  ///   collapses, recomputing costs in parallel (see
+  ///   batch_collapse_least_cost_edges). The result is close to but not the
+  ///   same as the serial greedy order.
+  IGL_INLINE bool decimate(
+    const Eigen::MatrixXd & V,
+    const Eigen::MatrixXi & F,
+    const int max_m,
+    const bool block_intersections,
+    const bool parallel,
+    Eigen::MatrixXd & U,
+    Eigen::MatrixXi & G,
+    Eigen::VectorXi & J,
+    Eigen::VectorXi & I);
 
   /// Collapses edges of a **closed manifold mesh** (V,F) using user defined
   /// callbacks in a priority queue. Functions control the cost and placement of each collapse the
@@ -146,6 +167,24 @@ namespace igl
     Eigen::MatrixXi & G,
     Eigen::VectorXi & J,
     Eigen::VectorXi & I);
+  /// \overload
+  ///
+  /// @param[in] parallel  whether to collapse edges in rounds of independent
+  ///   collapses (see batch_collapse_least_cost_edges). Callbacks are still
+  ///   called one collapse at a time, but cost_and_placement will be called
+  ///   concurrently.
+  IGL_INLINE bool decimate(
+    const Eigen::MatrixXd & V,
+    const Eigen::MatrixXi & F,
+    const decimate_cost_and_placement_callback & cost_and_placement,
+    const decimate_stopping_condition_callback & stopping_condition,
+    const decimate_pre_collapse_callback       & pre_collapse,
+    const decimate_post_collapse_callback      & post_collapse,
+    const bool parallel,
+    Eigen::MatrixXd & U,
+    Eigen::MatrixXi & G,
+    Eigen::VectorXi & J,
+    Eigen::VectorXi & I);
 }
 
 #ifndef IGL_STATIC_LIBRARY
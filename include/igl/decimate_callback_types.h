@@ -8,7 +8,7 @@
 #ifndef IGL_DECIMATE_CALLBACK_TYPES_H
 #define IGL_DECIMATE_CALLBACK_TYPES_H
 #include <Eigen/Core>
-#include "min_heap.h"
+#include "IndexedHeap.h"
 /// @file decimate_callback_types.h
 ///
 /// See decimate.h for more details.
@@ -59,8 +59,10 @@ namespace igl
   ///     F(f,:) opposite the vth corner, where EI(e,0)=v. Similarly EF(e,1) "
   ///     e=(j->i)
   /// @param[in] EI  #E by 2 list of edge flap corners (see above).
-  /// @param[in] Q  queue containing pairs of costs and edge indices and insertion "time"
-  /// @param[in] EQ  #E list of "time" of last time pushed into Q
+  /// @param[in] Q  queue of costs keyed by edge index (collapsed edges are
+  ///   removed)
+  /// @param[in] EQ  #E list of number of times each edge's cost was updated
+  ///   (-1 for collapsed edges)
   /// @param[in] C  #E by dim list of stored placements
   /// @param[in] e  index into E of attempted collapsed edge. Set to -1 if Q is empty or
   ///               contains only infinite cost edges.
@@ -77,7 +79,7 @@ namespace igl
       const Eigen::VectorXi &                             ,/*EMAP*/
       const Eigen::MatrixXi &                             ,/*EF*/
       const Eigen::MatrixXi &                             ,/*EI*/
-      const igl::min_heap< std::tuple<double,int,int> > & ,/*Q*/
+      const igl::IndexedHeap<double> &                    ,/*Q*/
       const Eigen::VectorXi &                             ,/*EQ*/
       const Eigen::MatrixXd &                             ,/*C*/
       const int                                           ,/*e*/
@@ -101,8 +103,10 @@ namespace igl
   ///     F(f,:) opposite the vth corner, where EI(e,0)=v. Similarly EF(e,1)
   ///     e=(j->i)
   /// @param[in] EI  #E by 2 list of edge flap corners (see above).
-  /// @param[in] Q  queue containing pairs of costs and edge indices and insertion "time"
-  /// @param[in] EQ  #E list of "time" of last time pushed into Q
+  /// @param[in] Q  queue of costs keyed by edge index (collapsed edges are
+  ///   removed)
+  /// @param[in] EQ  #E list of number of times each edge's cost was updated
+  ///   (-1 for collapsed edges)
   /// @param[in] C  #E by dim list of stored placements
   /// @param[in] e  index into E of attempted collapsed edge. Set to -1 if Q is empty or
   ///               contains only infinite cost edges.
@@ -115,7 +119,7 @@ namespace igl
       const Eigen::VectorXi &                             ,/*EMAP*/
       const Eigen::MatrixXi &                             ,/*EF*/
       const Eigen::MatrixXi &                             ,/*EI*/
-      const igl::min_heap< std::tuple<double,int,int> > & ,/*Q*/
+      const igl::IndexedHeap<double> &                    ,/*Q*/
       const Eigen::VectorXi &                             ,/*EQ*/
       const Eigen::MatrixXd &                             ,/*C*/
       const int                                            /*e*/
@@ -134,8 +138,10 @@ namespace igl
   ///     F(f,:) opposite the vth corner, where EI(e,0)=v. Similarly EF(e,1)
   ///     e=(j->i)
   /// @param[in] EI  #E by 2 list of edge flap corners (see above).
-  /// @param[in] Q  queue containing pairs of costs and edge indices and insertion "time"
-  /// @param[in] EQ  #E list of "time" of last time pushed into Q
+  /// @param[in] Q  queue of costs keyed by edge index (collapsed edges are
+  ///   removed)
+  /// @param[in] EQ  #E list of number of times each edge's cost was updated
+  ///   (-1 for collapsed edges)
   /// @param[in] C  #E by dim list of stored placements
   /// @param[in] e  index into E of attempted collapsed edge. Set to -1 if Q is empty or
   ///               contains only infinite cost edges.
@@ -152,7 +158,7 @@ namespace igl
       const Eigen::VectorXi &                             ,/*EMAP*/
       const Eigen::MatrixXi &                             ,/*EF*/
       const Eigen::MatrixXi &                             ,/*EI*/
-      const igl::min_heap< std::tuple<double,int,int> > & ,/*Q*/
+      const igl::IndexedHeap<double> &                    ,/*Q*/
       const Eigen::VectorXi &                             ,/*EQ*/
       const Eigen::MatrixXd &                             ,/*C*/
       const int                                           ,/*e*/
@@ -6,6 +6,78 @@
 // v. 2.0. If a copy of the MPL was not distributed with this file, You can 
 // obtain one at http://mozilla.org/MPL/2.0/.
 #include "dijkstra.h"
+#include "parallel_for.h"
+#include <cassert>
+
+namespace igl
+{
+  namespace dijkstra_internal
+  {
+    // Settle vertices in order of (distance,index) until the queue is empty
+    // or a target is settled. relax(u,dist) updates the queue with the
+    // neighbors of u.
+    template <typename Scalar, typename IsTarget, typename Relax>
+    inline int run(
+      IndexedHeap<Scalar> & queue,
+      const IsTarget & is_target,
+      const Relax & relax)
+    {
+      while(!queue.empty())
+      {
+        const std::pair<Scalar,int> top = queue.pop();
+        if(is_target(top.second))
+        {
+          return top.second;
+        }
+        relax(top.second,top.first);
+      }
+      return -1;
+    }
+
+    // Seed all sources at distance 0 (ws must be reset) and run on the
+    // columns of A
+    template <typename Scalar, typename DerivedS, typename IsTarget>
+    inline int run(
+      const Eigen::SparseMatrix<Scalar> & A,
+      const Eigen::MatrixBase<DerivedS> & S,
+      const Scalar max_distance,
+      const IsTarget & is_target,
+      DijkstraWorkspace<Scalar> & ws)
+    {
+      const Scalar inf = std::numeric_limits<Scalar>::infinity();
+      for(Eigen::Index i = 0;i<S.size();i++)
+      {
+        const int s = int(S(i));
+        assert(s >= 0 && s < A.cols());
+        if(ws.distance(s) == inf)
+        {
+          ws.reached.push_back(s);
+          ws.distance(s) = 0;
+          ws.queue.update(s,0);
+        }
+      }
+      return run(ws.queue,is_target,[&](const int u,const Scalar dist)
+      {
+        for(typename Eigen::SparseMatrix<Scalar>::InnerIterator it(A,u);it;++it)
+        {
+          const int v = int(it.row());
+          const Scalar distance_through_u = dist + it.value();
+          if(distance_through_u < ws.distance(v) &&
+            distance_through_u <= max_distance)
+          {
+            if(ws.distance(v) == inf)
+            {
+              ws.reached.push_back(v);
+            }
+            ws.distance(v) = distance_through_u;
+            ws.previous(v) = u;
+            ws.queue.update(v,distance_through_u);
+          }
+        }
+      });
+    }
+  }
+}
 
 template <typename IndexType, typename DerivedD, typename DerivedP>
 IGL_INLINE int igl::dijkstra(
@@ -16,43 +88,30 @@ IGL_INLINE int igl::dijkstra(
   Eigen::PlainObjectBase<DerivedD> &min_distance,
   Eigen::PlainObjectBase<DerivedP> &previous)
 {
+  typedef typename DerivedD::Scalar Scalar;
   int numV = VV.size();
-  min_distance.setConstant(numV, 1, std::numeric_limits<typename DerivedD::Scalar>::max());
+  min_distance.setConstant(numV, 1, std::numeric_limits<Scalar>::max());
   min_distance[source] = 0;
   previous.setConstant(numV, 1, -1);
-  std::set<std::pair<typename DerivedD::Scalar, IndexType> > vertex_queue;
-  vertex_queue.insert(std::make_pair(min_distance[source], source));
-
-  while (!vertex_queue.empty())
-  {
-    typename DerivedD::Scalar dist = vertex_queue.begin()->first;
-    IndexType u = vertex_queue.begin()->second;
-    vertex_queue.erase(vertex_queue.begin());
-
-    if (targets.find(u)!= targets.end())
-      return u;
-
-    // Visit each edge exiting u
-    const std::vector<IndexType> &neighbors = VV[u];
-    for (typename std::vector<IndexType>::const_iterator neighbor_iter = neighbors.begin();
-         neighbor_iter != neighbors.end();
-         neighbor_iter++)
+  IndexedHeap<Scalar> vertex_queue(numV);
+  vertex_queue.update(source, min_distance[source]);
+  return dijkstra_internal::run(
+    vertex_queue,
+    [&targets](const int u){ return targets.find(u) != targets.end(); },
+    [&](const int u, const Scalar dist)
     {
-      IndexType v = *neighbor_iter;
-      typename DerivedD::Scalar distance_through_u = dist + weights[u];
-      if (distance_through_u < min_distance[v]) {
-        vertex_queue.erase(std::make_pair(min_distance[v], v));
-
-        min_distance[v] = distance_through_u;
-        previous[v] = u;
-        vertex_queue.insert(std::make_pair(min_distance[v], v));
-
+      // Visit each edge exiting u
+      for (const IndexType v : VV[u])
+      {
+        Scalar distance_through_u = dist + weights[u];
+        if (distance_through_u < min_distance[v])
+        {
+          min_distance[v] = distance_through_u;
+          previous[v] = u;
+          vertex_queue.update(v, distance_through_u);
+        }
       }
-
-    }
-  }
-  //we should never get here
-  return -1;
+    });
 }
 
 template <typename IndexType, typename DerivedD, typename DerivedP>
@@ -90,43 +149,90 @@ IGL_INLINE int igl::dijkstra(
   Eigen::PlainObjectBase<DerivedD> &min_distance,
   Eigen::PlainObjectBase<DerivedP> &previous)
 {
+  typedef typename DerivedD::Scalar Scalar;
   int numV = VV.size();
 
-  min_distance.setConstant(numV, 1, std::numeric_limits<typename DerivedD::Scalar>::infinity());
+  min_distance.setConstant(numV, 1, std::numeric_limits<Scalar>::infinity());
   min_distance[source] = 0;
   previous.setConstant(numV, 1, -1);
-  std::set<std::pair<typename DerivedD::Scalar, IndexType> > vertex_queue;
-  vertex_queue.insert(std::make_pair(min_distance[source], source));
+  IndexedHeap<Scalar> vertex_queue(numV);
+  vertex_queue.update(source, min_distance[source]);
+  return dijkstra_internal::run(
+    vertex_queue,
+    [&targets](const int u){ return targets.find(u) != targets.end(); },
+    [&](const int u, const Scalar dist)
+    {
+      // Visit each edge exiting u
+      for (const IndexType v : VV[u])
+      {
+        Scalar distance_through_u = dist + (V.row(u) - V.row(v)).norm();
+        if (distance_through_u < min_distance[v])
+        {
+          min_distance[v] = distance_through_u;
+          previous[v] = u;
+          vertex_queue.update(v, distance_through_u);
+        }
+      }
+    });
+}
 
-  while (!vertex_queue.empty())
-  {
-    typename DerivedD::Scalar dist = vertex_queue.begin()->first;
-    IndexType u = vertex_queue.begin()->second;
-    vertex_queue.erase(vertex_queue.begin());
+template <typename Scalar, typename DerivedS>
+IGL_INLINE void igl::dijkstra(
+  const Eigen::SparseMatrix<Scalar> & A,
+  const Eigen::MatrixBase<DerivedS> & S,
+  const Scalar max_distance,
+  DijkstraWorkspace<Scalar> & ws)
+{
+  assert(A.rows() == A.cols());
+  ws.reset(A.cols());
+  dijkstra_internal::run(
+    A,S,max_distance,[](const int){ return false; },ws);
+}
 
-    if (targets.find(u)!= targets.end())
-      return u;
+template <typename Scalar, typename DerivedS, typename DerivedT>
+IGL_INLINE int igl::dijkstra(
+  const Eigen::SparseMatrix<Scalar> & A,
+  const Eigen::MatrixBase<DerivedS> & S,
+  const Eigen::MatrixBase<DerivedT> & T,
+  const Scalar max_distance,
+  DijkstraWorkspace<Scalar> & ws)
+{
+  assert(A.rows() == A.cols());
+  ws.reset(A.cols());
+  for(Eigen::Index i = 0;i<T.size();i++) { ws.is_target[T(i)] = 1; }
+  const int target = dijkstra_internal::run(
+    A,S,max_distance,[&ws](const int u){ return ws.is_target[u] != 0; },ws);
+  for(Eigen::Index i = 0;i<T.size();i++) { ws.is_target[T(i)] = 0; }
+  return target;
+}
 
-    // Visit each edge exiting u
-    const std::vector<IndexType> &neighbors = VV[u];
-    for (typename std::vector<IndexType>::const_iterator neighbor_iter = neighbors.begin();
-         neighbor_iter != neighbors.end();
-         neighbor_iter++)
+template <typename Scalar, typename DerivedS, typename DerivedD>
+IGL_INLINE void igl::dijkstra(
+  const Eigen::SparseMatrix<Scalar> & A,
+  const Eigen::MatrixBase<DerivedS> & S,
+  const Scalar max_distance,
+  Eigen::PlainObjectBase<DerivedD> & D)
+{
+  assert(A.rows() == A.cols());
+  D.setConstant(
+    A.cols(),S.size(),std::numeric_limits<typename DerivedD::Scalar>::infinity());
+  std::vector<DijkstraWorkspace<Scalar> > workspaces;
+  igl::parallel_for(
+    S.size(),
+    [&workspaces](const size_t n){ workspaces.resize(n); },
+    [&](const Eigen::Index s, const size_t t)
     {
-      IndexType v = *neighbor_iter;
-      typename DerivedD::Scalar distance_through_u = dist + (V.row(u) - V.row(v)).norm();
-      if (distance_through_u < min_distance[v]) {
-        vertex_queue.erase(std::make_pair(min_distance[v], v));
-
-        min_distance[v] = distance_through_u;
-        previous[v] = u;
-        vertex_queue.insert(std::make_pair(min_distance[v], v));
-
+      DijkstraWorkspace<Scalar> & ws = workspaces[t];
+      ws.reset(A.cols());
+      dijkstra_internal::run(
+        A,S.segment(s,1),max_distance,[](const int){ return false; },ws);
+      for(const int v : ws.reached)
+      {
+        D(v,s) = ws.distance(v);
       }
-
-    }
-  }
-  return -1;
+    },
+    [](const size_t){},
+    1);
 }
 
 #ifdef IGL_STATIC_LIBRARY
@@ -135,4 +241,7 @@ template int igl::dijkstra<int, Eigen::Matrix<double, -1, 1, 0, -1, 1>, Eigen::M
 template int igl::dijkstra<int, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, 1, 0, -1, 1> >(int const&, std::set<int, std::less<int>, std::allocator<int> > const&, std::vector<std::vector<int, std::allocator<int> >, std::allocator<std::vector<int, std::allocator<int> > > > const&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&);
 template void igl::dijkstra<int, Eigen::Matrix<int, -1, 1, 0, -1, 1> >(int const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> > const&, std::vector<int, std::allocator<int> >&);
 template int igl::dijkstra<int, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, 1, 0, -1, 1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, std::vector<std::vector<int, std::allocator<int> >, std::allocator<std::vector<int, std::allocator<int> > > > const&, int const&, std::set<int, std::less<int>, std::allocator<int> > const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&);
+template void igl::dijkstra<double, Eigen::Matrix<int, -1, 1, 0, -1, 1> >(Eigen::SparseMatrix<double, 0, int> const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> > const&, double, igl::DijkstraWorkspace<double>&);
+template int igl::dijkstra<double, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, 1, 0, -1, 1> >(Eigen::SparseMatrix<double, 0, int> const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> > const&, double, igl::DijkstraWorkspace<double>&);
+template void igl::dijkstra<double, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, -1, 0, -1, -1> >(Eigen::SparseMatrix<double, 0, int> const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> > const&, double, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&);
 #endif
@@ -9,13 +9,60 @@
 #ifndef IGL_DIJKSTRA
 #define IGL_DIJKSTRA
 #include "igl_inline.h"
+#include "IndexedHeap.h"
 
 #include <Eigen/Core>
+#include <Eigen/Sparse>
+#include <limits>
 #include <vector>
 #include <set>
 
 namespace igl {
 
+  /// Reusable state of igl::dijkstra on a weighted adjacency matrix. Keeping a
+  /// workspace alive across queries on the same graph avoids all allocation,
+  /// and only the vertices reached by the previous query are reset.
+  ///
+  /// @tparam Scalar  type of edge weights and distances
+  ///
+  /// \see dijkstra
+  template <typename Scalar>
+  struct DijkstraWorkspace
+  {
+    /// #V list of distances to the nearest source (infinity if unreached)
+    Eigen::Matrix<Scalar,Eigen::Dynamic,1> distance;
+    /// #V list of previous vertex on a shortest path (-1 for sources and
+    /// unreached vertices)
+    Eigen::VectorXi previous;
+    /// list of vertices with finite distance, in the order they were reached
+    std::vector<int> reached;
+    /// priority queue of tentative distances
+    IndexedHeap<Scalar> queue;
+    /// #V list of flags marking the current targets
+    std::vector<char> is_target;
+    /// Prepare for a query on a graph with n vertices. Resets only the
+    /// vertices reached by the previous query if n is unchanged.
+    void reset(const int n)
+    {
+      if(distance.size() != n)
+      {
+        distance.setConstant(n,std::numeric_limits<Scalar>::infinity());
+        previous.setConstant(n,-1);
+        is_target.assign(n,0);
+        queue.resize(n);
+        reached.clear();
+        return;
+      }
+      for(const int v : reached)
+      {
+        distance(v) = std::numeric_limits<Scalar>::infinity();
+        previous(v) = -1;
+      }
+      reached.clear();
+      queue.clear();
+    }
+  };
+
   /// Dijkstra's algorithm for vertex-weighted shortest paths, with multiple targets.
   /// Adapted from http://rosettacode.org/wiki/Dijkstra%27s_algorithm .
   ///
@@ -53,6 +100,74 @@ namespace igl {
     const std::vector<std::vector<IndexType> >& VV,
     Eigen::PlainObjectBase<DerivedD> &min_distance,
     Eigen::PlainObjectBase<DerivedP> &previous);
+  /// Dijkstra's algorithm for edge-weighted shortest paths from multiple
+  /// sources on a graph given by its (compressed column) adjacency matrix,
+  /// using an indexed 4-ary heap as priority queue. Results are left in the
+  /// workspace, which can be reused for further queries without allocation.
+  ///
+  /// @param[in] A  #V by #V sparse matrix so that A(v,u) is the (non-negative)
+  ///   length of edge u→v (column u lists the edges leaving u); symmetric for
+  ///   undirected graphs
+  /// @param[in] S  #S list of source vertices, all seeded at distance 0
+  /// @param[in] max_distance  vertices farther than this from all sources are
+  ///   left unreached (use infinity for no bound)
+  /// @param[in,out] ws  workspace, on output ws.distance, ws.previous and
+  ///   ws.reached describe the shortest path forest
+  ///
+  /// #### Example:
+  ///
+  /// \code{cpp}
+  ///     // Edge lengths as adjacency matrix
+  ///     Eigen::MatrixXi E;
+  ///     igl::edges(F,E);
+  ///     std::vector<Eigen::Triplet<double> > IJV;
+  ///     for(int e = 0;e<E.rows();e++)
+  ///     {
+  ///       const double l = (V.row(E(e,0))-V.row(E(e,1))).norm();
+  ///       IJV.emplace_back(E(e,0),E(e,1),l);
+  ///       IJV.emplace_back(E(e,1),E(e,0),l);
+  ///     }
+  ///     Eigen::SparseMatrix<double> A(V.rows(),V.rows());
+  ///     A.setFromTriplets(IJV.begin(),IJV.end());
+  ///     igl::DijkstraWorkspace<double> ws;
+  ///     for(const int s : sources)
+  ///     {
+  ///       igl::dijkstra(A,Eigen::VectorXi::Constant(1,s),radius,ws);
+  ///       for(const int v : ws.reached) { ... ws.distance(v) ... }
+  ///     }
+  /// \endcode
+  template <typename Scalar, typename DerivedS>
+  IGL_INLINE void dijkstra(
+    const Eigen::SparseMatrix<Scalar> & A,
+    const Eigen::MatrixBase<DerivedS> & S,
+    const Scalar max_distance,
+    DijkstraWorkspace<Scalar> & ws);
+  /// \overload
+  ///
+  /// @param[in] T  #T list of target vertices, the search stops as soon as the
+  ///   shortest distance to one of them is known
+  /// @return first target reached or -1 if none is within max_distance
+  template <typename Scalar, typename DerivedS, typename DerivedT>
+  IGL_INLINE int dijkstra(
+    const Eigen::SparseMatrix<Scalar> & A,
+    const Eigen::MatrixBase<DerivedS> & S,
+    const Eigen::MatrixBase<DerivedT> & T,
+    const Scalar max_distance,
+    DijkstraWorkspace<Scalar> & ws);
+  /// Independent single-source Dijkstra queries, run in parallel with one
+  /// workspace per thread.
+  ///
+  /// @param[in] A  #V by #V adjacency matrix of edge lengths (see above)
+  /// @param[in] S  #S list of source vertices
+  /// @param[in] max_distance  bound on distances (use infinity for no bound)
+  /// @param[out] D  #V by #S matrix so that D(v,s) is the distance from S(s)
+  ///   to v (infinity if farther than max_distance)
+  template <typename Scalar, typename DerivedS, typename DerivedD>
+  IGL_INLINE void dijkstra(
+    const Eigen::SparseMatrix<Scalar> & A,
+    const Eigen::MatrixBase<DerivedS> & S,
+    const Scalar max_distance,
+    Eigen::PlainObjectBase<DerivedD> & D);
   /// Backtracking after Dijkstra's algorithm, to find shortest path.
   ///
   /// @param[in] vertex           vertex to which we want the shortest path (from same source as above)
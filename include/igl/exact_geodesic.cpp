@@ -15,11 +15,13 @@
 #include "PI.h"
 #include <algorithm>
 #include "IGL_ASSERT.h"
+#include "parallel_for.h"
 #include <cmath>
 #include <cstddef>
 #include <ctime>
 #include <fstream>
 #include <iostream>
+#include <numeric>
 #include <set>
 #include <vector>
 #include <memory>
@@ -158,10 +160,11 @@ public:
 
 	~MemoryAllocator(){};
 
-	void clear()
+	void clear()		//forget all allocations but keep the blocks for reuse
 	{
-		reset(m_block_size,
-			  m_max_number_of_blocks);
+		m_current_block = 0;
+		m_current_position = 0;
+		m_deleted.clear();
 	}
 
 	void reset(unsigned block_size,
@@ -173,6 +176,7 @@ public:
 		assert(m_block_size > 0);
 		assert(m_max_number_of_blocks > 0);
 
+		m_current_block = 0;
 		m_current_position = 0;
 
 		m_storage.reserve(max_number_of_blocks);
@@ -190,11 +194,14 @@ public:
 		{
 			if(m_current_position + 1 >= m_block_size)
 			{
-				m_storage.push_back( std::vector<T>() );
-				m_storage.back().resize(m_block_size);
+				if(++m_current_block == m_storage.size())
+				{
+					m_storage.push_back( std::vector<T>() );
+					m_storage.back().resize(m_block_size);
+				}
 				m_current_position = 0;
 			}
-			result = & m_storage.back()[m_current_position];
+			result = & m_storage[m_current_block][m_current_position];
 			++m_current_position;
 		}
 		else
@@ -218,6 +225,7 @@ private:
 	std::vector<std::vector<T> > m_storage;
 	unsigned m_block_size;				//size of a single block
 	unsigned m_max_number_of_blocks;		//maximum allowed number of blocks
+	unsigned m_current_block;			//block currently being filled
 	unsigned m_current_position;			//first unused element inside the current block
 
 	std::vector<pointer> m_deleted;			//pointers to deleted elemets
@@ -1819,6 +1827,8 @@ public:
 
 	void print_statistics();
 
+	unsigned iterations(){return m_iterations;};		//number of interval propagations in the last propagation step
+
 private:
 	typedef std::set<interval_pointer, Interval> IntervalQueue;
 
@@ -2457,12 +2467,16 @@ inline void GeodesicAlgorithmExact::propagate(std::vector<SurfacePoint>& sources
 inline bool GeodesicAlgorithmExact::check_stop_conditions(unsigned& index)
 {
 	double queue_distance = (*m_queue.begin())->min();
-	if(queue_distance < stop_distance())
+	if(queue_distance >= stop_distance())		//everything closer than the stop distance is final
+	{
+		return true;
+	}
+	if(m_stop_vertices.empty())
 	{
 		return false;
 	}
 
-	while(index < m_stop_vertices.size())
+	while(index < m_stop_vertices.size())		//stop once all the stop points are covered
 	{
 		vertex_pointer v = m_stop_vertices[index].first;
 		edge_pointer edge = v->adjacent_edges()[0];				//take any edge
@@ -3237,6 +3251,155 @@ IGL_INLINE void igl::exact_geodesic(
   }
 }
 
+template <typename DerivedV, typename DerivedF>
+IGL_INLINE igl::ExactGeodesicSolver::ExactGeodesicSolver(
+  const Eigen::MatrixBase<DerivedV> &V,
+  const Eigen::MatrixBase<DerivedF> &F):
+  mesh(new igl::geodesic::Mesh())
+{
+  assert((V.cols() == 3 || V.cols() == 2) && F.cols() == 3 && "Only support 2D/3D triangle mesh");
+  std::vector<typename DerivedV::Scalar> points(V.rows() * 3);
+  std::vector<typename DerivedF::Scalar> faces(F.rows() * F.cols());
+  for (size_t i = 0; i < points.size(); i++)
+  {
+    // Append 0s for 2D input
+    points[i] = ((i%3)<2 || V.cols()==3) ? V(i / 3, i % 3) : 0.0;
+  }
+  for (size_t i = 0; i < faces.size(); i++)
+  {
+    faces[i] = F(i / 3, i % 3);
+  }
+  mesh->initialize_mesh_data(points, faces);
+}
+
+IGL_INLINE igl::ExactGeodesicSolver::ExactGeodesicSolver(
+  ExactGeodesicSolver &&) = default;
+
+IGL_INLINE igl::ExactGeodesicSolver & igl::ExactGeodesicSolver::operator=(
+  ExactGeodesicSolver &&) = default;
+
+IGL_INLINE igl::ExactGeodesicSolver::~ExactGeodesicSolver() = default;
+
+template <typename DerivedX>
+IGL_INLINE std::vector<int> igl::ExactGeodesicSolver::to_vector(
+  const Eigen::MatrixBase<DerivedX> &X)
+{
+  std::vector<int> x;
+  x.reserve(X.size());
+  for(int i = 0;i < X.rows(); i++)
+  {
+    for(int j = 0;j < X.cols(); j++)
+    {
+      x.push_back(X(i, j));
+    }
+  }
+  return x;
+}
+
+template <
+  typename DerivedVS,
+  typename DerivedFS,
+  typename DerivedVT,
+  typename DerivedFT,
+  typename DerivedD>
+IGL_INLINE void igl::ExactGeodesicSolver::solve(
+  const Eigen::MatrixBase<DerivedVS> &VS,
+  const Eigen::MatrixBase<DerivedFS> &FS,
+  const Eigen::MatrixBase<DerivedVT> &VT,
+  const Eigen::MatrixBase<DerivedFT> &FT,
+  Eigen::PlainObjectBase<DerivedD> &D,
+  const double stop_distance)
+{
+  const std::vector<int> vt = to_vector(VT);
+  const std::vector<int> ft = to_vector(FT);
+  if(workspaces.empty())
+  {
+    workspaces.emplace_back(new igl::geodesic::GeodesicAlgorithmExact(mesh.get()));
+  }
+  Eigen::VectorXd Dd(vt.size() + ft.size());
+  last_num_iterations = solve_one(
+    to_vector(VS),to_vector(FS),vt,ft,stop_distance,*workspaces[0],Dd.data());
+  D = Dd.cast<typename DerivedD::Scalar>();
+}
+
+template <
+  typename DerivedVT,
+  typename DerivedFT,
+  typename DerivedD>
+IGL_INLINE void igl::ExactGeodesicSolver::solve(
+  const std::vector<std::vector<int> > &VS,
+  const std::vector<std::vector<int> > &FS,
+  const Eigen::MatrixBase<DerivedVT> &VT,
+  const Eigen::MatrixBase<DerivedFT> &FT,
+  Eigen::PlainObjectBase<DerivedD> &D,
+  const double stop_distance)
+{
+  assert((FS.empty() || FS.size() == VS.size()) && "FS should match VS or be empty");
+  const std::vector<int> vt = to_vector(VT);
+  const std::vector<int> ft = to_vector(FT);
+  const std::vector<int> no_sources;
+  Eigen::MatrixXd Dd(vt.size() + ft.size(), VS.size());
+  std::vector<std::size_t> iterations(VS.size());
+  igl::parallel_for(
+    VS.size(),
+    [&](const size_t nthreads)
+    {
+      // One workspace per thread, kept for later calls
+      while(workspaces.size() < nthreads)
+      {
+        workspaces.emplace_back(
+          new igl::geodesic::GeodesicAlgorithmExact(mesh.get()));
+      }
+    },
+    [&](const int j, const size_t t)
+    {
+      iterations[j] = solve_one(
+        VS[j],FS.empty() ? no_sources : FS[j],vt,ft,stop_distance,
+        *workspaces[t],Dd.col(j).data());
+    },
+    [](const size_t){},
+    1);
+  last_num_iterations =
+    std::accumulate(iterations.begin(),iterations.end(),std::size_t(0));
+  D = Dd.cast<typename DerivedD::Scalar>();
+}
+
+IGL_INLINE std::size_t igl::ExactGeodesicSolver::solve_one(
+  const std::vector<int> &VS,
+  const std::vector<int> &FS,
+  const std::vector<int> &VT,
+  const std::vector<int> &FT,
+  const double stop_distance,
+  igl::geodesic::GeodesicAlgorithmExact &w,
+  double * D) const
+{
+  std::vector<igl::geodesic::SurfacePoint> source;
+  source.reserve(VS.size() + FS.size());
+  for(const int v : VS) { source.emplace_back(&mesh->vertices()[v]); }
+  for(const int f : FS) { source.emplace_back(&mesh->faces()[f]); }
+  std::vector<igl::geodesic::SurfacePoint> target;
+  target.reserve(VT.size() + FT.size());
+  for(const int v : VT) { target.emplace_back(&mesh->vertices()[v]); }
+  for(const int f : FT) { target.emplace_back(&mesh->faces()[f]); }
+
+  // Propagation stops beyond stop_distance or as soon as the distances to
+  // all targets are final, whichever comes first
+  w.propagate(
+    source,std::min(stop_distance,igl::geodesic::GEODESIC_INF),&target);
+  for (size_t i = 0; i < target.size(); i++)
+  {
+    double d;
+    w.best_source(target[i], d);
+    // Targets beyond the stop distance may hold partial estimates
+    D[i] = (d >= igl::geodesic::GEODESIC_INF || d > stop_distance) ?
+      std::numeric_limits<double>::infinity() : d;
+  }
+  return w.iterations();
+}
+
 #ifdef IGL_STATIC_LIBRARY
 template void igl::exact_geodesic<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, 1, 0, -1, 1>>(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1>> const &, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1>> const &, Eigen::MatrixBase<Eigen::Matrix<int, -1, 1, 0, -1, 1>> const &, Eigen::MatrixBase<Eigen::Matrix<int, -1, 1, 0, -1, 1>> const &, Eigen::MatrixBase<Eigen::Matrix<int, -1, 1, 0, -1, 1>> const &, Eigen::MatrixBase<Eigen::Matrix<int, -1, 1, 0, -1, 1>> const &, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 1, 0, -1, 1>> &);
+template igl::ExactGeodesicSolver::ExactGeodesicSolver<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&);
+template void igl::ExactGeodesicSolver::solve<Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, 1, 0, -1, 1> >(Eigen::MatrixBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> >&, double);
+template void igl::ExactGeodesicSolver::solve<Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, -1, 0, -1, -1> >(std::vector<std::vector<int, std::allocator<int> >, std::allocator<std::vector<int, std::allocator<int> > > > const&, std::vector<std::vector<int, std::allocator<int> >, std::allocator<std::vector<int, std::allocator<int> > > > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&, double);
 #endif
@@ -11,9 +11,18 @@
 
 #include "igl_inline.h"
 #include <Eigen/Core>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <vector>
 
 namespace igl 
 {
+  namespace geodesic
+  {
+    class Mesh;
+    class GeodesicAlgorithmExact;
+  }
   /// Exact geodesic algorithm for triangular mesh with the implementation from https://code.google.com/archive/p/geodesic/, 
   /// and the algorithm first described by Mitchell, Mount and Papadimitriou in 1987
   ///
@@ -43,6 +52,105 @@ namespace igl
       const Eigen::MatrixBase<DerivedVT> &VT,
       const Eigen::MatrixBase<DerivedFT> &FT,
       Eigen::PlainObjectBase<DerivedD> &D);
+  /// Reusable exact geodesic distance solver (same algorithm as
+  /// exact_geodesic) for many queries against the same mesh.
+  ///
+  /// The internal mesh structure is built once at construction. Each
+  /// workspace (one per thread for batches) keeps its interval lists and
+  /// interval memory pool between queries.
+  ///
+  /// #### Example:
+  ///     igl::ExactGeodesicSolver solver(V,F);
+  ///     // distances from vertex 0 to all vertices
+  ///     solver.solve(VS,FS,VT,FT,D);
+  ///     // distances from each source set, up to 0.5
+  ///     solver.solve(VS_batch,FS_batch,VT,FT,D_batch,0.5);
+  ///
+  /// \see exact_geodesic
+  class ExactGeodesicSolver
+  {
+  public:
+    /// @param[in] V  #V by 3 list of 3D vertex positions
+    /// @param[in] F  #F by 3 list of mesh faces
+    template <typename DerivedV, typename DerivedF>
+    IGL_INLINE ExactGeodesicSolver(
+      const Eigen::MatrixBase<DerivedV> &V,
+      const Eigen::MatrixBase<DerivedF> &F);
+    IGL_INLINE ExactGeodesicSolver(ExactGeodesicSolver &&);
+    IGL_INLINE ExactGeodesicSolver & operator=(ExactGeodesicSolver &&);
+    ExactGeodesicSolver(const ExactGeodesicSolver &) = delete;
+    ExactGeodesicSolver & operator=(const ExactGeodesicSolver &) = delete;
+    IGL_INLINE ~ExactGeodesicSolver();
+    /// Geodesic distances from one source set.
+    ///
+    /// @param[in] VS #VS by 1 vector specifying indices of source vertices
+    /// @param[in] FS #FS by 1 vector specifying indices of source faces
+    /// @param[in] VT #VT by 1 vector specifying indices of target vertices
+    /// @param[in] FT #FT by 1 vector specifying indices of target faces
+    /// @param[out] D  #VT+#FT by 1 vector of geodesic distances of each
+    ///   target w.r.t. the nearest one in the source set (infinity if
+    ///   farther than stop_distance)
+    /// @param[in] stop_distance  propagation stops beyond this distance (it
+    ///   also stops as soon as the distances to all targets are final)
+    template <
+      typename DerivedVS,
+      typename DerivedFS,
+      typename DerivedVT,
+      typename DerivedFT,
+      typename DerivedD>
+    IGL_INLINE void solve(
+      const Eigen::MatrixBase<DerivedVS> &VS,
+      const Eigen::MatrixBase<DerivedFS> &FS,
+      const Eigen::MatrixBase<DerivedVT> &VT,
+      const Eigen::MatrixBase<DerivedFT> &FT,
+      Eigen::PlainObjectBase<DerivedD> &D,
+      const double stop_distance = std::numeric_limits<double>::infinity());
+    /// Geodesic distances from many independent source sets, solved in
+    /// parallel.
+    ///
+    /// @param[in] VS  #sets list of lists of indices of source vertices
+    /// @param[in] FS  #sets list of lists of indices of source faces (or
+    ///   empty if there are no face sources)
+    /// @param[in] VT #VT by 1 vector specifying indices of target vertices
+    /// @param[in] FT #FT by 1 vector specifying indices of target faces
+    /// @param[out] D  #VT+#FT by #sets matrix of geodesic distances, column j
+    ///   w.r.t. source set j (infinity if farther than stop_distance)
+    /// @param[in] stop_distance  propagation stops beyond this distance (it
+    ///   also stops as soon as the distances to all targets are final)
+    template <
+      typename DerivedVT,
+      typename DerivedFT,
+      typename DerivedD>
+    IGL_INLINE void solve(
+      const std::vector<std::vector<int> > &VS,
+      const std::vector<std::vector<int> > &FS,
+      const Eigen::MatrixBase<DerivedVT> &VT,
+      const Eigen::MatrixBase<DerivedFT> &FT,
+      Eigen::PlainObjectBase<DerivedD> &D,
+      const double stop_distance = std::numeric_limits<double>::infinity());
+    /// @return number of interval propagations performed by the last call to
+    ///   solve (summed over source sets)
+    std::size_t num_iterations() const { return last_num_iterations; }
+  private:
+    /// Row-major copy of a matrix of indices
+    template <typename DerivedX>
+    IGL_INLINE static std::vector<int> to_vector(
+      const Eigen::MatrixBase<DerivedX> &X);
+    /// Distances from sources to targets using workspace w
+    ///
+    /// @return number of interval propagations
+    IGL_INLINE std::size_t solve_one(
+      const std::vector<int> &VS,
+      const std::vector<int> &FS,
+      const std::vector<int> &VT,
+      const std::vector<int> &FT,
+      const double stop_distance,
+      geodesic::GeodesicAlgorithmExact &w,
+      double * D) const;
+    std::unique_ptr<geodesic::Mesh> mesh;
+    std::vector<std::unique_ptr<geodesic::GeodesicAlgorithmExact> > workspaces;
+    std::size_t last_num_iterations = 0;
+  };
 }
 
 #ifndef IGL_STATIC_LIBRARY
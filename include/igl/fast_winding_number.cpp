@@ -379,12 +379,13 @@ IGL_INLINE void igl::fast_winding_number(
 
 template <
   typename DerivedV,
-  typename DerivedF>
+  typename DerivedF,
+  typename Scalar>
 IGL_INLINE void igl::fast_winding_number(
   const Eigen::MatrixBase<DerivedV> & V,
   const Eigen::MatrixBase<DerivedF> & F,
   const int order,
-  FastWindingNumberBVH & fwn_bvh)
+  FastWindingNumberBVHT<Scalar> & fwn_bvh)
 {
   assert(V.cols() == 3 && "V should be 3D");
   assert(F.cols() == 3 && "F should contain triangles");
@@ -415,11 +416,32 @@ IGL_INLINE void igl::fast_winding_number(
     order);
 }
 
+template <
+  typename DerivedV,
+  typename Scalar>
+IGL_INLINE void igl::fast_winding_number_refit(
+  const Eigen::MatrixBase<DerivedV> & V,
+  FastWindingNumberBVHT<Scalar> & fwn_bvh)
+{
+  assert(V.cols() == 3 && "V should be 3D");
+  assert(size_t(V.rows()) == fwn_bvh.U.size() && "V should have same #V as fwn_bvh");
+  // Overwrite in place so the solid angle tree's pointer stays valid
+  igl::parallel_for(V.rows(),[&](const int i)
+  {
+    for(int j = 0;j<3;j++)
+    {
+      fwn_bvh.U[i][j] = V(i,j);
+    }
+  },10000);
+  fwn_bvh.ut_solid_angle.refit(&fwn_bvh.U[0]);
+}
+
 template <
   typename DerivedQ,
-  typename DerivedW>
+  typename DerivedW,
+  typename Scalar>
 IGL_INLINE void igl::fast_winding_number(
-  const FastWindingNumberBVH & fwn_bvh,
+  const FastWindingNumberBVHT<Scalar> & fwn_bvh,
   const float accuracy_scale,
   const Eigen::MatrixBase<DerivedQ> & Q,
   Eigen::PlainObjectBase<DerivedW> & W)
@@ -428,7 +450,7 @@ IGL_INLINE void igl::fast_winding_number(
   W.resize(Q.rows(),1);
   igl::parallel_for(Q.rows(),[&](int p)
   {
-    FastWindingNumber::HDK_Sample::UT_Vector3T<float>Qp;
+    FastWindingNumber::HDK_Sample::UT_Vector3T<Scalar>Qp;
     Qp[0] = Q(p,0);
     Qp[1] = Q(p,1);
     Qp[2] = Q(p,2);
@@ -436,15 +458,15 @@ IGL_INLINE void igl::fast_winding_number(
   },1000);
 }
 
-template <typename Derivedp>
+template <typename Derivedp, typename Scalar>
 IGL_INLINE typename Derivedp::Scalar igl::fast_winding_number(
-  const FastWindingNumberBVH & fwn_bvh,
+  const FastWindingNumberBVHT<Scalar> & fwn_bvh,
   const float accuracy_scale,
   const Eigen::MatrixBase<Derivedp> & p)
 {
   assert(p.cols() == 3 && "p should be 3D");
 
-  FastWindingNumber::HDK_Sample::UT_Vector3T<float>Qp;
+  FastWindingNumber::HDK_Sample::UT_Vector3T<Scalar>Qp;
   Qp[0] = p(0,0);
   Qp[1] = p(0,1);
   Qp[2] = p(0,2);
@@ -454,7 +476,6 @@ IGL_INLINE typename Derivedp::Scalar igl::fast_winding_number(
   return w;
 }
 
-
 #ifdef IGL_STATIC_LIBRARY
 // Explicit template instantiation
 // generated by autoexplicit.sh
@@ -473,4 +494,10 @@ template void igl::fast_winding_number<Eigen::Matrix<float, -1, -1, 0, -1, -1>,
 template Eigen::Matrix<float, 1, 3, 1, 1, 3>::Scalar igl::fast_winding_number<Eigen::Matrix<float, 1, 3, 1, 1, 3> >(igl::FastWindingNumberBVH const&, float, Eigen::MatrixBase<Eigen::Matrix<float, 1, 3, 1, 1, 3> > const&);
 template void igl::fast_winding_number<Eigen::Matrix<float, -1, 3, 0, -1, 3>, Eigen::Matrix<int, -1, 3, 0, -1, 3> >(Eigen::MatrixBase<Eigen::Matrix<float, -1, 3, 0, -1, 3> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 3, 0, -1, 3> > const&, int, igl::FastWindingNumberBVH&);
 template void igl::fast_winding_number<Eigen::Matrix<float, -1, 3, 1, -1, 3>, Eigen::Matrix<int, -1, 3, 1, -1, 3> >(Eigen::MatrixBase<Eigen::Matrix<float, -1, 3, 1, -1, 3> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 3, 1, -1, 3> > const&, int, igl::FastWindingNumberBVH&);
+template void igl::fast_winding_number_refit<Eigen::Matrix<double, -1, -1, 0, -1, -1>, float>(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, igl::FastWindingNumberBVHT<float>&);
+template void igl::fast_winding_number_refit<Eigen::Matrix<float, -1, -1, 0, -1, -1>, float>(Eigen::MatrixBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> > const&, igl::FastWindingNumberBVHT<float>&);
+template void igl::fast_winding_number<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, double>(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, int, igl::FastWindingNumberBVHT<double>&);
+template void igl::fast_winding_number_refit<Eigen::Matrix<double, -1, -1, 0, -1, -1>, double>(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, igl::FastWindingNumberBVHT<double>&);
+template void igl::fast_winding_number<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, 1, 0, -1, 1>, double>(igl::FastWindingNumberBVHT<double> const&, float, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> >&);
+template Eigen::Matrix<double, 1, 3, 1, 1, 3>::Scalar igl::fast_winding_number<Eigen::Matrix<double, 1, 3, 1, 1, 3>, double>(igl::FastWindingNumberBVHT<double> const&, float, Eigen::MatrixBase<Eigen::Matrix<double, 1, 3, 1, 1, 3> > const&);
 #endif
@@ -137,14 +137,21 @@ namespace igl
       template <typename T1, typename T2> class UT_SolidAngle;} }
   /// Structure for caching precomputation for fast winding number for triangle
   /// soups
-  struct FastWindingNumberBVH {
+  ///
+  /// @tparam Scalar  precision of the stored positions and expansions (float
+  ///   or double). Double precision is slower but remains accurate for meshes
+  ///   far from the origin.
+  template <typename Scalar>
+  struct FastWindingNumberBVHT {
     /// @private
-    FastWindingNumber::HDK_Sample::UT_SolidAngle<float,float> ut_solid_angle;
+    FastWindingNumber::HDK_Sample::UT_SolidAngle<Scalar,Scalar> ut_solid_angle;
     // Need copies of these so they stay alive between calls.
     /// @private
-    std::vector<FastWindingNumber::HDK_Sample::UT_Vector3T<float> > U;
+    std::vector<FastWindingNumber::HDK_Sample::UT_Vector3T<Scalar> > U;
     std::vector<int> F;
   };
+  /// Single precision fast winding number precomputation
+  typedef FastWindingNumberBVHT<float> FastWindingNumberBVH;
   /// Compute approximate winding number of a triangle soup mesh according to
   /// "Fast Winding Numbers for Soups and Clouds" [Barill et al. 2018].
   ///
@@ -172,12 +179,31 @@ namespace igl
   ///   
   template <
     typename DerivedV,
-    typename DerivedF>
+    typename DerivedF,
+    typename Scalar>
   IGL_INLINE void fast_winding_number(
     const Eigen::MatrixBase<DerivedV> & V,
     const Eigen::MatrixBase<DerivedF> & F,
     const int order,
-    FastWindingNumberBVH & fwn_bvh);
+    FastWindingNumberBVHT<Scalar> & fwn_bvh);
+  /// Update a precomputed bounding volume hierarchy after the mesh vertices
+  /// have moved (e.g., in each frame of an animation), keeping the
+  /// connectivity and tree topology. Only the bounding boxes and expansion
+  /// coefficients are recomputed (bottom-up, in parallel), which is much
+  /// cheaper than rebuilding. Queries stay correct for any deformation, but
+  /// become slower if the deformation is so large that the original tree
+  /// groups far apart triangles.
+  ///
+  /// @param[in] V  #V by 3 list of new mesh vertex positions (same #V as
+  ///   used to build fwn_bvh)
+  /// @param[in,out] fwn_bvh  bounding volume hierarchy built with
+  ///   fast_winding_number(V,F,order,fwn_bvh)
+  template <
+    typename DerivedV,
+    typename Scalar>
+  IGL_INLINE void fast_winding_number_refit(
+    const Eigen::MatrixBase<DerivedV> & V,
+    FastWindingNumberBVHT<Scalar> & fwn_bvh);
   /// After precomputation, compute winding number at a each of many points in a
   /// list.
   ///
@@ -187,9 +213,10 @@ namespace igl
   /// @param[out] W  #Q list of winding number values
   template <
     typename DerivedQ,
-    typename DerivedW>
+    typename DerivedW,
+    typename Scalar>
   IGL_INLINE void fast_winding_number(
-    const FastWindingNumberBVH & fwn_bvh,
+    const FastWindingNumberBVHT<Scalar> & fwn_bvh,
     const float accuracy_scale,
     const Eigen::MatrixBase<DerivedQ> & Q,
     Eigen::PlainObjectBase<DerivedW> & W);
@@ -199,9 +226,9 @@ namespace igl
   /// @param[in] accuracy_scale  parameter controlling accuracy (e.g., 2)
   /// @param[in] p single position
   /// @return w  winding number of this point
-  template <typename Derivedp>
+  template <typename Derivedp, typename Scalar>
   IGL_INLINE typename Derivedp::Scalar fast_winding_number(
-    const FastWindingNumberBVH & fwn_bvh,
+    const FastWindingNumberBVHT<Scalar> & fwn_bvh,
     const float accuracy_scale,
     const Eigen::MatrixBase<Derivedp> & p);
 }
@@ -14,6 +14,7 @@
 #include "per_face_normals.h"
 #include "volume.h"
 #include "doublearea.h"
+#include "parallel_for.h"
 
 namespace igl {
 
@@ -23,6 +24,7 @@ template <typename DerivedV, typename DerivedF>
 IGL_INLINE void grad_tet(
   const Eigen::MatrixBase<DerivedV>&V,
   const Eigen::MatrixBase<DerivedF>&T,
+  SparseAssemblyData & data,
   Eigen::SparseMatrix<typename DerivedV::Scalar> &G,
   bool uniform)
 {
@@ -92,39 +94,36 @@ IGL_INLINE void grad_tet(
       repmat([T(:,4);T(:,2);T(:,3);T(:,1)],3,1), ...
       repmat(A./(3*repmat(vol,4,1)),3,1).*N(:), ...
       3*m,n);*/
-  std::vector<Eigen::Triplet<double> > G_t;
-  for (int i = 0; i < 4*m; i++) {
-    int T_j; // j indexes : repmat([T(:,4);T(:,2);T(:,3);T(:,1)],3,1)
-    switch (i/m) {
-      case 0:
-        T_j = 3;
-        break;
-      case 1:
-        T_j = 1;
-        break;
-      case 2:
-        T_j = 2;
-        break;
-      case 3:
-        T_j = 0;
-        break;
+  // Row i of [T(:,4);T(:,2);T(:,3);T(:,1)] contributes
+  // (d*m + i%m, T(i%m,T_j), A(i)/(3*vol(i%m)) * N(i,d)) as contribution 3*i+d
+  const int T_j[4] = {3,1,2,0};
+  const std::uint64_t T_hash = SparseAssemblyData::hash(T);
+  if(!data.matches(3*m,n,m,12,T_hash))
+  {
+    Eigen::VectorXi I(3*4*m), J(3*4*m);
+    for (int i = 0; i < 4*m; i++) {
+      const int i_idx = i%m;
+      const int j_idx = T(i_idx,T_j[i/m]);
+      for (int d = 0; d < 3; d++) {
+        I(3*i+d) = d*m+i_idx;
+        J(3*i+d) = j_idx;
+      }
     }
-    int i_idx = i%m;
-    int j_idx = T(i_idx,T_j);
-
-    double val_before_n = A(i)/(3*vol(i_idx));
-    G_t.push_back(Eigen::Triplet<double>(0*m+i_idx, j_idx, val_before_n * N(i,0)));
-    G_t.push_back(Eigen::Triplet<double>(1*m+i_idx, j_idx, val_before_n * N(i,1)));
-    G_t.push_back(Eigen::Triplet<double>(2*m+i_idx, j_idx, val_before_n * N(i,2)));
+    sparse_assembly_precompute(I,J,3*m,n,m,12,T_hash,data);
   }
-  G.resize(3*m,n);
-  G.setFromTriplets(G_t.begin(), G_t.end());
+  sparse_assembly(data,[&](const int t)
+  {
+    const int i = t/3;
+    double val_before_n = A(i)/(3*vol(i%m));
+    return typename DerivedV::Scalar(val_before_n * N(i,t-3*i));
+  },G);
 }
 
 template <typename DerivedV, typename DerivedF>
 IGL_INLINE void grad_tri(
   const Eigen::MatrixBase<DerivedV>&V,
   const Eigen::MatrixBase<DerivedF>&F,
+  SparseAssemblyData & data,
   Eigen::SparseMatrix<typename DerivedV::Scalar> &G,
   bool uniform)
 {
@@ -137,7 +136,7 @@ IGL_INLINE void grad_tri(
   Eigen::Matrix<typename DerivedV::Scalar,Eigen::Dynamic,3>
     eperp21(m,3), eperp13(m,3);
 
-  for (int i=0;i<m;++i)
+  parallel_for(m,[&](const int i)
   {
     // renaming indices of vertices of triangles for convenience
     int i1 = F(i,0);
@@ -189,23 +188,38 @@ IGL_INLINE void grad_tri(
     eperp13.row(i) = u.cross(v13);
     eperp13.row(i) = eperp13.row(i) / std::sqrt(eperp13.row(i).dot(eperp13.row(i)));
     eperp13.row(i) *= norm13 / dblA;
-  }
+  },1000);
 
-  // create sparse gradient operator matrix
-  G.resize(dims*m,nv);
-  std::vector<Eigen::Triplet<typename DerivedV::Scalar> > Gijv;
-  Gijv.reserve(4*dims*m);
-  for(int f = 0;f<F.rows();f++)
+  // create sparse gradient operator matrix: for each face f and dimension
+  // d, contributions 4*(f*dims+d)+{0,1,2,3} are
+  //   (f+d*m,F(f,1), eperp13(f,d)), (f+d*m,F(f,0),-eperp13(f,d)),
+  //   (f+d*m,F(f,2), eperp21(f,d)), (f+d*m,F(f,0),-eperp21(f,d))
+  const std::uint64_t F_hash = SparseAssemblyData::hash(F);
+  if(!data.matches(dims*m,nv,m,4*dims,F_hash))
   {
-    for(int d = 0;d<dims;d++)
+    Eigen::VectorXi I(4*dims*m), J(4*dims*m);
+    parallel_for(m,[&](const int f)
     {
-      Gijv.emplace_back(f+d*m,F(f,1), eperp13(f,d));
-      Gijv.emplace_back(f+d*m,F(f,0),-eperp13(f,d));
-      Gijv.emplace_back(f+d*m,F(f,2), eperp21(f,d));
-      Gijv.emplace_back(f+d*m,F(f,0),-eperp21(f,d));
-    }
+      for(int d = 0;d<dims;d++)
+      {
+        const int t = 4*(f*dims+d);
+        I.segment(t,4).setConstant(f+d*m);
+        J(t+0) = F(f,1);
+        J(t+1) = F(f,0);
+        J(t+2) = F(f,2);
+        J(t+3) = F(f,0);
+      }
+    },1000);
+    sparse_assembly_precompute(I,J,dims*m,nv,m,4*dims,F_hash,data);
   }
-  G.setFromTriplets(Gijv.begin(), Gijv.end());
+  sparse_assembly(data,[&](const int t)
+  {
+    const int q = t>>2;
+    const int f = q/dims;
+    const int d = q-f*dims;
+    const auto & e = (t & 2) ? eperp21 : eperp13;
+    return (t & 1) ? -e(f,d) : e(f,d);
+  },G);
 }
 
 } // anonymous namespace
@@ -218,14 +232,26 @@ IGL_INLINE void igl::grad(
   const Eigen::MatrixBase<DerivedF>&F,
   Eigen::SparseMatrix<typename DerivedV::Scalar> &G,
   bool uniform)
+{
+  SparseAssemblyData data;
+  return grad(V,F,data,G,uniform);
+}
+
+template <typename DerivedV, typename DerivedF>
+IGL_INLINE void igl::grad(
+  const Eigen::MatrixBase<DerivedV>&V,
+  const Eigen::MatrixBase<DerivedF>&F,
+  SparseAssemblyData & data,
+  Eigen::SparseMatrix<typename DerivedV::Scalar> &G,
+  bool uniform)
 {
   assert(F.cols() == 3 || F.cols() == 4);
   switch(F.cols())
   {
     case 3:
-      return grad_tri(V,F,G,uniform);
+      return grad_tri(V,F,data,G,uniform);
     case 4:
-      return grad_tet(V,F,G,uniform);
+      return grad_tet(V,F,data,G,uniform);
     default:
       assert(false);
   }
@@ -237,4 +263,6 @@ IGL_INLINE void igl::grad(
 template void igl::grad<Eigen::Matrix<double, -1, 2, 0, -1, 2>, Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, 2, 0, -1, 2> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::SparseMatrix<Eigen::Matrix<double, -1, 2, 0, -1, 2>::Scalar, 0, int>&, bool);
 template void igl::grad<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::SparseMatrix<Eigen::Matrix<double, -1, -1, 0, -1, -1>::Scalar, 0, int>&, bool);
 template void igl::grad<Eigen::Matrix<double, -1, 3, 0, -1, 3>, Eigen::Matrix<int, -1, 3, 0, -1, 3> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, 3, 0, -1, 3> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 3, 0, -1, 3> > const&, Eigen::SparseMatrix<Eigen::Matrix<double, -1, 3, 0, -1, 3>::Scalar, 0, int>&, bool);
+template void igl::grad<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, igl::SparseAssemblyData&, Eigen::SparseMatrix<Eigen::Matrix<double, -1, -1, 0, -1, -1>::Scalar, 0, int>&, bool);
+template void igl::grad<Eigen::Matrix<double, -1, 3, 0, -1, 3>, Eigen::Matrix<int, -1, 3, 0, -1, 3> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, 3, 0, -1, 3> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 3, 0, -1, 3> > const&, igl::SparseAssemblyData&, Eigen::SparseMatrix<Eigen::Matrix<double, -1, 3, 0, -1, 3>::Scalar, 0, int>&, bool);
 #endif
@@ -8,6 +8,7 @@
 #ifndef IGL_GRAD_H
 #define IGL_GRAD_H
 #include "igl_inline.h"
+#include "sparse_assembly.h"
 
 #include <Eigen/Core>
 #include <Eigen/Sparse>
@@ -32,6 +33,20 @@ namespace igl {
     const Eigen::MatrixBase<DerivedF>&F,
     Eigen::SparseMatrix<typename DerivedV::Scalar> &G,
     bool uniform = false);
+  /// \overload
+  /// \brief Reuses the sparsity pattern of G across calls with the same F
+  /// (e.g., when only V changes).
+  ///
+  /// @param[in,out] data  sparsity pattern of G; (re)computed from F if
+  ///     empty or if the output size, #F, entries per element or the hash of
+  ///     F's indices differ from the stored ones
+  template <typename DerivedV, typename DerivedF>
+  IGL_INLINE void grad(
+    const Eigen::MatrixBase<DerivedV>&V,
+    const Eigen::MatrixBase<DerivedF>&F,
+    SparseAssemblyData & data,
+    Eigen::SparseMatrix<typename DerivedV::Scalar> &G,
+    bool uniform = false);
 }
 #ifndef IGL_STATIC_LIBRARY
 #  include "grad.cpp"
@@ -19,8 +19,12 @@
 #include "unique.h"
 #include "avg_edge_length.h"
 #include "PlainMatrix.h"
+#include "default_num_threads.h"
+#include "parallel_for.h"
 
+#include <algorithm>
 #include <cassert>
+#include <vector>
 
 template < typename DerivedV, typename DerivedF, typename Scalar >
 IGL_INLINE bool igl::heat_geodesics_precompute(
@@ -97,69 +101,137 @@ IGL_INLINE bool igl::heat_geodesics_precompute(
   return true;
 }
 
+namespace igl
+{
+  namespace internal
+  {
+    // Solve for the distances to gammas[first+j] in column j of D, running
+    // every stage as a multi-column solve.
+    template <typename Scalar>
+    IGL_INLINE void heat_geodesics_solve_columns(
+      const HeatGeodesicsData<Scalar> & data,
+      const std::vector<std::vector<int> > & gammas,
+      const int first,
+      const int k,
+      Eigen::Matrix<Scalar,Eigen::Dynamic,Eigen::Dynamic> & D)
+    {
+      typedef Eigen::Matrix<Scalar,Eigen::Dynamic,Eigen::Dynamic> MatrixXS;
+      // number of mesh vertices
+      const int n = data.Grad.cols();
+      // Set up delta at gamma
+      MatrixXS u0 = MatrixXS::Zero(n,k);
+      for(int j = 0;j<k;j++)
+      {
+        for(const int g : gammas[first+j])
+        {
+          u0(g,j) = 1;
+        }
+      }
+      // Neumann solution
+      MatrixXS u;
+      igl::min_quad_with_fixed_solve(
+        data.Neumann,u0,MatrixXS(0,k),MatrixXS(),u);
+      if(data.b.size()>0)
+      {
+        // Average Dirichelt and Neumann solutions
+        MatrixXS uD;
+        igl::min_quad_with_fixed_solve(
+          data.Dirichlet,u0,MatrixXS::Zero(data.b.size(),k).eval(),MatrixXS(),uD);
+        u += uD;
+        u *= 0.5;
+      }
+      MatrixXS grad_u = data.Grad*u;
+      const int m = data.Grad.rows()/data.ng;
+      for(int j = 0;j<k;j++)
+      {
+        for(int i = 0;i<m;i++)
+        {
+          // It is very important to use a stable norm calculation here. If
+          // the triangle is far from a source, then the floating point values
+          // in the gradient can be _very_ small (e.g., 1e-300). The
+          // standard/naive norm calculation will suffer from underflow.
+          // Dividing by the max value is more stable. (Eigen implements this
+          // as stableNorm or blueNorm).
+          Scalar norm = 0;
+          Scalar ma = 0;
+          for(int d = 0;d<data.ng;d++) {ma = std::max(ma,std::fabs(grad_u(d*m+i,j)));}
+          for(int d = 0;d<data.ng;d++)
+          {
+            const Scalar gui = grad_u(d*m+i,j) / ma;
+            norm += gui*gui;
+          }
+          norm = ma*sqrt(norm);
+          // These are probably over kill; ma==0 should be enough
+          if(ma == 0 || norm == 0 || norm!=norm)
+          {
+            for(int d = 0;d<data.ng;d++) { grad_u(d*m+i,j) = 0; }
+          }else
+          {
+            for(int d = 0;d<data.ng;d++) { grad_u(d*m+i,j) /= norm; }
+          }
+        }
+      }
+      const MatrixXS div_X = -data.Div*grad_u;
+      const MatrixXS Beq = MatrixXS::Zero(1,k);
+      igl::min_quad_with_fixed_solve(
+        data.Poisson,(-div_X).eval(),MatrixXS(0,k),Beq,D);
+      for(int j = 0;j<k;j++)
+      {
+        const std::vector<int> & gamma = gammas[first+j];
+        Scalar Dgamma = 0;
+        for(const int g : gamma) { Dgamma += D(g,j); }
+        D.col(j).array() -= Dgamma/Scalar(gamma.size());
+        if(D.col(j).mean() < 0)
+        {
+          D.col(j) = -D.col(j);
+        }
+      }
+    }
+  }
+}
+
 template < typename Scalar, typename Derivedgamma, typename DerivedD>
 IGL_INLINE void igl::heat_geodesics_solve(
   const HeatGeodesicsData<Scalar> & data,
   const Eigen::MatrixBase<Derivedgamma> & gamma,
   Eigen::PlainObjectBase<DerivedD> & D)
 {
-  // number of mesh vertices
-  const int n = data.Grad.cols();
-  // Set up delta at gamma
-  DerivedD u0 = DerivedD::Zero(n,1);
+  std::vector<std::vector<int> > gammas(1,std::vector<int>(gamma.size()));
   for(int g = 0;g<gamma.size();g++)
   {
-    u0(gamma(g)) = 1;
+    gammas[0][g] = gamma(g);
   }
-  // Neumann solution
-  DerivedD u;
-  igl::min_quad_with_fixed_solve(
-    data.Neumann,u0,DerivedD(),DerivedD(),u);
-  if(data.b.size()>0)
-  {
-    // Average Dirichelt and Neumann solutions
-    DerivedD uD;
-    igl::min_quad_with_fixed_solve(
-      data.Dirichlet,u0,DerivedD::Zero(data.b.size()).eval(),DerivedD(),uD);
-    u += uD;
-    u *= 0.5;
-  }
-  DerivedD grad_u = data.Grad*u;
-  const int m = data.Grad.rows()/data.ng;
-  for(int i = 0;i<m;i++)
+  Eigen::Matrix<Scalar,Eigen::Dynamic,Eigen::Dynamic> D1;
+  internal::heat_geodesics_solve_columns(data,gammas,0,1,D1);
+  D = D1.template cast<typename DerivedD::Scalar>();
+}
+
+template < typename Scalar, typename DerivedD>
+IGL_INLINE void igl::heat_geodesics_solve(
+  const HeatGeodesicsData<Scalar> & data,
+  const std::vector<std::vector<int> > & gammas,
+  Eigen::PlainObjectBase<DerivedD> & D)
+{
+  const int n = data.Grad.cols();
+  const int k = gammas.size();
+  D.resize(n,k);
+  if(k == 0)
   {
-    // It is very important to use a stable norm calculation here. If the
-    // triangle is far from a source, then the floating point values in the
-    // gradient can be _very_ small (e.g., 1e-300). The standard/naive norm
-    // calculation will suffer from underflow. Dividing by the max value is more
-    // stable. (Eigen implements this as stableNorm or blueNorm).
-    Scalar norm = 0;
-    Scalar ma = 0;
-    for(int d = 0;d<data.ng;d++) {ma = std::max(ma,std::fabs(grad_u(d*m+i)));}
-    for(int d = 0;d<data.ng;d++)
-    {
-      const Scalar gui = grad_u(d*m+i) / ma;
-      norm += gui*gui;
-    }
-    norm = ma*sqrt(norm);
-    // These are probably over kill; ma==0 should be enough
-    if(ma == 0 || norm == 0 || norm!=norm)
-    {
-      for(int d = 0;d<data.ng;d++) { grad_u(d*m+i) = 0; }
-    }else
-    {
-      for(int d = 0;d<data.ng;d++) { grad_u(d*m+i) /= norm; }
-    }
+    return;
   }
-  const DerivedD div_X = -data.Div*grad_u;
-  const DerivedD Beq = (DerivedD(1,1)<<0).finished();
-  igl::min_quad_with_fixed_solve(data.Poisson,(-div_X).eval(),DerivedD(),Beq,D);
-  DerivedD Dgamma = D(gamma.derived());
-  D.array() -= Dgamma.mean();
-  if(D.mean() < 0)
+  // One block of columns per thread: within a block the (sequential) sparse
+  // triangular solves sweep over several right-hand sides at once.
+  const int num_blocks =
+    std::min<int>(k,std::max<int>(1,igl::default_num_threads()));
+  igl::parallel_for(num_blocks,[&](const int b)
   {
-    D = -D;
-  }
+    const int first = (b*k)/num_blocks;
+    const int last = ((b+1)*k)/num_blocks;
+    Eigen::Matrix<Scalar,Eigen::Dynamic,Eigen::Dynamic> Db;
+    internal::heat_geodesics_solve_columns(data,gammas,first,last-first,Db);
+    D.middleCols(first,last-first) =
+      Db.template cast<typename DerivedD::Scalar>();
+  },1);
 }
 
 #ifdef IGL_STATIC_LIBRARY
@@ -167,4 +239,5 @@ IGL_INLINE void igl::heat_geodesics_solve(
 template void igl::heat_geodesics_solve<double, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, 1, 0, -1, 1> >(igl::HeatGeodesicsData<double> const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> >&);
 template bool igl::heat_geodesics_precompute<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, double>(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, double, igl::HeatGeodesicsData<double>&);
 template bool igl::heat_geodesics_precompute<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, double>(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, igl::HeatGeodesicsData<double>&);
+template void igl::heat_geodesics_solve<double, Eigen::Matrix<double, -1, -1, 0, -1, -1> >(igl::HeatGeodesicsData<double> const&, std::vector<std::vector<int, std::allocator<int> >, std::allocator<std::vector<int, std::allocator<int> > > > const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&);
 #endif
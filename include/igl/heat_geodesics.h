@@ -11,6 +11,7 @@
 #include "min_quad_with_fixed.h"
 #include <Eigen/Sparse>
 #include <Eigen/Sparse>
+#include <vector>
 namespace igl
 {
   /// Precomputation data for heat_geodesics_solve
@@ -68,6 +69,22 @@ namespace igl
     const HeatGeodesicsData<Scalar> & data,
     const Eigen::MatrixBase<Derivedgamma> & gamma,
     Eigen::PlainObjectBase<DerivedD> & D);
+  /// Compute fast approximate geodesic distances to each of many sets of
+  /// source vertices (e.g., all-to-landmark distances) using precomputed
+  /// data. The heat, normalization and Poisson stages are solved for blocks
+  /// of sets at once as multi-column solves, with blocks solved in parallel.
+  ///
+  /// @param[in] data  precomputation data (see heat_geodesics_precompute)
+  /// @param[in] gammas  #gammas list of lists of indices into V of source
+  ///   vertices (each non-empty)
+  /// @param[out] D  #V by #gammas list of distances, column j to gammas[j]
+  ///
+  /// \fileinfo
+  template < typename Scalar, typename DerivedD>
+  IGL_INLINE void heat_geodesics_solve(
+    const HeatGeodesicsData<Scalar> & data,
+    const std::vector<std::vector<int> > & gammas,
+    Eigen::PlainObjectBase<DerivedD> & D);
 }
 
 #ifndef IGL_STATIC_LIBRARY
@@ -20,7 +20,7 @@ IGL_INLINE void igl::infinite_cost_stopping_condition(
     const Eigen::VectorXi & EMAP,
     const Eigen::MatrixXi & EF,
     const Eigen::MatrixXi & EI,
-    const igl::min_heap< std::tuple<double,int,int> > & ,/*Q*/
+    const igl::IndexedHeap<double> &                    ,/*Q*/
     const Eigen::VectorXi &                             EQ,
     const Eigen::MatrixXd & /*C*/,
     const int e,
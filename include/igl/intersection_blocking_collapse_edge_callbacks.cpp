@@ -34,7 +34,7 @@ void igl::intersection_blocking_collapse_edge_callbacks(
       const Eigen::VectorXi & EMAP,
       const Eigen::MatrixXi & EF,
       const Eigen::MatrixXi & EI,
-      const igl::min_heap< std::tuple<double,int,int> > & Q,
+      const igl::IndexedHeap<double> & Q,
       const Eigen::VectorXi & EQ,
       const Eigen::MatrixXd & C,
       const int e)->bool
@@ -58,7 +58,7 @@ void igl::intersection_blocking_collapse_edge_callbacks(
       const Eigen::VectorXi & EMAP,
       const Eigen::MatrixXi & EF,
       const Eigen::MatrixXi & EI,
-      const igl::min_heap< std::tuple<double,int,int> > & Q,
+      const igl::IndexedHeap<double> & Q,
       const Eigen::VectorXi & EQ,
       const Eigen::MatrixXd & C,
       const int e,
@@ -6,15 +6,250 @@
 // v. 2.0. If a copy of the MPL was not distributed with this file, You can 
 // obtain one at http://mozilla.org/MPL/2.0/.
 #include "marching_cubes.h"
-#include "march_cube.h"
+#include "parallel_for.h"
 
 // Adapted from public domain code at
 // http://paulbourke.net/geometry/polygonise/marchingsource.cpp
 
-#include <unordered_map>
-#include <iostream>
-#include <cstdint>
+#include <algorithm>
+#include <bitset>
 #include <cassert>
+#include <cstdint>
+#include <numeric>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace igl
+{
+  namespace internal
+  {
+    // Same edge key as igl::march_cube uses for E2V
+    inline std::int64_t marching_cubes_edge_key(std::int32_t i, std::int32_t j)
+    {
+      if(i>j){ std::swap(i,j); }
+      std::int64_t ret = 0;
+      ret |= i;
+      ret |= static_cast<std::int64_t>(j) << 32;
+      return ret;
+    }
+
+    // Dense grid marching cubes without an edge hash map.
+    //
+    // Each edge vertex is owned by the first cube (in z-y-x order) containing
+    // the edge, i.e., the cube that creates it when marching serially. Slabs
+    // of cubes (fixed z) are first counted in parallel, prefix summed, and
+    // then emitted in parallel, so V and F come out in exactly the serial
+    // order. A slab only needs the ids of vertices owned by the previous slab
+    // on their shared face, which pass 1 records.
+    //
+    // If keys is not null, (*keys)[v] is set to the E2V key of vertex v.
+    template <
+      typename DerivedS, 
+      typename DerivedGV, 
+      typename DerivedV, 
+      typename DerivedF>
+    IGL_INLINE void marching_cubes_dense(
+      const Eigen::MatrixBase<DerivedS> & S,
+      const Eigen::MatrixBase<DerivedGV> & GV,
+      const unsigned nx,
+      const unsigned ny,
+      const unsigned nz,
+      const typename DerivedS::Scalar isovalue,
+      Eigen::PlainObjectBase<DerivedV> &V,
+      Eigen::PlainObjectBase<DerivedF> &F,
+      std::vector<std::int64_t> * keys)
+    {
+#include "marching_cubes_tables.h"
+      typedef typename DerivedS::Scalar Scalar;
+      typedef std::int64_t Index;
+      V.resize(0,3);
+      F.resize(0,3);
+      if(keys) { keys->clear(); }
+      if(nx < 2 || ny < 2 || nz < 2) { return; }
+
+      // (x,y,z) offsets of cube corners in the same order as a2fVertexOffset
+      const int corner[8][3] = 
+        {{0,0,0},{1,0,0},{1,1,0},{0,1,0},{0,0,1},{1,0,1},{1,1,1},{0,1,1}};
+      Index ioffset[8];
+      for(int c = 0;c<8;c++)
+      {
+        ioffset[c] = 
+          corner[c][0] + Index(nx)*(corner[c][1] + Index(ny)*corner[c][2]);
+      }
+      // Edges touching a slab are stored in 5 planes of nx*ny slots: x- and
+      // y-edges of its bottom face, x- and y-edges of its top face, z-edges.
+      // edge_slot[e] is the slot of cube (0,0)'s edge e.
+      //
+      // A cube owns edge e iff for each axis k other than e's, e lies on the
+      // cube's upper face in k or the cube is at 0 in k (no earlier cube
+      // shares it). owned[b] is the mask of edges owned by a cube where bit k
+      // of b is set iff the cube's k-th coordinate is 0.
+      const Index nxy = Index(nx)*Index(ny);
+      Index edge_slot[12];
+      int owned[8] = {0,0,0,0,0,0,0,0};
+      for(int e = 0;e<12;e++)
+      {
+        const int * a = corner[a2eConnection[e][0]];
+        const int * b = corner[a2eConnection[e][1]];
+        int axis = 0;
+        int lo[3];
+        for(int k = 0;k<3;k++)
+        {
+          if(a[k] != b[k]) { axis = k; }
+          lo[k] = std::min(a[k],b[k]);
+        }
+        const int plane = axis == 2 ? 4 : axis + 2*lo[2];
+        edge_slot[e] = plane*nxy + lo[0] + Index(nx)*lo[1];
+        for(int bits = 0;bits<8;bits++)
+        {
+          bool owns = true;
+          for(int k = 0;k<3;k++)
+          {
+            if(k != axis && lo[k] == 0 && !(bits & (1<<k))) { owns = false; }
+          }
+          if(owns) { owned[bits] |= 1<<e; }
+        }
+      }
+      // Number of triangles for each cube configuration
+      int num_faces[256];
+      for(int c = 0;c<256;c++)
+      {
+        num_faces[c] = 0;
+        while(num_faces[c] < 5 && a2fConnectionTable[c][3*num_faces[c]] >= 0)
+        {
+          num_faces[c]++;
+        }
+      }
+      const auto cube_flags = [&S,&ioffset,&isovalue](const Index i)->int
+      {
+        int c_flags = 0;
+        for(int c = 0;c<8;c++)
+        {
+          if(S(i+ioffset[c]) > isovalue){ c_flags |= 1<<c; }
+        }
+        return c_flags;
+      };
+
+      const Index num_slabs = Index(nz)-1;
+      // Pass 1: count vertices and faces of each slab and record (slot in
+      // top face, local id) of the vertices it owns on its top face.
+      std::vector<Index> vertex_offset(num_slabs+1,0);
+      std::vector<Index> face_offset(num_slabs+1,0);
+      std::vector<std::vector<std::pair<Index,Index> > > top(num_slabs);
+      igl::parallel_for(num_slabs,[&](const Index z)
+      {
+        Index n = 0;
+        Index m = 0;
+        for(Index y = 0;y<Index(ny)-1;y++)
+        {
+          for(Index x = 0;x<Index(nx)-1;x++)
+          {
+            const int c_flags = cube_flags(x+nx*(y+ny*z));
+            const int e_flags = aiCubeEdgeFlags[c_flags];
+            if(e_flags == 0) { continue; }
+            const int o_flags = 
+              e_flags & owned[(x==0) | ((y==0)<<1) | ((z==0)<<2)];
+            for(int e = 0; e < 12; e++)
+            {
+              if(o_flags & (1<<e))
+              {
+                const Index slot = edge_slot[e] + x + nx*y;
+                if(slot >= 2*nxy && slot < 4*nxy)
+                {
+                  top[z].emplace_back(slot-2*nxy,n);
+                }
+                n++;
+              }
+            }
+            m += num_faces[c_flags];
+          }
+        }
+        vertex_offset[z+1] = n;
+        face_offset[z+1] = m;
+      },2);
+      std::partial_sum(
+        vertex_offset.begin(),vertex_offset.end(),vertex_offset.begin());
+      std::partial_sum(
+        face_offset.begin(),face_offset.end(),face_offset.begin());
+
+      // Pass 2: emit vertices and faces of each slab at its offsets
+      V.resize(vertex_offset.back(),3);
+      F.resize(face_offset.back(),3);
+      if(keys) { keys->resize(V.rows()); }
+      // Per-thread vertex ids of the edges touching the current slab. Only
+      // slots of crossed edges are read and each is written first (by its
+      // owner in this slab or from the previous slab's top face), so these
+      // are never reset.
+      std::vector<std::vector<Index> > slab_ids;
+      igl::parallel_for(
+        num_slabs,
+        [&slab_ids](const size_t num_threads){ slab_ids.resize(num_threads); },
+        [&](const Index z, const size_t thread)
+        {
+          std::vector<Index> & ids = slab_ids[thread];
+          if(ids.empty()) { ids.resize(5*nxy); }
+          if(z > 0)
+          {
+            for(const auto & slot_id : top[z-1])
+            {
+              ids[slot_id.first] = vertex_offset[z-1] + slot_id.second;
+            }
+          }
+          Index n = vertex_offset[z];
+          Index m = face_offset[z];
+          for(Index y = 0;y<Index(ny)-1;y++)
+          {
+            for(Index x = 0;x<Index(nx)-1;x++)
+            {
+              const Index i = x+nx*(y+ny*z);
+              const int c_flags = cube_flags(i);
+              const int e_flags = aiCubeEdgeFlags[c_flags];
+              if(e_flags == 0) { continue; }
+              const int o_flags = 
+                e_flags & owned[(x==0) | ((y==0)<<1) | ((z==0)<<2)];
+              Index edge_vertices[12];
+              for(int e = 0; e < 12; e++)
+              {
+                if(e_flags & (1<<e))
+                {
+                  const Index slot = edge_slot[e] + x + nx*y;
+                  if(o_flags & (1<<e))
+                  {
+                    // find crossing point assuming linear interpolation along
+                    // edges (oriented as seen by the owner)
+                    const Index vi = i + ioffset[a2eConnection[e][0]];
+                    const Index vj = i + ioffset[a2eConnection[e][1]];
+                    const Scalar a = S(vi);
+                    const Scalar b = S(vj);
+                    const Scalar t = (isovalue - a)/(b - a);
+                    V.row(n) = GV.row(vi) + t*(GV.row(vj) - GV.row(vi));
+                    if(keys) { (*keys)[n] = marching_cubes_edge_key(vi,vj); }
+                    ids[slot] = n++;
+                  }
+                  edge_vertices[e] = ids[slot];
+                }
+              }
+              // Insert the triangles that were found.  There can be up to
+              // five per cube
+              for(int f = 0; f < num_faces[c_flags]; f++)
+              {
+                for(int k = 0;k<3;k++)
+                {
+                  F(m,k) = edge_vertices[a2fConnectionTable[c_flags][3*f+k]];
+                }
+                m++;
+              }
+            }
+          }
+          assert(n == vertex_offset[z+1]);
+          assert(m == face_offset[z+1]);
+        },
+        [](const size_t){},
+        2);
+    }
+  }
+}
 
 template <typename DerivedS, typename DerivedGV, typename DerivedV, typename DerivedF>
 IGL_INLINE void igl::marching_cubes(
@@ -27,8 +262,7 @@ IGL_INLINE void igl::marching_cubes(
     Eigen::PlainObjectBase<DerivedV> &V,
     Eigen::PlainObjectBase<DerivedF> &F)
 {
-  std::unordered_map<std::int64_t,int> E2V;
-  return marching_cubes(S,GV,nx,ny,nz,isovalue,V,F,E2V);
+  internal::marching_cubes_dense(S,GV,nx,ny,nz,isovalue,V,F,nullptr);
 }
 
 template <
@@ -47,64 +281,14 @@ IGL_INLINE void igl::marching_cubes(
   Eigen::PlainObjectBase<DerivedF> &F,
   std::unordered_map<std::int64_t,int> &E2V)
 {
-  typedef typename DerivedS::Scalar Scalar;
-  typedef unsigned Index;
-  // use same order as a2fVertexOffset
-  const unsigned ioffset[8] = {0,1,1+nx,nx,nx*ny,1+nx*ny,1+nx+nx*ny,nx+nx*ny};
-
-
-  V.resize(std::pow(nx*ny*nz,2./3.),3);
-  F.resize(std::pow(nx*ny*nz,2./3.),3);
-  Index n = 0;
-  Index m = 0;
-
-  const auto xyz2i = [&nx,&ny]
-    (const int & x, const int & y, const int & z)->unsigned
-  {
-    return x+nx*(y+ny*(z));
-  };
-  const auto cube = 
-    [
-      &GV,&S,&V,&n,&F,&m,&isovalue,
-      &E2V,&xyz2i,&ioffset
-    ]
-    (const int x, const int y, const int z)
+  std::vector<std::int64_t> keys;
+  internal::marching_cubes_dense(S,GV,nx,ny,nz,isovalue,V,F,&keys);
+  E2V.clear();
+  E2V.reserve(keys.size());
+  for(size_t v = 0;v<keys.size();v++)
   {
-    const unsigned i = xyz2i(x,y,z);
-
-    //Make a local copy of the values at the cube's corners
-    Eigen::Matrix<Scalar,8,1> cS;
-    Eigen::Matrix<Index,8,1> cI;
-    //Find which vertices are inside of the surface and which are outside
-    for(int c = 0; c < 8; c++)
-    {
-      const unsigned ic = i + ioffset[c];
-      cI(c) = ic;
-      cS(c) = S(ic);
-    }
-
-    march_cube(GV,cS,cI,isovalue,V,n,F,m,E2V);
-
-  };
-
-  // march over all cubes (loop order chosen to match memory)
-  //
-  // Should be possible to parallelize safely if threads are "well separated".
-  // Like red-black Gauss Seidel. Probably each thread need's their own E2V,V,F,
-  // and then merge at the end. Annoying part are the edges lying on the
-  // interface between chunks.
-  for(int z=0;z<nz-1;z++)
-  {
-    for(int y=0;y<ny-1;y++)
-    {
-      for(int x=0;x<nx-1;x++)
-      {
-        cube(x,y,z);
-      }
-    }
+    E2V.emplace(keys[v],int(v));
   }
-  V.conservativeResize(n,3);
-  F.conservativeResize(m,3);
 }
 
 template <
@@ -121,31 +305,116 @@ IGL_INLINE void igl::marching_cubes(
   Eigen::PlainObjectBase<DerivedV> &V,
   Eigen::PlainObjectBase<DerivedF> &F)
 {
+#include "marching_cubes_tables.h"
   typedef Eigen::Index Index;
   typedef typename DerivedV::Scalar Scalar;
 
-  std::unordered_map<std::int64_t,int> E2V;
-  V.resize(4*GV.rows(),3);
-  F.resize(4*GV.rows(),3);
-  Index n = 0;
-  Index m = 0;
-
-  // march over cubes
-
-  //Make a local copy of the values at the cube's corners
-  Eigen::Matrix<Scalar, 8, 1> cS;
-  Eigen::Matrix<Index, 8, 1> cI;
-  for(Index c = 0;c<GI.rows();c++)
+  // Cubes may share edges arbitrarily, so crossed edges are gathered and
+  // sorted by key instead. Each crossed edge is owned by its first occurrence
+  // in cube-edge order (where a serial march would create its vertex) and
+  // cubes are then emitted in parallel at prefix-summed offsets.
+  int num_faces[256];
+  for(int c = 0;c<256;c++)
+  {
+    num_faces[c] = 0;
+    while(num_faces[c] < 5 && a2fConnectionTable[c][3*num_faces[c]] >= 0)
+    {
+      num_faces[c]++;
+    }
+  }
+  const Index num_cubes = GI.rows();
+  std::vector<unsigned char> cube_flags(num_cubes);
+  std::vector<Index> edge_offset(num_cubes+1,0);
+  std::vector<Index> face_offset(num_cubes+1,0);
+  igl::parallel_for(num_cubes,[&](const Index c)
   {
+    int c_flags = 0;
     for(int v = 0; v < 8; v++)
     {
-      cI(v) = GI(c,v);
-      cS(v) = S(GI(c,v));
+      const Scalar s = S(GI(c,v));
+      if(s > isovalue){ c_flags |= 1<<v; }
+    }
+    cube_flags[c] = c_flags;
+    edge_offset[c+1] = std::bitset<12>(aiCubeEdgeFlags[c_flags]).count();
+    face_offset[c+1] = num_faces[c_flags];
+  },1000);
+  std::partial_sum(edge_offset.begin(),edge_offset.end(),edge_offset.begin());
+  std::partial_sum(face_offset.begin(),face_offset.end(),face_offset.begin());
+
+  // (key,position) of each crossed edge
+  const Index num_edges = edge_offset.back();
+  std::vector<std::pair<std::int64_t,Index> > crossed(num_edges);
+  igl::parallel_for(num_cubes,[&](const Index c)
+  {
+    const int e_flags = aiCubeEdgeFlags[cube_flags[c]];
+    Index p = edge_offset[c];
+    for(int e = 0; e < 12; e++)
+    {
+      if(e_flags & (1<<e))
+      {
+        crossed[p] = {
+          internal::marching_cubes_edge_key(
+            GI(c,a2eConnection[e][0]),GI(c,a2eConnection[e][1])),
+          p};
+        p++;
+      }
+    }
+  },1000);
+  std::sort(crossed.begin(),crossed.end());
+  // owner[p] is the first position of p's edge, vertex_id[p] the number of
+  // owners before p
+  std::vector<Index> owner(num_edges);
+  std::vector<Index> vertex_id(num_edges+1,0);
+  for(Index k = 0;k<num_edges;)
+  {
+    const std::int64_t key = crossed[k].first;
+    const Index first = crossed[k].second;
+    vertex_id[first+1] = 1;
+    for(;k<num_edges && crossed[k].first == key;k++)
+    {
+      owner[crossed[k].second] = first;
     }
-    march_cube(GV,cS,cI,isovalue,V,n,F,m,E2V);
   }
-  V.conservativeResize(n,3);
-  F.conservativeResize(m,3);
+  std::partial_sum(vertex_id.begin(),vertex_id.end(),vertex_id.begin());
+
+  V.resize(vertex_id.back(),3);
+  F.resize(face_offset.back(),3);
+  igl::parallel_for(num_cubes,[&](const Index c)
+  {
+    const int c_flags = cube_flags[c];
+    const int e_flags = aiCubeEdgeFlags[c_flags];
+    if(e_flags == 0) { return; }
+    Index p = edge_offset[c];
+    Index edge_vertices[12];
+    for(int e = 0; e < 12; e++)
+    {
+      if(e_flags & (1<<e))
+      {
+        if(owner[p] == p)
+        {
+          // find crossing point assuming linear interpolation along edges
+          const Index i = GI(c,a2eConnection[e][0]);
+          const Index j = GI(c,a2eConnection[e][1]);
+          const Scalar a = S(i);
+          const Scalar b = S(j);
+          const Scalar t = (isovalue - a)/(b - a);
+          V.row(vertex_id[p]) = GV.row(i) + t*(GV.row(j) - GV.row(i));
+        }
+        edge_vertices[e] = vertex_id[owner[p]];
+        p++;
+      }
+    }
+    // Insert the triangles that were found.  There can be up to five per cube
+    Index m = face_offset[c];
+    for(int f = 0; f < num_faces[c_flags]; f++)
+    {
+      for(int k = 0;k<3;k++)
+      {
+        F(m,k) = edge_vertices[a2fConnectionTable[c_flags][3*f+k]];
+      }
+      m++;
+    }
+  },1000);
 }
 
 #ifdef IGL_STATIC_LIBRARY
@@ -162,4 +431,5 @@ template void igl::marching_cubes<Eigen::Matrix<double, -1, 1, 0, -1, 1>, Eigen:
 template void igl::marching_cubes<Eigen::Matrix<double, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, unsigned int, unsigned int, unsigned int, Eigen::Matrix<double, -1, 1, 0, -1, 1>::Scalar, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> >&);
 template void igl::marching_cubes<Eigen::Matrix<double, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::Matrix<double, -1, 1, 0, -1, 1>::Scalar, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> >&);
 template void igl::marching_cubes<Eigen::Matrix<double, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, 8, 0, -1, 8>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 8, 0, -1, 8> > const&, Eigen::Matrix<double, -1, 1, 0, -1, 1>::Scalar, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> >&);
+template void igl::marching_cubes<Eigen::Matrix<double, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, unsigned int, unsigned int, unsigned int, Eigen::Matrix<double, -1, 1, 0, -1, 1>::Scalar, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> >&, std::unordered_map<std::int64_t,int>&);
 #endif
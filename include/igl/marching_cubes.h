@@ -26,6 +26,11 @@ namespace igl
   /// @param[out] V  #V by 3 list of mesh vertex positions
   /// @param[out] F  #F by 3 list of mesh triangle indices into rows of V
   ///
+  /// \note Slabs of cubes are marched in parallel. Each edge vertex is owned
+  /// by the first cube containing it, so no edge hash map is needed and V, F
+  /// are identical to (and in the same order as) a serial march.
+  ///
+  /// \see marching_cubes_streaming for grids that do not fit in memory
   template <
     typename DerivedS, 
     typename DerivedGV, 
@@ -45,7 +50,8 @@ namespace igl
   /// \brief Return edge-to-vertex map which can be used to implement
   /// batched root finding by caller (see 909_BatchMarchingCubes)
   ///
-  /// @param[out] E2V  map from edge key to index into rows of V
+  /// @param[out] E2V  map from edge key to index into rows of V (cleared
+  ///   first)
   template <
     typename DerivedS, 
     typename DerivedGV, 
@@ -69,6 +75,9 @@ namespace igl
   /// @param[in] GV  #S by 3 list of referenced grid vertex positions
   /// @param[in] GI  #GI by 8 list of grid corner indices into rows of GV (e.g.,
   /// as output by igl::sparse_voxel_grid) in y-x-z binary counting order.
+  ///
+  /// \note Cubes are marched in parallel and crossed edges are deduplicated
+  /// by sorting their keys, so V, F match a serial march.
   template <
     typename DerivedS, 
     typename DerivedGV, 
@@ -0,0 +1,240 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 Alec Jacobson <alecjacobson@gmail.com>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#ifndef IGL_MARCHING_CUBES_STREAMING_H
+#define IGL_MARCHING_CUBES_STREAMING_H
+#include <Eigen/Core>
+
+namespace igl
+{
+  /// Out-of-core marching cubes on a dense grid too large to hold in memory.
+  /// The grid is pulled one z-slice at a time from a callback and the mesh
+  /// is pushed to a sink slab by slab, so memory is proportional to one
+  /// slice (two slices of values and positions plus per-edge ids of one
+  /// slab) instead of the whole volume.
+  ///
+  /// Concatenating the chunks passed to sink gives exactly the output of
+  /// igl::marching_cubes on the full grid.
+  ///
+  /// @tparam Scalar  scalar type of values and positions
+  /// @tparam SliceFunc  callable as 
+  ///   `slice(z,Sz,GVz)` with `const unsigned z`, 
+  ///   `Eigen::Matrix<Scalar,Eigen::Dynamic,1> & Sz`, 
+  ///   `Eigen::Matrix<Scalar,Eigen::Dynamic,3> & GVz`
+  /// @tparam SinkFunc  callable as `sink(V,F)` with
+  ///   `const Eigen::Matrix<Scalar,Eigen::Dynamic,3> & V`,
+  ///   `const Eigen::Matrix<int,Eigen::Dynamic,3> & F`
+  /// @param[in] nx  resolutions of the grid in x dimension
+  /// @param[in] ny  resolutions of the grid in y dimension
+  /// @param[in] nz  resolutions of the grid in z dimension
+  /// @param[in] slice  called once for each z=0,…,nz-1 in order to set Sz to
+  ///   the nx*ny values at grid corners (x,y,z), i.e. Sz(x + y*nx), and GVz
+  ///   to their nx*ny by 3 positions
+  /// @param[in] isovalue  the isovalue of the surface to reconstruct
+  /// @param[in] sink  called once for each slab of cubes between slices z
+  ///   and z+1 with the slab's new vertices V and faces F, which index all
+  ///   vertices passed to sink so far (e.g., 
+  ///   igl::StreamingPLYWriter::append)
+  ///
+  /// #### Example:
+  ///
+  /// \code{cpp}
+  ///     igl::StreamingPLYWriter writer;
+  ///     writer.open("surface.ply");
+  ///     igl::marching_cubes_streaming(nx,ny,nz,
+  ///       [&](const unsigned z,Eigen::VectorXd & Sz,
+  ///         Eigen::Matrix<double,Eigen::Dynamic,3> & GVz){ ... },
+  ///       0.0,
+  ///       [&](const Eigen::Matrix<double,Eigen::Dynamic,3> & V,
+  ///         const Eigen::Matrix<int,Eigen::Dynamic,3> & F)
+  ///       { writer.append(V,F); });
+  ///     writer.close();
+  /// \endcode
+  ///
+  /// \see marching_cubes
+  template <typename Scalar, typename SliceFunc, typename SinkFunc>
+  inline void marching_cubes_streaming(
+    const unsigned nx,
+    const unsigned ny,
+    const unsigned nz,
+    const SliceFunc & slice,
+    const Scalar isovalue,
+    const SinkFunc & sink);
+}
+
+// Implementation
+
+#include <algorithm>
+#include <bitset>
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+template <typename Scalar, typename SliceFunc, typename SinkFunc>
+inline void igl::marching_cubes_streaming(
+  const unsigned nx,
+  const unsigned ny,
+  const unsigned nz,
+  const SliceFunc & slice,
+  const Scalar isovalue,
+  const SinkFunc & sink)
+{
+#include "marching_cubes_tables.h"
+  typedef Eigen::Matrix<Scalar,Eigen::Dynamic,1> VectorS;
+  typedef Eigen::Matrix<Scalar,Eigen::Dynamic,3> MatrixV;
+  typedef Eigen::Matrix<int,Eigen::Dynamic,3> MatrixF;
+  typedef std::int64_t Index;
+  if(nx < 2 || ny < 2 || nz < 2) { return; }
+
+  // Same edge ownership as igl::marching_cubes: each edge vertex belongs to
+  // the first cube (in z-y-x order) containing the edge. Edges touching a
+  // slab are stored in 5 planes of nx*ny slots: x- and y-edges of its bottom
+  // face, x- and y-edges of its top face, z-edges. After each slab the top
+  // face becomes the next slab's bottom face.
+  const int corner[8][3] = 
+    {{0,0,0},{1,0,0},{1,1,0},{0,1,0},{0,0,1},{1,0,1},{1,1,1},{0,1,1}};
+  const Index nxy = Index(nx)*Index(ny);
+  Index coffset[8];
+  for(int c = 0;c<8;c++)
+  {
+    coffset[c] = corner[c][0] + Index(nx)*corner[c][1];
+  }
+  Index edge_slot[12];
+  int owned[8] = {0,0,0,0,0,0,0,0};
+  for(int e = 0;e<12;e++)
+  {
+    const int * a = corner[a2eConnection[e][0]];
+    const int * b = corner[a2eConnection[e][1]];
+    int axis = 0;
+    int lo[3];
+    for(int k = 0;k<3;k++)
+    {
+      if(a[k] != b[k]) { axis = k; }
+      lo[k] = std::min(a[k],b[k]);
+    }
+    const int plane = axis == 2 ? 4 : axis + 2*lo[2];
+    edge_slot[e] = plane*nxy + lo[0] + Index(nx)*lo[1];
+    for(int bits = 0;bits<8;bits++)
+    {
+      bool owns = true;
+      for(int k = 0;k<3;k++)
+      {
+        if(k != axis && lo[k] == 0 && !(bits & (1<<k))) { owns = false; }
+      }
+      if(owns) { owned[bits] |= 1<<e; }
+    }
+  }
+  int num_faces[256];
+  for(int c = 0;c<256;c++)
+  {
+    num_faces[c] = 0;
+    while(num_faces[c] < 5 && a2fConnectionTable[c][3*num_faces[c]] >= 0)
+    {
+      num_faces[c]++;
+    }
+  }
+
+  // Values and positions of the current slab's two slices
+  VectorS S[2];
+  MatrixV GV[2];
+  slice(0,S[0],GV[0]);
+  std::vector<int> ids(5*nxy,0);
+  std::vector<unsigned char> cube_flags((nx-1)*(ny-1));
+  MatrixV V;
+  MatrixF F;
+  // Number of vertices passed to sink so far
+  int n = 0;
+  for(unsigned z = 0;z+1<nz;z++)
+  {
+    // side[c] is the slice containing corner c
+    int side[8];
+    for(int c = 0;c<8;c++)
+    {
+      side[c] = (z + corner[c][2]) % 2;
+    }
+    slice(z+1,S[(z+1)%2],GV[(z+1)%2]);
+    assert(S[(z+1)%2].size() == nxy && "Sz should have nx*ny entries");
+    assert(GV[(z+1)%2].rows() == nxy && "GVz should have nx*ny rows");
+    std::copy(ids.begin()+2*nxy,ids.begin()+4*nxy,ids.begin());
+
+    // Count this slab's vertices and faces
+    Index num_v = 0;
+    Index num_f = 0;
+    for(Index y = 0;y<Index(ny)-1;y++)
+    {
+      for(Index x = 0;x<Index(nx)-1;x++)
+      {
+        const Index i = x+nx*y;
+        int c_flags = 0;
+        for(int c = 0;c<8;c++)
+        {
+          if(S[side[c]](i+coffset[c]) > isovalue){ c_flags |= 1<<c; }
+        }
+        cube_flags[x+(nx-1)*y] = c_flags;
+        num_v += std::bitset<12>(
+          aiCubeEdgeFlags[c_flags] & 
+          owned[(x==0) | ((y==0)<<1) | ((z==0)<<2)]).count();
+        num_f += num_faces[c_flags];
+      }
+    }
+
+    V.resize(num_v,3);
+    F.resize(num_f,3);
+    Index v = 0;
+    Index f = 0;
+    for(Index y = 0;y<Index(ny)-1;y++)
+    {
+      for(Index x = 0;x<Index(nx)-1;x++)
+      {
+        const Index i = x+nx*y;
+        const int c_flags = cube_flags[x+(nx-1)*y];
+        const int e_flags = aiCubeEdgeFlags[c_flags];
+        if(e_flags == 0) { continue; }
+        const int o_flags = 
+          e_flags & owned[(x==0) | ((y==0)<<1) | ((z==0)<<2)];
+        int edge_vertices[12];
+        for(int e = 0; e < 12; e++)
+        {
+          if(e_flags & (1<<e))
+          {
+            const Index slot = edge_slot[e] + i;
+            if(o_flags & (1<<e))
+            {
+              // find crossing point assuming linear interpolation along edges
+              const int ca = a2eConnection[e][0];
+              const int cb = a2eConnection[e][1];
+              const Index ia = i + coffset[ca];
+              const Index ib = i + coffset[cb];
+              const Scalar a = S[side[ca]](ia);
+              const Scalar b = S[side[cb]](ib);
+              const Scalar t = (isovalue - a)/(b - a);
+              V.row(v) = GV[side[ca]].row(ia) + 
+                t*(GV[side[cb]].row(ib) - GV[side[ca]].row(ia));
+              ids[slot] = n + int(v);
+              v++;
+            }
+            edge_vertices[e] = ids[slot];
+          }
+        }
+        for(int k = 0; k < num_faces[c_flags]; k++)
+        {
+          for(int c = 0;c<3;c++)
+          {
+            F(f,c) = edge_vertices[a2fConnectionTable[c_flags][3*k+c]];
+          }
+          f++;
+        }
+      }
+    }
+    assert(v == num_v);
+    assert(f == num_f);
+    sink(V,F);
+    n += int(num_v);
+  }
+}
+
+#endif
@@ -8,7 +8,6 @@
 #include "massmatrix.h"
 #include "massmatrix_intrinsic.h"
 #include "edge_lengths.h"
-#include "sparse.h"
 #include "doublearea.h"
 #include "volume.h"
 #include "voronoi_mass.h"
@@ -33,13 +32,16 @@ namespace igl
       const Eigen::MatrixBase<DerivedV>& V, 
       const Eigen::MatrixBase<DerivedF>& F, 
       const MassMatrixType type,
+      SparseAssemblyData & data,
       Eigen::SparseMatrix<Scalar>& M)
     {
       MassMatrixType eff_type = 
         type == MASSMATRIX_TYPE_DEFAULT? MASSMATRIX_TYPE_VORONOI : type;
       Eigen::Matrix<Scalar, Eigen::Dynamic, 3> l;
       igl::edge_lengths(V, F, l);
-      return massmatrix_intrinsic(l, F, eff_type, M);
+      // Matches massmatrix_intrinsic(l,F,type,M)
+      const int n = F.maxCoeff()+1;
+      return massmatrix_intrinsic(l, F, eff_type, n, data, M);
     }
   };
   
@@ -50,6 +52,7 @@ namespace igl
       const Eigen::MatrixBase<DerivedV>& V, 
       const Eigen::MatrixBase<DerivedF>& F, 
       const MassMatrixType type,
+      SparseAssemblyData & data,
       Eigen::SparseMatrix<Scalar>& M)
     {
       const int n = V.rows();
@@ -61,36 +64,56 @@ namespace igl
       Eigen::Matrix<Scalar, Eigen::Dynamic, 1> vol;
       volume(V, F, vol);
       vol = vol.array().abs();
-      Eigen::Matrix<typename DerivedF::Scalar ,Eigen::Dynamic,1> MI;
-      Eigen::Matrix<typename DerivedF::Scalar ,Eigen::Dynamic,1> MJ;
+      // Row and column indices are only needed to (re)compute the pattern.
+      // Voronoi contributes one diagonal entry per vertex, the other types a
+      // fixed number per element.
+      const int num_elements = eff_type == MASSMATRIX_TYPE_VORONOI ? n : m;
+      const int element_size =
+        eff_type == MASSMATRIX_TYPE_VORONOI ? 1 :
+        eff_type == MASSMATRIX_TYPE_FULL ? 16 : 4;
+      const std::uint64_t F_hash = SparseAssemblyData::hash(F);
+      const bool pattern =
+        !data.matches(n,n,num_elements,element_size,F_hash);
+      Eigen::VectorXi MI;
+      Eigen::VectorXi MJ;
       Eigen::Matrix<Scalar ,Eigen::Dynamic,1> MV;
   
       switch (eff_type)
       {
         case MASSMATRIX_TYPE_BARYCENTRIC:
-          MI.resize(m*4,1); MJ.resize(m*4,1); MV.resize(m*4,1);
-          MI.block(0*m,0,m,1) = F.col(0);
-          MI.block(1*m,0,m,1) = F.col(1);
-          MI.block(2*m,0,m,1) = F.col(2);
-          MI.block(3*m,0,m,1) = F.col(3);
-          MJ = MI;
+          if(pattern)
+          {
+            MI.resize(m*4,1);
+            MI.block(0*m,0,m,1) = F.col(0).template cast<int>();
+            MI.block(1*m,0,m,1) = F.col(1).template cast<int>();
+            MI.block(2*m,0,m,1) = F.col(2).template cast<int>();
+            MI.block(3*m,0,m,1) = F.col(3).template cast<int>();
+            MJ = MI;
+          }
           repmat(vol,4,1,MV);
           assert(MV.rows()==m*4&&MV.cols()==1);
           MV.array() /= 4.;
           break;
         case MASSMATRIX_TYPE_VORONOI:
           {
-            MI = decltype(MI)::LinSpaced(n,0,n-1);
-            MJ = MI;
+            if(pattern)
+            {
+              MI = decltype(MI)::LinSpaced(n,0,n-1);
+              MJ = MI;
+            }
             voronoi_mass(V,F,MV);
             break;
           }
         case MASSMATRIX_TYPE_FULL:
-          MI.resize(m*16,1); MJ.resize(m*16,1); MV.resize(m*16,1);
           // indicies and values of the element mass matrix entries in the order
           // (1,0),(2,0),(3,0),(2,1),(3,1),(0,1),(3,2),(0,2),(1,2),(0,3),(1,3),(2,3),(0,0),(1,1),(2,2),(3,3);
-          MI<<F.col(1),F.col(2),F.col(3),F.col(2),F.col(3),F.col(0),F.col(3),F.col(0),F.col(1),F.col(0),F.col(1),F.col(2),F.col(0),F.col(1),F.col(2),F.col(3);
-          MJ<<F.col(0),F.col(0),F.col(0),F.col(1),F.col(1),F.col(1),F.col(2),F.col(2),F.col(2),F.col(3),F.col(3),F.col(3),F.col(0),F.col(1),F.col(2),F.col(3);
+          if(pattern)
+          {
+            MI.resize(m*16,1); MJ.resize(m*16,1);
+            const Eigen::MatrixXi Fi = F.template cast<int>();
+            MI<<Fi.col(1),Fi.col(2),Fi.col(3),Fi.col(2),Fi.col(3),Fi.col(0),Fi.col(3),Fi.col(0),Fi.col(1),Fi.col(0),Fi.col(1),Fi.col(2),Fi.col(0),Fi.col(1),Fi.col(2),Fi.col(3);
+            MJ<<Fi.col(0),Fi.col(0),Fi.col(0),Fi.col(1),Fi.col(1),Fi.col(1),Fi.col(2),Fi.col(2),Fi.col(2),Fi.col(3),Fi.col(3),Fi.col(3),Fi.col(0),Fi.col(1),Fi.col(2),Fi.col(3);
+          }
           repmat(vol,16,1,MV);
           assert(MV.rows()==m*16&&MV.cols()==1);
           MV.block(0*m,0,12*m,1) /= 20.;
@@ -99,7 +122,12 @@ namespace igl
         default:
           assert(false && "Unknown Mass matrix eff_type");
       }
-      sparse(MI,MJ,MV,n,n,M);
+      if(pattern)
+      {
+        sparse_assembly_precompute(
+          MI,MJ,n,n,num_elements,element_size,F_hash,data);
+      }
+      sparse_assembly(data,[&MV](const int t){ return MV(t); },M);
     }
   };
   
@@ -110,12 +138,13 @@ namespace igl
       const Eigen::MatrixBase<DerivedV>& V,
       const Eigen::MatrixBase<DerivedF>& F,
       const MassMatrixType type,
+      SparseAssemblyData & data,
       Eigen::SparseMatrix<Scalar>& M)
     {
       if (F.cols() == 3) {
-        MassMatrixHelper<DerivedV, DerivedF, Scalar, 3>::compute(V, F, type, M);
+        MassMatrixHelper<DerivedV, DerivedF, Scalar, 3>::compute(V, F, type, data, M);
       } else if (F.cols() == 4) {
-        MassMatrixHelper<DerivedV, DerivedF, Scalar, 4>::compute(V, F, type, M);
+        MassMatrixHelper<DerivedV, DerivedF, Scalar, 4>::compute(V, F, type, data, M);
       } else {
         // Handle unsupported simplex size at runtime
         assert(false && "Unsupported simplex size");
@@ -131,7 +160,19 @@ IGL_INLINE void igl::massmatrix(
   const MassMatrixType type,
   Eigen::SparseMatrix<Scalar>& M)
 {
-  MassMatrixHelper<DerivedV, DerivedF, Scalar, DerivedF::ColsAtCompileTime>::compute(V, F, type, M);
+  SparseAssemblyData data;
+  return massmatrix(V,F,type,data,M);
+}
+
+template <typename DerivedV, typename DerivedF, typename Scalar>
+IGL_INLINE void igl::massmatrix(
+  const Eigen::MatrixBase<DerivedV> & V, 
+  const Eigen::MatrixBase<DerivedF> & F, 
+  const MassMatrixType type,
+  SparseAssemblyData & data,
+  Eigen::SparseMatrix<Scalar>& M)
+{
+  MassMatrixHelper<DerivedV, DerivedF, Scalar, DerivedF::ColsAtCompileTime>::compute(V, F, type, data, M);
 }
 
 #ifdef IGL_STATIC_LIBRARY
@@ -146,4 +187,6 @@ template void igl::massmatrix<Eigen::Matrix<double, -1, 3, 0, -1, 3>, Eigen::Mat
 template void igl::massmatrix<Eigen::Matrix<double, -1, 3, 0, -1, 3>, Eigen::Matrix<int, -1, 3, 0, -1, 3>, double>(Eigen::MatrixBase<Eigen::Matrix<double, -1, 3, 0, -1, 3> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 3, 0, -1, 3> > const&, igl::MassMatrixType, Eigen::SparseMatrix<double, 0, int>&);
 template void igl::massmatrix<Eigen::Matrix<double, -1, 3, 1, -1, 3>, Eigen::Matrix<int, -1, 3, 1, -1, 3>, double>(Eigen::MatrixBase<Eigen::Matrix<double, -1, 3, 1, -1, 3> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 3, 1, -1, 3> > const&, igl::MassMatrixType, Eigen::SparseMatrix<double, 0, int>&);
 template void igl::massmatrix<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, double>(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, igl::MassMatrixType, Eigen::SparseMatrix<double, 0, int>&);
+template void igl::massmatrix<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, double>(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, igl::MassMatrixType, igl::SparseAssemblyData&, Eigen::SparseMatrix<double, 0, int>&);
+template void igl::massmatrix<Eigen::Matrix<double, -1, 3, 0, -1, 3>, Eigen::Matrix<int, -1, 3, 0, -1, 3>, double>(Eigen::MatrixBase<Eigen::Matrix<double, -1, 3, 0, -1, 3> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 3, 0, -1, 3> > const&, igl::MassMatrixType, igl::SparseAssemblyData&, Eigen::SparseMatrix<double, 0, int>&);
 #endif
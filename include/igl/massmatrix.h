@@ -8,6 +8,7 @@
 #ifndef IGL_MASSMATRIX_H
 #define IGL_MASSMATRIX_H
 #include "igl_inline.h"
+#include "sparse_assembly.h"
 
 #include <Eigen/Dense>
 #include <Eigen/Sparse>
@@ -54,6 +55,20 @@ namespace igl
     const Eigen::MatrixBase<DerivedF> & F, 
     const MassMatrixType type,
     Eigen::SparseMatrix<Scalar>& M);
+  /// \overload
+  /// \brief Reuses the sparsity pattern of M across calls with the same F and
+  /// type (e.g., when only V changes).
+  ///
+  /// @param[in,out] data  sparsity pattern of M; (re)computed from F if
+  ///     empty or if the output size, #F, entries per element or the hash of
+  ///     F's indices differ from the stored ones
+  template <typename DerivedV, typename DerivedF, typename Scalar>
+  IGL_INLINE void massmatrix(
+    const Eigen::MatrixBase<DerivedV> & V, 
+    const Eigen::MatrixBase<DerivedF> & F, 
+    const MassMatrixType type,
+    SparseAssemblyData & data,
+    Eigen::SparseMatrix<Scalar>& M);
 }
 
 #ifndef IGL_STATIC_LIBRARY
@@ -7,7 +7,6 @@
 // obtain one at http://mozilla.org/MPL/2.0/.
 #include "massmatrix_intrinsic.h"
 #include "edge_lengths.h"
-#include "sparse.h"
 #include "doublearea.h"
 #include "repmat.h"
 #include <Eigen/Geometry>
@@ -32,6 +31,19 @@ IGL_INLINE void igl::massmatrix_intrinsic(
   const MassMatrixType type,
   const int n,
   Eigen::SparseMatrix<Scalar>& M)
+{
+  SparseAssemblyData data;
+  return massmatrix_intrinsic(l,F,type,n,data,M);
+}
+
+template <typename Derivedl, typename DerivedF, typename Scalar>
+IGL_INLINE void igl::massmatrix_intrinsic(
+  const Eigen::MatrixBase<Derivedl> & l, 
+  const Eigen::MatrixBase<DerivedF> & F, 
+  const MassMatrixType type,
+  const int n,
+  SparseAssemblyData & data,
+  Eigen::SparseMatrix<Scalar>& M)
 {
   MassMatrixType eff_type = type;
   const int m = F.rows();
@@ -44,19 +56,27 @@ IGL_INLINE void igl::massmatrix_intrinsic(
   assert(F.cols() == 3 && "only triangles supported");
   Eigen::Matrix<Scalar ,Eigen::Dynamic,1> dblA;
   doublearea(l,0.,dblA);
-  Eigen::Matrix<typename DerivedF::Scalar ,Eigen::Dynamic,1> MI;
-  Eigen::Matrix<typename DerivedF::Scalar ,Eigen::Dynamic,1> MJ;
+  // Row and column indices are only needed to (re)compute the pattern
+  const int element_size = eff_type == MASSMATRIX_TYPE_FULL ? 9 : 3;
+  const std::uint64_t F_hash = SparseAssemblyData::hash(F);
+  const bool pattern = !data.matches(n,n,m,element_size,F_hash);
+  Eigen::VectorXi MI;
+  Eigen::VectorXi MJ;
   Eigen::Matrix<Scalar ,Eigen::Dynamic,1> MV;
 
   switch(eff_type)
   {
     case MASSMATRIX_TYPE_BARYCENTRIC:
       // diagonal entries for each face corner
-      MI.resize(m*3,1); MJ.resize(m*3,1); MV.resize(m*3,1);
-      MI.block(0*m,0,m,1) = F.col(0);
-      MI.block(1*m,0,m,1) = F.col(1);
-      MI.block(2*m,0,m,1) = F.col(2);
-      MJ = MI;
+      if(pattern)
+      {
+        MI.resize(m*3,1);
+        MI.block(0*m,0,m,1) = F.col(0).template cast<int>();
+        MI.block(1*m,0,m,1) = F.col(1).template cast<int>();
+        MI.block(2*m,0,m,1) = F.col(2).template cast<int>();
+        MJ = MI;
+      }
+      MV.resize(m*3,1);
       repmat(dblA,3,1,MV);
       MV.array() /= 6.0;
       break;
@@ -64,11 +84,15 @@ IGL_INLINE void igl::massmatrix_intrinsic(
       {
         // diagonal entries for each face corner
         // http://www.alecjacobson.com/weblog/?p=874
-        MI.resize(m*3,1); MJ.resize(m*3,1); MV.resize(m*3,1);
-        MI.block(0*m,0,m,1) = F.col(0);
-        MI.block(1*m,0,m,1) = F.col(1);
-        MI.block(2*m,0,m,1) = F.col(2);
-        MJ = MI;
+        if(pattern)
+        {
+          MI.resize(m*3,1);
+          MI.block(0*m,0,m,1) = F.col(0).template cast<int>();
+          MI.block(1*m,0,m,1) = F.col(1).template cast<int>();
+          MI.block(2*m,0,m,1) = F.col(2).template cast<int>();
+          MJ = MI;
+        }
+        MV.resize(m*3,1);
 
         // Holy shit this needs to be cleaned up and optimized
         Eigen::Matrix<Scalar ,Eigen::Dynamic,3> cosines(m,3);
@@ -110,11 +134,16 @@ IGL_INLINE void igl::massmatrix_intrinsic(
         break;
       }
     case MASSMATRIX_TYPE_FULL:
-      MI.resize(m*9,1); MJ.resize(m*9,1); MV.resize(m*9,1);
       // indicies and values of the element mass matrix entries in the order
       // (0,1),(1,0),(1,2),(2,1),(2,0),(0,2),(0,0),(1,1),(2,2);
-      MI<<F.col(0),F.col(1),F.col(1),F.col(2),F.col(2),F.col(0),F.col(0),F.col(1),F.col(2);
-      MJ<<F.col(1),F.col(0),F.col(2),F.col(1),F.col(0),F.col(2),F.col(0),F.col(1),F.col(2);
+      if(pattern)
+      {
+        MI.resize(m*9,1); MJ.resize(m*9,1);
+        const Eigen::MatrixXi Fi = F.template cast<int>();
+        MI<<Fi.col(0),Fi.col(1),Fi.col(1),Fi.col(2),Fi.col(2),Fi.col(0),Fi.col(0),Fi.col(1),Fi.col(2);
+        MJ<<Fi.col(1),Fi.col(0),Fi.col(2),Fi.col(1),Fi.col(0),Fi.col(2),Fi.col(0),Fi.col(1),Fi.col(2);
+      }
+      MV.resize(m*9,1);
       repmat(dblA,9,1,MV);
       MV.block(0*m,0,6*m,1) /= 24.0;
       MV.block(6*m,0,3*m,1) /= 12.0;
@@ -122,7 +151,11 @@ IGL_INLINE void igl::massmatrix_intrinsic(
     default:
       assert(false && "Unknown Mass matrix eff_type");
   }
-  sparse(MI,MJ,MV,n,n,M);
+  if(pattern)
+  {
+    sparse_assembly_precompute(MI,MJ,n,n,m,element_size,F_hash,data);
+  }
+  sparse_assembly(data,[&MV](const int t){ return MV(t); },M);
 }
 
 #ifdef IGL_STATIC_LIBRARY
@@ -131,4 +164,6 @@ template void igl::massmatrix_intrinsic<Eigen::Matrix<double, -1, 3, 0, -1, 3>,
 template void igl::massmatrix_intrinsic<Eigen::Matrix<double, -1, 3, 0, -1, 3>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, double>(Eigen::MatrixBase<Eigen::Matrix<double, -1, 3, 0, -1, 3> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, igl::MassMatrixType, Eigen::SparseMatrix<double, 0, int>&);
 template void igl::massmatrix_intrinsic<Eigen::Matrix<double, -1, 3, 0, -1, 3>, Eigen::Matrix<int, -1, 3, 1, -1, 3>, double>(Eigen::MatrixBase<Eigen::Matrix<double, -1, 3, 0, -1, 3> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 3, 1, -1, 3> > const&, igl::MassMatrixType, Eigen::SparseMatrix<double, 0, int>&);
 template void igl::massmatrix_intrinsic<Eigen::Matrix<double, -1, 3, 0, -1, 3>, Eigen::Matrix<int, -1, 3, 0, -1, 3>, double>(Eigen::MatrixBase<Eigen::Matrix<double, -1, 3, 0, -1, 3> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 3, 0, -1, 3> > const&, igl::MassMatrixType, Eigen::SparseMatrix<double, 0, int>&);
+template void igl::massmatrix_intrinsic<Eigen::Matrix<double, -1, 3, 0, -1, 3>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, double>(Eigen::MatrixBase<Eigen::Matrix<double, -1, 3, 0, -1, 3> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, igl::MassMatrixType, const int, igl::SparseAssemblyData&, Eigen::SparseMatrix<double, 0, int>&);
+template void igl::massmatrix_intrinsic<Eigen::Matrix<double, -1, 3, 0, -1, 3>, Eigen::Matrix<int, -1, 3, 0, -1, 3>, double>(Eigen::MatrixBase<Eigen::Matrix<double, -1, 3, 0, -1, 3> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 3, 0, -1, 3> > const&, igl::MassMatrixType, const int, igl::SparseAssemblyData&, Eigen::SparseMatrix<double, 0, int>&);
 #endif
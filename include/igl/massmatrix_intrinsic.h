@@ -9,6 +9,7 @@
 #define IGL_MASSMATRIX_INTRINSIC_H
 #include "igl_inline.h"
 #include "massmatrix.h"
+#include "sparse_assembly.h"
 
 #include <Eigen/Dense>
 #include <Eigen/Sparse>
@@ -42,6 +43,21 @@ namespace igl
     const MassMatrixType type,
     const int n,
     Eigen::SparseMatrix<Scalar>& M);
+  /// \overload
+  /// \brief Reuses the sparsity pattern of M across calls with the same F and
+  /// type (e.g., when only l changes).
+  ///
+  /// @param[in,out] data  sparsity pattern of M; (re)computed from F if
+  ///     empty or if the output size, #F, entries per element or the hash of
+  ///     F's indices differ from the stored ones
+  template <typename Derivedl, typename DerivedF, typename Scalar>
+  IGL_INLINE void massmatrix_intrinsic(
+    const Eigen::MatrixBase<Derivedl> & l, 
+    const Eigen::MatrixBase<DerivedF> & F, 
+    const MassMatrixType type,
+    const int n,
+    SparseAssemblyData & data,
+    Eigen::SparseMatrix<Scalar>& M);
 }
 
 #ifndef IGL_STATIC_LIBRARY
@@ -54,6 +54,50 @@ namespace igl
     const bool pd,
     min_quad_with_fixed_data<T> & data
     );
+  /// Change the set of known indices of a system previously factored using
+  /// min_quad_with_fixed_precompute without refactoring it. Indices that
+  /// become known are enforced with Lagrange multipliers and indices that
+  /// become unknown border the existing factorization; both are eliminated
+  /// through a small dense Schur complement. Each index that changed since
+  /// the last full factorization costs one solve against that factorization
+  /// (reused across consecutive updates), so adding or removing a few
+  /// handles takes milliseconds.
+  ///
+  /// Only systems factored with LLT (pd and no Aeq) are updated this way;
+  /// otherwise, or once more than max_changes indices differ from the
+  /// factored known set, the system is factored from scratch.
+  ///
+  /// @param[in] A  n by n matrix of quadratic coefficients, as passed to
+  ///   min_quad_with_fixed_precompute
+  /// @param[in] known  new list of indices to known rows in Z (the order
+  ///   of Y in min_quad_with_fixed_solve)
+  /// @param[in] Aeq  m by n list of linear equality constraint coefficients,
+  ///   as passed to min_quad_with_fixed_precompute
+  /// @param[in] max_changes  maximum number of changed indices before
+  ///   refactoring
+  /// @param[in,out] data  factorization struct from
+  ///   min_quad_with_fixed_precompute
+  /// @return true on success, false on error
+  ///
+  /// #### Example:
+  ///
+  /// \code{cpp}
+  ///     igl::min_quad_with_fixed_data<double> data;
+  ///     igl::min_quad_with_fixed_precompute(A,b,Aeq,true,data);
+  ///     ...
+  ///     // user added a handle
+  ///     b.conservativeResize(b.size()+1);
+  ///     b(b.size()-1) = v;
+  ///     igl::min_quad_with_fixed_update(A,b,Aeq,data);
+  ///     igl::min_quad_with_fixed_solve(data,B,bc,Beq,Z);
+  /// \endcode
+  template <typename T, typename Derivedknown>
+  IGL_INLINE bool min_quad_with_fixed_update(
+    const Eigen::SparseMatrix<T>& A,
+    const Eigen::MatrixBase<Derivedknown> & known,
+    const Eigen::SparseMatrix<T>& Aeq,
+    min_quad_with_fixed_data<T> & data,
+    const int max_changes = 256);
   /// Solves a system previously factored using min_quad_with_fixed_precompute
   ///
   /// @tparam T  type of sparse matrix (e.g. double)
@@ -188,7 +232,7 @@ struct igl::min_quad_with_fixed_data
     LU = 2,
     QR_LLT = 3,
     NUM_SOLVER_TYPES = 4
-  } solver_type;
+  } solver_type = NUM_SOLVER_TYPES;
   /// Solver data (factorization)
   Eigen::SimplicialLLT <Eigen::SparseMatrix<T > > llt;
   Eigen::SimplicialLDLT<Eigen::SparseMatrix<T > > ldlt;
@@ -210,6 +254,34 @@ struct igl::min_quad_with_fixed_data
   Eigen::SparseMatrix<T> AeqTR1T;
   Eigen::SparseMatrix<T> AeqTE;
   Eigen::SparseMatrix<T> AeqTET;
+  /// Sparsity pattern of the last factored matrix: a precompute whose
+  /// matrix has the same pattern skips the symbolic analysis
+  Eigen::VectorXi factor_outer;
+  Eigen::VectorXi factor_inner;
+  /// Whether the known set was changed by min_quad_with_fixed_update since
+  /// the last factorization
+  bool updated = false;
+  /// Known and unknown indices of the factored system (known and unknown
+  /// differ from these after min_quad_with_fixed_update)
+  Eigen::VectorXi base_known;
+  Eigen::VectorXi base_unknown;
+  /// Indices of base_known that are now unknown
+  Eigen::VectorXi released;
+  /// Indices of base_unknown that are now known, and their positions in
+  /// base_unknown
+  Eigen::VectorXi fixed;
+  Eigen::VectorXi fixed_slot;
+  /// #known list of the position of each known index in base_known, or
+  /// -1-(its position in fixed)
+  Eigen::VectorXi known_slot;
+  /// A(released,base_unknown) and A(released,base_known)
+  Eigen::SparseMatrix<T> Aru;
+  Eigen::SparseMatrix<T> Ark;
+  /// #base_unknown by #released+#fixed solution of
+  /// A(base_unknown,base_unknown) W = [A(base_unknown,released) I(:,fixed_slot)]
+  Eigen::Matrix<T,Eigen::Dynamic,Eigen::Dynamic> W;
+  /// LU factorization of the Schur complement of the bordered system
+  Eigen::PartialPivLU<Eigen::Matrix<T,Eigen::Dynamic,Eigen::Dynamic> > S_lu;
   /// @private Debug
   Eigen::SparseMatrix<T> NA;
   Eigen::Matrix<T,Eigen::Dynamic,Eigen::Dynamic> NB;
@@ -22,8 +22,10 @@
 // Bug in unsupported/Eigen/SparseExtra needs iostream first
 #include <iostream>
 #include <unsupported/Eigen/SparseExtra>
+#include <algorithm>
 #include <cassert>
 #include <cstdio>
+#include <vector>
 #include "matlab_format.h"
 #include <type_traits>
 
@@ -107,6 +109,47 @@ IGL_INLINE bool igl::min_quad_with_fixed_precompute(
     data.unknown_lagrange.tail(data.lagrange.size()) = data.lagrange;
   }
 
+  // The factored system has no known-set updates
+  data.updated = false;
+  data.base_known = data.known;
+  data.base_unknown = data.unknown;
+  data.released.resize(0);
+  data.fixed.resize(0);
+  data.fixed_slot.resize(0);
+  data.known_slot = Eigen::VectorXi::LinSpaced(kr,0,kr-1);
+  data.Aru.resize(0,0);
+  data.Ark.resize(0,0);
+  data.W.resize(data.unknown.size(),0);
+
+  // Factor M, repeating the symbolic analysis only if M's pattern differs
+  // from that of the last matrix factored with the same solver type
+  const auto factorize = [&data](
+    auto & solver,
+    Eigen::SparseMatrix<T> & M,
+    const typename min_quad_with_fixed_data<T>::SolverType type)
+  {
+    M.makeCompressed();
+    const bool same_pattern =
+      data.solver_type == type &&
+      data.factor_outer.size() == M.outerSize()+1 &&
+      data.factor_inner.size() == M.nonZeros() &&
+      std::equal(
+        M.outerIndexPtr(),M.outerIndexPtr()+M.outerSize()+1,
+        data.factor_outer.data()) &&
+      std::equal(
+        M.innerIndexPtr(),M.innerIndexPtr()+M.nonZeros(),
+        data.factor_inner.data());
+    if(!same_pattern)
+    {
+      solver.analyzePattern(M);
+      data.factor_outer =
+        Eigen::Map<const Eigen::VectorXi>(M.outerIndexPtr(),M.outerSize()+1);
+      data.factor_inner =
+        Eigen::Map<const Eigen::VectorXi>(M.innerIndexPtr(),M.nonZeros());
+    }
+    solver.factorize(M);
+  };
+
   Eigen::SparseMatrix<T> Auu;
   slice(A,data.unknown,data.unknown,Auu);
   assert(Auu.size() != 0 && Auu.rows() > 0 && "There should be at least one unknown.");
@@ -224,7 +267,7 @@ IGL_INLINE bool igl::min_quad_with_fixed_precompute(
 #ifdef MIN_QUAD_WITH_FIXED_CPP_DEBUG
     cout<<"    llt"<<endl;
 #endif
-      data.llt.compute(Auu);
+      factorize(data.llt,Auu,min_quad_with_fixed_data<T>::LLT);
       switch(data.llt.info())
       {
         case Eigen::Success:
@@ -255,7 +298,7 @@ IGL_INLINE bool igl::min_quad_with_fixed_precompute(
 #ifdef MIN_QUAD_WITH_FIXED_CPP_DEBUG
         cout<<"    ldlt"<<endl;
 #endif
-        data.ldlt.compute(NA);
+        factorize(data.ldlt,NA,min_quad_with_fixed_data<T>::LDLT);
         switch(data.ldlt.info())
         {
           case Eigen::Success:
@@ -279,7 +322,7 @@ IGL_INLINE bool igl::min_quad_with_fixed_precompute(
 #endif
         // Resort to LU
         // Bottleneck >1/2
-        data.lu.compute(NA);
+        factorize(data.lu,NA,min_quad_with_fixed_data<T>::LU);
         //std::cout<<"NA=["<<std::endl<<NA<<std::endl<<"];"<<std::endl;
         switch(data.lu.info())
         {
@@ -369,7 +412,7 @@ IGL_INLINE bool igl::min_quad_with_fixed_precompute(
       cout<<"    factorize"<<endl;
 #endif
       // QRAuu should always be PD
-      data.llt.compute(QRAuu);
+      factorize(data.llt,QRAuu,min_quad_with_fixed_data<T>::QR_LLT);
       switch(data.llt.info())
       {
         case Eigen::Success:
@@ -407,6 +450,162 @@ IGL_INLINE bool igl::min_quad_with_fixed_precompute(
 }
 
 
+template <typename T, typename Derivedknown>
+IGL_INLINE bool igl::min_quad_with_fixed_update(
+  const Eigen::SparseMatrix<T>& A,
+  const Eigen::MatrixBase<Derivedknown> & known,
+  const Eigen::SparseMatrix<T>& Aeq,
+  min_quad_with_fixed_data<T> & data,
+  const int max_changes)
+{
+  typedef Eigen::Matrix<T,Eigen::Dynamic,Eigen::Dynamic> MatrixXT;
+  const int n = data.n;
+  assert(A.rows() == n && A.cols() == n && "A should match precompute");
+  const int kr = known.size();
+  const int nu0 = data.base_unknown.size();
+  const int nk0 = data.base_known.size();
+  assert((kr == 0 || known.minCoeff() >= 0)&& "known indices should be in [0,n)");
+  assert((kr == 0 || known.maxCoeff() < n) && "known indices should be in [0,n)");
+  // Positions in the factored system
+  Eigen::VectorXi base_known_slot = Eigen::VectorXi::Constant(n,-1);
+  Eigen::VectorXi base_unknown_slot = Eigen::VectorXi::Constant(n,-1);
+  for(int i = 0;i<nk0;i++) { base_known_slot(data.base_known(i)) = i; }
+  for(int u = 0;u<nu0;u++) { base_unknown_slot(data.base_unknown(u)) = u; }
+  std::vector<bool> is_known(n,false);
+  for(int i = 0;i<kr;i++) { is_known[known(i)] = true; }
+  // Changes with respect to the factored system
+  std::vector<int> released,fixed;
+  for(int i = 0;i<nk0;i++)
+  {
+    if(!is_known[data.base_known(i)]) { released.push_back(data.base_known(i)); }
+  }
+  for(int i = 0;i<kr;i++)
+  {
+    if(base_known_slot(known(i)) < 0) { fixed.push_back(known(i)); }
+  }
+  const int nr = released.size();
+  const int nc = fixed.size();
+  if(
+    data.solver_type != min_quad_with_fixed_data<T>::LLT ||
+    nr+nc > max_changes ||
+    nr+nc >= nu0)
+  {
+    // Factor from scratch
+    return min_quad_with_fixed_precompute(A,known,Aeq,data.Auu_pd,data);
+  }
+
+  // Columns of W already solved for by a previous update
+  Eigen::VectorXi old_column = Eigen::VectorXi::Constant(n,-1);
+  for(int j = 0;j<data.released.size();j++)
+  {
+    old_column(data.released(j)) = j;
+  }
+  for(int j = 0;j<data.fixed.size();j++)
+  {
+    old_column(data.fixed(j)) = data.released.size()+j;
+  }
+  // Rows of A (symmetric since Auu is positive definite) of released indices
+  Eigen::VectorXi released_slot = Eigen::VectorXi::Constant(n,-1);
+  for(int i = 0;i<nr;i++) { released_slot(released[i]) = i; }
+  std::vector<Eigen::Triplet<T> > Aru_ijv,Ark_ijv;
+  MatrixXT Arr = MatrixXT::Zero(nr,nr);
+  for(int i = 0;i<nr;i++)
+  {
+    for(typename Eigen::SparseMatrix<T>::InnerIterator it(A,released[i]);it;++it)
+    {
+      const int j = it.row();
+      if(base_unknown_slot(j) >= 0)
+      {
+        Aru_ijv.emplace_back(i,base_unknown_slot(j),it.value());
+      }else
+      {
+        Ark_ijv.emplace_back(i,base_known_slot(j),it.value());
+        if(released_slot(j) >= 0) { Arr(i,released_slot(j)) = it.value(); }
+      }
+    }
+  }
+  Eigen::SparseMatrix<T> Aru(nr,nu0),Ark(nr,nk0);
+  Aru.setFromTriplets(Aru_ijv.begin(),Aru_ijv.end());
+  Ark.setFromTriplets(Ark_ijv.begin(),Ark_ijv.end());
+
+  // W = Auu⁻¹ [Aur I(:,fixed)], solving only for new columns
+  MatrixXT W(nu0,nr+nc);
+  std::vector<int> new_columns;
+  for(int j = 0;j<nr+nc;j++)
+  {
+    const int index = j<nr ? released[j] : fixed[j-nr];
+    if(old_column(index) >= 0)
+    {
+      W.col(j) = data.W.col(old_column(index));
+    }else
+    {
+      new_columns.push_back(j);
+    }
+  }
+  if(!new_columns.empty())
+  {
+    const Eigen::SparseMatrix<T> Aur = Aru.transpose();
+    MatrixXT rhs = MatrixXT::Zero(nu0,new_columns.size());
+    for(int c = 0;c<int(new_columns.size());c++)
+    {
+      const int j = new_columns[c];
+      if(j<nr)
+      {
+        rhs.col(c) = Aur.col(j);
+      }else
+      {
+        rhs(base_unknown_slot(fixed[j-nr]),c) = 1;
+      }
+    }
+    // llt factors 0.5*Auu
+    const MatrixXT sol = 0.5*data.llt.solve(rhs);
+    for(int c = 0;c<int(new_columns.size());c++)
+    {
+      W.col(new_columns[c]) = sol.col(c);
+    }
+  }
+
+  // Schur complement of the bordered system
+  //   [Auu Aur C'] [x]
+  //   [Aru Arr 0 ] [z]
+  //   [C   0   0 ] [λ]
+  // where C selects the fixed rows of x
+  Eigen::VectorXi fixed_slot(nc);
+  for(int i = 0;i<nc;i++) { fixed_slot(i) = base_unknown_slot(fixed[i]); }
+  MatrixXT S(nr+nc,nr+nc);
+  S.topRows(nr) = -(Aru*W);
+  S.topLeftCorner(nr,nr) += Arr;
+  S.bottomRows(nc) = -W(fixed_slot,igl::placeholders::all);
+  data.S_lu.compute(S);
+
+  data.updated = true;
+  data.released = Eigen::Map<const Eigen::VectorXi>(released.data(),nr);
+  data.fixed = Eigen::Map<const Eigen::VectorXi>(fixed.data(),nc);
+  data.fixed_slot = fixed_slot;
+  data.Aru = Aru;
+  data.Ark = Ark;
+  data.W = W;
+  data.known = known.template cast<int>();
+  data.known_slot.resize(kr);
+  {
+    Eigen::VectorXi fixed_position = Eigen::VectorXi::Constant(n,-1);
+    for(int i = 0;i<nc;i++) { fixed_position(fixed[i]) = i; }
+    for(int i = 0;i<kr;i++)
+    {
+      data.known_slot(i) = base_known_slot(known(i)) >= 0 ?
+        base_known_slot(known(i)) : -1-fixed_position(known(i));
+    }
+  }
+  data.unknown.resize(n-kr);
+  for(int i = 0,u = 0;i<n;i++)
+  {
+    if(!is_known[i]) { data.unknown(u++) = i; }
+  }
+  data.unknown_lagrange = data.unknown;
+  return true;
+}
+
+
 template <
   typename T,
   typename DerivedB,
@@ -445,6 +644,69 @@ IGL_INLINE bool igl::min_quad_with_fixed_solve(
     }
   }
 
+  if(data.updated)
+  {
+    // Known set was changed by min_quad_with_fixed_update: solve the
+    // factored system bordered by released rows and fixed constraints
+    const int nr = data.released.size();
+    const int nc = data.fixed.size();
+    MatrixXT Y0 = MatrixXT::Zero(data.base_known.size(),cols);
+    MatrixXT YC(nc,cols);
+    for(int i = 0;i < kr;i++)
+    {
+      const int slot = data.known_slot(i);
+      if(slot >= 0)
+      {
+        Y0.row(slot) = Y.row(i).template cast<T>();
+      }else
+      {
+        YC.row(-1-slot) = Y.row(i).template cast<T>();
+      }
+    }
+    MatrixXT BB = MatrixXT::Zero(data.n,cols);
+    if(B.size() > 0)
+    {
+      BB = B.template cast<T>().replicate(1,B.cols()==cols?1:cols);
+    }
+    // llt factors 0.5*Auu
+    MatrixXT x = -0.5*data.llt.solve(
+      MatrixXT(BB(data.base_unknown,igl::placeholders::all) + data.preY*Y0));
+    if(nr+nc > 0)
+    {
+      MatrixXT rhs(nr+nc,cols);
+      rhs.topRows(nr) =
+        -(BB(data.released,igl::placeholders::all) + data.Ark*Y0) -
+        data.Aru*x;
+      rhs.bottomRows(nc) = YC - x(data.fixed_slot,igl::placeholders::all);
+      const MatrixXT s = data.S_lu.solve(rhs);
+      x -= data.W*s;
+      for(int i = 0;i<nr;i++)
+      {
+        for(int j = 0;j<cols;j++)
+        {
+          Z(data.released(i),j) = s(i,j);
+        }
+      }
+    }
+    for(int u = 0;u<data.base_unknown.size();u++)
+    {
+      for(int j = 0;j<cols;j++)
+      {
+        Z(data.base_unknown(u),j) = x(u,j);
+      }
+    }
+    // Fixed rows of x only satisfy their constraints up to roundoff
+    for(int i = 0;i < kr;i++)
+    {
+      for(int j = 0;j < cols;j++)
+      {
+        Z(data.known(i),j) = Y(i,j);
+      }
+    }
+    sol = Z(data.unknown,igl::placeholders::all);
+    return true;
+  }
+
   if(data.Aeq_li)
   {
     // number of lagrange multipliers aka linear equality constraints
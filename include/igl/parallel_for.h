@@ -31,6 +31,13 @@ namespace igl
   /// available on the current hardware to parallelize this for loop so long as
   /// loop_size<min_parallel, otherwise it will just use a serial for loop.
   ///
+  /// Loops are executed on the persistent, work-stealing igl::ThreadPool
+  /// returned by `ThreadPool::global()` (sized by igl::default_num_threads),
+  /// so no threads are created per call. Loops issued from inside another
+  /// parallel loop run serially unless the pool's nested policy says
+  /// otherwise. Use an igl::ThreadPool object directly to run on a different
+  /// pool.
+  ///
   /// Often if your code looks like:
   ///
   /// \code{cpp}
@@ -112,6 +119,7 @@ namespace igl
 // Implementation
 
 #include "default_num_threads.h"
+#include "ThreadPool.h"
 
 #include <cmath>
 #include <cassert>
@@ -144,63 +152,16 @@ inline bool igl::parallel_for(
   const AccumFunctionType & accum_func,
   const size_t min_parallel)
 {
-  assert(loop_size>=0);
-  if(loop_size==0) return false;
-  // Estimate number of threads in the pool
-  // http://ideone.com/Z7zldb
 #ifdef IGL_PARALLEL_FOR_FORCE_SERIAL
-  const size_t nthreads = 1;
+  assert(loop_size>=0);
+  prep_func(1);
+  for(Index i = 0;i<loop_size;i++) func(i,0);
+  accum_func(0);
+  return false;
 #else
-  const size_t nthreads = igl::default_num_threads();
+  return igl::ThreadPool::global().parallel_for(
+    loop_size,prep_func,func,accum_func,min_parallel);
 #endif
-  if(loop_size<min_parallel || nthreads<=1)
-  {
-    // serial
-    prep_func(1);
-    for(Index i = 0;i<loop_size;i++) func(i,0);
-    accum_func(0);
-    return false;
-  }else
-  {
-    // Size of a slice for the range functions
-    Index slice =
-      std::max(
-        (Index)std::round((loop_size+1)/static_cast<double>(nthreads)),(Index)1);
-
-    // [Helper] Inner loop
-    const auto & range = [&func](const Index k1, const Index k2, const size_t t)
-    {
-      for(Index k = k1; k < k2; k++) func(k,t);
-    };
-    prep_func(nthreads);
-    // Create pool and launch jobs
-    std::vector<std::thread> pool;
-    pool.reserve(nthreads);
-    // Inner range extents
-    Index i1 = 0;
-    Index i2 = std::min(0 + slice, loop_size);
-    {
-      size_t t = 0;
-      for (; t+1 < nthreads && i1 < loop_size; ++t)
-      {
-        pool.emplace_back(range, i1, i2, t);
-        i1 = i2;
-        i2 = std::min(i2 + slice, loop_size);
-      }
-      if (i1 < loop_size)
-      {
-        pool.emplace_back(range, i1, loop_size, t);
-      }
-    }
-    // Wait for jobs to finish
-    for (std::thread &t : pool) if (t.joinable()) t.join();
-    // Accumulate across threads
-    for(size_t t = 0;t<nthreads;t++)
-    {
-      accum_func(t);
-    }
-    return true;
-  }
 }
 
 //#ifndef IGL_STATIC_LIBRARY
@@ -0,0 +1,240 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 Alec Jacobson <alecjacobson@gmail.com>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#ifndef IGL_PARSE_ASCII_NUMBER_H
+#define IGL_PARSE_ASCII_NUMBER_H
+
+namespace igl
+{
+  /// Whitespace test matching std::isspace in the "C" locale, without the
+  /// locale lookup.
+  ///
+  /// @param[in] c  character
+  /// @return true iff c is ' ', '\\t', '\\n', '\\v', '\\f' or '\\r'
+  inline bool is_ascii_space(const char c);
+  /// Parse a decimal integer (optional sign followed by digits) from a
+  /// non-null-terminated character range, like `strtol`/`%ld` but without
+  /// skipping leading whitespace.
+  ///
+  /// @tparam Int  integer type
+  /// @param[in,out] p  position to parse at; advanced past the number on
+  ///   success, untouched otherwise
+  /// @param[in] end  end of the character range
+  /// @param[out] value  parsed value
+  /// @return true iff at least one digit was parsed
+  template <typename Int>
+  inline bool parse_ascii_integer(const char * & p, const char * end, Int & value);
+  /// Parse a real number from a non-null-terminated character range,
+  /// producing exactly the value `strtod` (Scalar=double) or `strtof`
+  /// (Scalar=float) would (i.e., correctly rounded). Decimal inputs with at
+  /// most 19 significant digits and a small exponent take an exact
+  /// fast path (Clinger's algorithm); anything else (long mantissas, large
+  /// exponents, inf, nan, hex) falls back to the C library. Does not skip
+  /// leading whitespace.
+  ///
+  /// @tparam Scalar  float, double or long double
+  /// @param[in,out] p  position to parse at; advanced past the number on
+  ///   success, untouched otherwise
+  /// @param[in] end  end of the character range
+  /// @param[out] value  parsed value
+  /// @return true iff a number was parsed
+  template <typename Scalar>
+  inline bool parse_ascii_real(const char * & p, const char * end, Scalar & value);
+}
+
+// Implementation
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <type_traits>
+
+inline bool igl::is_ascii_space(const char c)
+{
+  return c==' ' || (c>='\t' && c<='\r');
+}
+
+template <typename Int>
+inline bool igl::parse_ascii_integer(const char * & p, const char * end, Int & value)
+{
+  const char * s = p;
+  bool negative = false;
+  if(s<end && (*s=='+' || *s=='-'))
+  {
+    negative = *s=='-';
+    s++;
+  }
+  if(s>=end || *s<'0' || *s>'9') { return false; }
+  std::uint64_t v = 0;
+  for(;s<end && *s>='0' && *s<='9';s++)
+  {
+    v = v*10 + static_cast<std::uint64_t>(*s-'0');
+  }
+  value = static_cast<Int>(negative ? -static_cast<std::int64_t>(v) : static_cast<std::int64_t>(v));
+  p = s;
+  return true;
+}
+
+template <typename Scalar>
+inline bool igl::parse_ascii_real(const char * & p, const char * end, Scalar & value)
+{
+  const char * s = p;
+  bool negative = false;
+  if(s<end && (*s=='+' || *s=='-'))
+  {
+    negative = *s=='-';
+    s++;
+  }
+  // Significant digits (at most 19 fit in 64 bits)
+  std::uint64_t mantissa = 0;
+  int num_digits = 0;
+  int exponent = 0;
+  bool any_digit = false;
+  bool truncated = false;
+  for(;s<end && *s>='0' && *s<='9';s++)
+  {
+    any_digit = true;
+    const int d = *s-'0';
+    if(num_digits < 19)
+    {
+      if(mantissa != 0 || d != 0)
+      {
+        mantissa = mantissa*10 + d;
+        num_digits++;
+      }
+    }else
+    {
+      exponent++;
+      truncated |= d != 0;
+    }
+  }
+  if(s<end && *s=='.')
+  {
+    s++;
+    for(;s<end && *s>='0' && *s<='9';s++)
+    {
+      any_digit = true;
+      const int d = *s-'0';
+      if(num_digits < 19)
+      {
+        if(mantissa != 0 || d != 0)
+        {
+          mantissa = mantissa*10 + d;
+          num_digits++;
+        }
+        exponent--;
+      }else
+      {
+        truncated |= d != 0;
+      }
+    }
+  }
+  const auto & fallback = [&](const char * stop)->bool
+  {
+    // Copy to null-terminated storage, the input range need not be
+    char small[64];
+    std::string large;
+    const std::size_t n = std::size_t(stop-p);
+    const char * str;
+    if(n < sizeof(small))
+    {
+      std::memcpy(small,p,n);
+      small[n] = '\0';
+      str = small;
+    }else
+    {
+      large.assign(p,n);
+      str = large.c_str();
+    }
+    char * parse_end = nullptr;
+    Scalar v;
+    if(std::is_same<Scalar,float>::value)
+    {
+      v = static_cast<Scalar>(std::strtof(str,&parse_end));
+    }else if(std::is_same<Scalar,double>::value)
+    {
+      v = static_cast<Scalar>(std::strtod(str,&parse_end));
+    }else
+    {
+      v = static_cast<Scalar>(std::strtold(str,&parse_end));
+    }
+    if(parse_end == str) { return false; }
+    value = v;
+    p += parse_end-str;
+    return true;
+  };
+  if(!any_digit)
+  {
+    // inf, nan, ...: let the C library decide (at most a few characters)
+    const char * stop = p + 40 < end ? p + 40 : end;
+    return fallback(stop);
+  }
+  if(s<end && (*s=='e' || *s=='E'))
+  {
+    const char * t = s+1;
+    bool exponent_negative = false;
+    if(t<end && (*t=='+' || *t=='-'))
+    {
+      exponent_negative = *t=='-';
+      t++;
+    }
+    if(t<end && *t>='0' && *t<='9')
+    {
+      int e = 0;
+      for(;t<end && *t>='0' && *t<='9';t++)
+      {
+        if(e < 100000) { e = e*10 + (*t-'0'); }
+      }
+      exponent += exponent_negative ? -e : e;
+      s = t;
+    }
+    // otherwise 'e' is not part of the number
+  }
+  // Hexadecimal floats are left to the C library
+  if(s<end && (*s=='x' || *s=='X'))
+  {
+    const char * stop = s;
+    while(stop<end && !is_ascii_space(*stop)) { stop++; }
+    return fallback(stop);
+  }
+  if(mantissa == 0 && !truncated)
+  {
+    value = negative ? -Scalar(0) : Scalar(0);
+    p = s;
+    return true;
+  }
+  // Clinger's fast path: mantissa and power of ten are both exactly
+  // representable so a single correctly rounded operation gives the
+  // correctly rounded result.
+  typedef typename std::conditional<
+    std::is_same<Scalar,float>::value,float,double>::type Work;
+  const int max_exponent = std::is_same<Work,float>::value ? 10 : 22;
+  const std::uint64_t max_mantissa =
+    std::uint64_t(1) << std::numeric_limits<Work>::digits;
+  if(
+    !std::is_same<Scalar,long double>::value &&
+    !truncated &&
+    mantissa <= max_mantissa &&
+    exponent >= -max_exponent && exponent <= max_exponent)
+  {
+    static const Work powers[] = {
+      Work(1e0), Work(1e1), Work(1e2), Work(1e3), Work(1e4), Work(1e5),
+      Work(1e6), Work(1e7), Work(1e8), Work(1e9), Work(1e10), Work(1e11),
+      Work(1e12), Work(1e13), Work(1e14), Work(1e15), Work(1e16), Work(1e17),
+      Work(1e18), Work(1e19), Work(1e20), Work(1e21), Work(1e22)};
+    Work v = static_cast<Work>(mantissa);
+    v = exponent < 0 ? v / powers[-exponent] : v * powers[exponent];
+    value = static_cast<Scalar>(negative ? -v : v);
+    p = s;
+    return true;
+  }
+  return fallback(s);
+}
+
+#endif
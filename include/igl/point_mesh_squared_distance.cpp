@@ -43,6 +43,8 @@ IGL_INLINE void point_mesh_squared_distance(
   // Common code for 2D and 3D
   igl::AABB<DerivedV, DIM> tree;
   tree.init(V,Ele);
+  // Test points against small clusters of triangles at once
+  tree.freeze(V,Ele);
   tree.squared_distance(V,Ele,P,sqrD,I,C);
 }
 
@@ -0,0 +1,297 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 Alec Jacobson <alecjacobson@gmail.com>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#include "point_triangle_cluster_squared_distance.h"
+#if !defined(IGL_NO_SIMD) && defined(__AVX__)
+#  include <immintrin.h>
+#elif !defined(IGL_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64))
+#  include <emmintrin.h>
+#endif
+
+namespace igl
+{
+  namespace internal
+  {
+    // Lane-wise arithmetic, comparisons and blends on `size` values at once.
+    // Masks are whatever the comparisons return.
+    template <typename Scalar>
+    struct cluster_pack
+    {
+      static constexpr int size = 1;
+      typedef Scalar Type;
+      typedef bool Mask;
+      static Type load(const Scalar * x) { return *x; }
+      static void store(Scalar * x, const Type a) { *x = a; }
+      static Type set1(const Scalar a) { return a; }
+      static Type add(const Type a, const Type b) { return a+b; }
+      static Type sub(const Type a, const Type b) { return a-b; }
+      static Type mul(const Type a, const Type b) { return a*b; }
+      static Type div(const Type a, const Type b) { return a/b; }
+      static Mask le(const Type a, const Type b) { return a<=b; }
+      static Mask ge(const Type a, const Type b) { return a>=b; }
+      static Mask ne(const Type a, const Type b) { return a!=b; }
+      static Mask and_(const Mask a, const Mask b) { return a && b; }
+      static Mask or_(const Mask a, const Mask b) { return a || b; }
+      // a and not b
+      static Mask andnot(const Mask a, const Mask b) { return a && !b; }
+      static Type select(const Mask m, const Type a, const Type b)
+      {
+        return m ? a : b;
+      }
+    };
+#if !defined(IGL_NO_SIMD) && defined(__AVX__)
+    template <>
+    struct cluster_pack<double>
+    {
+      static constexpr int size = 4;
+      typedef __m256d Type;
+      typedef __m256d Mask;
+      static Type load(const double * x) { return _mm256_loadu_pd(x); }
+      static void store(double * x, const Type a) { _mm256_storeu_pd(x,a); }
+      static Type set1(const double a) { return _mm256_set1_pd(a); }
+      static Type add(const Type a, const Type b) { return _mm256_add_pd(a,b); }
+      static Type sub(const Type a, const Type b) { return _mm256_sub_pd(a,b); }
+      static Type mul(const Type a, const Type b) { return _mm256_mul_pd(a,b); }
+      static Type div(const Type a, const Type b) { return _mm256_div_pd(a,b); }
+      static Mask le(const Type a, const Type b)
+      {
+        return _mm256_cmp_pd(a,b,_CMP_LE_OQ);
+      }
+      static Mask ge(const Type a, const Type b)
+      {
+        return _mm256_cmp_pd(a,b,_CMP_GE_OQ);
+      }
+      static Mask ne(const Type a, const Type b)
+      {
+        return _mm256_cmp_pd(a,b,_CMP_NEQ_UQ);
+      }
+      static Mask and_(const Mask a, const Mask b) { return _mm256_and_pd(a,b); }
+      static Mask or_(const Mask a, const Mask b) { return _mm256_or_pd(a,b); }
+      static Mask andnot(const Mask a, const Mask b)
+      {
+        return _mm256_andnot_pd(b,a);
+      }
+      static Type select(const Mask m, const Type a, const Type b)
+      {
+        return _mm256_blendv_pd(b,a,m);
+      }
+    };
+    template <>
+    struct cluster_pack<float>
+    {
+      static constexpr int size = 8;
+      typedef __m256 Type;
+      typedef __m256 Mask;
+      static Type load(const float * x) { return _mm256_loadu_ps(x); }
+      static void store(float * x, const Type a) { _mm256_storeu_ps(x,a); }
+      static Type set1(const float a) { return _mm256_set1_ps(a); }
+      static Type add(const Type a, const Type b) { return _mm256_add_ps(a,b); }
+      static Type sub(const Type a, const Type b) { return _mm256_sub_ps(a,b); }
+      static Type mul(const Type a, const Type b) { return _mm256_mul_ps(a,b); }
+      static Type div(const Type a, const Type b) { return _mm256_div_ps(a,b); }
+      static Mask le(const Type a, const Type b)
+      {
+        return _mm256_cmp_ps(a,b,_CMP_LE_OQ);
+      }
+      static Mask ge(const Type a, const Type b)
+      {
+        return _mm256_cmp_ps(a,b,_CMP_GE_OQ);
+      }
+      static Mask ne(const Type a, const Type b)
+      {
+        return _mm256_cmp_ps(a,b,_CMP_NEQ_UQ);
+      }
+      static Mask and_(const Mask a, const Mask b) { return _mm256_and_ps(a,b); }
+      static Mask or_(const Mask a, const Mask b) { return _mm256_or_ps(a,b); }
+      static Mask andnot(const Mask a, const Mask b)
+      {
+        return _mm256_andnot_ps(b,a);
+      }
+      static Type select(const Mask m, const Type a, const Type b)
+      {
+        return _mm256_blendv_ps(b,a,m);
+      }
+    };
+#elif !defined(IGL_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64))
+    template <>
+    struct cluster_pack<double>
+    {
+      static constexpr int size = 2;
+      typedef __m128d Type;
+      typedef __m128d Mask;
+      static Type load(const double * x) { return _mm_loadu_pd(x); }
+      static void store(double * x, const Type a) { _mm_storeu_pd(x,a); }
+      static Type set1(const double a) { return _mm_set1_pd(a); }
+      static Type add(const Type a, const Type b) { return _mm_add_pd(a,b); }
+      static Type sub(const Type a, const Type b) { return _mm_sub_pd(a,b); }
+      static Type mul(const Type a, const Type b) { return _mm_mul_pd(a,b); }
+      static Type div(const Type a, const Type b) { return _mm_div_pd(a,b); }
+      static Mask le(const Type a, const Type b) { return _mm_cmple_pd(a,b); }
+      static Mask ge(const Type a, const Type b) { return _mm_cmpge_pd(a,b); }
+      static Mask ne(const Type a, const Type b) { return _mm_cmpneq_pd(a,b); }
+      static Mask and_(const Mask a, const Mask b) { return _mm_and_pd(a,b); }
+      static Mask or_(const Mask a, const Mask b) { return _mm_or_pd(a,b); }
+      static Mask andnot(const Mask a, const Mask b)
+      {
+        return _mm_andnot_pd(b,a);
+      }
+      static Type select(const Mask m, const Type a, const Type b)
+      {
+        return _mm_or_pd(_mm_and_pd(m,a),_mm_andnot_pd(m,b));
+      }
+    };
+    template <>
+    struct cluster_pack<float>
+    {
+      static constexpr int size = 4;
+      typedef __m128 Type;
+      typedef __m128 Mask;
+      static Type load(const float * x) { return _mm_loadu_ps(x); }
+      static void store(float * x, const Type a) { _mm_storeu_ps(x,a); }
+      static Type set1(const float a) { return _mm_set1_ps(a); }
+      static Type add(const Type a, const Type b) { return _mm_add_ps(a,b); }
+      static Type sub(const Type a, const Type b) { return _mm_sub_ps(a,b); }
+      static Type mul(const Type a, const Type b) { return _mm_mul_ps(a,b); }
+      static Type div(const Type a, const Type b) { return _mm_div_ps(a,b); }
+      static Mask le(const Type a, const Type b) { return _mm_cmple_ps(a,b); }
+      static Mask ge(const Type a, const Type b) { return _mm_cmpge_ps(a,b); }
+      static Mask ne(const Type a, const Type b) { return _mm_cmpneq_ps(a,b); }
+      static Mask and_(const Mask a, const Mask b) { return _mm_and_ps(a,b); }
+      static Mask or_(const Mask a, const Mask b) { return _mm_or_ps(a,b); }
+      static Mask andnot(const Mask a, const Mask b)
+      {
+        return _mm_andnot_ps(b,a);
+      }
+      static Type select(const Mask m, const Type a, const Type b)
+      {
+        return _mm_or_ps(_mm_and_ps(m,a),_mm_andnot_ps(m,b));
+      }
+    };
+#endif
+  }
+}
+
+template <typename Scalar>
+IGL_INLINE void igl::point_triangle_cluster_squared_distance(
+  const Scalar * p,
+  const TriangleCluster<Scalar> & cluster,
+  Scalar & sqr_d,
+  int & i,
+  Scalar * c)
+{
+  typedef internal::cluster_pack<Scalar> P;
+  typedef typename P::Type T;
+  typedef typename P::Mask M;
+  constexpr int N = TriangleCluster<Scalar>::capacity;
+  static_assert(N % P::size == 0,"Cluster must hold whole packs");
+  assert(cluster.size > 0 && cluster.size <= N);
+  Scalar lane_sqr_d[N];
+  Scalar lane_c[3][N];
+  const T zero = P::set1(Scalar(0));
+  const T one = P::set1(Scalar(1));
+  const T q[3] = {P::set1(p[0]),P::set1(p[1]),P::set1(p[2])};
+  const auto dot = [](const T * u, const T * v)->T
+  {
+    return P::add(P::add(P::mul(u[0],v[0]),P::mul(u[1],v[1])),P::mul(u[2],v[2]));
+  };
+  for(int t = 0;t<N;t += P::size)
+  {
+    T a[3],b[3],cc[3],ab[3],ac[3],ap[3],bp[3],cp[3];
+    for(int d = 0;d<3;d++)
+    {
+      a[d] = P::load(&cluster.x[0][d][t]);
+      b[d] = P::load(&cluster.x[1][d][t]);
+      cc[d] = P::load(&cluster.x[2][d][t]);
+      ab[d] = P::sub(b[d],a[d]);
+      ac[d] = P::sub(cc[d],a[d]);
+      ap[d] = P::sub(q[d],a[d]);
+      bp[d] = P::sub(q[d],b[d]);
+      cp[d] = P::sub(q[d],cc[d]);
+    }
+    // Real-time collision detection, Ericson, Chapter 5: same tests as
+    // point_simplex_squared_distance but every region is evaluated and the
+    // first region in Ericson's order wins
+    const T d1 = dot(ab,ap);
+    const T d2 = dot(ac,ap);
+    const T d3 = dot(ab,bp);
+    const T d4 = dot(ac,bp);
+    const T d5 = dot(ab,cp);
+    const T d6 = dot(ac,cp);
+    const T vc = P::sub(P::mul(d1,d4),P::mul(d3,d2));
+    const T vb = P::sub(P::mul(d5,d2),P::mul(d1,d6));
+    const T va = P::sub(P::mul(d3,d6),P::mul(d5,d4));
+    const T d43 = P::sub(d4,d3);
+    const T d56 = P::sub(d5,d6);
+    // vertex region outside A
+    const M in_a = P::and_(P::le(d1,zero),P::le(d2,zero));
+    M taken = in_a;
+    // vertex region outside B
+    const M in_b = P::andnot(P::and_(P::ge(d3,zero),P::le(d4,d3)),taken);
+    taken = P::or_(taken,in_b);
+    // edge region of AB (unless A and B coincide)
+    const M a_ne_b = P::or_(P::or_(
+      P::ne(a[0],b[0]),P::ne(a[1],b[1])),P::ne(a[2],b[2]));
+    const M in_ab = P::andnot(P::and_(a_ne_b,P::and_(P::le(vc,zero),
+      P::and_(P::ge(d1,zero),P::le(d3,zero)))),taken);
+    taken = P::or_(taken,in_ab);
+    // vertex region outside C
+    const M in_c = P::andnot(P::and_(P::ge(d6,zero),P::le(d5,d6)),taken);
+    taken = P::or_(taken,in_c);
+    // edge region of AC
+    const M in_ac = P::andnot(P::and_(P::le(vb,zero),
+      P::and_(P::ge(d2,zero),P::le(d6,zero))),taken);
+    taken = P::or_(taken,in_ac);
+    // edge region of BC
+    const M in_bc = P::andnot(P::and_(P::le(va,zero),
+      P::and_(P::ge(d43,zero),P::ge(d56,zero))),taken);
+    taken = P::or_(taken,in_bc);
+    // Only divide where the region is actually used so that masked lanes do
+    // not raise floating point exceptions
+    const T v_ab = P::div(d1,P::select(in_ab,P::sub(d1,d3),one));
+    const T w_ac = P::div(d2,P::select(in_ac,P::sub(d2,d6),one));
+    const T w_bc = P::div(d43,P::select(in_bc,P::add(d43,d56),one));
+    const T denom = P::div(one,P::select(taken,one,P::add(P::add(va,vb),vc)));
+    const T v = P::mul(vb,denom);
+    const T w = P::mul(vc,denom);
+    T sqr_d_t = zero;
+    for(int d = 0;d<3;d++)
+    {
+      // face region
+      T cd = P::add(P::add(a[d],P::mul(ab[d],v)),P::mul(ac[d],w));
+      cd = P::select(in_bc,P::add(b[d],P::mul(w_bc,P::sub(cc[d],b[d]))),cd);
+      cd = P::select(in_ac,P::add(a[d],P::mul(w_ac,ac[d])),cd);
+      cd = P::select(in_c,cc[d],cd);
+      cd = P::select(in_ab,P::add(a[d],P::mul(v_ab,ab[d])),cd);
+      cd = P::select(in_b,b[d],cd);
+      cd = P::select(in_a,a[d],cd);
+      P::store(&lane_c[d][t],cd);
+      const T e = P::sub(q[d],cd);
+      sqr_d_t = P::add(sqr_d_t,P::mul(e,e));
+    }
+    P::store(&lane_sqr_d[t],sqr_d_t);
+  }
+  int best = 0;
+  for(int t = 1;t<cluster.size;t++)
+  {
+    if(lane_sqr_d[t] < lane_sqr_d[best])
+    {
+      best = t;
+    }
+  }
+  sqr_d = lane_sqr_d[best];
+  i = cluster.primitive[best];
+  for(int d = 0;d<3;d++)
+  {
+    c[d] = lane_c[d][best];
+  }
+}
+
+#ifdef IGL_STATIC_LIBRARY
+// Explicit template instantiation
+template void igl::point_triangle_cluster_squared_distance<double>(double const*, igl::TriangleCluster<double> const&, double&, int&, double*);
+template void igl::point_triangle_cluster_squared_distance<float>(float const*, igl::TriangleCluster<float> const&, float&, int&, float*);
+#endif
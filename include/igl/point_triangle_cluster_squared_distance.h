@@ -0,0 +1,87 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 Alec Jacobson <alecjacobson@gmail.com>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#ifndef IGL_POINT_TRIANGLE_CLUSTER_SQUARED_DISTANCE_H
+#define IGL_POINT_TRIANGLE_CLUSTER_SQUARED_DISTANCE_H
+#include "igl_inline.h"
+#include <Eigen/Core>
+#include <cassert>
+namespace igl
+{
+  /// Small group of 3d triangles stored coordinate-wise (structure of arrays)
+  /// so that one point can be tested against all of them with SIMD
+  /// instructions, see point_triangle_cluster_squared_distance.
+  ///
+  /// @tparam Scalar  type of vertex positions (float or double)
+  template <typename Scalar>
+  struct alignas(32) TriangleCluster
+  {
+    /// Maximum number of triangles in a cluster
+    static constexpr int capacity = 8;
+    /// x[k][d][t] is the dth coordinate of the kth corner of triangle t
+    Scalar x[3][3][capacity];
+    /// index of each triangle (e.g., into Ele)
+    int primitive[capacity];
+    /// number of triangles in this cluster
+    int size = 0;
+    /// Append a triangle (segments and points can be stored by repeating
+    /// corners)
+    ///
+    /// @param[in] a  3-long first corner
+    /// @param[in] b  3-long second corner
+    /// @param[in] c  3-long third corner
+    /// @param[in] index  index of triangle
+    template <typename Deriveda, typename Derivedb, typename Derivedc>
+    void push_back(
+      const Eigen::MatrixBase<Deriveda> & a,
+      const Eigen::MatrixBase<Derivedb> & b,
+      const Eigen::MatrixBase<Derivedc> & c,
+      const int index)
+    {
+      assert(size < capacity);
+      for(int t = size;t<capacity;t++)
+      {
+        // Unused slots repeat the last triangle so that every lane computes
+        // on valid data
+        for(int d = 0;d<3;d++)
+        {
+          x[0][d][t] = Scalar(a(d));
+          x[1][d][t] = Scalar(b(d));
+          x[2][d][t] = Scalar(c(d));
+        }
+        primitive[t] = index;
+      }
+      size++;
+    }
+  };
+
+  /// Determine the closest triangle of a cluster to a point.
+  ///
+  /// All triangles are evaluated at once using AVX or SSE instructions if the
+  /// compiler targets them (`__AVX__`, `__SSE2__`), otherwise one at a time.
+  /// Define `IGL_NO_SIMD` to force the scalar version. Each triangle is
+  /// treated exactly as in point_simplex_squared_distance (Ericson's
+  /// closest point on triangle), so up to rounding the result is the same.
+  ///
+  /// @param[in] p  3-long query point
+  /// @param[in] cluster  non-empty cluster of triangles
+  /// @param[out] sqr_d  squared distance from p to closest triangle
+  /// @param[out] i  primitive of closest triangle (first in cluster if tied)
+  /// @param[out] c  3-long closest point on closest triangle
+  template <typename Scalar>
+  IGL_INLINE void point_triangle_cluster_squared_distance(
+    const Scalar * p,
+    const TriangleCluster<Scalar> & cluster,
+    Scalar & sqr_d,
+    int & i,
+    Scalar * c);
+}
+
+#ifndef IGL_STATIC_LIBRARY
+#  include "point_triangle_cluster_squared_distance.cpp"
+#endif
+#endif
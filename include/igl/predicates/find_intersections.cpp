@@ -16,11 +16,14 @@
 #include "../placeholders.h"
 #include "triangle_triangle_intersect.h"
 #include "../triangle_triangle_intersect.h"
+#include "../parallel_for.h"
+#include "../default_num_threads.h"
 #include <stdio.h>
-// atomic
-#include <igl/parallel_for.h>
+#include <algorithm>
 #include <atomic>
-#include <mutex>
+#include <cassert>
+#include <utility>
+#include <vector>
 
 template <
   typename DerivedV1,
@@ -31,6 +34,7 @@ template <
   typename DerivedCP >
 IGL_INLINE bool igl::predicates::find_intersections(
   const igl::AABB<DerivedV1,3> & tree1,
+  const igl::AABB<DerivedV2,3> & tree2,
   const Eigen::MatrixBase<DerivedV1> & V1,
   const Eigen::MatrixBase<DerivedF1> & F1,
   const Eigen::MatrixBase<DerivedV2> & V2,
@@ -39,6 +43,9 @@ IGL_INLINE bool igl::predicates::find_intersections(
   Eigen::PlainObjectBase<DerivedIF> & IF,
   Eigen::PlainObjectBase<DerivedCP> & CP)
 {
+  // Traversal below walks m_left/m_right pointers, which a frozen tree
+  // doesn't have (its root would look like an empty leaf)
+  assert(!tree1.is_frozen() && "Pointer-based methods require thaw() first");
   const bool detect_only = true;
   constexpr bool stinker = false;
   using AABBTree=igl::AABB<DerivedV1,3>;
@@ -46,28 +53,20 @@ IGL_INLINE bool igl::predicates::find_intersections(
   static_assert(
     std::is_same<Scalar,typename DerivedV2::Scalar>::value,
     "V1 and V2 must have the same scalar type");
-  using RowVector3S=Eigen::Matrix<Scalar,1,3>;
 
   // Determine if V1,F1 and V2,F2 point to the same data
   const bool self_test = (&V1 == &V2) && (&F1 == &F2);
   if(stinker){ printf("%s\n",self_test?"🍎&(V1,F1) == 🍎&(V2,F2)":"🍎≠🍊"); }
 
-  int num_if = 0;
-  // mutex
-  std::mutex append_mutex;
-  const auto append_intersection = 
-    [&IF,&CP,&num_if,&append_mutex]( const int f1, const int f2, const bool coplanar = false)
+  // Intersecting pair (f1,f2) and whether it's coplanar
+  struct Intersection
   {
-    std::lock_guard<std::mutex> lock(append_mutex);
-    if(num_if >= IF.rows())
-    {
-      IF.conservativeResize(2*IF.rows()+1,2);
-      CP.conservativeResize(IF.rows());
-    }
-    CP(num_if) = coplanar;
-    IF.row(num_if) << f1,f2;
-    num_if++;
+    int f1,f2;
+    bool coplanar;
   };
+  // Set as soon as any intersection is found (used to stop early if
+  // first_only)
+  std::atomic<bool> found_any(false);
 
   // Returns corner in ith face opposite of shared edge; -1 otherwise
   const auto shared_edge = [&F1](const int f, const int g)->int
@@ -107,109 +106,249 @@ IGL_INLINE bool igl::predicates::find_intersections(
     return false;
   };
 
-  RowVector3S dummy;
-
-  igl::parallel_for(F2.rows(),[&](const int f2)
+  // Test candidate pair of faces f1 (in F1) and f2 (in F2), appending to
+  // thread's list of intersections (for self_test, expects f1 < f2)
+  const auto test_pair = [&](
+    const int f1,
+    const int f2,
+    std::vector<Intersection> & intersections)
   {
-    if(stinker){ printf("f2: %d\n",f2); }
-    Eigen::AlignedBox<Scalar,3> box;
-    box.extend( V2.row( F2(f2,0) ).transpose() );
-    box.extend( V2.row( F2(f2,1) ).transpose() );
-    box.extend( V2.row( F2(f2,2) ).transpose() );
-    std::vector<const AABBTree*> candidates;
-    tree1.append_intersecting_leaves(box, candidates);
-    for(const auto * candidate : candidates)
+    if(stinker){ printf("f1,f2: %d,%d\n",f1,f2); }
+    const auto append_intersection = 
+      [&intersections,&found_any,f1,f2](const bool coplanar = false)
     {
-      const int f1 = candidate->m_primitive;
-      if(stinker){ printf("  f1: %d\n",f1); }
-      bool found_intersection = false;
-      bool yes_shared_verted = false;
-      bool yes_shared_edge = false;
-      if(self_test)
+      intersections.push_back({f1,f2,coplanar});
+      found_any.store(true,std::memory_order_relaxed);
+    };
+    bool found_intersection = false;
+    bool yes_shared_verted = false;
+    bool yes_shared_edge = false;
+    if(self_test)
+    {
+      assert(f1 < f2);
+      const int c = shared_edge(f1,f2);
+      yes_shared_edge = c != -1;
+      if(yes_shared_edge)
       {
-        // Skip self-test and direction f2>=f1 (assumes by symmetry we'll find
-        // the other direction since we're testing all pairs)
-        if(f1 >= f2)
+        if(stinker){ printf("    ⚠️  shared edge\n"); }
+        if(stinker)
         {
-          if(stinker){ printf("    ⏭\n"); }
-          continue;
+          printf("    %d: %d %d %d\n",f1,F1(f1,0),F1(f1,1),F1(f1,2));
+          printf("    %d: %d %d %d\n",f2,F1(f2,0),F1(f2,1),F1(f2,2));
+          printf("   edge: %d %d\n",F1(f1,(c+1)%3),F1(f1,(c+2)%3));
         }
-        const int c = shared_edge(f1,f2);
-        yes_shared_edge = c != -1;
-        if(yes_shared_edge)
+        found_intersection = igl::triangle_triangle_intersect_shared_edge(
+          V1,F1,f1,c,V1.row(F1(f1,c)),f2,1e-8);
+        if(found_intersection)
         {
-          if(stinker){ printf("    ⚠️  shared edge\n"); }
-          if(stinker)
-          {
-            printf("    %d: %d %d %d\n",f1,F1(f1,0),F1(f1,1),F1(f1,2));
-            printf("    %d: %d %d %d\n",f2,F1(f2,0),F1(f2,1),F1(f2,2));
-            printf("   edge: %d %d\n",F1(f1,(c+1)%3),F1(f1,(c+2)%3));
-          }
-          found_intersection = igl::triangle_triangle_intersect_shared_edge(
-            V1,F1,f1,c,V1.row(F1(f1,c)),f2,1e-8);
-          if(found_intersection)
-          {
-            append_intersection(f1,f2,true);
-          }
-        }else
+          append_intersection(true);
+        }
+      }else
+      {
+        int sf,sg;
+        yes_shared_verted = shared_vertex(f1,f2,sf,sg);
+        if(yes_shared_verted)
         {
-          int sf,sg;
-          yes_shared_verted = shared_vertex(f1,f2,sf,sg);
-          if(yes_shared_verted)
+          if(stinker){ printf("    ⚠️  shared vertex\n"); }
+          // Just to be sure. c≠sf
+          const int c = (sf+1)%3;
+          assert(F1(f1,sf) == F1(f2,sg));
+          found_intersection = igl::triangle_triangle_intersect_shared_vertex(
+            V1,F1,f1,sf,c,V1.row(F1(f1,c)),f2,sg,1e-14);
+          if(found_intersection && detect_only)
           {
-            if(stinker){ printf("    ⚠️  shared vertex\n"); }
-            // Just to be sure. c≠sf
-            const int c = (sf+1)%3;
-            assert(F1(f1,sf) == F1(f2,sg));
-            found_intersection = igl::triangle_triangle_intersect_shared_vertex(
-              V1,F1,f1,sf,c,V1.row(F1(f1,c)),f2,sg,1e-14);
-            if(found_intersection && detect_only)
-            {
-              // But wait? Couldn't these be coplanar?
-              append_intersection(f1,f2,false);
-            }
+            // But wait? Couldn't these be coplanar?
+            append_intersection(false);
           }
-          
         }
+        
       }
-      // This logic is confusing. 
-      if(
-        !self_test || 
-        (!yes_shared_verted && !yes_shared_edge) || 
-        (yes_shared_verted && found_intersection && !detect_only))
+    }
+    // This logic is confusing. 
+    if(
+      !self_test || 
+      (!yes_shared_verted && !yes_shared_edge) || 
+      (yes_shared_verted && found_intersection && !detect_only))
+    {
+      bool coplanar = false;
+      const bool tt_found_intersection = 
+        triangle_triangle_intersect(
+          V2.row(F2(f2,0)).template head<3>().eval(),
+          V2.row(F2(f2,1)).template head<3>().eval(),
+          V2.row(F2(f2,2)).template head<3>().eval(),
+          V1.row(F1(f1,0)).template head<3>().eval(),
+          V1.row(F1(f1,1)).template head<3>().eval(),
+          V1.row(F1(f1,2)).template head<3>().eval(),
+          coplanar);
+      if(found_intersection && !tt_found_intersection)
       {
-        bool coplanar = false;
-        RowVector3S v1,v2;
-        const bool tt_found_intersection = 
-          triangle_triangle_intersect(
-            V2.row(F2(f2,0)).template head<3>().eval(),
-            V2.row(F2(f2,1)).template head<3>().eval(),
-            V2.row(F2(f2,2)).template head<3>().eval(),
-            V1.row(F1(f1,0)).template head<3>().eval(),
-            V1.row(F1(f1,1)).template head<3>().eval(),
-            V1.row(F1(f1,2)).template head<3>().eval(),
-            coplanar);
-        if(found_intersection && !tt_found_intersection)
-        {
-          // We failed to find the edge. Mark it as an intersection but don't
-          // include edge.
-          append_intersection(f1,f2,coplanar);
-        }else if(tt_found_intersection)
-        {
-          found_intersection = true;
-          append_intersection(f1,f2,coplanar);
-        }
+        // We failed to find the edge. Mark it as an intersection but don't
+        // include edge.
+        append_intersection(coplanar);
+      }else if(tt_found_intersection)
+      {
+        found_intersection = true;
+        append_intersection(coplanar);
+      }
+    }
+    if(stinker) { printf("    %s\n",found_intersection? "☠️":"❌"); }
+  };
+
+  std::vector<std::vector<Intersection> > thread_intersections;
+  // Simultaneous traversal of tree1 and tree2 visiting all pairs of leaves
+  // with overlapping boxes. For self_test, tree2 is tree1 and each unordered
+  // pair of distinct leaves is visited once.
+  const auto traverse = [&](const auto & tree2)
+  {
+    using AABBTree2 = typename std::decay<decltype(tree2)>::type;
+    using NodePair = std::pair<const AABBTree*,const AABBTree2*>;
+    // Append overlapping child pairs of (a,b) to pairs, or test (a,b) if
+    // both are leaves
+    const auto split = [&](
+      const NodePair & ab,
+      std::vector<NodePair> & pairs,
+      std::vector<Intersection> & intersections)
+    {
+      const AABBTree * a = ab.first;
+      const AABBTree2 * b = ab.second;
+      if(!a->m_box.intersects(b->m_box)) { return; }
+      const auto push = [&pairs](const AABBTree * c, const AABBTree2 * d)
+      {
+        if(c && d && c->m_box.intersects(d->m_box)) { pairs.emplace_back(c,d); }
+      };
+      if(self_test && (const void*)a == (const void*)b)
+      {
+        if(a->is_leaf()) { return; }
+        const AABBTree2 * bl = b->m_left;
+        const AABBTree2 * br = b->m_right;
+        push(a->m_left,bl);
+        push(a->m_left,br);
+        push(a->m_right,br);
+        return;
+      }
+      const bool a_leaf = a->is_leaf();
+      const bool b_leaf = b->is_leaf();
+      if(a_leaf && b_leaf)
+      {
+        int f1 = a->m_primitive;
+        int f2 = b->m_primitive;
+        if(f1 < 0 || f2 < 0) { return; }
+        if(self_test && f1 > f2) { std::swap(f1,f2); }
+        test_pair(f1,f2,intersections);
+        return;
       }
-      if(stinker) { printf("    %s\n",found_intersection? "☠️":"❌"); }
-      if(num_if && first_only) { return; }
+      // Descend into the larger box
+      if(b_leaf || (!a_leaf &&
+        a->m_box.sizes().squaredNorm() >= b->m_box.sizes().squaredNorm()))
+      {
+        push(a->m_left,b);
+        push(a->m_right,b);
+      }else
+      {
+        push(a,b->m_left);
+        push(a,b->m_right);
+      }
+    };
+
+    // Expand pairs breadth-first serially until there's enough to go around
+    std::vector<NodePair> frontier;
+    std::vector<Intersection> seed_intersections;
+    if(tree1.m_box.intersects(tree2.m_box))
+    {
+      frontier.emplace_back(&tree1,&tree2);
+    }
+    const size_t target = 16*igl::default_num_threads();
+    while(frontier.size() && frontier.size() < target)
+    {
+      std::vector<NodePair> next;
+      next.reserve(4*frontier.size());
+      for(const auto & ab : frontier) { split(ab,next,seed_intersections); }
+      frontier.swap(next);
     }
-    if(num_if && first_only) { return; }
-  },1000);
-  IF.conservativeResize(num_if,2);
-  CP.conservativeResize(IF.rows());
+
+    std::vector<std::vector<NodePair> > stacks;
+    igl::parallel_for(
+      frontier.size(),
+      [&](const size_t nt)
+      {
+        stacks.resize(nt);
+        thread_intersections.resize(nt);
+      },
+      [&](const size_t i, const size_t t)
+      {
+        auto & stack = stacks[t];
+        stack.clear();
+        stack.push_back(frontier[i]);
+        while(!stack.empty())
+        {
+          if(first_only && found_any.load(std::memory_order_relaxed))
+          {
+            return;
+          }
+          const NodePair ab = stack.back();
+          stack.pop_back();
+          split(ab,stack,thread_intersections[t]);
+        }
+      },
+      [](const size_t){},
+      1);
+    thread_intersections.push_back(std::move(seed_intersections));
+  };
+  if(self_test)
+  {
+    traverse(tree1);
+  }else
+  {
+    assert(!tree2.is_frozen() && "Pointer-based methods require thaw() first");
+    traverse(tree2);
+  }
+
+  // Gather in deterministic order
+  std::vector<Intersection> intersections;
+  for(auto & thread : thread_intersections)
+  {
+    intersections.insert(intersections.end(),thread.begin(),thread.end());
+  }
+  std::sort(intersections.begin(),intersections.end(),
+    [](const Intersection & x, const Intersection & y)
+    { return std::make_pair(x.f2,x.f1) < std::make_pair(y.f2,y.f1); });
+  if(first_only && intersections.size() > 1) { intersections.resize(1); }
+  IF.resize(intersections.size(),2);
+  CP.resize(IF.rows());
+  for(int i = 0;i<IF.rows();i++)
+  {
+    IF.row(i) << intersections[i].f1,intersections[i].f2;
+    CP(i) = intersections[i].coplanar;
+  }
   return IF.rows();
 }
 
+template <
+  typename DerivedV1,
+  typename DerivedF1,
+  typename DerivedV2,
+  typename DerivedF2,
+  typename DerivedIF,
+  typename DerivedCP >
+IGL_INLINE bool igl::predicates::find_intersections(
+  const igl::AABB<DerivedV1,3> & tree1,
+  const Eigen::MatrixBase<DerivedV1> & V1,
+  const Eigen::MatrixBase<DerivedF1> & F1,
+  const Eigen::MatrixBase<DerivedV2> & V2,
+  const Eigen::MatrixBase<DerivedF2> & F2,
+  const bool first_only,
+  Eigen::PlainObjectBase<DerivedIF> & IF,
+  Eigen::PlainObjectBase<DerivedCP> & CP)
+{
+  // Left empty for self-intersections (tree1 is traversed against itself)
+  igl::AABB<DerivedV2,3> tree2;
+  if(!((&V1 == &V2) && (&F1 == &F2)))
+  {
+    tree2.init(V2,F2);
+  }
+  return find_intersections(tree1,tree2,V1,F1,V2,F2,first_only,IF,CP);
+}
+
 template <
   typename DerivedV1,
   typename DerivedF1,
@@ -295,4 +434,6 @@ template bool igl::predicates::find_intersections<Eigen::Matrix<double, -1, -1,
 template bool igl::predicates::find_intersections<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Array<bool, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, 1, 0, -1, 1> >(igl::AABB<Eigen::Matrix<double, -1, -1, 0, -1, -1>, 3> const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Array<bool, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&);
 // generated by autoexplicit.sh
 template bool igl::predicates::find_intersections<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Array<bool, -1, 1, 0, -1, 1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, bool, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Array<bool, -1, 1, 0, -1, 1> >&);
+// generated by autoexplicit.sh
+template bool igl::predicates::find_intersections<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Array<bool, -1, 1, 0, -1, 1> >(igl::AABB<Eigen::Matrix<double, -1, -1, 0, -1, -1>, 3> const&, igl::AABB<Eigen::Matrix<double, -1, -1, 0, -1, -1>, 3> const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, bool, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Array<bool, -1, 1, 0, -1, 1> >&);
 #endif
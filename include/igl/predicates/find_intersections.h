@@ -19,16 +19,44 @@ namespace igl
     /// Identify triangles where two meshes interesect 
     /// using AABBTree and igl::predicates::triangle_triangle_intersect.
     ///
-    /// @param[in] tree1 AABB tree for the first mesh
+    /// Candidate pairs are found by traversing tree1 and tree2
+    /// simultaneously (tree1 against itself if (V1,F1) and (V2,F2) are the
+    /// same objects, i.e., for self-intersections). Output rows are sorted by
+    /// F2 index then F1 index.
+    ///
+    /// @param[in] tree1 AABB tree for the first mesh (not frozen)
+    /// @param[in] tree2 AABB tree for the second mesh (not frozen); ignored
+    ///   for self-intersections
     /// @param[in] V1  #V1 by 3 list representing vertices on the first mesh
     /// @param[in] F1  #F1 by 3 list representing triangles on the first mesh
     /// @param[in] V2  #V2 by 3 list representing vertices on the second mesh
     /// @param[in] F2  #F2 by 3 list representing triangles on the second mesh
+    /// @param[in] first_only  whether to stop as soon as an intersection is
+    ///   found (IF will then have at most one row)
     /// @param[out] IF #IF by 2 list of intersecting triangle pairs, so that 
     ///   F1(IF(i,0),:) intersects F2(IF(i,1),:)
     /// @param[out] CP #IF list of whether the intersection is coplanar
     ///
     /// \see copyleft::cgal::intersect_other
+    template <
+      typename DerivedV1,
+      typename DerivedF1,
+      typename DerivedV2,
+      typename DerivedF2,
+      typename DerivedIF,
+      typename DerivedCP>
+    IGL_INLINE bool find_intersections(
+      const AABB<DerivedV1,3> & tree1,
+      const AABB<DerivedV2,3> & tree2,
+      const Eigen::MatrixBase<DerivedV1> & V1,
+      const Eigen::MatrixBase<DerivedF1> & F1,
+      const Eigen::MatrixBase<DerivedV2> & V2,
+      const Eigen::MatrixBase<DerivedF2> & F2,
+      const bool first_only,
+      Eigen::PlainObjectBase<DerivedIF> & IF,
+      Eigen::PlainObjectBase<DerivedCP> & CP);
+    /// \overload
+    /// \brief Tree for the second mesh built internally.
     template <
       typename DerivedV1,
       typename DerivedF1,
@@ -46,7 +74,7 @@ namespace igl
       Eigen::PlainObjectBase<DerivedIF> & IF,
       Eigen::PlainObjectBase<DerivedCP> & CP);
     /// \overload
-    /// \brief Tree built internally.
+    /// \brief Trees built internally.
     template <
       typename DerivedV1,
       typename DerivedF1,
@@ -25,6 +25,7 @@
 #include "per_vertex_normals.h"
 #include "avg_edge_length.h"
 #include "vertex_triangle_adjacency.h"
+#include "parallel_for.h"
 
 typedef enum
 {
@@ -144,7 +145,10 @@ public:
   // The i-th row contains the indices of the vertices that forms the i-th face in ccw order
   Eigen::MatrixXi faces;
 
-  std::vector<std::vector<int> > vertex_to_vertices;
+  // Vertex adjacency in compressed rows: neighbors of vertex i are
+  // adjacency[adjacency_offsets[i]] to adjacency[adjacency_offsets[i+1]-1]
+  std::vector<int> adjacency_offsets;
+  std::vector<int> adjacency;
   std::vector<std::vector<int> > vertex_to_faces;
   std::vector<std::vector<int> > vertex_to_faces_index;
   Eigen::MatrixXd face_normals;
@@ -171,19 +175,49 @@ public:
   int step;  /* If expStep==false, by how much rhe radius increases on every step */
   int maxSize; /* The maximum limit of the radius in the benchmark */
 
+  // Scratch space reused across the neighborhood searches of one thread
+  class Workspace
+  {
+  public:
+    // visited[v] == epoch iff v has been visited by the current search
+    std::vector<unsigned int> visited;
+    unsigned int epoch = 0;
+    // FIFO of (vertex, distance) as a vector consumed from the front
+    std::vector<std::pair<int,int> > queue;
+    std::vector<int> vv;
+    std::vector<int> vvtmp;
+    // Start a new search over n vertices
+    IGL_INLINE void begin(const size_t n)
+    {
+      if(visited.size() != n)
+      {
+        visited.assign(n,0);
+        epoch = 0;
+      }
+      if(++epoch == 0)
+      {
+        // Wrapped around
+        std::fill(visited.begin(),visited.end(),0);
+        epoch = 1;
+      }
+      queue.clear();
+    }
+  };
+
   IGL_INLINE CurvatureCalculator();
   IGL_INLINE void init(const Eigen::MatrixXd& V, const Eigen::MatrixXi& F);
 
   IGL_INLINE void finalEigenStuff(int, const std::array<Eigen::Vector3d, 3>&, Quadric&);
   IGL_INLINE void fitQuadric(const Eigen::Vector3d&, const std::array<Eigen::Vector3d, 3>& ref, const std::vector<int>& , Quadric *);
   IGL_INLINE void applyProjOnPlane(const Eigen::Vector3d&, const std::vector<int>&, std::vector<int>&);
-  IGL_INLINE void getSphere(const int, const double, std::vector<int>&, int min);
-  IGL_INLINE void getKRing(const int, const double,std::vector<int>&);
+  IGL_INLINE void getSphere(const int, const double, std::vector<int>&, int min, Workspace&);
+  IGL_INLINE void getKRing(const int, const double,std::vector<int>&, Workspace&);
   IGL_INLINE Eigen::Vector3d project(const Eigen::Vector3d&, const Eigen::Vector3d&, const Eigen::Vector3d&);
   IGL_INLINE void computeReferenceFrame(int, const Eigen::Vector3d&, std::array<Eigen::Vector3d, 3>&);
   IGL_INLINE void getAverageNormal(int, const std::vector<int>&, Eigen::Vector3d&);
   IGL_INLINE void getProjPlane(int, const std::vector<int>&, Eigen::Vector3d&);
   IGL_INLINE void applyMontecarlo(const std::vector<int>&,std::vector<int>*);
+  IGL_INLINE bool computeCurvatureAt(const int, Workspace&);
   IGL_INLINE void computeCurvature();
   IGL_INLINE void printCurvature(const std::string& outpath);
   IGL_INLINE double getAverageEdge();
@@ -323,7 +357,22 @@ IGL_INLINE void CurvatureCalculator::init(const Eigen::MatrixXd& V, const Eigen:
 //  vertices = vertices.array() * (1.0/igl::avg_edge_length(V,F));
 
   faces = F;
-  igl::adjacency_list(F, vertex_to_vertices);
+  {
+    std::vector<std::vector<int> > vertex_to_vertices;
+    igl::adjacency_list(F, vertex_to_vertices);
+    // Vertices after the last one referenced by F have no neighbors
+    adjacency_offsets.assign(V.rows()+1,0);
+    for (size_t i=0; i<vertex_to_vertices.size(); ++i)
+      adjacency_offsets[i+1] = vertex_to_vertices[i].size();
+    for (size_t i=0; i<(size_t)V.rows(); ++i)
+      adjacency_offsets[i+1] += adjacency_offsets[i];
+    adjacency.resize(adjacency_offsets.back());
+    for (size_t i=0; i<vertex_to_vertices.size(); ++i)
+      std::copy(
+        vertex_to_vertices[i].begin(),
+        vertex_to_vertices[i].end(),
+        adjacency.begin()+adjacency_offsets[i]);
+  }
   igl::vertex_triangle_adjacency(V, F, vertex_to_faces, vertex_to_faces_index);
   igl::per_face_normals(V, F, face_normals);
   igl::per_vertex_normals(V, F, face_normals, vertex_normals);
@@ -433,32 +482,26 @@ IGL_INLINE void CurvatureCalculator::finalEigenStuff(int i, const std::array<Eig
   // ---- end Eigen stuff
 }
 
-IGL_INLINE void CurvatureCalculator::getKRing(const int start, const double r, std::vector<int>&vv)
+IGL_INLINE void CurvatureCalculator::getKRing(const int start, const double r, std::vector<int>&vv, Workspace& ws)
 {
-  int bufsize=vertices.rows();
-  vv.reserve(bufsize);
-  std::list<std::pair<int,int> > queue;
-  std::vector<bool> visited(bufsize, false);
+  ws.begin(vertices.rows());
+  std::vector<std::pair<int,int> >& queue = ws.queue;
   queue.push_back(std::pair<int,int>(start,0));
-  visited[start]=true;
-  while (!queue.empty())
+  ws.visited[start]=ws.epoch;
+  for (size_t head=0; head<queue.size(); ++head)
   {
-    int toVisit=queue.front().first;
-    int distance=queue.front().second;
-    queue.pop_front();
+    int toVisit=queue[head].first;
+    int distance=queue[head].second;
     vv.push_back(toVisit);
-    if(toVisit<vertex_to_vertices.size())
+    if (distance<(int)r)
     {
-      if (distance<(int)r)
+      for (int a=adjacency_offsets[toVisit]; a<adjacency_offsets[toVisit+1]; ++a)
       {
-        for (unsigned int i=0; i<vertex_to_vertices[toVisit].size(); ++i)
+        int neighbor=adjacency[a];
+        if (ws.visited[neighbor]!=ws.epoch)
         {
-          int neighbor=vertex_to_vertices[toVisit][i];
-          if (!visited[neighbor])
-          {
-            queue.push_back(std::pair<int,int> (neighbor,distance+1));
-            visited[neighbor]=true;
-          }
+          queue.push_back(std::pair<int,int> (neighbor,distance+1));
+          ws.visited[neighbor]=ws.epoch;
         }
       }
     }
@@ -466,33 +509,30 @@ IGL_INLINE void CurvatureCalculator::getKRing(const int start, const double r, s
 }
 
 
-IGL_INLINE void CurvatureCalculator::getSphere(const int start, const double r, std::vector<int> &vv, int min)
+IGL_INLINE void CurvatureCalculator::getSphere(const int start, const double r, std::vector<int> &vv, int min, Workspace& ws)
 {
-  int bufsize=vertices.rows();
-  vv.reserve(bufsize);
-  std::list<int> queue;
-  std::vector<bool> visited(bufsize, false);
-  queue.push_back(start);
-  visited[start]=true;
+  ws.begin(vertices.rows());
+  std::vector<std::pair<int,int> >& queue = ws.queue;
+  queue.push_back(std::pair<int,int>(start,0));
+  ws.visited[start]=ws.epoch;
   Eigen::Vector3d me=vertices.row(start);
   std::priority_queue<std::pair<int, double>, std::vector<std::pair<int, double> >, comparer > extra_candidates;
-  while (!queue.empty())
+  for (size_t head=0; head<queue.size(); ++head)
   {
-    int toVisit=queue.front();
-    queue.pop_front();
+    int toVisit=queue[head].first;
     vv.push_back(toVisit);
-    for (unsigned int i=0; i<vertex_to_vertices[toVisit].size(); ++i)
+    for (int a=adjacency_offsets[toVisit]; a<adjacency_offsets[toVisit+1]; ++a)
     {
-      int neighbor=vertex_to_vertices[toVisit][i];
-      if (!visited[neighbor])
+      int neighbor=adjacency[a];
+      if (ws.visited[neighbor]!=ws.epoch)
       {
         Eigen::Vector3d neigh=vertices.row(neighbor);
         double distance=(me-neigh).norm();
         if (distance<r)
-          queue.push_back(neighbor);
+          queue.push_back(std::pair<int,int>(neighbor,0));
         else if ((int)vv.size()<min)
           extra_candidates.push(std::pair<int,double>(neighbor,distance));
-        visited[neighbor]=true;
+        ws.visited[neighbor]=ws.epoch;
       }
     }
   }
@@ -501,15 +541,15 @@ IGL_INLINE void CurvatureCalculator::getSphere(const int start, const double r,
     std::pair<int, double> cand=extra_candidates.top();
     extra_candidates.pop();
     vv.push_back(cand.first);
-    for (unsigned int i=0; i<vertex_to_vertices[cand.first].size(); ++i)
+    for (int a=adjacency_offsets[cand.first]; a<adjacency_offsets[cand.first+1]; ++a)
     {
-      int neighbor=vertex_to_vertices[cand.first][i];
-      if (!visited[neighbor])
+      int neighbor=adjacency[a];
+      if (ws.visited[neighbor]!=ws.epoch)
       {
         Eigen::Vector3d neigh=vertices.row(neighbor);
         double distance=(me-neigh).norm();
         extra_candidates.push(std::pair<int,double>(neighbor,distance));
-        visited[neighbor]=true;
+        ws.visited[neighbor]=ws.epoch;
       }
     }
   }
@@ -523,7 +563,7 @@ IGL_INLINE Eigen::Vector3d CurvatureCalculator::project(const Eigen::Vector3d& v
 IGL_INLINE void CurvatureCalculator::computeReferenceFrame(int i, const Eigen::Vector3d& normal, std::array<Eigen::Vector3d, 3>& ref )
 {
 
-  Eigen::Vector3d longest_v=Eigen::Vector3d(vertices.row(vertex_to_vertices[i][0]));
+  Eigen::Vector3d longest_v=Eigen::Vector3d(vertices.row(adjacency[adjacency_offsets[i]]));
 
   longest_v=(project(vertices.row(i),longest_v,normal)-Eigen::Vector3d(vertices.row(i))).normalized();
 
@@ -638,6 +678,81 @@ IGL_INLINE void CurvatureCalculator::applyMontecarlo(const std::vector<int>& vin
   }
 }
 
+IGL_INLINE bool CurvatureCalculator::computeCurvatureAt(const int i, Workspace& ws)
+{
+  std::vector<int>& vv = ws.vv;
+  std::vector<int>& vvtmp = ws.vvtmp;
+  Eigen::Vector3d normal;
+  vv.clear();
+  vvtmp.clear();
+  Eigen::Vector3d me=vertices.row(i);
+  switch (st)
+  {
+    case SPHERE_SEARCH:
+      getSphere(i,scaledRadius,vv,6,ws);
+      break;
+    case K_RING_SEARCH:
+      getKRing(i,kRing,vv,ws);
+      break;
+    default:
+      fprintf(stderr,"Error: search type not recognized");
+      return false;
+  }
+
+  if (vv.size()<6)
+  {
+    //std::cerr << "Could not compute curvature of radius " << scaledRadius << std::endl;
+    return true;
+  }
+
+
+  if (projectionPlaneCheck)
+  {
+    vvtmp.reserve (vv.size ());
+    applyProjOnPlane (vertex_normals.row(i), vv, vvtmp);
+    if (vvtmp.size() >= 6 && vvtmp.size()<vv.size())
+      vv.swap(vvtmp);
+  }
+
+
+  switch (nt)
+  {
+    case AVERAGE:
+      getAverageNormal(i,vv,normal);
+      break;
+    case PROJ_PLANE:
+      getProjPlane(i,vv,normal);
+      break;
+    default:
+      fprintf(stderr,"Error: normal type not recognized");
+      return false;
+  }
+  if (vv.size()<6)
+  {
+    //std::cerr << "Could not compute curvature of radius " << scaledRadius << std::endl;
+    return true;
+  }
+  if (montecarlo)
+  {
+    if(montecarloN<6)
+      return false;
+    vvtmp.clear();
+    vvtmp.reserve(vv.size());
+    applyMontecarlo(vv,&vvtmp);
+    vv.swap(vvtmp);
+  }
+
+  if (vv.size()<6)
+    return false;
+  std::array<Eigen::Vector3d, 3> ref;
+  computeReferenceFrame(i,normal,ref);
+
+  Quadric q;
+  fitQuadric (me, ref, vv, &q);
+  finalEigenStuff(i,ref,q);
+  return true;
+}
+
 IGL_INLINE void CurvatureCalculator::computeCurvature()
 {
   //CHECK che esista la mesh
@@ -653,81 +768,31 @@ IGL_INLINE void CurvatureCalculator::computeCurvature()
 
   scaledRadius=getAverageEdge()*sphereRadius;
 
-  std::vector<int> vv;
-  std::vector<int> vvtmp;
-  Eigen::Vector3d normal;
-
-  //double time_spent;
-  //double searchtime=0, ref_time=0, fit_time=0, final_time=0;
-
-  for (size_t i=0; i<vertices_count; ++i)
+  if (montecarlo)
   {
-    vv.clear();
-    vvtmp.clear();
-    Eigen::Vector3d me=vertices.row(i);
-    switch (st)
+    // rand() is neither thread-safe nor reproducible across threads, and a
+    // failed vertex stops the whole computation
+    Workspace ws;
+    for (size_t i=0; i<vertices_count; ++i)
     {
-      case SPHERE_SEARCH:
-        getSphere(i,scaledRadius,vv,6);
+      if (!computeCurvatureAt(i,ws))
         break;
-      case K_RING_SEARCH:
-        getKRing(i,kRing,vv);
-        break;
-      default:
-        fprintf(stderr,"Error: search type not recognized");
-        return;
     }
-
-    if (vv.size()<6)
-    {
-      //std::cerr << "Could not compute curvature of radius " << scaledRadius << std::endl;
-      continue;
-    }
-
-
-    if (projectionPlaneCheck)
-    {
-      vvtmp.reserve (vv.size ());
-      applyProjOnPlane (vertex_normals.row(i), vv, vvtmp);
-      if (vvtmp.size() >= 6 && vvtmp.size()<vv.size())
-        vv = vvtmp;
-    }
-
-
-    switch (nt)
-    {
-      case AVERAGE:
-        getAverageNormal(i,vv,normal);
-        break;
-      case PROJ_PLANE:
-        getProjPlane(i,vv,normal);
-        break;
-      default:
-        fprintf(stderr,"Error: normal type not recognized");
-        return;
-    }
-    if (vv.size()<6)
-    {
-      //std::cerr << "Could not compute curvature of radius " << scaledRadius << std::endl;
-      continue;
-    }
-    if (montecarlo)
-    {
-      if(montecarloN<6)
-        break;
-      vvtmp.reserve(vv.size());
-      applyMontecarlo(vv,&vvtmp);
-      vv=vvtmp;
-    }
-
-    if (vv.size()<6)
-      return;
-    std::array<Eigen::Vector3d, 3> ref;
-    computeReferenceFrame(i,normal,ref);
-
-    Quadric q;
-    fitQuadric (me, ref, vv, &q);
-    finalEigenStuff(i,ref,q);
+  }
+  else
+  {
+    // Each vertex is independent: searches only read the mesh and results
+    // are written to the vertex's own entries of curv and curvDir
+    std::vector<Workspace> workspaces;
+    igl::parallel_for(
+      vertices_count,
+      [&workspaces](const size_t n){ workspaces.resize(n); },
+      [this,&workspaces](const size_t i, const size_t t)
+      {
+        computeCurvatureAt(i,workspaces[t]);
+      },
+      [](const size_t){},
+      1000);
   }
 
   lastRadius=sphereRadius;
@@ -31,6 +31,20 @@ IGL_INLINE bool igl::qslim(
   Eigen::MatrixXi & G,
   Eigen::VectorXi & J,
   Eigen::VectorXi & I)
+{
+  return igl::qslim(V,F,max_m,block_intersections,false,U,G,J,I);
+}
+
+IGL_INLINE bool igl::qslim(
+  const Eigen::MatrixXd & V,
+  const Eigen::MatrixXi & F,
+  const int max_m,
+  const bool block_intersections,
+  const bool parallel,
+  Eigen::MatrixXd & U,
+  Eigen::MatrixXi & G,
+  Eigen::VectorXi & J,
+  Eigen::VectorXi & I)
 {
   using namespace igl;
   igl::AABB<Eigen::MatrixXd, 3> * tree = nullptr;
@@ -87,6 +101,7 @@ IGL_INLINE bool igl::qslim(
     max_faces_stopping_condition(m,orig_m,max_m),
     pre_collapse,
     post_collapse,
+    parallel,
     U, G, J, I);
   // Remove phony boundary faces and clean up
   const Eigen::Array<bool,Eigen::Dynamic,1> keep = (J.array()<orig_m);
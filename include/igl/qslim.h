@@ -38,6 +38,21 @@ namespace igl
     Eigen::MatrixXi & G,
     Eigen::VectorXi & J,
     Eigen::VectorXi & I);
+  /// \overload
+  ///
+  /// @param[in] parallel  whether to collapse edges in rounds of independent
+  ///   collapses, recomputing costs in parallel (see
+  ///   batch_collapse_least_cost_edges)
+  IGL_INLINE bool qslim(
+    const Eigen::MatrixXd & V,
+    const Eigen::MatrixXi & F,
+    const int max_m,
+    const bool block_intersections,
+    const bool parallel,
+    Eigen::MatrixXd & U,
+    Eigen::MatrixXi & G,
+    Eigen::VectorXi & J,
+    Eigen::VectorXi & I);
 }
 #ifndef IGL_STATIC_LIBRARY
 #  include "qslim.cpp"
@@ -66,7 +66,7 @@ IGL_INLINE void igl::qslim_optimal_collapse_edge_callbacks(
     const Eigen::VectorXi &                             ,/*EMAP*/
     const Eigen::MatrixXi &                             ,/*EF*/
     const Eigen::MatrixXi &                             ,/*EI*/
-    const igl::min_heap< std::tuple<double,int,int> > & ,/*Q*/
+    const igl::IndexedHeap<double> &                    ,/*Q*/
     const Eigen::VectorXi &                             ,/*EQ*/
     const Eigen::MatrixXd &                             ,/*C*/
     const int e)->bool
@@ -83,7 +83,7 @@ IGL_INLINE void igl::qslim_optimal_collapse_edge_callbacks(
       const Eigen::VectorXi &                             ,/*EMAP*/
       const Eigen::MatrixXi &                             ,  /*EF*/
       const Eigen::MatrixXi &                             ,  /*EI*/
-      const igl::min_heap< std::tuple<double,int,int> > & ,/*Q*/
+      const igl::IndexedHeap<double> &                    ,/*Q*/
       const Eigen::VectorXi &                             ,/*EQ*/
       const Eigen::MatrixXd &                             ,   /*C*/
       const int                                           ,   /*e*/
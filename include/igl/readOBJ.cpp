@@ -7,18 +7,530 @@
 // obtain one at http://mozilla.org/MPL/2.0/.
 #include "readOBJ.h"
 
+#include "MappedFile.h"
 #include "list_to_matrix.h"
 #include "max_size.h"
 #include "min_size.h"
+#include "parallel_for.h"
+#include "parse_ascii_number.h"
 #include "polygon_corners.h"
 #include "polygons_to_triangles.h"
+#include "split_into_line_chunks.h"
 
+#include <algorithm>
 #include <cassert>
-#include <iostream>
 #include <cstdio>
-#include <fstream>
-#include <sstream>
-#include <iterator>
+#include <cstring>
+#include <tuple>
+
+namespace igl
+{
+  namespace readOBJ_internal
+  {
+    // Contents of a range of whole lines of an .obj file. Rows (which may
+    // have varying lengths) are stored flat alongside their sizes to avoid an
+    // allocation per vertex/face.
+    template <typename Scalar, typename Index>
+    struct Parsed
+    {
+      std::vector<Scalar> V,TC,N;
+      std::vector<int> V_size,TC_size;
+      std::vector<Index> F,FTC,FN;
+      std::vector<int> F_size;
+      // Whether each face has texture coordinate/normal indices
+      std::vector<char> F_has_tc,F_has_n;
+      // Positions into F/FTC/FN of negative (relative) indices, which are
+      // stored relative to the number of V/TC/N preceding this range
+      std::vector<std::size_t> F_rel,FTC_rel,FN_rel;
+      struct Material
+      {
+        // number of faces preceding the usemtl line
+        std::size_t face;
+        bool has_name;
+        std::string name;
+      };
+      std::vector<Material> materials;
+      // Diagnostics with 0-based line numbers relative to this range
+      struct Message
+      {
+        std::size_t line;
+        const char * format;
+        int count;
+        std::string text;
+      };
+      std::vector<Message> warnings;
+      bool failed = false;
+      Message error;
+      std::size_t num_lines = 0;
+    };
+
+    // Parse whole lines in [begin,end)
+    template <typename Scalar, typename Index>
+    inline void parse(
+      const char * begin,
+      const char * end,
+      Parsed<Scalar,Index> & P)
+    {
+      const auto & fail =
+        [&P](const std::size_t line,const char * format,const int count=0)
+      {
+        P.failed = true;
+        P.error = {line,format,count,std::string()};
+      };
+      const char * line = begin;
+      std::size_t line_no = 0;
+      for(;line<end;line_no++)
+      {
+        const char * nl =
+          static_cast<const char *>(std::memchr(line,'\n',end-line));
+        const char * line_end = nl ? nl : end;
+        const char * next = nl ? nl+1 : end;
+        const char * p = line;
+        const auto & skip_space = [&p,line_end]()
+        {
+          while(p<line_end && igl::is_ascii_space(*p)) { p++; }
+        };
+        skip_space();
+        if(p == line_end)
+        {
+          // ignore empty line
+          line = next;
+          continue;
+        }
+        // Read first word containing type
+        const char * type = p;
+        while(p<line_end && !igl::is_ascii_space(*p)) { p++; }
+        const std::size_t type_len = p-type;
+        const auto & is_type = [type,type_len](const char * t)
+        {
+          return std::strlen(t) == type_len && std::strncmp(type,t,type_len)==0;
+        };
+        if(is_type("v"))
+        {
+          int count = 0;
+          Scalar x;
+          while(true)
+          {
+            skip_space();
+            if(p == line_end || !igl::parse_ascii_real(p,line_end,x)) { break; }
+            P.V.push_back(x);
+            count++;
+          }
+          if(count < 3)
+          {
+            fail(line_no,
+              "Error: readOBJ() vertex on line %d should have at least 3 coordinates");
+            return;
+          }
+          P.V_size.push_back(count);
+        }else if(is_type("vn") || is_type("vt"))
+        {
+          const bool is_normal = type[1] == 'n';
+          double x[3];
+          int count = 0;
+          for(;count<3;count++)
+          {
+            skip_space();
+            if(!igl::parse_ascii_real(p,line_end,x[count])) { break; }
+          }
+          if(is_normal)
+          {
+            if(count != 3)
+            {
+              fail(line_no,
+                "Error: readOBJ() normal on line %d should have 3 coordinates");
+              return;
+            }
+            P.N.insert(P.N.end(),x,x+3);
+          }else
+          {
+            if(count != 2 && count != 3)
+            {
+              fail(line_no,
+                "Error: readOBJ() texture coords on line %d should have 2 "
+                "or 3 coordinates (%d)",count);
+              return;
+            }
+            P.TC.insert(P.TC.end(),x,x+count);
+            P.TC_size.push_back(count);
+          }
+        }else if(is_type("f"))
+        {
+          const long long nV = P.V_size.size();
+          const long long nTC = P.TC_size.size();
+          const long long nN = P.N.size()/3;
+          const std::size_t f0 = P.F.size();
+          const std::size_t ftc0 = P.FTC.size();
+          const std::size_t fn0 = P.FN.size();
+          const auto & push = [](
+            const long long i,
+            const long long n,
+            std::vector<Index> & X,
+            std::vector<std::size_t> & X_rel)
+          {
+            if(i<0)
+            {
+              X_rel.push_back(X.size());
+              X.push_back(static_cast<Index>(static_cast<int>(i+n)));
+            }else
+            {
+              X.push_back(static_cast<Index>(static_cast<int>(i-1)));
+            }
+          };
+          // Read each "word" after type
+          while(true)
+          {
+            skip_space();
+            if(p == line_end) { break; }
+            const char * word_end = p;
+            while(word_end<line_end && !igl::is_ascii_space(*word_end))
+            {
+              word_end++;
+            }
+            // Accepts i, i/it, i//in and i/it/in (trailing characters are
+            // ignored)
+            long long i,it,in;
+            const char * q = p;
+            if(!igl::parse_ascii_integer(q,word_end,i))
+            {
+              fail(line_no,
+                "Error: readOBJ() face on line %d has invalid element format\n");
+              return;
+            }
+            push(i,nV,P.F,P.F_rel);
+            if(q<word_end && *q=='/')
+            {
+              q++;
+              if(q<word_end && *q=='/')
+              {
+                q++;
+                if(igl::parse_ascii_integer(q,word_end,in))
+                {
+                  push(in,nN,P.FN,P.FN_rel);
+                }
+              }else if(igl::parse_ascii_integer(q,word_end,it))
+              {
+                push(it,nTC,P.FTC,P.FTC_rel);
+                if(q<word_end && *q=='/')
+                {
+                  q++;
+                  if(igl::parse_ascii_integer(q,word_end,in))
+                  {
+                    push(in,nN,P.FN,P.FN_rel);
+                  }
+                }
+              }
+            }
+            p = word_end;
+          }
+          const std::size_t face = P.F.size()-f0;
+          const std::size_t ftc = P.FTC.size()-ftc0;
+          const std::size_t fn = P.FN.size()-fn0;
+          if(face>0 && (fn == 0 || fn == face) && (ftc == 0 || ftc == face))
+          {
+            P.F_size.push_back(static_cast<int>(face));
+            P.F_has_tc.push_back(ftc>0);
+            P.F_has_n.push_back(fn>0);
+          }else
+          {
+            fail(line_no,
+              "Error: readOBJ() face on line %d has invalid format\n");
+            return;
+          }
+        }else if(is_type("usemtl"))
+        {
+          skip_space();
+          const char * name = p;
+          while(p<line_end && !igl::is_ascii_space(*p)) { p++; }
+          P.materials.push_back(
+            {P.F_size.size(),p>name,std::string(name,p)});
+        }else if(
+          type[0] == '#' ||
+          type[0] == 'g' ||
+          type[0] == 's' ||
+          is_type("mtllib"))
+        {
+          //ignore comments or other shit
+        }else
+        {
+          //ignore any other lines
+          P.warnings.push_back({
+            line_no,
+            "Warning: readOBJ() ignored non-comment line %d:\n  %s",
+            0,
+            std::string(line,next)});
+        }
+        line = next;
+      }
+      P.num_lines = line_no;
+    }
+
+    // Offset every relative index position in rel into X by n
+    template <typename Index>
+    inline void shift_relative(
+      const std::vector<std::size_t> & rel,
+      const std::size_t n,
+      Index * X)
+    {
+      for(const std::size_t r : rel)
+      {
+        X[r] = static_cast<Index>(static_cast<int>(X[r] + n));
+      }
+    }
+
+    // Parse a whole .obj file in memory by splitting it into chunks of whole
+    // lines that are parsed in parallel and then concatenated.
+    //
+    // Returns false (after printing the error) on a parse error.
+    template <typename Scalar, typename Index>
+    inline bool parse_buffer(
+      const char * begin,
+      const char * end,
+      Parsed<Scalar,Index> & P,
+      std::vector<std::tuple<std::string, Index, Index >> & FM)
+    {
+      std::vector<const char *> bounds;
+      igl::split_into_line_chunks(begin,end,std::size_t(1)<<20,bounds);
+      const std::size_t k = bounds.size()-1;
+      std::vector<Parsed<Scalar,Index> > parts(k);
+      igl::parallel_for(k,[&](const std::size_t c)
+      {
+        parse(bounds[c],bounds[c+1],parts[c]);
+      },2);
+
+      // Report diagnostics in file order
+      std::size_t line_offset = 0;
+      for(const auto & part : parts)
+      {
+        for(const auto & w : part.warnings)
+        {
+          fprintf(stderr,w.format,int(line_offset+w.line+1),w.text.c_str());
+        }
+        if(part.failed)
+        {
+          fprintf(stderr,part.error.format,
+            int(line_offset+part.error.line+1),part.error.count);
+          return false;
+        }
+        line_offset += part.num_lines;
+      }
+
+      if(k == 1)
+      {
+        P = std::move(parts[0]);
+      }else
+      {
+        // Prefix sums of each part's sizes
+        struct Offsets
+        {
+          std::size_t V,V_size,TC,TC_size,N,F,F_size,FTC,FN;
+        };
+        std::vector<Offsets> offsets(k+1);
+        offsets[0] = {0,0,0,0,0,0,0,0,0};
+        for(std::size_t c = 0;c<k;c++)
+        {
+          const auto & part = parts[c];
+          const auto & o = offsets[c];
+          offsets[c+1] = {
+            o.V+part.V.size(),
+            o.V_size+part.V_size.size(),
+            o.TC+part.TC.size(),
+            o.TC_size+part.TC_size.size(),
+            o.N+part.N.size(),
+            o.F+part.F.size(),
+            o.F_size+part.F_size.size(),
+            o.FTC+part.FTC.size(),
+            o.FN+part.FN.size()};
+        }
+        const auto & total = offsets[k];
+        P = Parsed<Scalar,Index>();
+        P.V.resize(total.V);
+        P.V_size.resize(total.V_size);
+        P.TC.resize(total.TC);
+        P.TC_size.resize(total.TC_size);
+        P.N.resize(total.N);
+        P.F.resize(total.F);
+        P.F_size.resize(total.F_size);
+        P.F_has_tc.resize(total.F_size);
+        P.F_has_n.resize(total.F_size);
+        P.FTC.resize(total.FTC);
+        P.FN.resize(total.FN);
+        for(std::size_t c = 0;c<k;c++)
+        {
+          for(auto m : parts[c].materials)
+          {
+            m.face += offsets[c].F_size;
+            P.materials.push_back(m);
+          }
+        }
+        igl::parallel_for(k,[&](const std::size_t c)
+        {
+          auto & part = parts[c];
+          const auto & o = offsets[c];
+          std::copy(part.V.begin(),part.V.end(),P.V.begin()+o.V);
+          std::copy(part.V_size.begin(),part.V_size.end(),P.V_size.begin()+o.V_size);
+          std::copy(part.TC.begin(),part.TC.end(),P.TC.begin()+o.TC);
+          std::copy(part.TC_size.begin(),part.TC_size.end(),P.TC_size.begin()+o.TC_size);
+          std::copy(part.N.begin(),part.N.end(),P.N.begin()+o.N);
+          std::copy(part.F_size.begin(),part.F_size.end(),P.F_size.begin()+o.F_size);
+          std::copy(part.F_has_tc.begin(),part.F_has_tc.end(),P.F_has_tc.begin()+o.F_size);
+          std::copy(part.F_has_n.begin(),part.F_has_n.end(),P.F_has_n.begin()+o.F_size);
+          // Relative indices are relative to the vertices read so far
+          shift_relative(part.F_rel,o.V_size,part.F.data());
+          shift_relative(part.FTC_rel,o.TC_size,part.FTC.data());
+          shift_relative(part.FN_rel,o.N/3,part.FN.data());
+          std::copy(part.F.begin(),part.F.end(),P.F.begin()+o.F);
+          std::copy(part.FTC.begin(),part.FTC.end(),P.FTC.begin()+o.FTC);
+          std::copy(part.FN.begin(),part.FN.end(),P.FN.begin()+o.FN);
+          // Free memory early
+          part = Parsed<Scalar,Index>();
+        },2);
+      }
+
+      // Material ranges
+      std::string currentmaterialref;
+      bool FMwasinit = false;
+      int previous_face_no = 0;
+      for(const auto & m : P.materials)
+      {
+        const int current_face_no = static_cast<int>(m.face);
+        if(FMwasinit)
+        {
+          FM.push_back(std::make_tuple(
+            currentmaterialref,previous_face_no,current_face_no-1));
+          previous_face_no = current_face_no;
+        }else
+        {
+          FMwasinit = true;
+        }
+        if(m.has_name)
+        {
+          currentmaterialref = m.name;
+        }
+      }
+      if(!currentmaterialref.empty())
+      {
+        FM.push_back(std::make_tuple(
+          currentmaterialref,previous_face_no,int(P.F_size.size())-1));
+      }
+      return true;
+    }
+
+    // Exclusive prefix sum of sizes
+    inline void row_offsets(
+      const std::vector<int> & sizes,
+      std::vector<std::size_t> & offsets)
+    {
+      offsets.resize(sizes.size()+1);
+      offsets[0] = 0;
+      for(std::size_t i = 0;i<sizes.size();i++)
+      {
+        offsets[i+1] = offsets[i] + sizes[i];
+      }
+    }
+
+    // Flat rows to list of lists
+    template <typename T>
+    inline void flat_to_list(
+      const std::vector<T> & X,
+      const std::vector<int> & sizes,
+      std::vector<std::vector<T> > & L)
+    {
+      std::vector<std::size_t> offsets;
+      row_offsets(sizes,offsets);
+      L.resize(sizes.size());
+      igl::parallel_for(sizes.size(),[&](const std::size_t i)
+      {
+        L[i].assign(X.begin()+offsets[i],X.begin()+offsets[i+1]);
+      },10000);
+    }
+
+    // Face attribute indices (texture coordinates or normals) of faces that
+    // have them, empty lists for others
+    template <typename Index>
+    inline void face_attribute_to_list(
+      const std::vector<Index> & X,
+      const std::vector<int> & F_size,
+      const std::vector<char> & has,
+      std::vector<std::vector<Index> > & L)
+    {
+      std::vector<int> sizes(F_size.size());
+      for(std::size_t i = 0;i<F_size.size();i++)
+      {
+        sizes[i] = has[i] ? F_size[i] : 0;
+      }
+      flat_to_list(X,sizes,L);
+    }
+
+    template <typename Scalar, typename Index>
+    inline void to_lists(
+      const Parsed<Scalar,Index> & P,
+      std::vector<std::vector<Scalar > > & V,
+      std::vector<std::vector<Scalar > > & TC,
+      std::vector<std::vector<Scalar > > & N,
+      std::vector<std::vector<Index > > & F,
+      std::vector<std::vector<Index > > & FTC,
+      std::vector<std::vector<Index > > & FN)
+    {
+      flat_to_list(P.V,P.V_size,V);
+      flat_to_list(P.TC,P.TC_size,TC);
+      flat_to_list(P.N,std::vector<int>(P.N.size()/3,3),N);
+      flat_to_list(P.F,P.F_size,F);
+      face_attribute_to_list(P.FTC,P.F_size,P.F_has_tc,FTC);
+      face_attribute_to_list(P.FN,P.F_size,P.F_has_n,FN);
+    }
+
+#ifndef IGL_NO_EIGEN
+    // Flat rows to matrix, equivalent to list_to_matrix on the corresponding
+    // list of lists.
+    //
+    // Returns false if rows have different sizes (min_n and max_n are set
+    // to the smallest and largest size)
+    template <typename T, typename Derived>
+    inline bool flat_to_matrix(
+      const std::vector<T> & X,
+      const std::vector<int> & sizes,
+      Eigen::PlainObjectBase<Derived> & M,
+      int & min_n,
+      int & max_n)
+    {
+      const Eigen::Index m = sizes.size();
+      if(m == 0)
+      {
+        M.resize(
+          Derived::RowsAtCompileTime>=0?Derived::RowsAtCompileTime:0,
+          Derived::ColsAtCompileTime>=0?Derived::ColsAtCompileTime:0);
+        return true;
+      }
+      min_n = *std::min_element(sizes.begin(),sizes.end());
+      max_n = *std::max_element(sizes.begin(),sizes.end());
+      if(min_n != max_n)
+      {
+        return false;
+      }
+      const int n = min_n;
+      M.resize(m,n);
+      igl::parallel_for(m,[&](const Eigen::Index i)
+      {
+        for(int j = 0;j<n;j++)
+        {
+          M(i,j) = X[i*n+j];
+        }
+      },10000);
+      return true;
+    }
+    template <typename T, typename Derived>
+    inline bool flat_to_matrix(
+      const std::vector<T> & X,
+      const std::vector<int> & sizes,
+      Eigen::PlainObjectBase<Derived> & M)
+    {
+      int min_n,max_n;
+      return flat_to_matrix(X,sizes,M,min_n,max_n);
+    }
+#endif
+  }
+}
 
 template <typename Scalar, typename Index>
 IGL_INLINE bool igl::readOBJ(
@@ -30,16 +542,8 @@ IGL_INLINE bool igl::readOBJ(
   std::vector<std::vector<Index > > & FTC,
   std::vector<std::vector<Index > > & FN)
 {
-  // Open file, and check for error
-  FILE * obj_file = fopen(obj_file_name.c_str(),"r");
-  if(NULL==obj_file)
-  {
-    fprintf(stderr,"IOError: %s could not be opened...\n",
-            obj_file_name.c_str());
-    return false;
-  }
   std::vector<std::tuple<std::string, Index, Index >> FM;
-  return igl::readOBJ(obj_file,V,TC,N,F,FTC,FN, FM);
+  return igl::readOBJ(obj_file_name,V,TC,N,F,FTC,FN,FM);
 }
 
 template <typename Scalar, typename Index>
@@ -54,14 +558,28 @@ IGL_INLINE bool igl::readOBJ(
   std::vector<std::tuple<std::string, Index, Index >> &FM)
 {
   // Open file, and check for error
-  FILE * obj_file = fopen(obj_file_name.c_str(),"r");
-  if(NULL==obj_file)
+  igl::MappedFile obj_file(obj_file_name);
+  if(!obj_file.is_open())
   {
     fprintf(stderr,"IOError: %s could not be opened...\n",
             obj_file_name.c_str());
     return false;
   }
-  return igl::readOBJ(obj_file,V,TC,N,F,FTC,FN,FM);
+  // File open was successful so clear outputs
+  V.clear();
+  TC.clear();
+  N.clear();
+  F.clear();
+  FTC.clear();
+  FN.clear();
+  readOBJ_internal::Parsed<Scalar,Index> P;
+  if(!readOBJ_internal::parse_buffer(
+    obj_file.data(),obj_file.data()+obj_file.size(),P,FM))
+  {
+    return false;
+  }
+  readOBJ_internal::to_lists(P,V,TC,N,F,FTC,FN);
+  return true;
 }
 
 template <typename Scalar, typename Index>
@@ -82,196 +600,24 @@ IGL_INLINE bool igl::readOBJ(
   F.clear();
   FTC.clear();
   FN.clear();
-
-  // variables and constants to assist parsing the .obj file
-  // Constant strings to compare against
-  std::string v("v");
-  std::string vn("vn");
-  std::string vt("vt");
-  std::string f("f");
-  std::string tic_tac_toe("#");
-#ifndef IGL_LINE_MAX
-#  define IGL_LINE_MAX 2048
-#endif
-
-#ifndef MATERIAL_LINE_MAX
-#  define MATERIAL_LINE_MAX 2048
-#endif
-
-  char line[IGL_LINE_MAX];
-  char currentmaterialref[MATERIAL_LINE_MAX] = "";
-  bool FMwasinit = false;
-  int line_no = 1, previous_face_no=0, current_face_no = 0;
-  while (fgets(line, IGL_LINE_MAX, obj_file) != NULL)
+  // Slurp the rest of the file and parse it in memory
+  std::vector<char> buffer;
   {
-    char type[IGL_LINE_MAX];
-    // Read first word containing type
-    if(sscanf(line, "%s",type) == 1)
-    {
-      // Get pointer to rest of line right after type
-      char * l = &line[strlen(type)];
-      if(type == v)
-      {
-        std::istringstream ls(&line[1]);
-        std::vector<Scalar > vertex{ std::istream_iterator<Scalar >(ls), std::istream_iterator<Scalar >() };
-
-        if (vertex.size() < 3)
-        {
-          fprintf(stderr,
-                  "Error: readOBJ() vertex on line %d should have at least 3 coordinates",
-                  line_no);
-          fclose(obj_file);
-          return false;
-        }
-      
-        V.push_back(vertex);
-      }else if(type == vn)
-      {
-        double x[3];
-        int count =
-        sscanf(l,"%lf %lf %lf\n",&x[0],&x[1],&x[2]);
-        if(count != 3)
-        {
-          fprintf(stderr,
-                  "Error: readOBJ() normal on line %d should have 3 coordinates",
-                  line_no);
-          fclose(obj_file);
-          return false;
-        }
-        std::vector<Scalar > normal(count);
-        for(int i = 0;i<count;i++)
-        {
-          normal[i] = x[i];
-        }
-        N.push_back(normal);
-      }else if(type == vt)
-      {
-        double x[3];
-        int count =
-        sscanf(l,"%lf %lf %lf\n",&x[0],&x[1],&x[2]);
-        if(count != 2 && count != 3)
-        {
-          fprintf(stderr,
-                  "Error: readOBJ() texture coords on line %d should have 2 "
-                  "or 3 coordinates (%d)",
-                  line_no,count);
-          fclose(obj_file);
-          return false;
-        }
-        std::vector<Scalar > tex(count);
-        for(int i = 0;i<count;i++)
-        {
-          tex[i] = x[i];
-        }
-        TC.push_back(tex);
-      }else if(type == f)
-      {
-        const auto & shift = [&V](const int i)->int
-        {
-          return i<0 ? i+V.size() : i-1;
-        };
-        const auto & shift_t = [&TC](const int i)->int
-        {
-          return i<0 ? i+TC.size() : i-1;
-        };
-        const auto & shift_n = [&N](const int i)->int
-        {
-          return i<0 ? i+N.size() : i-1;
-        };
-        std::vector<Index > face;
-        std::vector<Index > ftc;
-        std::vector<Index > fn;
-        // Read each "word" after type
-        char word[IGL_LINE_MAX];
-        int offset;
-        while(sscanf(l,"%s%n",word,&offset) == 1)
-        {
-          // adjust offset
-          l += offset;
-          // Process word
-          long int i,it,in;
-          if(sscanf(word,"%ld/%ld/%ld",&i,&it,&in) == 3)
-          {
-            face.push_back(shift(i));
-            ftc.push_back(shift_t(it));
-            fn.push_back(shift_n(in));
-          }else if(sscanf(word,"%ld/%ld",&i,&it) == 2)
-          {
-            face.push_back(shift(i));
-            ftc.push_back(shift_t(it));
-          }else if(sscanf(word,"%ld//%ld",&i,&in) == 2)
-          {
-            face.push_back(shift(i));
-            fn.push_back(shift_n(in));
-          }else if(sscanf(word,"%ld",&i) == 1)
-          {
-            face.push_back(shift(i));
-          }else
-          {
-            fprintf(stderr,
-                    "Error: readOBJ() face on line %d has invalid element format\n",
-                    line_no);
-            fclose(obj_file);
-            return false;
-          }
-        }
-        if(
-           (face.size()>0 && fn.size() == 0 && ftc.size() == 0) ||
-           (face.size()>0 && fn.size() == face.size() && ftc.size() == 0) ||
-           (face.size()>0 && fn.size() == 0 && ftc.size() == face.size()) ||
-           (face.size()>0 && fn.size() == face.size() && ftc.size() == face.size()))
-        {
-          // No matter what add each type to lists so that lists are the
-          // correct lengths
-          F.push_back(face);
-          FTC.push_back(ftc);
-          FN.push_back(fn);
-          current_face_no++;
-        }else
-        {
-          fprintf(stderr,
-                  "Error: readOBJ() face on line %d has invalid format\n", line_no);
-          fclose(obj_file);
-          return false;
-        }
-      }else if(strlen(type) >= 1 && strcmp("usemtl",type)==0 )
-      {
-        if(FMwasinit){
-          FM.push_back(std::make_tuple(currentmaterialref,previous_face_no,current_face_no-1));
-          previous_face_no = current_face_no;
-        }
-        else{
-          FMwasinit=true;
-        }
-        sscanf(l, "%s\n", currentmaterialref);
-      }
-      else if(strlen(type) >= 1 && (type[0] == '#' ||
-            type[0] == 'g'  ||
-            type[0] == 's'  ||
-            strcmp("mtllib",type)==0))
-      {
-        //ignore comments or other shit
-      }else
-      {
-        //ignore any other lines
-        fprintf(stderr,
-                "Warning: readOBJ() ignored non-comment line %d:\n  %s",
-                line_no,
-                line);
-      }
-    }else
+    char block[1<<16];
+    std::size_t n;
+    while((n = fread(block,1,sizeof(block),obj_file)) > 0)
     {
-      // ignore empty line
+      buffer.insert(buffer.end(),block,block+n);
     }
-    line_no++;
   }
-  if(strcmp(currentmaterialref,"")!=0)
-    FM.push_back(std::make_tuple(currentmaterialref,previous_face_no,current_face_no-1));
   fclose(obj_file);
-
-  assert(F.size() == FN.size());
-  assert(F.size() == FTC.size());
-
+  readOBJ_internal::Parsed<Scalar,Index> P;
+  if(!readOBJ_internal::parse_buffer(
+    buffer.data(),buffer.data()+buffer.size(),P,FM))
+  {
+    return false;
+  }
+  readOBJ_internal::to_lists(P,V,TC,N,F,FTC,FN);
   return true;
 }
 
@@ -304,65 +650,70 @@ IGL_INLINE bool igl::readOBJ(
   Eigen::PlainObjectBase<DerivedFTC>& FTC,
   Eigen::PlainObjectBase<DerivedFN>& FN)
 {
-  std::vector<std::vector<double> > vV,vTC,vN;
-  std::vector<std::vector<int> > vF,vFTC,vFN;
-  bool success = igl::readOBJ(str,vV,vTC,vN,vF,vFTC,vFN);
-  if(!success)
+  igl::MappedFile obj_file(str);
+  if(!obj_file.is_open())
   {
-    // readOBJ(str,vV,vTC,vN,vF,vFTC,vFN) should have already printed an error
-    // message to stderr
+    fprintf(stderr,"IOError: %s could not be opened...\n",str.c_str());
+    return false;
+  }
+  readOBJ_internal::Parsed<double,int> P;
+  std::vector<std::tuple<std::string, int, int >> FM;
+  if(!readOBJ_internal::parse_buffer(
+    obj_file.data(),obj_file.data()+obj_file.size(),P,FM))
+  {
+    // parse_buffer should have already printed an error message to stderr
     return false;
   }
-  bool V_rect = igl::list_to_matrix(vV,V);
   const char * format = "Failed to cast %s to matrix: min (%d) != max (%d)\n";
-  if(!V_rect)
+  int min_n,max_n;
+  if(!readOBJ_internal::flat_to_matrix(P.V,P.V_size,V,min_n,max_n))
   {
-    printf(format,"V",igl::min_size(vV),igl::max_size(vV));
+    printf(format,"V",min_n,max_n);
     return false;
   }
-  bool F_rect = igl::list_to_matrix(vF,F);
-  if(!F_rect)
+  if(!readOBJ_internal::flat_to_matrix(P.F,P.F_size,F,min_n,max_n))
   {
-    printf(format,"F",igl::min_size(vF),igl::max_size(vF));
+    printf(format,"F",min_n,max_n);
     return false;
   }
-  if(!vN.empty())
+  if(!P.N.empty())
+  {
+    readOBJ_internal::flat_to_matrix(
+      P.N,std::vector<int>(P.N.size()/3,3),CN);
+  }
+  // Per-face sizes of texture coordinate/normal index lists
+  const auto & attribute_sizes = [&P](const std::vector<char> & has)
   {
-    bool VN_rect = igl::list_to_matrix(vN,CN);
-    if(!VN_rect)
+    std::vector<int> sizes(P.F_size.size());
+    for(std::size_t i = 0;i<sizes.size();i++)
     {
-      printf(format,"CN",igl::min_size(vN),igl::max_size(vN));
-      return false;
+      sizes[i] = has[i] ? P.F_size[i] : 0;
     }
-  }
-
-  if(!vFN.empty() && !vFN[0].empty())
+    return sizes;
+  };
+  if(!P.F_has_n.empty() && P.F_has_n[0])
   {
-    bool FN_rect = igl::list_to_matrix(vFN,FN);
-    if(!FN_rect)
+    if(!readOBJ_internal::flat_to_matrix(
+      P.FN,attribute_sizes(P.F_has_n),FN,min_n,max_n))
     {
-      printf(format,"FN",igl::min_size(vFN),igl::max_size(vFN));
+      printf(format,"FN",min_n,max_n);
       return false;
     }
   }
-
-  if(!vTC.empty())
+  if(!P.TC_size.empty())
   {
-
-    bool T_rect = igl::list_to_matrix(vTC,TC);
-    if(!T_rect)
+    if(!readOBJ_internal::flat_to_matrix(P.TC,P.TC_size,TC,min_n,max_n))
     {
-      printf(format,"TC",igl::min_size(vTC),igl::max_size(vTC));
+      printf(format,"TC",min_n,max_n);
       return false;
     }
   }
-  if(!vFTC.empty()&& !vFTC[0].empty())
+  if(!P.F_has_tc.empty() && P.F_has_tc[0])
   {
-
-    bool FTC_rect = igl::list_to_matrix(vFTC,FTC);
-    if(!FTC_rect)
+    if(!readOBJ_internal::flat_to_matrix(
+      P.FTC,attribute_sizes(P.F_has_tc),FTC,min_n,max_n))
     {
-      printf(format,"FTC",igl::min_size(vFTC),igl::max_size(vFTC));
+      printf(format,"FTC",min_n,max_n);
       return false;
     }
   }
@@ -375,25 +726,30 @@ IGL_INLINE bool igl::readOBJ(
   Eigen::PlainObjectBase<DerivedV>& V,
   Eigen::PlainObjectBase<DerivedF>& F)
 {
-  std::vector<std::vector<double> > vV,vTC,vN;
-  std::vector<std::vector<int> > vF,vFTC,vFN;
-  bool success = igl::readOBJ(str,vV,vTC,vN,vF,vFTC,vFN);
-  if(!success)
+  igl::MappedFile obj_file(str);
+  if(!obj_file.is_open())
   {
-    // readOBJ(str,vV,vTC,vN,vF,vFTC,vFN) should have already printed an error
-    // message to stderr
+    fprintf(stderr,"IOError: %s could not be opened...\n",str.c_str());
+    return false;
+  }
+  readOBJ_internal::Parsed<double,int> P;
+  std::vector<std::tuple<std::string, int, int >> FM;
+  if(!readOBJ_internal::parse_buffer(
+    obj_file.data(),obj_file.data()+obj_file.size(),P,FM))
+  {
+    // parse_buffer should have already printed an error message to stderr
     return false;
   }
-  bool V_rect = igl::list_to_matrix(vV,V);
-  if(!V_rect)
+  const char * format = "Failed to cast %s to matrix: min (%d) != max (%d)\n";
+  int min_n,max_n;
+  if(!readOBJ_internal::flat_to_matrix(P.V,P.V_size,V,min_n,max_n))
   {
-    // igl::list_to_matrix(vV,V) already printed error message to std err
+    printf(format,"V",min_n,max_n);
     return false;
   }
-  bool F_rect = igl::list_to_matrix(vF,F);
-  if(!F_rect)
+  if(!readOBJ_internal::flat_to_matrix(P.F,P.F_size,F,min_n,max_n))
   {
-    // igl::list_to_matrix(vF,F) already printed error message to std err
+    printf(format,"F",min_n,max_n);
     return false;
   }
   return true;
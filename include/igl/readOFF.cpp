@@ -7,27 +7,377 @@
 // obtain one at http://mozilla.org/MPL/2.0/.
 #include "readOFF.h"
 #include "list_to_matrix.h"
+#include "MappedFile.h"
+#include "parallel_for.h"
+#include "parse_ascii_number.h"
+#include "split_into_line_chunks.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+namespace igl
+{
+  namespace readOFF_internal
+  {
+    // Contents of an .off file with fixed-size rows stored flat
+    struct Parsed
+    {
+      // #V*3 positions, normals (NOFF) and colors (COFF)
+      std::vector<double> V,N,C;
+      std::vector<int> F;
+      std::vector<int> F_size;
+    };
+
+    // Parse vertex lines in [begin,end) (skipping blank lines and comments),
+    // stopping after max_vertices vertices.
+    //
+    // Returns pointer past last consumed line. bad_lines receives the
+    // number of vertices preceding each unparseable line.
+    inline const char * parse_vertices(
+      const char * begin,
+      const char * end,
+      const std::size_t max_vertices,
+      const bool has_normals,
+      const bool has_colors,
+      Parsed & P,
+      std::vector<std::size_t> & bad_lines)
+    {
+      const char * line = begin;
+      std::size_t num_vertices = 0;
+      while(line<end && num_vertices<max_vertices)
+      {
+        const char * nl =
+          static_cast<const char *>(std::memchr(line,'\n',end-line));
+        const char * line_end = nl ? nl : end;
+        const char * p = line;
+        line = nl ? nl+1 : end;
+        while(p<line_end && igl::is_ascii_space(*p)) { p++; }
+        if(p == line_end || *p == '#') { continue; }
+        double x[6] = {0,0,0,0,0,0};
+        int count = 0;
+        for(;count<6;count++)
+        {
+          while(p<line_end && igl::is_ascii_space(*p)) { p++; }
+          if(!igl::parse_ascii_real(p,line_end,x[count])) { break; }
+        }
+        if(count < 3)
+        {
+          bad_lines.push_back(P.V.size()/3);
+          continue;
+        }
+        P.V.insert(P.V.end(),x,x+3);
+        if(has_normals)
+        {
+          P.N.insert(P.N.end(),x+3,x+6);
+        }
+        if(has_colors)
+        {
+          for(int c = 3;c<6;c++) { P.C.push_back(x[c]/255.0); }
+        }
+        num_vertices++;
+      }
+      return line;
+    }
+
+    // Parse faces (valence followed by indices, which may continue on the
+    // following lines; rest of the line holding the last index is ignored)
+    // and comments in [begin,end).
+    //
+    // Returns false if a face could not be parsed; P holds the faces before
+    // it. truncated is set iff that face ran past end.
+    inline bool parse_faces(
+      const char * begin,
+      const char * end,
+      Parsed & P,
+      bool & truncated)
+    {
+      truncated = false;
+      const char * p = begin;
+      const auto & skip_space = [&p,end]()
+      {
+        while(p<end && igl::is_ascii_space(*p)) { p++; }
+      };
+      const auto & skip_line = [&p,end]()
+      {
+        const void * nl = std::memchr(p,'\n',end-p);
+        p = nl ? static_cast<const char *>(nl) : end;
+      };
+      while(true)
+      {
+        skip_space();
+        if(p == end) { return true; }
+        if(*p == '#')
+        {
+          skip_line();
+          continue;
+        }
+        int valence;
+        if(!igl::parse_ascii_integer(p,end,valence) || valence < 0)
+        {
+          return false;
+        }
+        for(int j = 0;j<valence;j++)
+        {
+          skip_space();
+          int index;
+          if(!igl::parse_ascii_integer(p,end,index))
+          {
+            // Drop the partial face
+            P.F.resize(P.F.size()-j);
+            truncated = p == end;
+            return false;
+          }
+          P.F.push_back(index);
+        }
+        P.F_size.push_back(valence);
+        skip_line();
+      }
+    }
+
+    // Parse a whole .off file in memory. Vertex and face sections are each
+    // split into chunks of whole lines parsed in parallel.
+    //
+    // Returns false (after printing the error) on a parse error.
+    inline bool parse_buffer(
+      const char * begin,
+      const char * end,
+      Parsed & P,
+      bool & has_normals,
+      bool & has_colors)
+    {
+      const char * p = begin;
+      while(p<end && igl::is_ascii_space(*p)) { p++; }
+      const char * word = p;
+      while(p<end && !igl::is_ascii_space(*p)) { p++; }
+      // First line is always OFF
+      const std::string header(word,p);
+      const std::string OFF("OFF");
+      const std::string NOFF("NOFF");
+      const std::string COFF("COFF");
+      if(header.empty()
+         || !(
+           header.compare(0, OFF.length(), OFF)==0 ||
+           header.compare(0, COFF.length(), COFF)==0 ||
+           header.compare(0,NOFF.length(),NOFF)==0))
+      {
+        printf("Error: readOFF() first line should be OFF or NOFF or COFF, not %s...",header.c_str());
+        return false;
+      }
+      has_normals = header.compare(0,NOFF.length(),NOFF)==0;
+      has_colors = header.compare(0,COFF.length(),COFF)==0;
+      // Second line is #vertices #faces #edges
+      while(p<end && igl::is_ascii_space(*p)) { p++; }
+      int counts[3] = {0,0,0};
+      while(p<end)
+      {
+        const char * nl = static_cast<const char *>(std::memchr(p,'\n',end-p));
+        const char * line_end = nl ? nl : end;
+        const char * line = p;
+        p = nl ? nl+1 : end;
+        if(*line == '#' || *line == '\n' || *line == '\r') { continue; }
+        const char * q = line;
+        for(int c = 0;c<3;c++)
+        {
+          while(q<line_end && igl::is_ascii_space(*q)) { q++; }
+          if(!igl::parse_ascii_integer(q,line_end,counts[c])) { break; }
+        }
+        break;
+      }
+      const std::size_t number_of_vertices = std::max(counts[0],0);
+      const std::size_t number_of_faces = std::max(counts[1],0);
+
+      // Find end of vertex section by counting non-comment lines
+      const char * vertices_end = p;
+      for(std::size_t i = 0;i<number_of_vertices && vertices_end<end;)
+      {
+        const char * nl = static_cast<const char *>(
+          std::memchr(vertices_end,'\n',end-vertices_end));
+        const char * q = vertices_end;
+        vertices_end = nl ? nl+1 : end;
+        while(q<vertices_end && igl::is_ascii_space(*q)) { q++; }
+        if(q<vertices_end && *q != '#') { i++; }
+      }
+      // Read vertices
+      std::vector<const char *> bounds;
+      igl::split_into_line_chunks(p,vertices_end,std::size_t(1)<<20,bounds);
+      std::size_t k = bounds.size()-1;
+      std::vector<Parsed> parts(k);
+      std::vector<std::vector<std::size_t> > bad_lines(k);
+      igl::parallel_for(k,[&](const std::size_t c)
+      {
+        parse_vertices(
+          bounds[c],bounds[c+1],number_of_vertices,
+          has_normals,has_colors,parts[c],bad_lines[c]);
+      },2);
+      P = Parsed();
+      {
+        std::size_t n = 0;
+        for(std::size_t c = 0;c<k;c++)
+        {
+          for(const auto b : bad_lines[c]) { printf("Error: bad line (%d)\n",int(n+b)); }
+          n += parts[c].V.size()/3;
+        }
+        const auto & cat = [&parts](std::vector<double> Parsed::* X)
+        {
+          std::vector<double> Y;
+          if(parts.size() == 1) { return std::move(parts[0].*X); }
+          std::size_t m = 0;
+          for(const auto & part : parts) { m += (part.*X).size(); }
+          Y.reserve(m);
+          for(auto & part : parts)
+          {
+            Y.insert(Y.end(),(part.*X).begin(),(part.*X).end());
+            std::vector<double>().swap(part.*X);
+          }
+          return Y;
+        };
+        P.V = cat(&Parsed::V);
+        P.N = cat(&Parsed::N);
+        P.C = cat(&Parsed::C);
+      }
+      // Lines that failed to parse mean the vertex section runs longer
+      p = vertices_end;
+      if(P.V.size()/3 < number_of_vertices)
+      {
+        std::vector<std::size_t> more_bad_lines;
+        const std::size_t n0 = P.V.size()/3;
+        p = parse_vertices(
+          p,end,number_of_vertices-n0,has_normals,has_colors,P,more_bad_lines);
+        for(const auto b : more_bad_lines) { printf("Error: bad line (%d)\n",int(b)); }
+        if(P.V.size()/3 < number_of_vertices)
+        {
+          return false;
+        }
+      }
+
+      // Read faces
+      igl::split_into_line_chunks(p,end,std::size_t(1)<<20,bounds);
+      k = bounds.size()-1;
+      parts.resize(k);
+      std::vector<char> ok(k),truncated(k);
+      igl::parallel_for(k,[&](const std::size_t c)
+      {
+        parts[c] = Parsed();
+        bool t;
+        ok[c] = parse_faces(bounds[c],bounds[c+1],parts[c],t);
+        truncated[c] = t;
+      },2);
+      // A face continuing past a chunk boundary: fall back to a serial parse
+      if(std::find(truncated.begin(),truncated.end()-1,1) != truncated.end()-1)
+      {
+        k = 1;
+        parts.assign(1,Parsed());
+        bool t;
+        ok.assign(1,parse_faces(p,end,parts[0],t));
+      }
+      // Only the first number_of_faces faces matter
+      std::size_t num_faces = 0, num_indices = 0, used = 0;
+      for(;used<k && num_faces<number_of_faces;used++)
+      {
+        num_faces += parts[used].F_size.size();
+        num_indices += parts[used].F.size();
+        // Faces after a bad one cannot be trusted
+        if(!ok[used])
+        {
+          used++;
+          break;
+        }
+      }
+      if(num_faces < number_of_faces)
+      {
+        printf("Error: bad line\n");
+        return false;
+      }
+      P.F.reserve(num_indices);
+      P.F_size.reserve(num_faces);
+      for(std::size_t c = 0;c<used;c++)
+      {
+        P.F.insert(P.F.end(),parts[c].F.begin(),parts[c].F.end());
+        P.F_size.insert(P.F_size.end(),parts[c].F_size.begin(),parts[c].F_size.end());
+      }
+      // Drop anything past the last face
+      std::size_t extra_indices = 0;
+      for(std::size_t f = number_of_faces;f<P.F_size.size();f++)
+      {
+        extra_indices += P.F_size[f];
+      }
+      P.F.resize(P.F.size()-extra_indices);
+      P.F_size.resize(number_of_faces);
+      return true;
+    }
+
+    template <typename Scalar, typename Index>
+    inline bool to_lists(
+      const char * begin,
+      const char * end,
+      std::vector<std::vector<Scalar > > & V,
+      std::vector<std::vector<Index > > & F,
+      std::vector<std::vector<Scalar > > & N,
+      std::vector<std::vector<Scalar > > & C)
+    {
+      Parsed P;
+      bool has_normals,has_colors;
+      if(!parse_buffer(begin,end,P,has_normals,has_colors))
+      {
+        return false;
+      }
+      const std::size_t n = P.V.size()/3;
+      const auto & rows = [n](
+        const std::vector<double> & X,
+        std::vector<std::vector<Scalar > > & Y)
+      {
+        Y.resize(n);
+        igl::parallel_for(n,[&](const std::size_t i)
+        {
+          Y[i].assign(X.begin()+3*i,X.begin()+3*i+3);
+        },10000);
+      };
+      rows(P.V,V);
+      if(has_normals) { rows(P.N,N); }
+      if(has_colors) { rows(P.C,C); }
+      const std::size_t m = P.F_size.size();
+      std::vector<std::size_t> offset(m+1,0);
+      for(std::size_t f = 0;f<m;f++) { offset[f+1] = offset[f]+P.F_size[f]; }
+      F.resize(m);
+      igl::parallel_for(m,[&](const std::size_t f)
+      {
+        F[f].assign(P.F.begin()+offset[f],P.F.begin()+offset[f+1]);
+      },10000);
+      return true;
+    }
+  }
+}
 
 template <typename Scalar, typename Index>
 IGL_INLINE bool igl::readOFF(
-  const std::string off_file_name,
+  FILE * off_file,
   std::vector<std::vector<Scalar > > & V,
   std::vector<std::vector<Index > > & F,
   std::vector<std::vector<Scalar > > & N,
   std::vector<std::vector<Scalar > > & C)
 {
-  FILE * off_file = fopen(off_file_name.c_str(),"r");
-  if(NULL==off_file)
+  V.clear();
+  F.clear();
+  N.clear();
+  C.clear();
+  // Slurp the rest of the file and parse it in memory
+  std::vector<char> buffer;
   {
-    printf("IOError: %s could not be opened...\n",off_file_name.c_str());
-    return false;
+    char block[1<<16];
+    std::size_t n;
+    while((n = fread(block,1,sizeof(block),off_file)) > 0)
+    {
+      buffer.insert(buffer.end(),block,block+n);
+    }
   }
-  return readOFF(off_file,V,F,N,C);
+  fclose(off_file);
+  return readOFF_internal::to_lists(
+    buffer.data(),buffer.data()+buffer.size(),V,F,N,C);
 }
 
 template <typename Scalar, typename Index>
 IGL_INLINE bool igl::readOFF(
-  FILE * off_file,
+  const std::string off_file_name,
   std::vector<std::vector<Scalar > > & V,
   std::vector<std::vector<Index > > & F,
   std::vector<std::vector<Scalar > > & N,
@@ -37,130 +387,16 @@ IGL_INLINE bool igl::readOFF(
   F.clear();
   N.clear();
   C.clear();
-
-  // First line is always OFF
-  char header[1000];
-  const std::string OFF("OFF");
-  const std::string NOFF("NOFF");
-  const std::string COFF("COFF");
-  if(fscanf(off_file,"%s\n",header)!=1
-     || !(
-       std::string(header).compare(0, OFF.length(), OFF)==0 ||
-       std::string(header).compare(0, COFF.length(), COFF)==0 ||
-       std::string(header).compare(0,NOFF.length(),NOFF)==0))
+  igl::MappedFile file;
+  if(!file.open(off_file_name))
   {
-    printf("Error: readOFF() first line should be OFF or NOFF or COFF, not %s...",header);
-    fclose(off_file);
+    printf("IOError: %s could not be opened...\n",off_file_name.c_str());
     return false;
   }
-  bool has_normals = std::string(header).compare(0,NOFF.length(),NOFF)==0;
-  bool has_vertexColors = std::string(header).compare(0,COFF.length(),COFF)==0;
-  // Second line is #vertices #faces #edges
-  int number_of_vertices;
-  int number_of_faces;
-  int number_of_edges;
-  char tic_tac_toe;
-  char line[1000];
-  bool still_comments = true;
-  while(still_comments)
-  {
-    fgets(line,1000,off_file);
-    still_comments = (line[0] == '#' || line[0] == '\n');
-  }
-  sscanf(line,"%d %d %d",&number_of_vertices,&number_of_faces,&number_of_edges);
-  V.resize(number_of_vertices);
-  if (has_normals)
-    N.resize(number_of_vertices);
-  if (has_vertexColors)
-    C.resize(number_of_vertices);
-  F.resize(number_of_faces);
-  //printf("%s %d %d %d\n",(has_normals ? "NOFF" : "OFF"),number_of_vertices,number_of_faces,number_of_edges);
-  // Read vertices
-  for(int i = 0;i<number_of_vertices;)
-  {
-    fgets(line, 1000, off_file);
-    double x,y,z,nx,ny,nz;
-    if(sscanf(line, "%lg %lg %lg %lg %lg %lg",&x,&y,&z,&nx,&ny,&nz)>= 3)
-    {
-      std::vector<Scalar > vertex;
-      vertex.resize(3);
-      vertex[0] = x;
-      vertex[1] = y;
-      vertex[2] = z;
-      V[i] = vertex;
-
-      if (has_normals)
-      {
-        std::vector<Scalar > normal;
-        normal.resize(3);
-        normal[0] = nx;
-        normal[1] = ny;
-        normal[2] = nz;
-        N[i] = normal;
-      }
-
-      if (has_vertexColors)
-      {
-        C[i].resize(3);
-        C[i][0] = nx / 255.0;
-        C[i][1] = ny / 255.0;
-        C[i][2] = nz / 255.0;
-      }
-      i++;
-    }else if(
-        fscanf(off_file,"%[#]",&tic_tac_toe)==1)
-    {
-      char comment[1000];
-      fscanf(off_file,"%[^\n]",comment);
-    }else
-    {
-      printf("Error: bad line (%d)\n",i);
-      if(feof(off_file))
-      {
-        fclose(off_file);
-        return false;
-      }
-    }
-  }
-  // Read faces
-  for(int i = 0;i<number_of_faces;)
-  {
-    std::vector<Index > face;
-    int valence;
-    if(fscanf(off_file,"%d",&valence)==1)
-    {
-      face.resize(valence);
-      for(int j = 0;j<valence;j++)
-      {
-        int index;
-        if(j<valence-1)
-        {
-          fscanf(off_file,"%d",&index);
-        }else{
-          fscanf(off_file,"%d%*[^\n]",&index);
-        }
-
-        face[j] = index;
-      }
-      F[i] = face;
-      i++;
-    }else if(
-             fscanf(off_file,"%[#]",&tic_tac_toe)==1)
-    {
-      char comment[1000];
-      fscanf(off_file,"%[^\n]",comment);
-    }else
-    {
-      printf("Error: bad line\n");
-      fclose(off_file);
-      return false;
-    }
-  }
-  fclose(off_file);
-  return true;
+  return readOFF_internal::to_lists(
+    file.data(),file.data()+file.size(),V,F,N,C);
 }
 
-
 #ifndef IGL_NO_EIGEN
 template <typename DerivedV, typename DerivedF>
 IGL_INLINE bool igl::readOFF(
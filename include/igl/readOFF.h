@@ -21,7 +21,9 @@
 namespace igl 
 {
   /// Read a mesh from an ascii OFF file, filling in vertex positions, normals
-  /// and texture coordinates. Mesh may have faces of any number of degree
+  /// and texture coordinates. Mesh may have faces of any number of degree.
+  /// A face's indices may continue on the following lines; anything after
+  /// its last index on that line (e.g., a face color) is ignored.
   ///
   /// @tparam Scalar  type for positions and vectors (will be read as double and cast
   ///     to Scalar)
@@ -10,8 +10,16 @@
 #include "unique_rows.h"
 #include "colon.h"
 #include "placeholders.h"
+#include "parallel_for.h"
+#include "sortrows.h"
 #include <functional>
 #include "PlainMatrix.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <numeric>
+#include <utility>
+#include <vector>
 
 template <
   typename DerivedV, 
@@ -64,7 +72,237 @@ IGL_INLINE void igl::remove_duplicate_vertices(
     (DerivedSVI::RowsAtCompileTime == 1 || DerivedSVI::ColsAtCompileTime == 1) &&
     (DerivedSVJ::RowsAtCompileTime == 1 || DerivedSVJ::ColsAtCompileTime == 1),
     "SVI and SVJ need to have RowsAtCompileTime == 1 or ColsAtCompileTime == 1");
-  remove_duplicate_vertices(V,epsilon,SV,SVI,SVJ);
+  remove_duplicate_vertices(
+    V,F,epsilon,REMOVE_DUPLICATE_VERTICES_TYPE_ROUND,SV,SVI,SVJ,SF);
+}
+
+template <
+  typename DerivedV, 
+  typename DerivedSV, 
+  typename DerivedSVI, 
+  typename DerivedSVJ>
+IGL_INLINE void igl::remove_duplicate_vertices(
+  const Eigen::MatrixBase<DerivedV>& V,
+  const double epsilon,
+  const RemoveDuplicateVerticesType type,
+  Eigen::PlainObjectBase<DerivedSV>& SV,
+  Eigen::PlainObjectBase<DerivedSVI>& SVI,
+  Eigen::PlainObjectBase<DerivedSVJ>& SVJ)
+{
+  static_assert(
+    (DerivedSVI::RowsAtCompileTime == 1 || DerivedSVI::ColsAtCompileTime == 1) &&
+    (DerivedSVJ::RowsAtCompileTime == 1 || DerivedSVJ::ColsAtCompileTime == 1),
+    "SVI and SVJ need to have RowsAtCompileTime == 1 or ColsAtCompileTime == 1");
+  if(type != REMOVE_DUPLICATE_VERTICES_TYPE_WELD)
+  {
+    return remove_duplicate_vertices(V,epsilon,SV,SVI,SVJ);
+  }
+  typedef Eigen::Index Index;
+  const Index n = V.rows();
+  const Index dim = V.cols();
+  if(n == 0)
+  {
+    SV.resize(0,dim);
+    SVI.resize(0,1);
+    SVJ.resize(0,1);
+    return;
+  }
+  // Union-find forest whose roots are the smallest index in their set
+  std::vector<Index> parent(n);
+  std::iota(parent.begin(),parent.end(),Index(0));
+  const auto find = [&parent](Index i)->Index
+  {
+    while(parent[i] != i)
+    {
+      parent[i] = parent[parent[i]];
+      i = parent[i];
+    }
+    return i;
+  };
+  if(epsilon <= 0)
+  {
+    // Exact duplicates: unique_rows is stable so IA holds first occurrences
+    const Eigen::MatrixXd Vd = V.template cast<double>();
+    Eigen::MatrixXd C;
+    Eigen::VectorXi IA,IC;
+    unique_rows(Vd,C,IA,IC);
+    for(Index i = 0;i<n;i++)
+    {
+      parent[i] = IA(IC(i));
+    }
+  }else
+  {
+    // Bin vertices into a grid of epsilon-sized cells so that welded pairs
+    // lie in the same or adjacent cells, and group them by cell
+    typedef Eigen::Matrix<std::int64_t,Eigen::Dynamic,Eigen::Dynamic> MatrixX64;
+    MatrixX64 G(n,dim);
+    // Cell coordinates are clamped (NaN included) to ±2^62 so converting
+    // them is defined and neighbor offsets can't overflow. Vertices clamped
+    // to the same boundary cell just cost extra distance tests.
+    const double max_cell = 4611686018427387904.0;
+    parallel_for(n,[&](const Index i)
+    {
+      for(Index c = 0;c<dim;c++)
+      {
+        const double g = std::floor(double(V(i,c))/epsilon);
+        G(i,c) = g < max_cell ?
+          (g > -max_cell ? std::int64_t(g) : -std::int64_t(max_cell)) :
+          std::int64_t(max_cell);
+      }
+    },10000);
+    MatrixX64 sG;
+    Eigen::VectorXi I;
+    sortrows(G,true,sG,I);
+    std::vector<Index> cell_start(1,0);
+    for(Index k = 1;k<n;k++)
+    {
+      if(sG.row(k) != sG.row(k-1)) { cell_start.push_back(k); }
+    }
+    cell_start.push_back(n);
+    const Index num_cells = Index(cell_start.size())-1;
+
+    // Open addressing hash table from cell coordinates to cell index
+    const auto hash = [dim](const std::int64_t * x)->std::uint64_t
+    {
+      std::uint64_t h = 0;
+      for(Index c = 0;c<dim;c++)
+      {
+        h = (h ^ std::uint64_t(x[c])) * 0x9E3779B97F4A7C15ull;
+        h ^= h >> 29;
+      }
+      return h;
+    };
+    std::uint64_t mask = 1;
+    while(mask < 2*std::uint64_t(num_cells)) { mask <<= 1; }
+    mask--;
+    std::vector<Index> table(mask+1,-1);
+    Eigen::Matrix<std::int64_t,Eigen::Dynamic,Eigen::Dynamic,Eigen::RowMajor> 
+      cells(num_cells,dim);
+    for(Index g = 0;g<num_cells;g++)
+    {
+      cells.row(g) = sG.row(cell_start[g]);
+      std::uint64_t h = hash(cells.row(g).data()) & mask;
+      while(table[h] >= 0) { h = (h+1) & mask; }
+      table[h] = g;
+    }
+    const auto lookup = [&](const std::int64_t * x)->Index
+    {
+      for(std::uint64_t h = hash(x) & mask;table[h] >= 0;h = (h+1) & mask)
+      {
+        if(std::equal(x,x+dim,cells.row(table[h]).data())) { return table[h]; }
+      }
+      return -1;
+    };
+    // Half of the neighboring cell offsets (first nonzero coordinate is +1)
+    // so that each pair of cells is visited once
+    std::vector<std::vector<std::int64_t> > offsets;
+    {
+      Index num_offsets = 1;
+      for(Index c = 0;c<dim;c++) { num_offsets *= 3; }
+      for(Index code = 0;code<num_offsets;code++)
+      {
+        std::vector<std::int64_t> o(dim);
+        Index rest = code;
+        for(Index c = 0;c<dim;c++)
+        {
+          o[c] = rest % 3 - 1;
+          rest /= 3;
+        }
+        const auto first = std::find_if(
+          o.begin(),o.end(),[](const std::int64_t oc){ return oc != 0; });
+        if(first != o.end() && *first > 0) { offsets.push_back(o); }
+      }
+    }
+
+    // Find pairs within epsilon in parallel, then join them serially
+    const double epsilon2 = epsilon*epsilon;
+    const auto close = [&V,dim,epsilon2](const Index a, const Index b)
+    {
+      double d2 = 0;
+      for(Index c = 0;c<dim;c++)
+      {
+        const double d = double(V(a,c)) - double(V(b,c));
+        d2 += d*d;
+      }
+      return d2 <= epsilon2;
+    };
+    std::vector<std::vector<std::pair<Index,Index> > > pairs;
+    parallel_for(
+      num_cells,
+      [&pairs](const size_t num_threads){ pairs.resize(num_threads); },
+      [&](const Index g, const size_t t)
+      {
+        for(Index a = cell_start[g];a<cell_start[g+1];a++)
+        {
+          for(Index b = a+1;b<cell_start[g+1];b++)
+          {
+            if(close(I(a),I(b))) { pairs[t].emplace_back(I(a),I(b)); }
+          }
+        }
+        std::vector<std::int64_t> x(dim);
+        for(const auto & o : offsets)
+        {
+          for(Index c = 0;c<dim;c++) { x[c] = cells(g,c) + o[c]; }
+          const Index h = lookup(x.data());
+          if(h < 0) { continue; }
+          for(Index a = cell_start[g];a<cell_start[g+1];a++)
+          {
+            for(Index b = cell_start[h];b<cell_start[h+1];b++)
+            {
+              if(close(I(a),I(b))) { pairs[t].emplace_back(I(a),I(b)); }
+            }
+          }
+        }
+      },
+      [](const size_t){},
+      1000);
+    for(const auto & thread_pairs : pairs)
+    {
+      for(const auto & pair : thread_pairs)
+      {
+        const Index a = find(pair.first);
+        const Index b = find(pair.second);
+        if(a < b) { parent[b] = a; } else if(b < a) { parent[a] = b; }
+      }
+    }
+  }
+
+  // Number groups in order of their first vertex
+  std::vector<Index> group(n);
+  Index num_groups = 0;
+  for(Index i = 0;i<n;i++)
+  {
+    if(find(i) == i) { group[i] = num_groups++; }
+  }
+  SVI.resize(num_groups,1);
+  SVJ.resize(n,1);
+  for(Index i = 0;i<n;i++)
+  {
+    const Index r = find(i);
+    if(r == i) { SVI(group[i]) = i; }
+    SVJ(i) = group[r];
+  }
+  SV = V(SVI.derived(),igl::placeholders::all);
+}
+
+template <
+  typename DerivedV, 
+  typename DerivedF,
+  typename DerivedSV, 
+  typename DerivedSVI, 
+  typename DerivedSVJ,
+  typename DerivedSF>
+IGL_INLINE void igl::remove_duplicate_vertices(
+  const Eigen::MatrixBase<DerivedV>& V,
+  const Eigen::MatrixBase<DerivedF>& F,
+  const double epsilon,
+  const RemoveDuplicateVerticesType type,
+  Eigen::PlainObjectBase<DerivedSV>& SV,
+  Eigen::PlainObjectBase<DerivedSVI>& SVI,
+  Eigen::PlainObjectBase<DerivedSVJ>& SVJ,
+  Eigen::PlainObjectBase<DerivedSF>& SF)
+{
+  remove_duplicate_vertices(V,epsilon,type,SV,SVI,SVJ);
   SF.resizeLike(F);
   for(int f = 0;f<F.rows();f++)
   {
@@ -90,4 +328,6 @@ template void igl::remove_duplicate_vertices<Eigen::Matrix<float, -1, 3, 1, -1,
 template void igl::remove_duplicate_vertices<Eigen::Matrix<double, -1, 3, 0, -1, 3>,   Eigen::Matrix<int, -1, 3, 0, -1, 3>,          Eigen::Matrix<double, -1, 3, 0, -1, 3>,   Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, 3, 0, -1, 3> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, 3, 0, -1, 3> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 3, 0, -1, 3> > const&, double, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 3, 0, -1, 3> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 3, 0, -1, 3> >&);
 template void igl::remove_duplicate_vertices<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>,        Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, double, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> >&);
 template void igl::remove_duplicate_vertices<Eigen::Matrix<double, -1, 3, 1, -1, 3>,   Eigen::Matrix<int, -1, 3, 1, -1, 3>,          Eigen::Matrix<double, -1, 3, 1, -1, 3>,   Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, 3, 1, -1, 3> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, 3, 1, -1, 3> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 3, 1, -1, 3> > const&, double, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 3, 1, -1, 3> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 3, 1, -1, 3> >&);
+template void igl::remove_duplicate_vertices<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, 1, 0, -1, 1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, double, igl::RemoveDuplicateVerticesType, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&);
+template void igl::remove_duplicate_vertices<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, double, igl::RemoveDuplicateVerticesType, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> >&);
 #endif
@@ -11,6 +11,18 @@
 #include <Eigen/Dense>
 namespace igl
 {
+  /// Ways of deciding which vertices are duplicates
+  enum RemoveDuplicateVerticesType
+  {
+    /// Round coordinates to multiples of epsilon and merge vertices whose
+    /// rounded coordinates are equal. SV is sorted by rounded coordinates.
+    REMOVE_DUPLICATE_VERTICES_TYPE_ROUND = 0,
+    /// Weld vertices within (Euclidean) distance epsilon of each other,
+    /// transitively, found with a parallel spatial hash in expected O(#V)
+    /// time. SV keeps the first vertex of each welded group, in order.
+    REMOVE_DUPLICATE_VERTICES_TYPE_WELD = 1,
+    NUM_REMOVE_DUPLICATE_VERTICES_TYPES = 2
+  };
   /// Remove duplicate vertices upto a uniqueness tolerance (epsilon)
   ///
   /// @param[in] V  #V by dim list of vertex positions
@@ -49,6 +61,39 @@ namespace igl
     Eigen::PlainObjectBase<DerivedSVI>& SVI,
     Eigen::PlainObjectBase<DerivedSVJ>& SVJ,
     Eigen::PlainObjectBase<DerivedSF>& SF);
+  /// \overload
+  /// @param[in] type  how duplicates are decided (see
+  ///   RemoveDuplicateVerticesType; the overloads above use
+  ///   REMOVE_DUPLICATE_VERTICES_TYPE_ROUND)
+  template <
+    typename DerivedV, 
+    typename DerivedSV, 
+    typename DerivedSVI, 
+    typename DerivedSVJ>
+  IGL_INLINE void remove_duplicate_vertices(
+    const Eigen::MatrixBase<DerivedV>& V,
+    const double epsilon,
+    const RemoveDuplicateVerticesType type,
+    Eigen::PlainObjectBase<DerivedSV>& SV,
+    Eigen::PlainObjectBase<DerivedSVI>& SVI,
+    Eigen::PlainObjectBase<DerivedSVJ>& SVJ);
+  /// \overload
+  template <
+    typename DerivedV, 
+    typename DerivedF,
+    typename DerivedSV, 
+    typename DerivedSVI, 
+    typename DerivedSVJ,
+    typename DerivedSF>
+  IGL_INLINE void remove_duplicate_vertices(
+    const Eigen::MatrixBase<DerivedV>& V,
+    const Eigen::MatrixBase<DerivedF>& F,
+    const double epsilon,
+    const RemoveDuplicateVerticesType type,
+    Eigen::PlainObjectBase<DerivedSV>& SV,
+    Eigen::PlainObjectBase<DerivedSVI>& SVI,
+    Eigen::PlainObjectBase<DerivedSVJ>& SVJ,
+    Eigen::PlainObjectBase<DerivedSF>& SF);
 }
 
 #ifndef IGL_STATIC_LIBRARY
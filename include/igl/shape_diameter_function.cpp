@@ -15,7 +15,9 @@
 #include "EPS.h"
 #include "Hit.h"
 #include "parallel_for.h"
+#include <array>
 #include <functional>
+#include <limits>
 #include <vector>
 #include <algorithm>
 
@@ -85,29 +87,51 @@ IGL_INLINE void igl::shape_diameter_function(
   const int num_samples,
   Eigen::PlainObjectBase<DerivedS> & S)
 {
-  using Scalar = typename DerivedP::Scalar;
-  using Vector3S = Eigen::Matrix<typename DerivedP::Scalar,3,1>;
-  const auto & shoot_ray = [&aabb,&V,&F](
-    const Vector3S& _s,
-    const Vector3S& dir)->double
+  using Scalar = typename DerivedV::Scalar;
+  using Vector3S = Eigen::Matrix<Scalar,3,1>;
+  // Trace each point's rays (which share an origin) in packets
+  constexpr int PacketSize = 8;
+  const int n = P.rows();
+  S.resize(n,1);
+  const Eigen::Matrix<Scalar,Eigen::Dynamic,3> D =
+    random_dir_stratified(num_samples).cast<Scalar>();
+  parallel_for(n,[&](const int p)
   {
-    Vector3S s = _s+1e-4*dir;
-    igl::Hit<Scalar> hit;
-    if(aabb.intersect_ray(
-      V,
-      F,
-      s  ,
-      dir,
-      hit))
-    {
-      return hit.t;
-    }else
+    const Vector3S origin = P.row(p).template cast<Scalar>();
+    const Vector3S normal = N.row(p).template cast<Scalar>();
+    int num_hits = 0;
+    double total_distance = 0;
+    for(int s0 = 0;s0<num_samples;s0+=PacketSize)
     {
-      return std::numeric_limits<double>::infinity();
+      Eigen::Matrix<Scalar,PacketSize,3> packet_origin,packet_dir;
+      for(int k = 0;k<PacketSize;k++)
+      {
+        // Pad the last packet by repeating its last ray
+        Vector3S d = D.row(std::min(s0+k,num_samples-1));
+        // Shoot _inward_
+        if(d.dot(normal) > 0)
+        {
+          // reverse ray
+          d *= -1;
+        }
+        packet_origin.row(k) = origin+1e-4*d;
+        packet_dir.row(k) = d;
+      }
+      std::array<igl::Hit<Scalar>,PacketSize> hits;
+      aabb.template intersect_ray_packet<PacketSize>(
+        V,F,packet_origin,packet_dir,
+        std::numeric_limits<Scalar>::infinity(),false,hits);
+      for(int k = 0;k<PacketSize && s0+k<num_samples;k++)
+      {
+        if(hits[k].id >= 0)
+        {
+          total_distance += hits[k].t;
+          num_hits++;
+        }
+      }
     }
-  };
-  return shape_diameter_function(shoot_ray,P,N,num_samples,S);
-
+    S(p) = total_distance/(double)num_hits;
+  },1000);
 }
 
 template <
@@ -184,5 +208,6 @@ template void igl::shape_diameter_function<Eigen::Matrix<double, -1, 3, 0, -1, 3
 template void igl::shape_diameter_function<Eigen::Matrix<double, 1, 3, 1, 1, 3>, Eigen::Matrix<double, 1, 3, 1, 1, 3>, Eigen::Matrix<double, -1, 1, 0, -1, 1> >(std::function<double (Eigen::Matrix<double, 3, 1, 0, 3, 1> const&, Eigen::Matrix<double, 3, 1, 0, 3, 1> const&)> const&, Eigen::MatrixBase<Eigen::Matrix<double, 1, 3, 1, 1, 3> > const&, Eigen::MatrixBase<Eigen::Matrix<double, 1, 3, 1, 1, 3> > const&, int, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> >&);
 template void igl::shape_diameter_function<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1> >(std::function<double (Eigen::Matrix<double, 3, 1, 0, 3, 1> const&, Eigen::Matrix<double, 3, 1, 0, 3, 1> const&)> const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, int, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&);
 template void igl::shape_diameter_function<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, bool, int, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&);
+template void igl::shape_diameter_function<Eigen::Matrix<double, -1, -1, 0, -1, -1>, 3, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, 1, 0, -1, 1> >(igl::AABB<Eigen::Matrix<double, -1, -1, 0, -1, -1>, 3> const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, int, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> >&);
 #endif
 
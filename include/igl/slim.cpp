@@ -25,6 +25,7 @@
 #include "polar_svd.h"
 #include "flip_avoiding_line_search.h"
 #include "mapping_energy_with_jacobians.h"
+#include "parallel_for.h"
 
 #include <iostream>
 #include <map>
@@ -112,7 +113,11 @@ namespace igl
       Eigen::VectorXi & /*soft_b_p*/,
       Eigen::MatrixXd & /*soft_bc_p*/)
     {
+#ifdef SLIM_CACHED
+      Eigen::SparseMatrix<double> & L = s.L;
+#else
       Eigen::SparseMatrix<double> L;
+#endif
       build_linear_system(s,L);
 
       igl::Timer t;
@@ -120,11 +125,25 @@ namespace igl
       //t.start();
       // solve
       Eigen::VectorXd Uc;
+      // The sparsity pattern of L does not change between iterations
+      const auto factorize = [&]()
+      {
+        if (s.first_solve || !s.solver.ptr)
+        {
+          if (!s.solver.ptr)
+          {
+            s.solver.ptr = std::make_unique<igl::SLIMData::Solver>();
+          }
+          s.solver.ptr->analyzePattern(L);
+          s.first_solve = false;
+        }
+        s.solver.ptr->factorize(L);
+      };
 #ifndef CHOLMOD
       if (s.dim == 2)
       {
-        Eigen::SimplicialLDLT<Eigen::SparseMatrix<double> > solver;
-        Uc = solver.compute(L).solve(s.rhs);
+        factorize();
+        Uc = s.solver.ptr->solve(s.rhs);
       }
       else
       { // seems like CG performs much worse for 2D and way better for 3D
@@ -136,8 +155,8 @@ namespace igl
         Uc = cg.solveWithGuess(s.rhs, guess);
       }
 #else
-        CholmodSimplicialLDLT<Eigen::SparseMatrix<double> > solver;
-        Uc = solver.compute(L).solve(s.rhs);
+      factorize();
+      Uc = s.solver.ptr->solve(s.rhs);
 #endif
       for (int i = 0; i < s.dim; i++)
         uv.col(i) = Uc.block(i * s.v_n, 0, s.v_n, 1);
@@ -234,14 +253,6 @@ namespace igl
       At.makeCompressed();
       #endif
 
-      #ifdef SLIM_CACHED
-      Eigen::SparseMatrix<double> id_m(s.A.cols(), s.A.cols());
-      #else
-      Eigen::SparseMatrix<double> id_m(A.cols(), A.cols());
-      #endif
-
-      id_m.setIdentity();
-
       // add proximal penalty
       #ifdef SLIM_CACHED
       s.AtA_data.W = s.WGL_M;
@@ -250,10 +261,30 @@ namespace igl
       else
         igl::AtA_cached(s.A,s.AtA_data,s.AtA);
 
-      L = s.AtA + s.proximal_p * id_m; //add also a proximal 
-      L.makeCompressed();
-
+      // L = AtA + proximal_p * I, values of AtA followed by the diagonal. The
+      // diagonal is always part of the pattern so soft constraints fit in too.
+      const int n = s.AtA.cols();
+      const int AtA_nnz = s.AtA.nonZeros();
+      if (L.rows() == 0)
+      {
+        std::vector<Eigen::Triplet<double> > IJV_L;
+        IJV_L.reserve(AtA_nnz + n);
+        for (int k = 0; k < s.AtA.outerSize(); ++k)
+          for (Eigen::SparseMatrix<double>::InnerIterator it(s.AtA, k); it; ++it)
+            IJV_L.emplace_back(it.row(), it.col(), 0);
+        for (int i = 0; i < n; i++)
+          IJV_L.emplace_back(i, i, 0);
+        L = Eigen::SparseMatrix<double>(n, n);
+        igl::sparse_cached_precompute(IJV_L,s.L_data,L);
+      }
+      s.L_values.resize(AtA_nnz + n);
+      s.L_values.head(AtA_nnz) =
+        Eigen::Map<const Eigen::VectorXd>(s.AtA.valuePtr(), AtA_nnz);
+      s.L_values.tail(n).setConstant(s.proximal_p);
+      igl::sparse_cached(s.L_values,s.L_data,L);
       #else
+      Eigen::SparseMatrix<double> id_m(A.cols(), A.cols());
+      id_m.setIdentity();
       L = At * s.WGL_M.asDiagonal() * A + s.proximal_p * id_m; //add also a proximal term
       L.makeCompressed();
       #endif
@@ -264,7 +295,6 @@ namespace igl
       buildRhs(s, A);
       #endif
 
-      Eigen::SparseMatrix<double> OldL = L;
       add_soft_constraints(s,L);
       L.makeCompressed();
     }
@@ -369,9 +399,10 @@ IGL_INLINE void igl::slim_update_weights_and_closest_rotations_with_jacobians(co
   double exp_f = exp_factor;
   const int dim = (Ji.cols()==4? 2:3);
 
+  // Each face is independent
   if (dim == 2)
   {
-    for (int i = 0; i < Ji.rows(); ++i)
+    igl::parallel_for(Ji.rows(), [&](const int i)
     {
       typedef Eigen::Matrix2d Mat2;
       typedef Eigen::Matrix<double, 2, 2, Eigen::RowMajor> RMat2;
@@ -473,19 +504,19 @@ IGL_INLINE void igl::slim_update_weights_and_closest_rotations_with_jacobians(co
       W.row(i) = Eigen::Map<Eigen::Matrix<double, 1, 4, Eigen::RowMajor>>(mat_W.data());
       // 2) Update local step (doesn't have to be a rotation, for instance in case of conformal energy)
       Ri.row(i) = Eigen::Map<Eigen::Matrix<double, 1,4,Eigen::RowMajor>>(ri.data());
-    }
+    },1000);
   }
   else
   {
     typedef Eigen::Matrix<double, 3, 1> Vec3;
     typedef Eigen::Matrix<double, 3, 3, Eigen::ColMajor> Mat3;
     typedef Eigen::Matrix<double, 3, 3, Eigen::RowMajor> RMat3;
-    Mat3 ji;
-    Vec3 m_sing_new;
-    Vec3 closest_sing_vec;
     const double sqrt_2 = sqrt(2);
-    for (int i = 0; i < Ji.rows(); ++i)
+    igl::parallel_for(Ji.rows(), [&](const int i)
     {
+      Mat3 ji;
+      Vec3 m_sing_new;
+      Vec3 closest_sing_vec;
       ji << Ji(i,0), Ji(i,1), Ji(i,2), 
       Ji(i,3), Ji(i,4), Ji(i,5), 
       Ji(i,6), Ji(i,7), Ji(i,8);
@@ -603,7 +634,7 @@ IGL_INLINE void igl::slim_update_weights_and_closest_rotations_with_jacobians(co
       W.row(i) = Eigen::Map<Eigen::Matrix<double, 1,9,Eigen::RowMajor>>(mat_W.data());
       // 2) Update closest rotations (not rotations in case of conformal energy)
       Ri.row(i) = Eigen::Map<Eigen::Matrix<double, 1,9,Eigen::RowMajor>>(ri.data());
-    } // for loop end
+    },1000); // for loop end
 
   } // if dim end
 
@@ -12,6 +12,10 @@
 #include "MappingEnergyType.h"
 #include <Eigen/Dense>
 #include <Eigen/Sparse>
+#include <memory>
+#ifdef CHOLMOD
+#include <Eigen/CholmodSupport>
+#endif
 
 // This option makes the iterations faster (all except the first) by caching the
 // sparsity pattern of the matrix involved in the assembly. It should be on if
@@ -81,7 +85,37 @@ struct SLIMData
   Eigen::VectorXi A_data;
   Eigen::SparseMatrix<double> AtA;
   igl::AtA_cached_data AtA_data;
+  /// System matrix AtA + proximal_p*I (+ soft constraints). Its sparsity
+  /// pattern is fixed at the first solve, after which only its values are
+  /// refreshed (through L_data)
+  Eigen::SparseMatrix<double> L;
+  Eigen::VectorXi L_data;
+  Eigen::VectorXd L_values;
+  #endif
+  #ifdef CHOLMOD
+  typedef Eigen::CholmodSimplicialLDLT<Eigen::SparseMatrix<double> > Solver;
+  #else
+  typedef Eigen::SimplicialLDLT<Eigen::SparseMatrix<double> > Solver;
   #endif
+  /// Owns a Solver, which Eigen makes noncopyable. Copying SLIMData copies
+  /// everything but the factorization: the copy starts without one and
+  /// analyzes the pattern again at its next solve.
+  struct SolverHolder
+  {
+    std::unique_ptr<Solver> ptr;
+    SolverHolder() {}
+    SolverHolder(const SolverHolder &) {}
+    SolverHolder(SolverHolder &&) = default;
+    SolverHolder & operator=(const SolverHolder &)
+    {
+      ptr.reset();
+      return *this;
+    }
+    SolverHolder & operator=(SolverHolder &&) = default;
+  };
+  /// Sparse Cholesky factorization of L. The symbolic analysis is computed
+  /// at the first solve and reused, later solves only factorize.
+  SolverHolder solver;
 };
 
 /// Compute necessary information to start using SLIM
@@ -12,9 +12,217 @@
 #include "sort.h"
 #include "colon.h"
 #include "IndexComparison.h"
+#include "default_num_threads.h"
+#include "parallel_for.h"
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
 #include <vector>
 
+namespace igl
+{
+  namespace internal
+  {
+    // Order-preserving map from a scalar to an unsigned integer key (-0 and 0
+    // get the same key since they compare equal)
+    template <typename Key, typename Scalar>
+    inline Key sortrows_key(const Scalar x)
+    {
+      constexpr Key sign = Key(1) << (8*sizeof(Key)-1);
+      if constexpr(std::is_floating_point<Scalar>::value)
+      {
+        static_assert(sizeof(Key) == sizeof(Scalar),"Key should match Scalar");
+        const Scalar y = x == Scalar(0) ? Scalar(0) : x;
+        Key bits;
+        std::memcpy(&bits,&y,sizeof(y));
+        return (bits & sign) ? ~bits : (bits | sign);
+      }else if constexpr(std::is_signed<Scalar>::value)
+      {
+        return Key(typename std::make_signed<Key>::type(x)) ^ sign;
+      }else
+      {
+        return Key(x);
+      }
+    }
+
+    // Stable LSD radix sort of row indices: rows are sorted by columns from
+    // last to first, one byte of each column's key (relative to the column's
+    // minimum) per pass. Histograms and scatters run in parallel over
+    // contiguous blocks of rows and passes where all keys share the same
+    // byte are skipped.
+    //
+    // Returns false (leaving IX untouched) if there are so many passes that
+    // a comparison sort would be faster, e.g., for random doubles.
+    template <typename Key, typename DerivedX, typename DerivedIX>
+    IGL_INLINE bool sortrows_radix(
+      const Eigen::DenseBase<DerivedX>& X,
+      const bool ascending,
+      Eigen::PlainObjectBase<DerivedIX>& IX)
+    {
+      typedef typename DerivedIX::Scalar Index;
+      typedef std::array<size_t,256> Histogram;
+      const size_t n = X.rows();
+      const Eigen::Index m = X.cols();
+      const size_t num_blocks = std::max<size_t>(1,
+        std::min<size_t>(igl::default_num_threads(),n/(1<<14)));
+      const size_t block_size = (n+num_blocks-1)/num_blocks;
+      const auto key = [&X,ascending](const size_t i, const Eigen::Index c)
+      {
+        const Key k = sortrows_key<Key>(X.coeff(i,c));
+        return ascending ? k : Key(~k);
+      };
+
+      // Range of keys in each column
+      std::vector<Key> block_min(num_blocks*m),block_max(num_blocks*m);
+      igl::parallel_for(num_blocks,[&](const size_t b)
+      {
+        Key * lo = block_min.data() + b*m;
+        Key * hi = block_max.data() + b*m;
+        std::fill(lo,lo+m,std::numeric_limits<Key>::max());
+        std::fill(hi,hi+m,Key(0));
+        const size_t end = std::min(n,(b+1)*block_size);
+        for(size_t i = b*block_size;i<end;i++)
+        {
+          for(Eigen::Index c = 0;c<m;c++)
+          {
+            const Key k = key(i,c);
+            lo[c] = std::min(lo[c],k);
+            hi[c] = std::max(hi[c],k);
+          }
+        }
+      },2);
+      std::vector<Key> min_key(m);
+      std::vector<int> num_bytes(m,0);
+      size_t num_passes = 0;
+      for(Eigen::Index c = 0;c<m;c++)
+      {
+        min_key[c] = block_min[c];
+        Key max_key = block_max[c];
+        for(size_t b = 1;b<num_blocks;b++)
+        {
+          min_key[c] = std::min(min_key[c],block_min[b*m+c]);
+          max_key = std::max(max_key,block_max[b*m+c]);
+        }
+        for(Key range = max_key-min_key[c];range;range >>= 8)
+        {
+          num_bytes[c]++;
+        }
+        num_passes += num_bytes[c];
+      }
+      // A pass scatters every row once, costing about as much as a round of
+      // comparisons of std::sort
+      if(num_passes > std::log2(double(n)))
+      {
+        return false;
+      }
+
+      std::vector<Key> K(n),K2(n);
+      std::vector<Index> I(n),I2(n);
+      for(size_t i = 0;i<n;i++)
+      {
+        I[i] = Index(i);
+      }
+      // histogram[b*bytes+p] counts digits of byte p in block b
+      const int bytes = sizeof(Key);
+      std::vector<Histogram> histogram(num_blocks*bytes);
+      std::vector<Histogram> count(num_blocks);
+      for(Eigen::Index c = m-1;c>=0;c--)
+      {
+        if(num_bytes[c] == 0)
+        {
+          continue;
+        }
+        igl::parallel_for(num_blocks,[&](const size_t b)
+        {
+          Histogram * h = histogram.data() + b*bytes;
+          for(int p = 0;p<num_bytes[c];p++) { h[p].fill(0); }
+          const size_t end = std::min(n,(b+1)*block_size);
+          for(size_t k = b*block_size;k<end;k++)
+          {
+            K[k] = key(I[k],c) - min_key[c];
+            for(int p = 0;p<num_bytes[c];p++)
+            {
+              h[p][(K[k]>>(8*p)) & 0xFF]++;
+            }
+          }
+        },2);
+        for(int p = 0;p<num_bytes[c];p++)
+        {
+          const int shift = 8*p;
+          // Skip passes where all keys share the same digit
+          bool trivial = false;
+          for(int d = 0;d<256 && !trivial;d++)
+          {
+            size_t total = 0;
+            for(size_t b = 0;b<num_blocks;b++)
+            {
+              total += histogram[b*bytes+p][d];
+            }
+            trivial = total == n;
+          }
+          if(trivial)
+          {
+            continue;
+          }
+          // Block counts change as rows move between blocks
+          if(p == 0 || num_blocks == 1)
+          {
+            for(size_t b = 0;b<num_blocks;b++)
+            {
+              count[b] = histogram[b*bytes+p];
+            }
+          }else
+          {
+            igl::parallel_for(num_blocks,[&](const size_t b)
+            {
+              count[b].fill(0);
+              const size_t end = std::min(n,(b+1)*block_size);
+              for(size_t k = b*block_size;k<end;k++)
+              {
+                count[b][(K[k]>>shift) & 0xFF]++;
+              }
+            },2);
+          }
+          // Exclusive prefix sum over (digit,block)
+          size_t offset = 0;
+          for(int d = 0;d<256;d++)
+          {
+            for(size_t b = 0;b<num_blocks;b++)
+            {
+              const size_t num = count[b][d];
+              count[b][d] = offset;
+              offset += num;
+            }
+          }
+          igl::parallel_for(num_blocks,[&](const size_t b)
+          {
+            const size_t end = std::min(n,(b+1)*block_size);
+            for(size_t k = b*block_size;k<end;k++)
+            {
+              const size_t q = count[b][(K[k]>>shift) & 0xFF]++;
+              K2[q] = K[k];
+              I2[q] = I[k];
+            }
+          },2);
+          std::swap(K,K2);
+          std::swap(I,I2);
+        }
+      }
+      IX.resize(n,1);
+      for(size_t k = 0;k<n;k++)
+      {
+        IX(k) = I[k];
+      }
+      return true;
+    }
+  }
+}
+
 // Obsolete slower version converst to vector
 //template <typename DerivedX, typename DerivedIX>
 //IGL_INLINE void igl::sortrows(
@@ -55,25 +263,45 @@ IGL_INLINE void igl::sortrows(
   Eigen::PlainObjectBase<DerivedY>& Y,
   Eigen::PlainObjectBase<DerivedIX>& IX)
 {
-  // This is already 2x faster than matlab's builtin `sortrows`. I have tried
-  // implementing a "multiple-pass" sort on each column, but see no performance
-  // improvement.
+  // The sort is stable: equal rows keep their relative order.
+  typedef typename DerivedX::Scalar Scalar;
   // Resize output
   const size_t num_rows = X.rows();
   const size_t num_cols = X.cols();
   Y.resize(num_rows,num_cols);
+  // Large arithmetic (integer or floating point) matrices are radix sorted
+  // in O(#X) instead of comparison sorted in O(#X log #X). Below a few
+  // thousand rows std::sort is faster.
+  const size_t min_radix_rows = 4096;
+  if constexpr(std::is_arithmetic<Scalar>::value && sizeof(Scalar) <= 8)
+  {
+    typedef typename std::conditional<
+      sizeof(Scalar) <= 4,std::uint32_t,std::uint64_t>::type Key;
+    if(num_rows >= min_radix_rows && num_cols > 0 &&
+      internal::sortrows_radix<Key>(X,ascending,IX))
+    {
+      for (size_t j=0; j<num_cols; j++) {
+          for(size_t i = 0;i<num_rows;i++)
+          {
+              Y(i,j) = X(IX(i), j);
+          }
+      }
+      return;
+    }
+  }
   IX.resize(num_rows,1);
   for(int i = 0;i<num_rows;i++)
   {
     IX(i) = i;
   }
+  // Ties are broken by index so this agrees with the radix sort
   if (ascending) {
     auto index_less_than = [&X, num_cols](size_t i, size_t j) {
       for (size_t c=0; c<num_cols; c++) {
         if (X.coeff(i, c) < X.coeff(j, c)) return true;
         else if (X.coeff(j,c) < X.coeff(i,c)) return false;
       }
-      return false;
+      return i < j;
     };
       std::sort(
         IX.data(),
@@ -86,7 +314,7 @@ IGL_INLINE void igl::sortrows(
         if (X.coeff(i, c) > X.coeff(j, c)) return true;
         else if (X.coeff(j,c) > X.coeff(i,c)) return false;
       }
-      return false;
+      return i < j;
     };
       std::sort(
         IX.data(),
@@ -154,6 +382,9 @@ template void igl::sortrows<Eigen::Matrix<int, -1, 2, 0, -1, 2>,Eigen::Matrix<in
 template void igl::sortrows<Eigen::Matrix<int, -1, -1, 0, -1, -1>,Eigen::Matrix<int, -1, -1, 0, -1, -1>,Eigen::Matrix<int, -1, -1, 0, -1, -1>>(Eigen::DenseBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const &, bool, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > &, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > &);
 template void igl::sortrows<Eigen::Matrix<double, -1, -1, 0, -1, -1>,Eigen::Matrix<double, -1, -1, 0, -1, -1>,Eigen::Matrix<long, -1, 1, 0, -1, 1>>(Eigen::DenseBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const &, bool, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > &, Eigen::PlainObjectBase<Eigen::Matrix<long, -1, 1, 0, -1, 1> > &);
 template void igl::sortrows<Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::DenseBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, bool, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> >&);
+template void igl::sortrows<Eigen::Matrix<std::int64_t, -1, -1, 0, -1, -1>, Eigen::Matrix<std::int64_t, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, 1, 0, -1, 1> >(Eigen::DenseBase<Eigen::Matrix<std::int64_t, -1, -1, 0, -1, -1> > const&, bool, Eigen::PlainObjectBase<Eigen::Matrix<std::int64_t, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&);
+template void igl::sortrows<Eigen::Matrix<float, -1, -1, 0, -1, -1>, Eigen::Matrix<float, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, 1, 0, -1, 1> >(Eigen::DenseBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> > const&, bool, Eigen::PlainObjectBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&);
+template void igl::sortrows<Eigen::Matrix<unsigned char, -1, 2, 0, -1, 2>, Eigen::Matrix<unsigned char, -1, 2, 0, -1, 2>, Eigen::Matrix<int, -1, 1, 0, -1, 1> >(Eigen::DenseBase<Eigen::Matrix<unsigned char, -1, 2, 0, -1, 2> > const&, bool, Eigen::PlainObjectBase<Eigen::Matrix<unsigned char, -1, 2, 0, -1, 2> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&);
 #ifdef WIN32
 template void igl::sortrows<Eigen::Matrix<double,-1,-1,0,-1,-1>,Eigen::Matrix<double,-1,-1,0,-1,-1>,Eigen::Matrix<__int64,-1,1,0,-1,1>>(Eigen::DenseBase<Eigen::Matrix<double,-1,-1,0,-1,-1> > const &, bool, Eigen::PlainObjectBase<Eigen::Matrix<double,-1,-1,0,-1,-1> > &, Eigen::PlainObjectBase<Eigen::Matrix<__int64,-1,1,0,-1,1> > &);
 template void igl::sortrows<Eigen::Matrix<int,-1,2,0,-1,2>,Eigen::Matrix<int,-1,2,0,-1,2>,Eigen::Matrix<__int64,-1,1,0,-1,1>>(Eigen::DenseBase<Eigen::Matrix<int,-1,2,0,-1,2> > const &, bool, Eigen::PlainObjectBase<Eigen::Matrix<int,-1,2,0,-1,2> > &, Eigen::PlainObjectBase<Eigen::Matrix<__int64,-1,1,0,-1,1> > &);
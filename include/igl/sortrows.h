@@ -15,6 +15,9 @@ namespace igl
 {
   /// Act like matlab's [Y,I] = sortrows(X)
   ///
+  /// The sort is stable (equal rows keep their order in X). Large integer and
+  /// floating point matrices are sorted with a parallel LSD radix sort.
+  ///
   /// @tparam DerivedX derived scalar type, e.g. Eigen::MatrixXi or Eigen::MatrixXd
   /// @tparam DerivedI derived integer type, e.g. Eigen::MatrixXi
   /// @param[in] X  m by n matrix whose entries are to be sorted
@@ -0,0 +1,107 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 Alec Jacobson <alecjacobson@gmail.com>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#include "sparse_assembly.h"
+#include "parallel_for.h"
+#include <algorithm>
+#include <cassert>
+#include <utility>
+#include <vector>
+
+template <typename DerivedI, typename DerivedJ>
+IGL_INLINE void igl::sparse_assembly_precompute(
+  const Eigen::MatrixBase<DerivedI> & I,
+  const Eigen::MatrixBase<DerivedJ> & J,
+  const Eigen::Index rows,
+  const Eigen::Index cols,
+  SparseAssemblyData & data)
+{
+  return sparse_assembly_precompute(I,J,rows,cols,I.size(),1,0,data);
+}
+
+template <typename DerivedI, typename DerivedJ>
+IGL_INLINE void igl::sparse_assembly_precompute(
+  const Eigen::MatrixBase<DerivedI> & I,
+  const Eigen::MatrixBase<DerivedJ> & J,
+  const Eigen::Index rows,
+  const Eigen::Index cols,
+  const Eigen::Index num_elements,
+  const Eigen::Index element_size,
+  const std::uint64_t elements_hash,
+  SparseAssemblyData & data)
+{
+  assert(I.size() == J.size());
+  assert(I.size() == num_elements*element_size);
+  const Eigen::Index num_contributions = I.size();
+  data.rows = rows;
+  data.cols = cols;
+  data.num_elements = num_elements;
+  data.element_size = element_size;
+  data.elements_hash = elements_hash;
+  // Bucket (row,index) pairs by column
+  Eigen::VectorXi column_start = Eigen::VectorXi::Zero(cols+1);
+  for(Eigen::Index t = 0;t<num_contributions;t++)
+  {
+    assert(I(t) >= 0 && I(t) < rows);
+    assert(J(t) >= 0 && J(t) < cols);
+    column_start(J(t)+1)++;
+  }
+  for(Eigen::Index c = 0;c<cols;c++) { column_start(c+1) += column_start(c); }
+  std::vector<std::pair<int,int> > row_index(num_contributions);
+  {
+    Eigen::VectorXi next = column_start.head(cols);
+    for(Eigen::Index t = 0;t<num_contributions;t++)
+    {
+      row_index[next(J(t))++] = {int(I(t)),int(t)};
+    }
+  }
+  // Sort each column by (row,index) and count distinct rows
+  data.order.resize(num_contributions);
+  Eigen::VectorXi column_nnz(cols);
+  igl::parallel_for(cols,[&](const Eigen::Index c)
+  {
+    const auto begin = row_index.begin()+column_start(c);
+    const auto end = row_index.begin()+column_start(c+1);
+    std::sort(begin,end);
+    int nnz = 0;
+    for(auto it = begin;it<end;it++)
+    {
+      nnz += (it == begin || it->first != (it-1)->first);
+      data.order(it-row_index.begin()) = it->second;
+    }
+    column_nnz(c) = nnz;
+  },1000);
+  data.outer.resize(cols+1);
+  data.outer(0) = 0;
+  for(Eigen::Index c = 0;c<cols;c++)
+  {
+    data.outer(c+1) = data.outer(c) + column_nnz(c);
+  }
+  const int nnz = data.outer(cols);
+  data.inner.resize(nnz);
+  data.start.resize(nnz+1);
+  igl::parallel_for(cols,[&](const Eigen::Index c)
+  {
+    int k = data.outer(c);
+    for(int p = column_start(c);p<column_start(c+1);p++)
+    {
+      if(p == column_start(c) || row_index[p].first != row_index[p-1].first)
+      {
+        data.inner(k) = row_index[p].first;
+        data.start(k) = p;
+        k++;
+      }
+    }
+  },1000);
+  data.start(nnz) = num_contributions;
+}
+
+#ifdef IGL_STATIC_LIBRARY
+// Explicit template instantiation
+template void igl::sparse_assembly_precompute<Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, 1, 0, -1, 1> >(Eigen::MatrixBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> > const&, const Eigen::Index, const Eigen::Index, igl::SparseAssemblyData&);
+template void igl::sparse_assembly_precompute<Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, 1, 0, -1, 1> >(Eigen::MatrixBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> > const&, const Eigen::Index, const Eigen::Index, const Eigen::Index, const Eigen::Index, const std::uint64_t, igl::SparseAssemblyData&);
+#endif
@@ -0,0 +1,194 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 Alec Jacobson <alecjacobson@gmail.com>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#ifndef IGL_SPARSE_ASSEMBLY_H
+#define IGL_SPARSE_ASSEMBLY_H
+#include "igl_inline.h"
+#include <Eigen/Core>
+#include <Eigen/Sparse>
+#include <cstdint>
+
+namespace igl
+{
+  /// Sparsity pattern (compressed column storage) of a matrix assembled by
+  /// summing a fixed list of (row,column) contributions, together with the
+  /// contributions landing in each nonzero.
+  ///
+  /// \see sparse_assembly_precompute, sparse_assembly
+  struct SparseAssemblyData
+  {
+    /// Size of the assembled matrix
+    Eigen::Index rows = 0;
+    Eigen::Index cols = 0;
+    /// cols+1 list of offsets into inner of the start of each column
+    Eigen::VectorXi outer;
+    /// nnz list of row indices of nonzeros
+    Eigen::VectorXi inner;
+    /// nnz+1 list of offsets into order of the contributions to each nonzero
+    Eigen::VectorXi start;
+    /// #contributions list of contribution indices sorted by the nonzero they
+    /// are summed into (and by index among those)
+    Eigen::VectorXi order;
+    /// Number of elements the contributions come from, number of
+    /// contributions per element and hash of the element indices (see hash),
+    /// used to detect a stale pattern
+    Eigen::Index num_elements = 0;
+    Eigen::Index element_size = 0;
+    std::uint64_t elements_hash = 0;
+    /// @return true iff no pattern has been precomputed
+    bool empty() const { return outer.size() == 0; }
+    /// @return true iff a pattern has been precomputed for a rows by cols
+    ///   matrix assembled from num_elements elements with element_size
+    ///   contributions each and element indices hashing to elements_hash
+    bool matches(
+      const Eigen::Index rows,
+      const Eigen::Index cols,
+      const Eigen::Index num_elements,
+      const Eigen::Index element_size,
+      const std::uint64_t elements_hash) const
+    {
+      return
+        !empty() &&
+        this->rows == rows &&
+        this->cols == cols &&
+        this->num_elements == num_elements &&
+        this->element_size == element_size &&
+        this->elements_hash == elements_hash;
+    }
+    /// @param[in] F  #F by k list of element indices
+    /// @return hash of the size and entries of F
+    template <typename DerivedF>
+    static std::uint64_t hash(const Eigen::MatrixBase<DerivedF> & F)
+    {
+      std::uint64_t h = std::uint64_t(F.rows())*0x9E3779B97F4A7C15ull;
+      h ^= std::uint64_t(F.cols());
+      for(Eigen::Index j = 0;j<F.cols();j++)
+      {
+        for(Eigen::Index i = 0;i<F.rows();i++)
+        {
+          h = (h ^ std::uint64_t(F(i,j))) * 0x9E3779B97F4A7C15ull;
+          h ^= h >> 29;
+        }
+      }
+      return h;
+    }
+  };
+  /// Precompute the sparsity pattern of X = sparse(I,J,V,rows,cols) for any V.
+  /// Contributions are bucketed by column in O(#I + cols) time and then each
+  /// column's contributions are sorted by row, in parallel over columns (no
+  /// triplet list, no global sort).
+  ///
+  /// @param[in] I  #I list of row indices of contributions
+  /// @param[in] J  #I list of column indices of contributions
+  /// @param[in] rows  number of rows of X
+  /// @param[in] cols  number of columns of X
+  /// @param[out] data  sparsity pattern and contribution map
+  ///
+  /// \see sparse, sparse_cached_precompute
+  template <typename DerivedI, typename DerivedJ>
+  IGL_INLINE void sparse_assembly_precompute(
+    const Eigen::MatrixBase<DerivedI> & I,
+    const Eigen::MatrixBase<DerivedJ> & J,
+    const Eigen::Index rows,
+    const Eigen::Index cols,
+    SparseAssemblyData & data);
+  /// \overload
+  ///
+  /// @param[in] num_elements  number of elements contributing to X
+  /// @param[in] element_size  number of contributions per element, so that
+  ///   #I = num_elements*element_size
+  /// @param[in] elements_hash  SparseAssemblyData::hash of the element
+  ///   indices I and J were built from
+  template <typename DerivedI, typename DerivedJ>
+  IGL_INLINE void sparse_assembly_precompute(
+    const Eigen::MatrixBase<DerivedI> & I,
+    const Eigen::MatrixBase<DerivedJ> & J,
+    const Eigen::Index rows,
+    const Eigen::Index cols,
+    const Eigen::Index num_elements,
+    const Eigen::Index element_size,
+    const std::uint64_t elements_hash,
+    SparseAssemblyData & data);
+  /// Fill X with the values of sparse(I,J,V,rows,cols) where I,J were passed
+  /// to sparse_assembly_precompute and V(t) = value(t). Each nonzero gathers
+  /// its contributions (in increasing t, so the result matches
+  /// Eigen::SparseMatrix::setFromTriplets exactly) in parallel over columns.
+  /// If X already has the pattern of data, only its values are overwritten and
+  /// nothing is allocated.
+  ///
+  /// @tparam ValueFunc  callable as `Scalar value(const int t)`
+  /// @param[in] data  output of sparse_assembly_precompute
+  /// @param[in] value  value of the t-th contribution
+  /// @param[in,out] X  data.rows by data.cols assembled sparse matrix
+  ///
+  /// #### Example:
+  ///
+  /// \code{cpp}
+  ///     igl::SparseAssemblyData data;
+  ///     igl::sparse_assembly_precompute(I,J,m,n,data);
+  ///     Eigen::SparseMatrix<double> X;
+  ///     igl::sparse_assembly(data,[&V](const int t){ return V(t); },X);
+  /// \endcode
+  template <typename Scalar, typename ValueFunc>
+  inline void sparse_assembly(
+    const SparseAssemblyData & data,
+    const ValueFunc & value,
+    Eigen::SparseMatrix<Scalar> & X);
+}
+
+// Implementation
+
+#include "parallel_for.h"
+#include <algorithm>
+
+template <typename Scalar, typename ValueFunc>
+inline void igl::sparse_assembly(
+  const SparseAssemblyData & data,
+  const ValueFunc & value,
+  Eigen::SparseMatrix<Scalar> & X)
+{
+  const Eigen::Index nnz = data.inner.size();
+  // Reuse X's pattern if it is already the right one
+  if(
+    X.rows() != data.rows ||
+    X.cols() != data.cols ||
+    !X.isCompressed() ||
+    X.nonZeros() != nnz ||
+    !std::equal(
+      data.outer.data(),data.outer.data()+data.outer.size(),
+      X.outerIndexPtr()) ||
+    !std::equal(
+      data.inner.data(),data.inner.data()+nnz,X.innerIndexPtr()))
+  {
+    X.resize(data.rows,data.cols);
+    X.resizeNonZeros(nnz);
+    std::copy(
+      data.outer.data(),data.outer.data()+data.outer.size(),
+      X.outerIndexPtr());
+    std::copy(data.inner.data(),data.inner.data()+nnz,X.innerIndexPtr());
+  }
+  Scalar * values = X.valuePtr();
+  igl::parallel_for(data.cols,[&](const Eigen::Index c)
+  {
+    for(int k = data.outer(c);k<data.outer(c+1);k++)
+    {
+      // Every nonzero has at least one contribution
+      Scalar sum = value(data.order(data.start(k)));
+      for(int p = data.start(k)+1;p<data.start(k+1);p++)
+      {
+        sum += value(data.order(p));
+      }
+      values[k] = sum;
+    }
+  },1000);
+}
+
+#ifndef IGL_STATIC_LIBRARY
+#  include "sparse_assembly.cpp"
+#endif
+
+#endif
@@ -0,0 +1,36 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 Alec Jacobson <alecjacobson@gmail.com>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#include "split_into_line_chunks.h"
+#include "default_num_threads.h"
+#include <algorithm>
+#include <cstring>
+
+IGL_INLINE void igl::split_into_line_chunks(
+  const char * begin,
+  const char * end,
+  const std::size_t target_chunk_size,
+  std::vector<const char *> & bounds)
+{
+  const std::size_t size = end>begin ? std::size_t(end-begin) : 0;
+  const std::size_t max_chunks = 8*std::size_t(igl::default_num_threads());
+  const std::size_t num_chunks = std::max<std::size_t>(1,std::min(
+    max_chunks,
+    size/std::max<std::size_t>(target_chunk_size,1)));
+  bounds.clear();
+  bounds.reserve(num_chunks+1);
+  bounds.push_back(begin);
+  for(std::size_t c = 1;c<num_chunks;c++)
+  {
+    const char * guess = begin + (size*c)/num_chunks;
+    // Never go backwards past the previous boundary
+    guess = std::max(guess,bounds.back());
+    const void * nl = guess<end ? std::memchr(guess,'\n',end-guess) : nullptr;
+    bounds.push_back(nl ? static_cast<const char *>(nl)+1 : end);
+  }
+  bounds.push_back(end);
+}
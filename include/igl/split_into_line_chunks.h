@@ -0,0 +1,39 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 Alec Jacobson <alecjacobson@gmail.com>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#ifndef IGL_SPLIT_INTO_LINE_CHUNKS_H
+#define IGL_SPLIT_INTO_LINE_CHUNKS_H
+#include "igl_inline.h"
+#include <cstddef>
+#include <vector>
+
+namespace igl
+{
+  /// Split a character range into contiguous chunks whose boundaries fall
+  /// right after a newline ('\\n') so that each chunk holds whole lines and
+  /// can be parsed independently (e.g., in parallel).
+  ///
+  /// @param[in] begin  start of the range
+  /// @param[in] end  end of the range
+  /// @param[in] target_chunk_size  desired number of bytes per chunk. The
+  ///   number of chunks is additionally capped at a small multiple of
+  ///   igl::default_num_threads().
+  /// @param[out] bounds  #chunks+1 list of chunk boundaries so that chunk c
+  ///   is [bounds[c],bounds[c+1]). bounds.front()==begin and
+  ///   bounds.back()==end. Chunks may be empty.
+  IGL_INLINE void split_into_line_chunks(
+    const char * begin,
+    const char * end,
+    const std::size_t target_chunk_size,
+    std::vector<const char *> & bounds);
+}
+
+#ifndef IGL_STATIC_LIBRARY
+#  include "split_into_line_chunks.cpp"
+#endif
+
+#endif
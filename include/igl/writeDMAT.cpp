@@ -7,6 +7,7 @@
 // obtain one at http://mozilla.org/MPL/2.0/.
 #include "writeDMAT.h"
 #include "list_to_matrix.h"
+#include "write_ascii_rows.h"
 #include <Eigen/Core>
 
 #include <cstdio>
@@ -27,14 +28,17 @@ IGL_INLINE bool igl::writeDMAT(
   {
     // first line contains number of rows and number of columns
     fprintf(fp,"%d %d\n",(int)W.cols(),(int)W.rows());
-    // Loop over columns slowly
-    for(int j = 0;j < W.cols();j++)
-    {
-      // loop over rows (down columns) quickly
-      for(int i = 0;i < W.rows();i++)
+    // Loop over columns slowly, rows (down columns) quickly
+    const Eigen::Index m = W.rows();
+    if(!igl::write_ascii_rows(fp,W.size(),
+      [&W,m](const Eigen::Index k,igl::AsciiBuffer & buffer)
       {
-        fprintf(fp,"%0.17lg\n",(double)W(i,j));
-      }
+        buffer.append_number(W(k%m,k/m)).append('\n');
+      }))
+    {
+      fclose(fp);
+      fprintf(stderr,"IOError: writing %s failed\n",file_name.c_str());
+      return false;
     }
   }else
   {
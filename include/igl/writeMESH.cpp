@@ -8,6 +8,7 @@
 #include "writeMESH.h"
 
 #include "verbose.h"
+#include "write_ascii_rows.h"
 #include "list_to_matrix.h"
 #include <Eigen/Core>
 
@@ -88,14 +89,16 @@ IGL_INLINE bool igl::writeMESH(
   int number_of_tet_vertices = V.rows();
   fprintf(mesh_file,"%d\n",number_of_tet_vertices);
   // loop over tet vertices
-  for(int i = 0;i<number_of_tet_vertices;i++)
-  {
-    // print position of ith tet vertex
-    fprintf(mesh_file,"%.17lg %.17lg %.17lg 1\n",
-      (double)V(i,0),
-      (double)V(i,1),
-      (double)V(i,2));
-  }
+  bool ok = igl::write_ascii_rows(mesh_file,number_of_tet_vertices,
+    [&V](const int i,igl::AsciiBuffer & buffer)
+    {
+      // print position of ith tet vertex
+      for(int j = 0;j<3;j++)
+      {
+        buffer.append_number(V(i,j)).append(' ');
+      }
+      buffer.append("1\n");
+    });
   verbose("WARNING: save_mesh() assumes that vertices have"
       " same indices in surface as volume...\n");
   // print faces
@@ -104,31 +107,38 @@ IGL_INLINE bool igl::writeMESH(
   int number_of_triangles = F.rows();
   fprintf(mesh_file,"%d\n",number_of_triangles);
   // loop over faces
-  for(int i = 0;i<number_of_triangles;i++)
-  {
-    // loop over vertices in face
-    fprintf(mesh_file,"%d %d %d 1\n", 
-      (int)F(i,0)+1, 
-      (int)F(i,1)+1, 
-      (int)F(i,2)+1);
-  }
+  ok = ok && igl::write_ascii_rows(mesh_file,number_of_triangles,
+    [&F](const int i,igl::AsciiBuffer & buffer)
+    {
+      // loop over vertices in face
+      for(int j = 0;j<3;j++)
+      {
+        buffer.append_number((int)F(i,j)+1).append(' ');
+      }
+      buffer.append("1\n");
+    });
   // print tetrahedra
   fprintf(mesh_file,"Tetrahedra\n");
   int number_of_tetrahedra = T.rows();
   // print number of tetrahedra
   fprintf(mesh_file,"%d\n",number_of_tetrahedra);
   // loop over tetrahedra
-  for(int i = 0; i < number_of_tetrahedra;i++)
+  ok = ok && igl::write_ascii_rows(mesh_file,number_of_tetrahedra,
+    [&T](const int i,igl::AsciiBuffer & buffer)
+    {
+      // mesh standard uses 1-based indexing
+      for(int j = 0;j<4;j++)
+      {
+        buffer.append_number((int)T(i,j)+1).append(' ');
+      }
+      buffer.append("1\n");
+    });
+  fclose(mesh_file);
+  if(!ok)
   {
-    // mesh standard uses 1-based indexing
-    fprintf(mesh_file, "%d %d %d %d 1\n",
-      (int)T(i,0)+1,
-      (int)T(i,1)+1,
-      (int)T(i,2)+1,
-      (int)T(i,3)+1);
+    fprintf(stderr,"IOError: writing %s failed\n",str.c_str());
   }
-  fclose(mesh_file);
-  return true;
+  return ok;
 }
 
 #ifdef IGL_STATIC_LIBRARY
@@ -6,11 +6,8 @@
 // v. 2.0. If a copy of the MPL was not distributed with this file, You can
 // obtain one at http://mozilla.org/MPL/2.0/.
 #include "writeOBJ.h"
+#include "write_ascii_rows.h"
 
-#include <iostream>
-#include <limits>
-#include <iomanip>
-#include <fstream>
 #include <cstdio>
 #include <cassert>
 
@@ -36,65 +33,74 @@ IGL_INLINE bool igl::writeOBJ(
     printf("IOError: %s could not be opened for writing...",str.c_str());
     return false;
   }
+  const bool write_N = CN.rows() >0;
+  const bool write_texture_coords = TC.rows() >0;
   // Loop over V
-  for(int i = 0;i<(int)V.rows();i++)
-  {
-    fprintf(obj_file,"v");
-    for(int j = 0;j<(int)V.cols();++j)
+  bool ok = igl::write_ascii_rows(obj_file,V.rows(),
+    [&V](const Eigen::Index i,igl::AsciiBuffer & buffer)
     {
-      fprintf(obj_file," %0.17g", V(i,j));
-    }
-    fprintf(obj_file,"\n");
-  }
-  bool write_N = CN.rows() >0;
+      buffer.append('v');
+      for(int j = 0;j<(int)V.cols();++j)
+      {
+        buffer.append(' ').append_number(V(i,j));
+      }
+      buffer.append('\n');
+    });
 
   if(write_N)
   {
-    for(int i = 0;i<(int)CN.rows();i++)
-    {
-      fprintf(obj_file,"vn %0.17g %0.17g %0.17g\n",
-              CN(i,0),
-              CN(i,1),
-              CN(i,2)
-              );
-    }
+    ok = ok && igl::write_ascii_rows(obj_file,CN.rows(),
+      [&CN](const Eigen::Index i,igl::AsciiBuffer & buffer)
+      {
+        buffer.append("vn");
+        for(int j = 0;j<3;++j)
+        {
+          buffer.append(' ').append_number(CN(i,j));
+        }
+        buffer.append('\n');
+      });
     fprintf(obj_file,"\n");
   }
 
-  bool write_texture_coords = TC.rows() >0;
-
   if(write_texture_coords)
   {
-    for(int i = 0;i<(int)TC.rows();i++)
-    {
-      fprintf(obj_file, "vt %0.17g %0.17g\n",TC(i,0),TC(i,1));
-    }
+    ok = ok && igl::write_ascii_rows(obj_file,TC.rows(),
+      [&TC](const Eigen::Index i,igl::AsciiBuffer & buffer)
+      {
+        buffer.append("vt ").append_number(TC(i,0));
+        buffer.append(' ').append_number(TC(i,1)).append('\n');
+      });
     fprintf(obj_file,"\n");
   }
 
   // loop over F
-  for(int i = 0;i<(int)F.rows();++i)
-  {
-    fprintf(obj_file,"f");
-    for(int j = 0; j<(int)F.cols();++j)
+  ok = ok && igl::write_ascii_rows(obj_file,F.rows(),
+    [&](const Eigen::Index i,igl::AsciiBuffer & buffer)
     {
-      // OBJ is 1-indexed
-      fprintf(obj_file," %u",F(i,j)+1);
-
-      if(write_texture_coords)
-        fprintf(obj_file,"/%u",FTC(i,j)+1);
-      if(write_N)
+      buffer.append('f');
+      for(int j = 0; j<(int)F.cols();++j)
       {
-        if (write_texture_coords)
-          fprintf(obj_file,"/%u",FN(i,j)+1);
-        else
-          fprintf(obj_file,"//%u",FN(i,j)+1);
+        // OBJ is 1-indexed
+        buffer.append(' ').append_number(unsigned(F(i,j)+1));
+
+        if(write_texture_coords)
+          buffer.append('/').append_number(unsigned(FTC(i,j)+1));
+        if(write_N)
+        {
+          if (write_texture_coords)
+            buffer.append('/').append_number(unsigned(FN(i,j)+1));
+          else
+            buffer.append("//").append_number(unsigned(FN(i,j)+1));
+        }
       }
-    }
-    fprintf(obj_file,"\n");
-  }
+      buffer.append('\n');
+    });
   fclose(obj_file);
-  return true;
+  if(!ok)
+  {
+    fprintf(stderr,"IOError: writing %s failed\n",str.c_str());
+  }
+  return ok;
 }
 
 template <typename DerivedV, typename DerivedF>
@@ -104,16 +110,39 @@ IGL_INLINE bool igl::writeOBJ(
   const Eigen::MatrixBase<DerivedF>& F)
 {
   assert(V.cols() == 3 && "V should have 3 columns");
-  std::ofstream s(str);
-  if(!s.is_open())
+  FILE * obj_file = fopen(str.c_str(),"w");
+  if(NULL==obj_file)
   {
     fprintf(stderr,"IOError: writeOBJ() could not open %s\n",str.c_str());
     return false;
   }
-  s<<
-    V.format(Eigen::IOFormat(Eigen::FullPrecision,Eigen::DontAlignCols," ","\n","v ","","","\n"))<<
-    (F.array()+1).format(Eigen::IOFormat(Eigen::FullPrecision,Eigen::DontAlignCols," ","\n","f ","","","\n"));
-  return true;
+  const bool ok =
+    igl::write_ascii_rows(obj_file,V.rows(),
+      [&V](const Eigen::Index i,igl::AsciiBuffer & buffer)
+      {
+        buffer.append('v');
+        for(Eigen::Index j = 0;j<V.cols();j++)
+        {
+          buffer.append(' ').append_number(V(i,j));
+        }
+        buffer.append('\n');
+      }) &&
+    igl::write_ascii_rows(obj_file,F.rows(),
+      [&F](const Eigen::Index i,igl::AsciiBuffer & buffer)
+      {
+        buffer.append('f');
+        for(Eigen::Index j = 0;j<F.cols();j++)
+        {
+          buffer.append(' ').append_number(F(i,j)+1);
+        }
+        buffer.append('\n');
+      });
+  fclose(obj_file);
+  if(!ok)
+  {
+    fprintf(stderr,"IOError: writing %s failed\n",str.c_str());
+  }
+  return ok;
 }
 
 template <typename DerivedV, typename T>
@@ -123,28 +152,41 @@ IGL_INLINE bool igl::writeOBJ(
   const std::vector<std::vector<T> >& F)
 {
   assert(V.cols() == 3 && "V should have 3 columns");
-  std::ofstream s(str);
-  if(!s.is_open())
+  FILE * obj_file = fopen(str.c_str(),"w");
+  if(NULL==obj_file)
   {
     fprintf(stderr,"IOError: writeOBJ() could not open %s\n",str.c_str());
     return false;
   }
-  s<<V.format(Eigen::IOFormat(Eigen::FullPrecision,Eigen::DontAlignCols," ","\n","v ","","","\n"));
-  
-  for(const auto& face : F)
+  const bool ok =
+    igl::write_ascii_rows(obj_file,V.rows(),
+      [&V](const Eigen::Index i,igl::AsciiBuffer & buffer)
+      {
+        buffer.append('v');
+        for(Eigen::Index j = 0;j<V.cols();j++)
+        {
+          buffer.append(' ').append_number(V(i,j));
+        }
+        buffer.append('\n');
+      }) &&
+    igl::write_ascii_rows(obj_file,F.size(),
+      [&F](const size_t f,igl::AsciiBuffer & buffer)
+      {
+        const auto & face = F[f];
+        assert(face.size() != 0);
+        buffer.append(face.size() == 2 ? 'l' : 'f');
+        for(const auto& vi : face)
+        {
+          buffer.append(' ').append_number(vi+1);
+        }
+        buffer.append('\n');
+      });
+  fclose(obj_file);
+  if(!ok)
   {
-    int face_size = face.size();
-    assert(face_size != 0);
-
-    s << (face_size == 2 ? "l" : "f");
-
-    for(const auto& vi : face)
-    {
-      s<<" "<<(vi+1); 
-    }
-    s<<"\n";
+    fprintf(stderr,"IOError: writing %s failed\n",str.c_str());
   }
-  return true;
+  return ok;
 }
 
 #ifdef IGL_STATIC_LIBRARY
@@ -6,8 +6,30 @@
 // v. 2.0. If a copy of the MPL was not distributed with this file, You can
 // obtain one at http://mozilla.org/MPL/2.0/.
 #include "writeOFF.h"
+#include "write_ascii_rows.h"
 #include <cstdio>
-#include <fstream>
+
+namespace igl
+{
+  namespace internal
+  {
+    // Write "n i j k ..." per face
+    template <typename DerivedF>
+    bool write_off_faces(FILE * s, const Eigen::MatrixBase<DerivedF>& F)
+    {
+      return igl::write_ascii_rows(s,F.rows(),
+        [&F](const Eigen::Index i,igl::AsciiBuffer & buffer)
+        {
+          buffer.append_number(F.cols());
+          for(Eigen::Index j = 0;j<F.cols();j++)
+          {
+            buffer.append(' ').append_number(F(i,j));
+          }
+          buffer.append('\n');
+        });
+    }
+  }
+}
 
 // write mesh to an ascii off file
 template <typename DerivedV, typename DerivedF>
@@ -17,18 +39,32 @@ IGL_INLINE bool igl::writeOFF(
   const Eigen::MatrixBase<DerivedF>& F)
 {
   assert(V.cols() == 3 && "V should have 3 columns");
-  std::ofstream s(fname);
-  if(!s.is_open())
+  FILE * s = fopen(fname.c_str(),"w");
+  if(NULL==s)
   {
     fprintf(stderr,"IOError: writeOFF() could not open %s\n",fname.c_str());
     return false;
   }
 
-  s<<
-    "OFF\n"<<V.rows()<<" "<<F.rows()<<" 0\n"<<
-    V.format(Eigen::IOFormat(Eigen::FullPrecision,Eigen::DontAlignCols," ","\n","","","","\n"))<<
-    (F.array()).format(Eigen::IOFormat(Eigen::FullPrecision,Eigen::DontAlignCols," ","\n",std::to_string(F.cols()) + " ","","","\n"));
-  return true;
+  fprintf(s,"OFF\n%ld %ld 0\n",long(V.rows()),long(F.rows()));
+  const bool ok =
+    igl::write_ascii_rows(s,V.rows(),
+      [&V](const Eigen::Index i,igl::AsciiBuffer & buffer)
+      {
+        for(Eigen::Index j = 0;j<V.cols();j++)
+        {
+          if(j > 0) { buffer.append(' '); }
+          buffer.append_number(V(i,j));
+        }
+        buffer.append('\n');
+      }) &&
+    igl::internal::write_off_faces(s,F);
+  fclose(s);
+  if(!ok)
+  {
+    fprintf(stderr,"IOError: writing %s failed\n",fname.c_str());
+  }
+  return ok;
 }
 
 // write mesh and colors-by-vertex to an ascii off file
@@ -48,8 +84,8 @@ IGL_INLINE bool igl::writeOFF(
     return false;
   }
 
-  std::ofstream s(fname);
-  if(!s.is_open())
+  FILE * s = fopen(fname.c_str(),"w");
+  if(NULL==s)
   {
     fprintf(stderr,"IOError: writeOFF() could not open %s\n",fname.c_str());
     return false;
@@ -61,15 +97,28 @@ IGL_INLINE bool igl::writeOFF(
   // (https://github.com/libigl/libigl/pull/679)
   Eigen::Matrix<typename DerivedC::Scalar,Eigen::Dynamic,Eigen::Dynamic> RGB_Array = rgbScale * C;
 
-  s<< "COFF\n"<<V.rows()<<" "<<F.rows()<<" 0\n";
-  for (unsigned i=0; i< V.rows(); i++)
+  fprintf(s,"COFF\n%ld %ld 0\n",long(V.rows()),long(F.rows()));
+  const bool ok =
+    igl::write_ascii_rows(s,V.rows(),
+      [&V,&RGB_Array](const Eigen::Index i,igl::AsciiBuffer & buffer)
+      {
+        for(Eigen::Index j = 0;j<V.cols();j++)
+        {
+          buffer.append_number(V(i,j)).append(' ');
+        }
+        for(int c = 0;c<3;c++)
+        {
+          buffer.append_number(unsigned(RGB_Array(i,c))).append(' ');
+        }
+        buffer.append("255\n");
+      }) &&
+    igl::internal::write_off_faces(s,F);
+  fclose(s);
+  if(!ok)
   {
-    s <<V.row(i).format(Eigen::IOFormat(Eigen::FullPrecision,Eigen::DontAlignCols," "," ","","",""," "));
-    s << unsigned(RGB_Array(i,0)) << " " << unsigned(RGB_Array(i,1)) << " " << unsigned(RGB_Array(i,2)) << " 255\n";
+    fprintf(stderr,"IOError: writing %s failed\n",fname.c_str());
   }
-
-  s<<(F.array()).format(Eigen::IOFormat(Eigen::FullPrecision,Eigen::DontAlignCols," ","\n",std::to_string(F.cols()) + " ","","","\n"));
-  return true;
+  return ok;
 }
 
 #ifdef IGL_STATIC_LIBRARY
@@ -0,0 +1,172 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 Alec Jacobson <alecjacobson@gmail.com>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#ifndef IGL_WRITE_ASCII_ROWS_H
+#define IGL_WRITE_ASCII_ROWS_H
+#include "igl_inline.h"
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <type_traits>
+
+namespace igl
+{
+  /// Growable character buffer for formatting ascii files without iostreams
+  /// or printf. Floating point numbers are written with the fewest digits
+  /// that read back (e.g., with strtod/sscanf) to exactly the same value of
+  /// the same type: `0.1` rather than `0.10000000000000001`.
+  ///
+  /// Uses std::to_chars when the standard library implements it for floating
+  /// point types and falls back to printf's `%.17g` (`%.9g` for float),
+  /// which also round-trips but is longer.
+  class AsciiBuffer
+  {
+    public:
+      void clear() { m_size = 0; }
+      std::size_t size() const { return m_size; }
+      const char * data() const { return m_data.data(); }
+      /// Append a character
+      AsciiBuffer & append(const char c)
+      {
+        reserve(1);
+        m_data[m_size++] = c;
+        return *this;
+      }
+      /// Append a null-terminated string
+      AsciiBuffer & append(const char * s)
+      {
+        const std::size_t n = std::strlen(s);
+        reserve(n);
+        std::memcpy(&m_data[m_size],s,n);
+        m_size += n;
+        return *this;
+      }
+      /// Append an integer or floating point number
+      ///
+      /// @tparam Scalar  arithmetic type. Floating point types other than
+      ///   float are written as double.
+      template <typename Scalar>
+      AsciiBuffer & append_number(const Scalar x);
+    private:
+      void reserve(const std::size_t n)
+      {
+        if(m_size + n > m_data.size())
+        {
+          m_data.resize(2*(m_size + n));
+        }
+      }
+      std::string m_data;
+      std::size_t m_size = 0;
+  };
+
+  /// Write n rows of ascii text to a file. Rows are formatted in parallel
+  /// into per-thread buffers a chunk at a time, and chunks are written in
+  /// order, so the output is identical to formatting rows serially.
+  ///
+  /// @tparam Func  callable as `format(i,buffer)`
+  /// @param[in] fp  file opened for writing
+  /// @param[in] n  number of rows
+  /// @param[in] format  function appending the ith row (including its line
+  ///   break) to an igl::AsciiBuffer
+  /// @return true on success, false if writing failed
+  ///
+  /// #### Example:
+  ///
+  /// \code{cpp}
+  ///     igl::write_ascii_rows(fp,V.rows(),
+  ///       [&V](const int i, igl::AsciiBuffer & buffer)
+  ///       {
+  ///         buffer.append("v");
+  ///         for(int j = 0;j<V.cols();j++)
+  ///         {
+  ///           buffer.append(' ').append_number(V(i,j));
+  ///         }
+  ///         buffer.append('\n');
+  ///       });
+  /// \endcode
+  template <typename Func>
+  inline bool write_ascii_rows(
+    FILE * fp,
+    const std::size_t n,
+    const Func & format);
+}
+
+// Implementation
+
+#include "default_num_threads.h"
+#include "parallel_for.h"
+#include <algorithm>
+#include <charconv>
+#include <vector>
+
+template <typename Scalar>
+inline igl::AsciiBuffer & igl::AsciiBuffer::append_number(const Scalar x)
+{
+  static_assert(std::is_arithmetic<Scalar>::value,"Scalar must be arithmetic");
+  // Longest double is "-2.2250738585072014e-308" (24 chars)
+  reserve(32);
+  char * first = &m_data[m_size];
+  char * last = first + 32;
+  if constexpr(std::is_integral<Scalar>::value)
+  {
+    m_size = std::to_chars(first,last,x).ptr - m_data.data();
+  }else
+  {
+    typedef typename std::conditional<
+      std::is_same<Scalar,float>::value,float,double>::type Real;
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+    m_size = std::to_chars(first,last,Real(x)).ptr - m_data.data();
+#else
+    m_size += std::snprintf(
+      first,32,std::is_same<Real,float>::value ? "%.9g" : "%.17g",
+      double(x));
+#endif
+  }
+  return *this;
+}
+
+template <typename Func>
+inline bool igl::write_ascii_rows(
+  FILE * fp,
+  const std::size_t n,
+  const Func & format)
+{
+  // Rows per chunk: large enough to amortize the fwrite and thread
+  // dispatch, small enough to bound memory
+  const std::size_t chunk_size = 1<<14;
+  const std::size_t num_chunks = (n+chunk_size-1)/chunk_size;
+  const std::size_t batch_size = std::max<std::size_t>(
+    1,std::min<std::size_t>(igl::default_num_threads(),num_chunks));
+  std::vector<AsciiBuffer> buffers(batch_size);
+  for(std::size_t batch = 0;batch<num_chunks;batch += batch_size)
+  {
+    const std::size_t num = std::min(batch_size,num_chunks-batch);
+    igl::parallel_for(num,[&](const std::size_t b)
+    {
+      AsciiBuffer & buffer = buffers[b];
+      buffer.clear();
+      const std::size_t begin = (batch+b)*chunk_size;
+      const std::size_t end = std::min(n,begin+chunk_size);
+      for(std::size_t i = begin;i<end;i++)
+      {
+        format(i,buffer);
+      }
+    },2);
+    for(std::size_t b = 0;b<num;b++)
+    {
+      const AsciiBuffer & buffer = buffers[b];
+      if(std::fwrite(buffer.data(),1,buffer.size(),fp) != buffer.size())
+      {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+#endif
@@ -1,17 +1,21 @@
 #include <test_common.h>
 #include <igl/AABB.h>
+#include <igl/ambient_occlusion.h>
 #include <igl/EPS.h>
 #include <igl/avg_edge_length.h>
 #include <igl/barycenter.h>
 #include <igl/colon.h>
 #include <igl/placeholders.h>
 #include <igl/get_seconds.h>
+#include <igl/icosahedron.h>
 #include <igl/point_mesh_squared_distance.h>
 #include <igl/point_simplex_squared_distance.h>
 #include <igl/per_face_normals.h>
 #include <igl/barycenter.h>
 #include <igl/randperm.h>
 #include <igl/read_triangle_mesh.h>
+#include <igl/shape_diameter_function.h>
+#include <igl/upsample.h>
 #include <iostream>
 
 TEST_CASE("AABB: find_2d", "[igl]")
@@ -315,3 +319,318 @@ TEST_CASE("AABB: intersect_tet", "[igl]")
   REQUIRE(UV(1) == Approx(0.52));
 
 }
+
+TEST_CASE("AABB: freeze", "[igl]")
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  igl::icosahedron(V,F);
+  for(int l = 0;l<3;l++)
+  {
+    Eigen::MatrixXd U;
+    Eigen::MatrixXi G;
+    igl::upsample(V,F,U,G);
+    V = U.rowwise().normalized();
+    F = G;
+  }
+  igl::AABB<Eigen::MatrixXd,3> tree;
+  tree.init(V,F);
+  igl::AABB<Eigen::MatrixXd,3> frozen = tree;
+  frozen.freeze();
+  REQUIRE(frozen.is_frozen());
+  REQUIRE(frozen.m_left == nullptr);
+  REQUIRE(frozen.m_right == nullptr);
+  REQUIRE(frozen.size() == tree.size());
+  REQUIRE(frozen.height() == tree.height());
+
+  const Eigen::MatrixXd P = 1.5*Eigen::MatrixXd::Random(1000,3);
+  {
+    Eigen::VectorXd sqrD,frozen_sqrD;
+    Eigen::VectorXi I,frozen_I;
+    Eigen::MatrixXd C,frozen_C;
+    tree.squared_distance(V,F,P,sqrD,I,C);
+    frozen.squared_distance(V,F,P,frozen_sqrD,frozen_I,frozen_C);
+    test_common::assert_eq(sqrD,frozen_sqrD);
+    test_common::assert_eq(I,frozen_I);
+    test_common::assert_eq(C,frozen_C);
+  }
+  {
+    const Eigen::MatrixXd dir = -P;
+    Eigen::VectorXi I,frozen_I;
+    Eigen::VectorXd T,frozen_T;
+    Eigen::MatrixXd UV,frozen_UV;
+    const double inf = std::numeric_limits<double>::infinity();
+    tree.intersect_ray(V,F,P,dir,inf,I,T,UV);
+    frozen.intersect_ray(V,F,P,dir,inf,frozen_I,frozen_T,frozen_UV);
+    test_common::assert_eq(I,frozen_I);
+    REQUIRE((I.array() >= 0).all());
+    for(int i = 0;i<P.rows();i++)
+    {
+      REQUIRE(T(i) == frozen_T(i));
+    }
+    std::vector<std::vector<igl::Hit<double>>> hits,frozen_hits;
+    tree.intersect_ray(V,F,P,dir,hits);
+    frozen.intersect_ray(V,F,P,dir,frozen_hits);
+    for(int i = 0;i<P.rows();i++)
+    {
+      REQUIRE(hits[i].size() == frozen_hits[i].size());
+      for(int h = 0;h<hits[i].size();h++)
+      {
+        REQUIRE(hits[i][h].id == frozen_hits[i][h].id);
+        REQUIRE(hits[i][h].t == frozen_hits[i][h].t);
+      }
+    }
+  }
+  // Thawing restores a pointer tree with the same structure
+  frozen.thaw();
+  REQUIRE(!frozen.is_frozen());
+  REQUIRE(frozen.size() == tree.size());
+  frozen.validate();
+  Eigen::RowVector3d c;
+  int i,frozen_i;
+  const Eigen::RowVector3d p(0.3,-0.2,0.1);
+  REQUIRE(tree.squared_distance(V,F,p,i,c) ==
+    frozen.squared_distance(V,F,p,frozen_i,c));
+  REQUIRE(i == frozen_i);
+}
+
+TEST_CASE("AABB: freeze find", "[igl]")
+{
+  Eigen::MatrixXd V(6,2);
+  V << 0,0, 1,0, 0,1, 2,1, 2,2, 1,2;
+  Eigen::MatrixXi F(4,3);
+  F << 2,0,1, 2,1,5, 5,3,4, 5,1,3;
+  igl::AABB<Eigen::MatrixXd,2> tree;
+  tree.init(V,F);
+  tree.freeze();
+  const Eigen::RowVector2d q(0.5,0.5);
+  std::vector<int> r = tree.find(V,F,q);
+  REQUIRE(r.size() == 2);
+  REQUIRE(r[0] == 0);
+  REQUIRE(r[1] == 1);
+  r = tree.find(V,F,q,true);
+  REQUIRE(r.size() == 1);
+  REQUIRE(tree.find(V,F,Eigen::RowVector2d(5,5)).empty());
+}
+
+TEST_CASE("AABB: freeze clusters", "[igl]")
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  igl::icosahedron(V,F);
+  for(int l = 0;l<3;l++)
+  {
+    Eigen::MatrixXd U;
+    Eigen::MatrixXi G;
+    igl::upsample(V,F,U,G);
+    V = U.rowwise().normalized();
+    F = G;
+  }
+  igl::AABB<Eigen::MatrixXd,3> tree;
+  tree.init(V,F);
+  igl::AABB<Eigen::MatrixXd,3> clustered = tree;
+  clustered.freeze(V,F);
+  REQUIRE(clustered.is_frozen());
+  REQUIRE(clustered.m_frozen->clusters.size() > 0);
+  REQUIRE(clustered.size() == tree.size());
+
+  const Eigen::MatrixXd P = 1.5*Eigen::MatrixXd::Random(1000,3);
+  Eigen::VectorXd sqrD,clustered_sqrD;
+  Eigen::VectorXi I,clustered_I;
+  Eigen::MatrixXd C,clustered_C;
+  tree.squared_distance(V,F,P,sqrD,I,C);
+  clustered.squared_distance(V,F,P,clustered_sqrD,clustered_I,clustered_C);
+  test_common::assert_near(sqrD,clustered_sqrD,1e-14);
+  test_common::assert_near(C,clustered_C,1e-14);
+  // Ties may be broken differently
+  for(int p = 0;p<P.rows();p++)
+  {
+    double sqr_d;
+    Eigen::RowVector3d c;
+    igl::point_simplex_squared_distance<3>(
+      Eigen::RowVector3d(P.row(p)),V,F,clustered_I(p),sqr_d,c);
+    REQUIRE(sqr_d == Approx(sqrD(p)).margin(1e-14));
+  }
+}
+
+TEST_CASE("AABB: build methods", "[igl]")
+{
+  // Coarse sphere plus a small, dense sphere: very uneven element sizes
+  const auto sphere = [](const int levels, Eigen::MatrixXd & V, Eigen::MatrixXi & F)
+  {
+    igl::icosahedron(V,F);
+    for(int l = 0;l<levels;l++)
+    {
+      Eigen::MatrixXd U;
+      Eigen::MatrixXi G;
+      igl::upsample(V,F,U,G);
+      V = U.rowwise().normalized();
+      F = G;
+    }
+  };
+  Eigen::MatrixXd V1,V2;
+  Eigen::MatrixXi F1,F2;
+  sphere(1,V1,F1);
+  sphere(4,V2,F2);
+  V2 = (0.05*V2).rowwise() + Eigen::RowVector3d(0.5,0.2,0.3);
+  Eigen::MatrixXd V(V1.rows()+V2.rows(),3);
+  V<<V1,V2;
+  Eigen::MatrixXi F(F1.rows()+F2.rows(),3);
+  F<<F1,F2.array()+V1.rows();
+
+  igl::AABB<Eigen::MatrixXd,3> median;
+  median.init(V,F);
+  const Eigen::MatrixXd P = Eigen::MatrixXd::Random(500,3);
+  Eigen::VectorXd sqrD;
+  Eigen::VectorXi I;
+  Eigen::MatrixXd C;
+  median.squared_distance(V,F,P,sqrD,I,C);
+  for(const auto method : {
+    igl::AABB_BUILD_METHOD_MEDIAN,
+    igl::AABB_BUILD_METHOD_SAH,
+    igl::AABB_BUILD_METHOD_LBVH})
+  {
+    igl::AABB<Eigen::MatrixXd,3> tree;
+    tree.init(V,F,method);
+    tree.validate();
+    // Full binary tree with one leaf per element
+    REQUIRE(tree.size() == 2*F.rows()-1);
+    std::vector<igl::AABB<Eigen::MatrixXd,3>*> leaves = tree.gather_leaves(F.rows());
+    for(int f = 0;f<F.rows();f++)
+    {
+      REQUIRE(leaves[f] != nullptr);
+      REQUIRE(leaves[f]->m_primitive == f);
+    }
+    Eigen::VectorXd method_sqrD;
+    Eigen::VectorXi method_I;
+    Eigen::MatrixXd method_C;
+    tree.squared_distance(V,F,P,method_sqrD,method_I,method_C);
+    test_common::assert_near(method_sqrD,sqrD,1e-15);
+    if(method == igl::AABB_BUILD_METHOD_SAH)
+    {
+      REQUIRE(tree.sah_cost() < median.sah_cost());
+    }
+  }
+}
+
+TEST_CASE("AABB: ray packets", "[igl]")
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  igl::icosahedron(V,F);
+  for(int l = 0;l<3;l++)
+  {
+    Eigen::MatrixXd U;
+    Eigen::MatrixXi G;
+    igl::upsample(V,F,U,G);
+    V = U.rowwise().normalized();
+    F = G;
+  }
+  // Second, smaller sphere occluding part of the first
+  {
+    const Eigen::MatrixXd U = (0.4*V).rowwise() + Eigen::RowVector3d(1.3,0,0);
+    const Eigen::MatrixXi G = F.array() + V.rows();
+    V.conservativeResize(2*V.rows(),3);
+    V.bottomRows(U.rows()) = U;
+    F.conservativeResize(2*F.rows(),3);
+    F.bottomRows(G.rows()) = G;
+  }
+  igl::AABB<Eigen::MatrixXd,3> tree;
+  tree.init(V,F);
+  igl::AABB<Eigen::MatrixXd,3> frozen = tree;
+  frozen.freeze();
+  // Rays from inside and outside the sphere, many of them missing; an odd
+  // count leaves a partial last packet
+  const int num_rays = 1001;
+  Eigen::MatrixXd R(num_rays,6);
+  R.leftCols(3) = 1.5*Eigen::MatrixXd::Random(num_rays,3);
+  R.rightCols(3) = Eigen::MatrixXd::Random(num_rays,3);
+  const double inf = std::numeric_limits<double>::infinity();
+  for(const auto * aabb : {&tree,&frozen})
+  {
+    Eigen::VectorXi I;
+    Eigen::VectorXd T;
+    Eigen::MatrixXd UV;
+    aabb->intersect_rays(V,F,R,inf,I,T,UV);
+    int num_hits = 0;
+    for(int r = 0;r<num_rays;r++)
+    {
+      igl::Hit<double> hit;
+      const Eigen::RowVector3d origin = R.row(r).head<3>();
+      const Eigen::RowVector3d dir = R.row(r).tail<3>();
+      if(aabb->intersect_ray(V,F,origin,dir,inf,hit))
+      {
+        REQUIRE(I(r) == hit.id);
+        REQUIRE(T(r) == hit.t);
+        REQUIRE(UV(r,0) == hit.u);
+        REQUIRE(UV(r,1) == hit.v);
+        num_hits++;
+      }else
+      {
+        REQUIRE(I(r) == -1);
+        REQUIRE(std::isnan(T(r)));
+      }
+    }
+    REQUIRE(num_hits > 0);
+    REQUIRE(num_hits < num_rays);
+    // Other packet sizes and a bound on t
+    Eigen::Matrix<double,4,3> origin = R.topLeftCorner<4,3>();
+    Eigen::Matrix<double,4,3> dir = R.topRightCorner<4,3>();
+    std::array<igl::Hit<double>,4> hits;
+    const int num_packet_hits =
+      aabb->intersect_ray_packet<4>(V,F,origin,dir,0.5,false,hits);
+    int expected_hits = 0;
+    for(int r = 0;r<4;r++)
+    {
+      igl::Hit<double> hit;
+      if(aabb->intersect_ray(V,F,origin.row(r),dir.row(r),0.5,hit) &&
+        hit.t < 0.5)
+      {
+        REQUIRE(hits[r].id == hit.id);
+        REQUIRE(hits[r].t == hit.t);
+        expected_hits++;
+      }else
+      {
+        REQUIRE(hits[r].id == -1);
+      }
+    }
+    REQUIRE(num_packet_hits == expected_hits);
+  }
+
+  // Packet traced ambient occlusion and shape diameter function match
+  // tracing one ray at a time
+  Eigen::MatrixXd N;
+  igl::per_face_normals(V,F,N);
+  Eigen::MatrixXd BC;
+  igl::barycenter(V,F,BC);
+  const std::function<bool(const Eigen::Vector3d &,const Eigen::Vector3d &)>
+    occluded = [&](const Eigen::Vector3d & s,const Eigen::Vector3d & dir)
+  {
+    igl::Hit<double> hit;
+    return tree.intersect_ray(
+      V,F,Eigen::RowVector3d(s+1e-4*dir),Eigen::RowVector3d(dir),hit);
+  };
+  const std::function<double(const Eigen::Vector3d &,const Eigen::Vector3d &)>
+    distance = [&](const Eigen::Vector3d & s,const Eigen::Vector3d & dir)
+  {
+    igl::Hit<double> hit;
+    return tree.intersect_ray(
+      V,F,Eigen::RowVector3d(s+1e-4*dir),Eigen::RowVector3d(dir),hit) ?
+      double(hit.t) : inf;
+  };
+  // Sample count not a multiple of the packet size
+  const int num_samples = 61;
+  // Directions are random: reseed to get the same ones
+  Eigen::VectorXd S,expected_S;
+  std::srand(0);
+  igl::ambient_occlusion(frozen,V,F,BC,N,num_samples,S);
+  std::srand(0);
+  igl::ambient_occlusion(occluded,BC,N,num_samples,expected_S);
+  test_common::assert_eq(S,expected_S);
+  REQUIRE(S.maxCoeff() > 0);
+  std::srand(0);
+  igl::shape_diameter_function(tree,V,F,BC,N,num_samples,S);
+  std::srand(0);
+  igl::shape_diameter_function(distance,BC,N,num_samples,expected_S);
+  test_common::assert_eq(S,expected_S);
+}
@@ -0,0 +1,232 @@
+#include <test_common.h>
+#include <igl/BinaryCache.h>
+#include <igl/AABB.h>
+#include <igl/cotmatrix.h>
+#include <igl/icosahedron.h>
+#include <igl/triangle_triangle_adjacency.h>
+#include <igl/unique_edge_map.h>
+#include <igl/upsample.h>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <tuple>
+#include <type_traits>
+
+TEST_CASE("BinaryCache: round trip", "[igl]")
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  igl::icosahedron(V,F);
+  for(int l = 0;l<2;l++)
+  {
+    Eigen::MatrixXd U;
+    Eigen::MatrixXi G;
+    igl::upsample(V,F,U,G);
+    V = U.rowwise().normalized();
+    F = G;
+  }
+  Eigen::MatrixXi E,uE,uEC,uEE;
+  Eigen::VectorXi EMAP;
+  igl::unique_edge_map(F,E,uE,EMAP,uEC,uEE);
+  Eigen::MatrixXi TT,TTi;
+  igl::triangle_triangle_adjacency(F,TT,TTi);
+  Eigen::SparseMatrix<double> L;
+  igl::cotmatrix(V,F,L);
+  const Eigen::Matrix<float,Eigen::Dynamic,3,Eigen::RowMajor> VR =
+    V.cast<float>();
+  igl::AABB<Eigen::MatrixXd,3> tree;
+  tree.init(V,F);
+
+  const std::string path = test_common::data_path("_tmp_BinaryCache.iglcache");
+  {
+    igl::BinaryCacheWriter writer;
+    writer.add("V",V);
+    writer.add("F",F);
+    writer.add("E",E);
+    writer.add("uE",uE);
+    writer.add("EMAP",EMAP);
+    writer.add("uEC",uEC);
+    writer.add("uEE",uEE);
+    writer.add("TT",TT);
+    writer.add("TTi",TTi);
+    writer.add("L",L);
+    writer.add("VR",VR);
+    // Unfrozen tree is frozen on the fly
+    writer.add("tree",tree);
+    REQUIRE(writer.write(path));
+  }
+
+  igl::AABB<Eigen::MatrixXd,3> mapped_tree;
+  {
+    igl::BinaryCache cache(path);
+    REQUIRE(cache.is_open());
+    REQUIRE(cache.names().size() == 12);
+    REQUIRE(cache.find("nope") == nullptr);
+    const auto check_dense = [&cache](const std::string & name, const auto & X)
+    {
+      typedef typename std::decay<decltype(X)>::type Derived;
+      Eigen::Map<const Derived> M(X.data(),X.rows(),X.cols());
+      REQUIRE(cache.map(name,M));
+      REQUIRE(M.data() != X.data());
+      test_common::assert_eq(M,X);
+      // Zero-copy views are aligned within the file
+      REQUIRE(
+        reinterpret_cast<std::uintptr_t>(M.data()) %
+        igl::BinaryCache::ALIGNMENT == 0);
+    };
+    check_dense("V",V);
+    check_dense("F",F);
+    check_dense("E",E);
+    check_dense("uE",uE);
+    check_dense("EMAP",EMAP);
+    check_dense("uEC",uEC);
+    check_dense("uEE",uEE);
+    check_dense("TT",TT);
+    check_dense("TTi",TTi);
+    check_dense("VR",VR);
+    {
+      // Wrong scalar type, storage order or kind
+      Eigen::Map<const Eigen::MatrixXf> Vf(nullptr,0,0);
+      REQUIRE(!cache.map("V",Vf));
+      Eigen::Map<const Eigen::MatrixXf> VRc(nullptr,0,0);
+      REQUIRE(!cache.map("VR",VRc));
+      Eigen::Map<const Eigen::MatrixXd> Ld(nullptr,0,0);
+      REQUIRE(!cache.map("L",Ld));
+    }
+    Eigen::Map<const Eigen::SparseMatrix<double> > ML(
+      0,0,0,nullptr,nullptr,nullptr);
+    REQUIRE(cache.map("L",ML));
+    const Eigen::SparseMatrix<double> LL = ML;
+    test_common::assert_eq(LL,L);
+    REQUIRE(cache.map("tree",mapped_tree));
+    REQUIRE(mapped_tree.is_frozen());
+  }
+
+  // Tree keeps the file mapped after the cache is closed
+  tree.freeze();
+  const Eigen::MatrixXd P = 1.5*Eigen::MatrixXd::Random(100,3);
+  Eigen::VectorXd sqrD,mapped_sqrD;
+  Eigen::VectorXi I,mapped_I;
+  Eigen::MatrixXd C,mapped_C;
+  tree.squared_distance(V,F,P,sqrD,I,C);
+  mapped_tree.squared_distance(V,F,P,mapped_sqrD,mapped_I,mapped_C);
+  test_common::assert_eq(sqrD,mapped_sqrD);
+  test_common::assert_eq(I,mapped_I);
+  REQUIRE(tree.size() == mapped_tree.size());
+  std::remove(path.c_str());
+}
+
+TEST_CASE("BinaryCache: rejects invalid files", "[igl]")
+{
+  const std::string path = test_common::data_path("_tmp_BinaryCache.iglcache");
+  igl::BinaryCacheWriter writer;
+  writer.add("A",Eigen::MatrixXd::Identity(3,3));
+  REQUIRE(writer.write(path));
+  std::string contents;
+  {
+    std::ifstream in(path,std::ios::binary);
+    contents.assign(
+      std::istreambuf_iterator<char>(in),std::istreambuf_iterator<char>());
+  }
+  const auto rewrite = [&path](const std::string & data)
+  {
+    std::ofstream out(path,std::ios::binary | std::ios::trunc);
+    out.write(data.data(),data.size());
+  };
+  igl::BinaryCache cache;
+  REQUIRE(cache.open(path));
+  // Truncated section
+  rewrite(contents.substr(0,contents.size()-8));
+  REQUIRE(!cache.open(path));
+  REQUIRE(!cache.is_open());
+  // Bad magic
+  std::string bad = contents;
+  bad[0] = 'X';
+  rewrite(bad);
+  REQUIRE(!cache.open(path));
+  // Future version
+  bad = contents;
+  bad[8] = char(igl::BinaryCache::VERSION+1);
+  rewrite(bad);
+  REQUIRE(!cache.open(path));
+  // Size whose byte count wraps around to the stored one: 8*(2⁶¹+9) ≡ 72
+  bad = contents;
+  const std::int64_t rows = (std::int64_t(1)<<61)+9, cols = 1;
+  const std::size_t section = sizeof(igl::BinaryCache::Header);
+  bad.replace(
+    section+offsetof(igl::BinaryCache::Section,rows),sizeof(rows),
+    reinterpret_cast<const char *>(&rows),sizeof(rows));
+  bad.replace(
+    section+offsetof(igl::BinaryCache::Section,cols),sizeof(cols),
+    reinterpret_cast<const char *>(&cols),sizeof(cols));
+  rewrite(bad);
+  REQUIRE(!cache.open(path));
+  std::remove(path.c_str());
+}
+
+TEST_CASE("BinaryCache: rejects invalid indices", "[igl]")
+{
+  const std::string path = test_common::data_path("_tmp_BinaryCache.iglcache");
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  igl::icosahedron(V,F);
+  igl::AABB<Eigen::MatrixXd,3> tree;
+  tree.init(V,F);
+  Eigen::SparseMatrix<double> L;
+  igl::cotmatrix(V,F,L);
+  // Overwrite the int at position `index` of array `i` of the only section
+  const auto corrupt = [&path](const int i,const int index,const int value)
+  {
+    std::string contents;
+    {
+      std::ifstream in(path,std::ios::binary);
+      contents.assign(
+        std::istreambuf_iterator<char>(in),std::istreambuf_iterator<char>());
+    }
+    igl::BinaryCache::Section section;
+    std::memcpy(
+      &section,contents.data()+sizeof(igl::BinaryCache::Header),
+      sizeof(section));
+    std::uint64_t offsets[3],bytes;
+    REQUIRE(igl::BinaryCache::layout(section,offsets,bytes));
+    std::memcpy(
+      &contents[section.offset+offsets[i]+sizeof(int)*index],
+      &value,sizeof(int));
+    std::ofstream out(path,std::ios::binary | std::ios::trunc);
+    out.write(contents.data(),contents.size());
+  };
+  igl::BinaryCache cache;
+  for(const auto & [i,index,value] : std::vector<std::tuple<int,int,int> >{
+    // outer not ending at nnz
+    {0,int(L.cols()),int(L.nonZeros())+1},
+    // decreasing outer
+    {0,1,int(L.nonZeros())},
+    // row index out of range
+    {1,0,int(L.rows())},
+    {1,0,-1}})
+  {
+    igl::BinaryCacheWriter writer;
+    writer.add("L",L);
+    REQUIRE(writer.write(path));
+    REQUIRE(cache.open(path));
+    corrupt(i,index,value);
+    REQUIRE(!cache.open(path));
+  }
+  const int n = tree.size();
+  for(const int value : {n,0,1,-1-n})
+  {
+    igl::BinaryCacheWriter writer;
+    writer.add("tree",tree);
+    REQUIRE(writer.write(path));
+    REQUIRE(cache.open(path));
+    // root's right child out of range, a cycle, an empty left subtree and a
+    // leaf with an out-of-range primitive
+    corrupt(2,value == -1-n ? n-1 : 0,value);
+    REQUIRE(!cache.open(path));
+  }
+  std::remove(path.c_str());
+}
@@ -0,0 +1,121 @@
+#include <test_common.h>
+#include <igl/SparseBrickSDF.h>
+#include <igl/icosahedron.h>
+#include <igl/upsample.h>
+#include <igl/signed_distance.h>
+#include <igl/fast_winding_number.h>
+#include <igl/AABB.h>
+
+TEST_CASE("SparseBrickSDF: sphere", "[igl]")
+{
+  typedef igl::SparseBrickSDF<double> SDF;
+  const double r = 0.7;
+  int num_evaluations = 0;
+  const SDF::BatchedFunction sphere = 
+    [&](const SDF::MatrixX3SR & X)->SDF::VectorXS
+    {
+      num_evaluations += X.rows();
+      return X.rowwise().norm().array()-r;
+    };
+  const double h = 0.02;
+  const double band = 3*h;
+  SDF sdf;
+  sdf.init(Eigen::RowVector3d(-1,-1,-1),h,band,sphere);
+  sdf.fill(Eigen::RowVector3d(-1,-1,-1),Eigen::RowVector3d(1,1,1));
+  const int num_bricks = sdf.num_stored_bricks();
+  REQUIRE(num_bricks > 0);
+  // Memory should follow the surface: far fewer bricks than cover the box
+  const int dense_bricks = std::pow(std::ceil(2./(h*SDF::brick_size)),3);
+  REQUIRE(num_bricks < dense_bricks/2);
+
+  // Random points near the sphere
+  const int n = 1000;
+  Eigen::MatrixXd P = Eigen::MatrixXd::Random(n,3);
+  P.rowwise().normalize();
+  const Eigen::VectorXd R = 
+    r + 2*h*Eigen::VectorXd::Random(n).array();
+  P = P.array().colwise()*R.array();
+  Eigen::VectorXd S;
+  Eigen::MatrixXd G;
+  const int num_evaluations_before = num_evaluations;
+  sdf.query(P,S,G);
+  // Everything was already filled
+  REQUIRE(num_evaluations == num_evaluations_before);
+  for(int p = 0;p<n;p++)
+  {
+    // Trilinear interpolation error is O(h²/r)
+    REQUIRE(S(p) == Approx(R(p)-r).margin(h*h/r));
+    const Eigen::RowVector3d N = P.row(p).normalized();
+    REQUIRE((G.row(p)-N).norm() < 0.1);
+  }
+
+  // Far away: ±band
+  Eigen::MatrixXd Q(2,3);
+  Q<<
+    0.0,0.0,0.0,
+    0.9,0.9,0.9;
+  Eigen::VectorXd SQ;
+  sdf.query(Q,SQ);
+  REQUIRE(SQ(0) == -band);
+  REQUIRE(SQ(1) == band);
+}
+
+TEST_CASE("SparseBrickSDF: lazy", "[igl]")
+{
+  typedef igl::SparseBrickSDF<double> SDF;
+  // Plane z=0.3 passing through many bricks
+  const SDF::BatchedFunction plane = 
+    [](const SDF::MatrixX3SR & X)->SDF::VectorXS
+    {
+      return X.col(2).array()-0.3;
+    };
+  SDF sdf;
+  sdf.init(Eigen::RowVector3d(0,0,0),0.1,0.2,plane);
+  REQUIRE(sdf.num_stored_bricks() == 0);
+  Eigen::MatrixXd P(4,3);
+  P<<
+     0.15, 0.25, 0.31,
+    -3.05, 7.25, 0.21,
+     0.15, 0.25, 5.00,
+     0.15, 0.25,-5.00;
+  Eigen::VectorXd S;
+  Eigen::MatrixXd G;
+  sdf.query(P,S,G);
+  // Only the two bricks touching the plane store samples
+  REQUIRE(sdf.num_stored_bricks() == 2);
+  REQUIRE(sdf.bricks.size() == 4);
+  // Linear functions are reproduced exactly
+  REQUIRE(S(0) == Approx(0.01).margin(1e-12));
+  REQUIRE(S(1) == Approx(-0.09).margin(1e-12));
+  REQUIRE(S(2) == 0.2);
+  REQUIRE(S(3) == -0.2);
+  for(int p = 0;p<2;p++)
+  {
+    test_common::assert_near(G.row(p),Eigen::RowVector3d(0,0,1),1e-12);
+  }
+}
+
+TEST_CASE("SparseBrickSDF: mesh", "[igl]")
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  igl::icosahedron(V,F);
+  igl::upsample(Eigen::MatrixXd(V),Eigen::MatrixXi(F),V,F,3);
+  V.rowwise().normalize();
+  const double h = 0.025;
+  igl::SparseBrickSDF<double> sdf;
+  sdf.init(V,F,h,4*h);
+  // Queries near the surface
+  Eigen::MatrixXd P = Eigen::MatrixXd::Random(500,3);
+  P.rowwise().normalize();
+  P.array().colwise() *= 1+0.1*Eigen::VectorXd::Random(P.rows()).array();
+  Eigen::VectorXd S;
+  sdf.query(P,S);
+  igl::AABB<Eigen::MatrixXd,3> tree;
+  tree.init(V,F);
+  igl::FastWindingNumberBVH fwn_bvh;
+  igl::fast_winding_number(V.cast<float>().eval(),F,2,fwn_bvh);
+  Eigen::VectorXd S_exact;
+  igl::signed_distance_fast_winding_number(P,V,F,tree,fwn_bvh,S_exact);
+  test_common::assert_near(S,S_exact,h);
+}
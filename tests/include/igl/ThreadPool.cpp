@@ -0,0 +1,92 @@
+#include <test_common.h>
+#include <igl/ThreadPool.h>
+#include <igl/parallel_for.h>
+#include <atomic>
+#include <stdexcept>
+
+TEST_CASE("ThreadPool: every iteration once", "[igl]")
+{
+  igl::ThreadPool pool(4);
+  for(const int n : {1,3,4,17,1000,100003})
+  {
+    std::vector<std::atomic<int>> count(n);
+    for(auto & c : count) { c = 0; }
+    pool.parallel_for(n,[&](const int i){ count[i]++; });
+    for(int i = 0;i<n;i++) { REQUIRE(count[i] == 1); }
+  }
+}
+
+TEST_CASE("ThreadPool: accumulate", "[igl]")
+{
+  igl::ThreadPool pool(3);
+  const int n = 54321;
+  Eigen::VectorXd S;
+  double sum = 0;
+  const bool parallel = pool.parallel_for(
+    n,
+    [&S](const size_t t){ S = Eigen::VectorXd::Zero(t); },
+    [&S](const int i, const size_t t){ S(t) += i; },
+    [&S,&sum](const size_t t){ sum += S(t); },
+    1000,
+    7);
+  REQUIRE(parallel);
+  REQUIRE(sum == double(n)*(n-1)/2);
+}
+
+TEST_CASE("ThreadPool: nested", "[igl]")
+{
+  igl::ThreadPool pool(4);
+  const int n = 64;
+  for(const auto policy :
+    {igl::ThreadPool::NESTED_SERIAL,igl::ThreadPool::NESTED_PARALLEL})
+  {
+    pool.set_nested_policy(policy);
+    std::atomic<int> count(0);
+    std::atomic<int> nested_parallel(0);
+    std::atomic<int> in_region(0);
+    pool.parallel_for(n,[&](const int)
+    {
+      in_region += igl::ThreadPool::in_parallel_region();
+      if(pool.parallel_for(n,[&](const int){ count++; }))
+      {
+        nested_parallel++;
+      }
+    });
+    REQUIRE(count == n*n);
+    REQUIRE(in_region == n);
+    if(policy == igl::ThreadPool::NESTED_SERIAL)
+    {
+      REQUIRE(nested_parallel == 0);
+    }
+  }
+  REQUIRE(!igl::ThreadPool::in_parallel_region());
+}
+
+TEST_CASE("ThreadPool: exception", "[igl]")
+{
+  igl::ThreadPool pool(4);
+  std::atomic<int> count(0);
+  REQUIRE_THROWS_AS(
+    pool.parallel_for(1000,[&](const int i)
+    {
+      if(i == 500) { throw std::runtime_error("boom"); }
+      count++;
+    }),
+    std::runtime_error);
+  // pool still usable
+  count = 0;
+  pool.parallel_for(1000,[&](const int){ count++; });
+  REQUIRE(count == 1000);
+}
+
+TEST_CASE("ThreadPool: parallel_for uses global pool", "[igl]")
+{
+  const int n = 10000;
+  Eigen::VectorXi X = Eigen::VectorXi::Zero(n);
+  // Many small loops should be cheap since threads are persistent
+  for(int r = 0;r<1000;r++)
+  {
+    igl::parallel_for(n,[&](const int i){ X(i)++; },1000);
+  }
+  REQUIRE((X.array() == 1000).all());
+}
@@ -9,9 +9,89 @@
 #include <igl/barycentric_interpolation.h>
 #include <igl/readOBJ.h>
 #include <igl/blue_noise.h>
+#include <igl/icosahedron.h>
+#include <igl/upsample.h>
 #include <igl/knn.h>
 #include <igl/octree.h>
 #include <igl/slice.h>
+#include <igl/ThreadPool.h>
+#include <random>
+
+namespace blue_noise
+{
+  // Unit sphere
+  void sphere(Eigen::MatrixXd & V, Eigen::MatrixXi & F)
+  {
+    igl::icosahedron(V,F);
+    igl::upsample(Eigen::MatrixXd(V),Eigen::MatrixXi(F),V,F,3);
+    V.rowwise().normalize();
+  }
+
+  template <typename DerivedP>
+  double min_distance(const Eigen::MatrixBase<DerivedP> & P)
+  {
+    double min_d = std::numeric_limits<double>::infinity();
+    for(int i = 0;i<P.rows();i++)
+    {
+      for(int j = i+1;j<P.rows();j++)
+      {
+        min_d = std::min(min_d,(P.row(i)-P.row(j)).norm());
+      }
+    }
+    return min_d;
+  }
+}
+
+TEST_CASE("blue_noise: sphere", "[igl]")
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  blue_noise::sphere(V,F);
+  const double r = 0.1;
+  Eigen::MatrixXd B,P,Bp,Pp;
+  Eigen::VectorXi FI,FIp;
+  igl::blue_noise(V,F,r,B,FI,P,std::mt19937(0));
+  igl::blue_noise_parallel(V,F,r,Bp,FIp,Pp,std::mt19937(0));
+  REQUIRE(blue_noise::min_distance(P) >= r);
+  REQUIRE(blue_noise::min_distance(Pp) >= r);
+  // Both are maximal samplings from similar candidates
+  REQUIRE(Pp.rows() > 0.8*P.rows());
+  REQUIRE(Pp.rows() < 1.2*P.rows());
+  for(int i = 0;i<Pp.rows();i++)
+  {
+    Eigen::RowVector3d p = Eigen::RowVector3d::Zero();
+    for(int c = 0;c<3;c++) { p += Bp(i,c)*V.row(F(FIp(i),c)); }
+    REQUIRE((p-Pp.row(i)).norm() < 1e-12);
+  }
+}
+
+TEST_CASE("blue_noise: parallel_reproduce", "[igl]")
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  blue_noise::sphere(V,F);
+  // Small enough that each phase group has more cells than the threshold
+  // for running its loop in parallel
+  const double r = 0.02;
+  Eigen::MatrixXd B1,P1,B2,P2;
+  Eigen::VectorXi FI1,FI2;
+  // Single threaded: loops issued from inside a parallel loop run serially
+  igl::ThreadPool pool(2);
+  pool.parallel_for(2,[&](const int i)
+  {
+    REQUIRE(igl::ThreadPool::in_parallel_region());
+    if(i == 0) { igl::blue_noise_parallel(V,F,r,B1,FI1,P1,std::mt19937(7)); }
+  });
+  // On the global pool (igl::default_num_threads() threads)
+  igl::blue_noise_parallel(V,F,r,B2,FI2,P2,std::mt19937(7));
+  test_common::assert_eq(P1,P2);
+  test_common::assert_eq(FI1,FI2);
+  igl::blue_noise_parallel(V,F,r,B2,FI2,P2,std::mt19937(7));
+  test_common::assert_eq(P1,P2);
+  test_common::assert_eq(FI1,FI2);
+  igl::blue_noise_parallel(V,F,r,B2,FI2,P2,std::mt19937(8));
+  REQUIRE((P1.rows() != P2.rows() || P1 != P2));
+}
 
 //TEST_CASE("blue_noise: decimated-knight", "[igl]")
 //{
@@ -1,5 +1,11 @@
 #include <test_common.h>
 #include <igl/decimate.h>
+#include <igl/decimate_trivial_callbacks.h>
+#include <igl/icosahedron.h>
+#include <igl/is_edge_manifold.h>
+#include <igl/shortest_edge_and_midpoint.h>
+#include <igl/upsample.h>
+#include <igl/vertex_components.h>
 #include <igl/sort.h>
 #include <igl/sortrows.h>
 #include <igl/matlab_format.h>
@@ -70,3 +76,91 @@ TEST_CASE("decimate: closed", "[igl]")
 
   test_common::run_test_cases(test_common::closed_genus_0_meshes(), test_case);
 }
+
+TEST_CASE("decimate: queue stays bounded by live edges", "[igl]")
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  igl::icosahedron(V,F);
+  for(int l = 0;l<3;l++)
+  {
+    Eigen::MatrixXd U;
+    Eigen::MatrixXi G;
+    igl::upsample(V,F,U,G);
+    V = U.rowwise().normalized();
+    F = G;
+  }
+  igl::decimate_cost_and_placement_callback cost_and_placement =
+    igl::shortest_edge_and_midpoint;
+  igl::decimate_pre_collapse_callback pre_collapse;
+  igl::decimate_post_collapse_callback post_collapse;
+  igl::decimate_trivial_callbacks(pre_collapse,post_collapse);
+  int num_collapsed = 0;
+  const int max_collapsed = F.rows()/4;
+  bool bounded = true;
+  const igl::decimate_stopping_condition_callback stopping_condition =
+    [&](
+      const Eigen::MatrixXd &,
+      const Eigen::MatrixXi &,
+      const Eigen::MatrixXi &,
+      const Eigen::VectorXi &,
+      const Eigen::MatrixXi &,
+      const Eigen::MatrixXi &,
+      const igl::IndexedHeap<double> & Q,
+      const Eigen::VectorXi & EQ,
+      const Eigen::MatrixXd &,
+      const int e,
+      const int e1,
+      const int e2,
+      const int,
+      const int)->bool
+    {
+      // Collapsed edges are out of the queue; every live edge is in it
+      bounded = bounded &&
+        !Q.contains(e) && !Q.contains(e1) && !Q.contains(e2) &&
+        Q.size() == (EQ.array() != -1).count();
+      return ++num_collapsed >= max_collapsed;
+    };
+  Eigen::MatrixXd U;
+  Eigen::MatrixXi G;
+  Eigen::VectorXi J,I;
+  REQUIRE(igl::decimate(
+    V,F,cost_and_placement,stopping_condition,pre_collapse,post_collapse,
+    U,G,J,I));
+  REQUIRE(bounded);
+  REQUIRE(G.rows() == F.rows()-2*max_collapsed);
+}
+
+TEST_CASE("decimate: parallel", "[igl]")
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  igl::icosahedron(V,F);
+  for(int l = 0;l<4;l++)
+  {
+    Eigen::MatrixXd U;
+    Eigen::MatrixXi G;
+    igl::upsample(V,F,U,G);
+    V = U.rowwise().normalized();
+    F = G;
+  }
+  const int max_m = F.rows()/10;
+  Eigen::MatrixXd U;
+  Eigen::MatrixXi G;
+  Eigen::VectorXi J,I;
+  REQUIRE(igl::decimate(V,F,max_m,false,true,U,G,J,I));
+  REQUIRE(G.rows() <= max_m);
+  // Stops as soon as the stopping condition is met
+  REQUIRE(G.rows() >= max_m-2);
+  REQUIRE(igl::is_edge_manifold(G));
+  Eigen::VectorXi C;
+  igl::vertex_components(G,C);
+  REQUIRE(C.maxCoeff() == 0);
+  // Birth indices are sane
+  for(int i = 0;i<U.rows();i++)
+  {
+    REQUIRE(U.row(i).norm() == Approx(1.0).margin(1e-1));
+  }
+  REQUIRE(J.maxCoeff() < F.rows());
+  REQUIRE(I.maxCoeff() < V.rows());
+}
@@ -1,6 +1,8 @@
 #include <test_common.h>
 #include <igl/dijkstra.h>
 #include <igl/adjacency_list.h>
+#include <igl/icosahedron.h>
+#include <igl/upsample.h>
 #include <iostream>
 
 TEST_CASE("dijkstra: cube", "[igl]")
@@ -38,3 +40,111 @@ TEST_CASE("dijkstra: discrete distances", "[igl]")
   REQUIRE(min_distance[0] == 0);
 }
 
+
+namespace
+{
+  // Unit sphere mesh, its vertex adjacency lists and matrix of edge lengths
+  void sphere_graph(
+    Eigen::MatrixXd & V,
+    std::vector<std::vector<int> > & VV,
+    Eigen::SparseMatrix<double> & A)
+  {
+    Eigen::MatrixXi F;
+    igl::icosahedron(V,F);
+    for(int l = 0;l<3;l++)
+    {
+      Eigen::MatrixXd U;
+      Eigen::MatrixXi G;
+      igl::upsample(V,F,U,G);
+      V = U.rowwise().normalized();
+      F = G;
+    }
+    igl::adjacency_list(F,VV);
+    std::vector<Eigen::Triplet<double> > IJV;
+    for(int u = 0;u<int(VV.size());u++)
+    {
+      for(const int v : VV[u])
+      {
+        IJV.emplace_back(v,u,(V.row(u)-V.row(v)).norm());
+      }
+    }
+    A.resize(V.rows(),V.rows());
+    A.setFromTriplets(IJV.begin(),IJV.end());
+  }
+}
+
+TEST_CASE("dijkstra: sparse matches adjacency list", "[igl]")
+{
+  Eigen::MatrixXd V;
+  std::vector<std::vector<int> > VV;
+  Eigen::SparseMatrix<double> A;
+  sphere_graph(V,VV,A);
+  Eigen::VectorXd min_distance;
+  Eigen::VectorXi previous;
+  igl::dijkstra(V,VV,7,{},min_distance,previous);
+  igl::DijkstraWorkspace<double> ws;
+  igl::dijkstra(A,Eigen::VectorXi::Constant(1,7),
+    std::numeric_limits<double>::infinity(),ws);
+  test_common::assert_eq(ws.distance,min_distance);
+  REQUIRE(int(ws.reached.size()) == V.rows());
+  // Every shortest path leads back to the source
+  std::vector<int> path;
+  igl::dijkstra(100,ws.previous,path);
+  REQUIRE(path.back() == 7);
+  REQUIRE(path.front() == 100);
+}
+
+TEST_CASE("dijkstra: multi-source, bound, targets and reuse", "[igl]")
+{
+  Eigen::MatrixXd V;
+  std::vector<std::vector<int> > VV;
+  Eigen::SparseMatrix<double> A;
+  sphere_graph(V,VV,A);
+  const double inf = std::numeric_limits<double>::infinity();
+  Eigen::VectorXi S(3);
+  S<<0,50,300;
+  // Single-source distances in parallel
+  Eigen::MatrixXd D;
+  igl::dijkstra(A,S,inf,D);
+  REQUIRE(D.rows() == V.rows());
+  REQUIRE(D.cols() == S.size());
+  igl::DijkstraWorkspace<double> ws;
+  for(int s = 0;s<S.size();s++)
+  {
+    igl::dijkstra(A,S.segment(s,1),inf,ws);
+    test_common::assert_eq(Eigen::VectorXd(D.col(s)),ws.distance);
+  }
+  // Multi-source distance is the minimum over sources, computed with a
+  // reused workspace
+  igl::dijkstra(A,S,inf,ws);
+  const Eigen::VectorXd nearest = D.rowwise().minCoeff();
+  test_common::assert_eq(ws.distance,nearest);
+  // Bounded search reaches exactly the vertices within the bound
+  const double radius = 0.5;
+  igl::dijkstra(A,S,radius,ws);
+  int within = 0;
+  for(int v = 0;v<V.rows();v++)
+  {
+    if(nearest(v) <= radius)
+    {
+      within++;
+      REQUIRE(ws.distance(v) == nearest(v));
+    }else
+    {
+      REQUIRE(ws.distance(v) == inf);
+      REQUIRE(ws.previous(v) == -1);
+    }
+  }
+  REQUIRE(int(ws.reached.size()) == within);
+  // Search stops at the closest target
+  Eigen::VectorXi T(3);
+  T<<10,200,400;
+  int closest = T(0);
+  for(int t = 1;t<T.size();t++)
+  {
+    if(nearest(T(t)) < nearest(closest)) { closest = T(t); }
+  }
+  REQUIRE(igl::dijkstra(A,S,T,inf,ws) == closest);
+  REQUIRE(ws.distance(closest) == nearest(closest));
+  REQUIRE(igl::dijkstra(A,S,T,1e-3,ws) == -1);
+}
@@ -1,5 +1,6 @@
 #include <test_common.h>
 #include <igl/exact_geodesic.h>
+#include <igl/triangulated_grid.h>
 
 TEST_CASE("exact_geodesic: square", "[igl]")
 {
@@ -23,3 +24,76 @@ TEST_CASE("exact_geodesic: square", "[igl]")
   Dgt<<0,1,1.4142135624,1;
   test_common::assert_near(D,Dgt,1e-10);
 }
+
+TEST_CASE("exact_geodesic: solver", "[igl]")
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  igl::triangulated_grid(12,9,V,F);
+  // Bump it so that geodesics are not straight lines
+  V.conservativeResize(V.rows(),3);
+  V.col(2) = 0.3*(3.0*V.col(0)).array().sin()*(2.0*V.col(1)).array().cos();
+  Eigen::VectorXi VT = Eigen::VectorXi::LinSpaced(V.rows(),0,V.rows()-1);
+  Eigen::VectorXi FT = Eigen::VectorXi::LinSpaced(F.rows(),0,F.rows()-1);
+  Eigen::VectorXi FS,none;
+  igl::ExactGeodesicSolver solver(V,F);
+  std::vector<std::vector<int> > VS_list;
+  for(const int s : {0,17,53,int(V.rows())-1})
+  {
+    VS_list.push_back({s});
+  }
+  // Second set has two sources
+  VS_list[1].push_back(40);
+  Eigen::MatrixXd Dall;
+  solver.solve(VS_list,{},VT,FT,Dall);
+  REQUIRE(Dall.rows() == VT.size()+FT.size());
+  REQUIRE(Dall.cols() == int(VS_list.size()));
+  for(int j = 0;j<int(VS_list.size());j++)
+  {
+    Eigen::VectorXi VS = Eigen::Map<const Eigen::VectorXi>(
+      VS_list[j].data(),VS_list[j].size());
+    Eigen::VectorXd Dgt;
+    igl::exact_geodesic(V,F,VS,FS,VT,FT,Dgt);
+    Eigen::VectorXd D;
+    solver.solve(VS,FS,VT,FT,D);
+    test_common::assert_near(D,Dgt,1e-8);
+    test_common::assert_near(Eigen::VectorXd(Dall.col(j)),Dgt,1e-8);
+    // Reusing the solver gives the same result
+    Eigen::VectorXd D2;
+    solver.solve(VS,FS,VT,FT,D2);
+    test_common::assert_eq(D,D2);
+    // Stop distance: near targets unchanged, far ones infinite
+    const double stop = 0.5*Dgt.maxCoeff();
+    solver.solve(VS,FS,VT,none,D,stop);
+    for(int i = 0;i<VT.size();i++)
+    {
+      if(Dgt(i) < 0.9*stop)
+      {
+        REQUIRE(D(i) == Approx(Dgt(i)).margin(1e-8));
+      }else if(Dgt(i) > 1.1*stop)
+      {
+        REQUIRE(std::isinf(D(i)));
+      }
+    }
+  }
+
+  // Propagation stops early for a nearby target or a small stop distance
+  Eigen::VectorXi VS(1);
+  VS << 0;
+  Eigen::VectorXd Dgt,D;
+  solver.solve(VS,FS,VT,none,Dgt);
+  const std::size_t all_iterations = solver.num_iterations();
+  Eigen::VectorXi near(1);
+  near << 1;
+  solver.solve(VS,FS,near,none,D);
+  REQUIRE(D(0) == Approx(Dgt(1)).margin(1e-8));
+  REQUIRE(solver.num_iterations() < all_iterations/4);
+  solver.solve(VS,FS,VT,none,D,0.1*Dgt.maxCoeff());
+  REQUIRE(solver.num_iterations() < all_iterations/4);
+  // A far target needs everything closer (but still gets the same distance)
+  Eigen::VectorXi far(1);
+  far << V.rows()-1;
+  solver.solve(VS,FS,far,none,D);
+  REQUIRE(D(0) == Approx(Dgt(V.rows()-1)).margin(1e-8));
+  REQUIRE(solver.num_iterations() <= all_iterations);
+}
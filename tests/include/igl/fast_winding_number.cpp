@@ -13,6 +13,8 @@
 #include <igl/barycenter.h>
 #include <igl/per_face_normals.h>
 #include <igl/doublearea.h>
+#include <igl/icosahedron.h>
+#include <igl/upsample.h>
 
 TEST_CASE("fast_winding_number: one_point_cloud", "[igl]")
 {
@@ -105,3 +107,66 @@ TEST_CASE("fast_winding_number: meshes", "[igl]" "[slow]")
     {"bunny.off", "elephant.off", "hemisphere.obj"},
     test_case);
 }
+
+TEST_CASE("fast_winding_number: refit", "[igl]")
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  igl::icosahedron(V,F);
+  igl::upsample(Eigen::MatrixXd(V),Eigen::MatrixXi(F),V,F,2);
+  V.rowwise().normalize();
+  Eigen::MatrixXd Q = 1.5*Eigen::MatrixXd::Random(200,3);
+  igl::FastWindingNumberBVH fwn_bvh;
+  igl::fast_winding_number(V,F,2,fwn_bvh);
+  // Stretch, rotate and translate the sphere
+  Eigen::Matrix3d A;
+  A<<
+    1.5, 0.2, 0.0,
+   -0.2, 0.8, 0.1,
+    0.0, 0.3, 1.1;
+  const Eigen::MatrixXd U =
+    (V*A.transpose()).rowwise() + Eigen::RowVector3d(0.3,-0.2,0.1);
+  igl::fast_winding_number_refit(U,fwn_bvh);
+  Eigen::VectorXd W_exact;
+  igl::winding_number(U,F,Q,W_exact);
+  Eigen::VectorXd W_refit;
+  igl::fast_winding_number(fwn_bvh,2,Q,W_refit);
+  test_common::assert_near(W_refit,W_exact,1e-2);
+  // With a huge accuracy scale nearly every triangle is evaluated directly,
+  // so stale boxes or expansions would show up as large errors
+  igl::fast_winding_number(fwn_bvh,1000,Q,W_refit);
+  test_common::assert_near(W_refit,W_exact,1e-5);
+}
+
+TEST_CASE("fast_winding_number: double", "[igl]")
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  igl::icosahedron(V,F);
+  igl::upsample(Eigen::MatrixXd(V),Eigen::MatrixXi(F),V,F,2);
+  V.rowwise().normalize();
+  Eigen::MatrixXd Q = 1.5*Eigen::MatrixXd::Random(200,3);
+  // Far from the origin single precision can no longer resolve the mesh
+  const Eigen::RowVector3d offset(1e6,-2e6,3e6);
+  V.rowwise() += offset;
+  Q.rowwise() += offset;
+  igl::FastWindingNumberBVHT<double> fwn_bvh;
+  igl::fast_winding_number(V,F,2,fwn_bvh);
+  Eigen::VectorXd W;
+  igl::fast_winding_number(fwn_bvh,2,Q,W);
+  Eigen::VectorXd W_exact;
+  igl::winding_number(V,F,Q,W_exact);
+  test_common::assert_near(W,W_exact,1e-2);
+  // refit back to the origin
+  V.rowwise() -= offset;
+  Q.rowwise() -= offset;
+  igl::fast_winding_number_refit(V,fwn_bvh);
+  igl::fast_winding_number(fwn_bvh,2,Q,W);
+  igl::winding_number(V,F,Q,W_exact);
+  test_common::assert_near(W,W_exact,1e-2);
+  for(int q = 0;q<Q.rows();q++)
+  {
+    REQUIRE(igl::fast_winding_number(fwn_bvh,2,Eigen::RowVector3d(Q.row(q))) ==
+      Approx(W(q)).margin(1e-12));
+  }
+}
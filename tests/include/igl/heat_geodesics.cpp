@@ -2,6 +2,8 @@
 #include <igl/heat_geodesics.h>
 #include <igl/upsample.h>
 #include <igl/avg_edge_length.h>
+#include <igl/icosahedron.h>
+#include <igl/triangulated_grid.h>
 
 TEST_CASE("heat_geodesic: upsampled cube", "[igl]")
 {
@@ -24,4 +26,46 @@ TEST_CASE("heat_geodesic: upsampled cube", "[igl]")
   REQUIRE((V.row(i)-V.row(0)).norm() == Approx(dist(i)).margin(avg_edge));
   }
 
-}
\ No newline at end of file
+}
+TEST_CASE("heat_geodesic: batched", "[igl]")
+{
+  const auto check = [](const Eigen::MatrixXd & V, const Eigen::MatrixXi & F)
+  {
+    igl::HeatGeodesicsData<double> data;
+    igl::heat_geodesics_precompute(V,F,data);
+    std::vector<std::vector<int> > gammas;
+    for(int j = 0;j<7;j++)
+    {
+      gammas.push_back({(j*97)%int(V.rows())});
+    }
+    // multiple sources in one set
+    gammas.push_back({0,int(V.rows())/2,int(V.rows())-1});
+    Eigen::MatrixXd D;
+    igl::heat_geodesics_solve(data,gammas,D);
+    REQUIRE(D.rows() == V.rows());
+    REQUIRE(D.cols() == int(gammas.size()));
+    for(int j = 0;j<int(gammas.size());j++)
+    {
+      Eigen::VectorXi gamma = 
+        Eigen::Map<const Eigen::VectorXi>(gammas[j].data(),gammas[j].size());
+      Eigen::VectorXd Dj;
+      igl::heat_geodesics_solve(data,gamma,Dj);
+      test_common::assert_near(D.col(j),Dj,1e-10);
+    }
+  };
+  {
+    INFO("closed");
+    Eigen::MatrixXd V;
+    Eigen::MatrixXi F;
+    igl::icosahedron(V,F);
+    igl::upsample(Eigen::MatrixXd(V),Eigen::MatrixXi(F),V,F,2);
+    check(V,F);
+  }
+  {
+    INFO("boundary");
+    Eigen::MatrixXd V;
+    Eigen::MatrixXi F;
+    igl::triangulated_grid(20,20,V,F);
+    check(V,F);
+  }
+}
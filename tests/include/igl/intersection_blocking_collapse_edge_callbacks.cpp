@@ -4,7 +4,7 @@
 #include <igl/decimate_callback_types.h>
 #include <igl/AABB.h>
 #include <igl/collapse_edge.h>
-#include <igl/min_heap.h>
+#include <igl/IndexedHeap.h>
 #include <tuple>
 
 TEST_CASE("intersection_blocking_collapse_edge_callbacks: simple", "[igl]")
@@ -72,7 +72,7 @@ TEST_CASE("intersection_blocking_collapse_edge_callbacks: simple", "[igl]")
   Eigen::VectorXi EMAP;
   Eigen::MatrixXi E,EF,EI;
   igl::edge_flaps(F,E,EMAP,EF,EI);
-  igl::min_heap< std::tuple<double,int,int> > Q;
+  igl::IndexedHeap<double> Q;
   Eigen::VectorXi EQ;
   Eigen::MatrixXd C = Eigen::MatrixXd::Zero(E.rows(),3);
   // Try to do the collapses.
@@ -0,0 +1,142 @@
+#include <test_common.h>
+#include <igl/marching_cubes.h>
+#include <igl/march_cube.h>
+#include <cstdint>
+#include <unordered_map>
+
+namespace
+{
+  // Sphere-ish field with ripples on a (nx,ny,nz) grid; S contains exact
+  // isovalue hits to exercise the "inside" tie rule
+  void field(
+    const int nx,
+    const int ny,
+    const int nz,
+    Eigen::VectorXd & S,
+    Eigen::MatrixXd & GV)
+  {
+    S.resize(nx*ny*nz);
+    GV.resize(nx*ny*nz,3);
+    for(int z = 0;z<nz;z++)
+    {
+      for(int y = 0;y<ny;y++)
+      {
+        for(int x = 0;x<nx;x++)
+        {
+          const int i = x+nx*(y+ny*z);
+          GV.row(i) << 
+            double(x)/(nx-1)-0.5, double(y)/(ny-1)-0.5, double(z)/(nz-1)-0.5;
+          S(i) = GV.row(i).norm() - 0.3 + 0.05*std::sin(17.0*GV(i,0)*GV(i,1));
+          if((x+y+z)%7 == 0 && std::abs(S(i))<0.05) { S(i) = 0; }
+        }
+      }
+    }
+  }
+}
+
+TEST_CASE("marching_cubes: dense matches serial march", "[igl]")
+{
+  const int nx = 23, ny = 19, nz = 17;
+  Eigen::VectorXd S;
+  Eigen::MatrixXd GV;
+  field(nx,ny,nz,S,GV);
+  const Eigen::MatrixBase<Eigen::MatrixXd> & GVb = GV;
+
+  // Serial reference
+  const unsigned ioffset[8] = 
+    {0,1,1+nx,nx,nx*ny,1+nx*ny,1+nx+nx*ny,nx+nx*ny};
+  Eigen::MatrixXd eV(0,3);
+  Eigen::MatrixXi eF(0,3);
+  unsigned n = 0, m = 0;
+  std::unordered_map<std::int64_t,int> eE2V;
+  for(int z = 0;z<nz-1;z++)
+  {
+    for(int y = 0;y<ny-1;y++)
+    {
+      for(int x = 0;x<nx-1;x++)
+      {
+        Eigen::Matrix<double,8,1> cS;
+        Eigen::Matrix<unsigned,8,1> cI;
+        for(int c = 0;c<8;c++)
+        {
+          cI(c) = x+nx*(y+ny*z) + ioffset[c];
+          cS(c) = S(cI(c));
+        }
+        igl::march_cube(GVb,cS,cI,0.0,eV,n,eF,m,eE2V);
+      }
+    }
+  }
+  eV.conservativeResize(n,3);
+  eF.conservativeResize(m,3);
+  REQUIRE(eF.rows() > 100);
+
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  igl::marching_cubes(S,GV,nx,ny,nz,0,V,F);
+  test_common::assert_eq(V,eV);
+  test_common::assert_eq(F,eF);
+
+  std::unordered_map<std::int64_t,int> E2V;
+  E2V[-1] = 7;
+  igl::marching_cubes(S,GV,nx,ny,nz,0,V,F,E2V);
+  test_common::assert_eq(V,eV);
+  test_common::assert_eq(F,eF);
+  REQUIRE(E2V == eE2V);
+
+  // Degenerate grids
+  igl::marching_cubes(S,GV,nx*ny*nz,1,1,0,V,F);
+  REQUIRE(V.rows() == 0);
+  REQUIRE(F.rows() == 0);
+}
+
+TEST_CASE("marching_cubes: sparse matches serial march", "[igl]")
+{
+  const int nx = 15, ny = 16, nz = 14;
+  Eigen::VectorXd S;
+  Eigen::MatrixXd GV;
+  field(nx,ny,nz,S,GV);
+  const Eigen::MatrixBase<Eigen::MatrixXd> & GVb = GV;
+  // Every other cube in scrambled order
+  const unsigned ioffset[8] = 
+    {0,1,1+nx,nx,nx*ny,1+nx*ny,1+nx+nx*ny,nx+nx*ny};
+  const int num_cubes = (nx-1)*(ny-1)*(nz-1);
+  Eigen::MatrixXi GI(0,8);
+  for(int k = 0;k<num_cubes;k++)
+  {
+    const int c = (k*7919) % num_cubes;
+    if(c % 2) { continue; }
+    const int x = c % (nx-1);
+    const int y = (c / (nx-1)) % (ny-1);
+    const int z = c / ((nx-1)*(ny-1));
+    GI.conservativeResize(GI.rows()+1,8);
+    for(int v = 0;v<8;v++)
+    {
+      GI(GI.rows()-1,v) = x+nx*(y+ny*z) + ioffset[v];
+    }
+  }
+
+  Eigen::MatrixXd eV(0,3);
+  Eigen::MatrixXi eF(0,3);
+  Eigen::Index n = 0, m = 0;
+  std::unordered_map<std::int64_t,int> E2V;
+  for(Eigen::Index c = 0;c<GI.rows();c++)
+  {
+    Eigen::Matrix<double,8,1> cS;
+    Eigen::Matrix<Eigen::Index,8,1> cI;
+    for(int v = 0;v<8;v++)
+    {
+      cI(v) = GI(c,v);
+      cS(v) = S(GI(c,v));
+    }
+    igl::march_cube(GVb,cS,cI,0.0,eV,n,eF,m,E2V);
+  }
+  eV.conservativeResize(n,3);
+  eF.conservativeResize(m,3);
+  REQUIRE(eF.rows() > 100);
+
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  igl::marching_cubes(S,GV,GI,0,V,F);
+  test_common::assert_eq(V,eV);
+  test_common::assert_eq(F,eF);
+}
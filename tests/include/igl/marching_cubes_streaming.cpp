@@ -0,0 +1,101 @@
+#include <test_common.h>
+#include <igl/marching_cubes_streaming.h>
+#include <igl/marching_cubes.h>
+#include <igl/StreamingPLYWriter.h>
+#include <igl/readPLY.h>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+
+TEST_CASE("marching_cubes_streaming: matches marching_cubes", "[igl]")
+{
+  const int nx = 21, ny = 18, nz = 25;
+  const auto position = [&](const int x, const int y, const int z)
+  {
+    return Eigen::RowVector3d(
+      double(x)/(nx-1)-0.5, double(y)/(ny-1)-0.5, double(z)/(nz-1)-0.5);
+  };
+  const auto value = [](const Eigen::RowVector3d & p)
+  {
+    // Two blobs so some slabs are empty
+    return std::min(
+      (p-Eigen::RowVector3d(0.1,0,-0.25)).norm()-0.2,
+      (p-Eigen::RowVector3d(-0.1,0.05,0.2)).norm()-0.15);
+  };
+  Eigen::VectorXd S(nx*ny*nz);
+  Eigen::MatrixXd GV(nx*ny*nz,3);
+  for(int z = 0;z<nz;z++)
+  {
+    for(int y = 0;y<ny;y++)
+    {
+      for(int x = 0;x<nx;x++)
+      {
+        const int i = x+nx*(y+ny*z);
+        GV.row(i) = position(x,y,z);
+        S(i) = value(GV.row(i));
+      }
+    }
+  }
+  Eigen::MatrixXd eV;
+  Eigen::MatrixXi eF;
+  igl::marching_cubes(S,GV,nx,ny,nz,0,eV,eF);
+  REQUIRE(eF.rows() > 100);
+
+  const std::string path = (std::filesystem::temp_directory_path() /
+    "igl_test_marching_cubes_streaming.ply").string();
+  // Remove the file however the test exits
+  const struct Remove
+  {
+    const std::string & path;
+    ~Remove(){ std::remove(path.c_str()); }
+  } remove_path{path};
+  igl::StreamingPLYWriter writer;
+  REQUIRE(writer.open(path));
+  Eigen::MatrixXd V(0,3);
+  Eigen::MatrixXi F(0,3);
+  unsigned next_z = 0;
+  int num_chunks = 0;
+  igl::marching_cubes_streaming(nx,ny,nz,
+    [&](const unsigned z,
+      Eigen::VectorXd & Sz,
+      Eigen::Matrix<double,Eigen::Dynamic,3> & GVz)
+    {
+      // Slices are requested once each, in order
+      REQUIRE(z == next_z++);
+      Sz.resize(nx*ny);
+      GVz.resize(nx*ny,3);
+      for(int y = 0;y<ny;y++)
+      {
+        for(int x = 0;x<nx;x++)
+        {
+          GVz.row(x+nx*y) = position(x,y,z);
+          Sz(x+nx*y) = value(GVz.row(x+nx*y));
+        }
+      }
+    },
+    0.0,
+    [&](
+      const Eigen::Matrix<double,Eigen::Dynamic,3> & Vz,
+      const Eigen::Matrix<int,Eigen::Dynamic,3> & Fz)
+    {
+      num_chunks++;
+      REQUIRE(writer.append(Vz,Fz));
+      V.conservativeResize(V.rows()+Vz.rows(),3);
+      V.bottomRows(Vz.rows()) = Vz;
+      F.conservativeResize(F.rows()+Fz.rows(),3);
+      F.bottomRows(Fz.rows()) = Fz;
+    });
+  REQUIRE(next_z == unsigned(nz));
+  REQUIRE(num_chunks == nz-1);
+  test_common::assert_eq(V,eV);
+  test_common::assert_eq(F,eF);
+
+  REQUIRE(writer.num_vertices() == eV.rows());
+  REQUIRE(writer.num_faces() == eF.rows());
+  REQUIRE(writer.close());
+  Eigen::MatrixXd pV;
+  Eigen::MatrixXi pF;
+  REQUIRE(igl::readPLY(path,pV,pF));
+  test_common::assert_eq(pV,eV);
+  test_common::assert_eq(pF,eF);
+}
@@ -1,6 +1,9 @@
 #include <test_common.h>
 #include <igl/min_quad_with_fixed.h>
 #include <igl/EPS.h>
+#include <igl/cotmatrix.h>
+#include <igl/icosahedron.h>
+#include <igl/upsample.h>
 
 TEST_CASE("min_quad_with_fixed: dense", "[igl]" )
 {
@@ -46,3 +49,98 @@ TEST_CASE("min_quad_with_fixed: Aeq", "[igl]" )
   test_common::assert_near(Z,Zgt,epsilon);
 
 }
+
+TEST_CASE("min_quad_with_fixed: update known set", "[igl]" )
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  igl::icosahedron(V,F);
+  for(int l = 0;l<3;l++)
+  {
+    Eigen::MatrixXd U;
+    Eigen::MatrixXi G;
+    igl::upsample(V,F,U,G);
+    V = U.rowwise().normalized();
+    F = G;
+  }
+  Eigen::SparseMatrix<double> L;
+  igl::cotmatrix(V,F,L);
+  const Eigen::SparseMatrix<double> A = -L;
+  const Eigen::SparseMatrix<double> Aeq;
+  const Eigen::MatrixXd B = 0.1*V;
+  const Eigen::VectorXd Beq;
+  // Solve from scratch for comparison
+  const auto expected = [&](const Eigen::VectorXi & b)
+  {
+    igl::min_quad_with_fixed_data<double> data;
+    REQUIRE(igl::min_quad_with_fixed_precompute(A,b,Aeq,true,data));
+    Eigen::MatrixXd Z;
+    REQUIRE(igl::min_quad_with_fixed_solve(
+      data,B,(V(b,Eigen::all)*2.0).eval(),Beq,Z));
+    return Z;
+  };
+  igl::min_quad_with_fixed_data<double> data;
+  Eigen::VectorXi b(4);
+  b<<0,7,100,300;
+  REQUIRE(igl::min_quad_with_fixed_precompute(A,b,Aeq,true,data));
+  const std::vector<Eigen::VectorXi> edits = {
+    // add handles (in any order)
+    (Eigen::VectorXi(6)<<0,7,100,300,5,200).finished(),
+    (Eigen::VectorXi(7)<<200,0,7,100,300,5,42).finished(),
+    // remove original handles
+    (Eigen::VectorXi(5)<<200,7,300,5,42).finished(),
+    // add and remove
+    (Eigen::VectorXi(4)<<0,100,5,500).finished(),
+    // back to the original set
+    b};
+  for(const auto & bi : edits)
+  {
+    REQUIRE(igl::min_quad_with_fixed_update(A,bi,Aeq,data));
+    REQUIRE(data.known == bi);
+    Eigen::MatrixXd Z;
+    REQUIRE(igl::min_quad_with_fixed_solve(
+      data,B,(V(bi,Eigen::all)*2.0).eval(),Beq,Z));
+    test_common::assert_near(Z,expected(bi),1e-10);
+  }
+  // Too many changes refactors
+  Eigen::VectorXi many = Eigen::VectorXi::LinSpaced(50,0,49*10);
+  REQUIRE(igl::min_quad_with_fixed_update(A,many,Aeq,data,10));
+  REQUIRE(!data.updated);
+  Eigen::MatrixXd Z;
+  REQUIRE(igl::min_quad_with_fixed_solve(
+    data,B,(V(many,Eigen::all)*2.0).eval(),Beq,Z));
+  test_common::assert_near(Z,expected(many),1e-10);
+}
+
+TEST_CASE("min_quad_with_fixed: reuse symbolic factorization", "[igl]" )
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  igl::icosahedron(V,F);
+  Eigen::MatrixXd U;
+  Eigen::MatrixXi G;
+  igl::upsample(V,F,U,G);
+  V = U.rowwise().normalized();
+  F = G;
+  Eigen::SparseMatrix<double> L;
+  igl::cotmatrix(V,F,L);
+  const Eigen::SparseMatrix<double> Aeq;
+  Eigen::VectorXi b(2);
+  b<<0,10;
+  const Eigen::MatrixXd Y = V(b,Eigen::all);
+  const Eigen::MatrixXd B = Eigen::MatrixXd::Zero(V.rows(),3);
+  igl::min_quad_with_fixed_data<double> data;
+  for(const double scale : {1.0,2.0,0.5})
+  {
+    // Same pattern, different values
+    Eigen::SparseMatrix<double> A = -L;
+    A.diagonal().array() += scale;
+    igl::min_quad_with_fixed_data<double> fresh;
+    REQUIRE(igl::min_quad_with_fixed_precompute(A,b,Aeq,true,data));
+    REQUIRE(igl::min_quad_with_fixed_precompute(A,b,Aeq,true,fresh));
+    Eigen::MatrixXd Z,Zfresh;
+    REQUIRE(igl::min_quad_with_fixed_solve(data,B,Y,Eigen::VectorXd(),Z));
+    REQUIRE(igl::min_quad_with_fixed_solve(fresh,B,Y,Eigen::VectorXd(),Zfresh));
+    test_common::assert_eq(Z,Zfresh);
+  }
+}
@@ -0,0 +1,87 @@
+#include <test_common.h>
+#include <igl/point_triangle_cluster_squared_distance.h>
+#include <igl/point_simplex_squared_distance.h>
+
+namespace
+{
+  template <typename Scalar>
+  void check_against_point_simplex_squared_distance(const Scalar tol)
+  {
+    typedef Eigen::Matrix<Scalar,Eigen::Dynamic,3> MatrixX3S;
+    typedef Eigen::Matrix<Scalar,1,3> RowVector3S;
+    // Random triangles plus degenerate ones (repeated corners, collinear
+    // corners) and triangles sharing vertices so that some closest points
+    // land exactly on vertices and edges
+    const int n = 64;
+    MatrixX3S V = MatrixX3S::Random(3*n,3);
+    Eigen::Matrix<int,Eigen::Dynamic,3> F(n,3);
+    for(int f = 0;f<n;f++)
+    {
+      F.row(f) << 3*f,3*f+1,3*f+2;
+    }
+    // segment, point, collinear and shared corners
+    F(1,2) = F(1,1);
+    F(2,1) = F(2,2) = F(2,0);
+    V.row(F(3,2)) = Scalar(0.5)*(V.row(F(3,0))+V.row(F(3,1)));
+    F(4,0) = F(5,0);
+    F(6,1) = F(5,2);
+    const MatrixX3S P = Scalar(2)*MatrixX3S::Random(200,3);
+    // Each cluster size from 1 to capacity
+    constexpr int capacity = igl::TriangleCluster<Scalar>::capacity;
+    for(int size = 1;size<=capacity;size++)
+    {
+      for(int first = 0;first+size<=n;first += size)
+      {
+        igl::TriangleCluster<Scalar> cluster;
+        for(int f = first;f<first+size;f++)
+        {
+          cluster.push_back(V.row(F(f,0)),V.row(F(f,1)),V.row(F(f,2)),f);
+        }
+        REQUIRE(cluster.size == size);
+        for(int p = 0;p<P.rows()+3;p++)
+        {
+          // Also query exactly at a corner
+          const RowVector3S q = p < P.rows() ?
+            RowVector3S(P.row(p)) : RowVector3S(V.row(F(first,p-P.rows())));
+          Scalar expected_sqr_d = std::numeric_limits<Scalar>::infinity();
+          RowVector3S expected_c;
+          for(int f = first;f<first+size;f++)
+          {
+            Scalar sqr_d;
+            RowVector3S c;
+            igl::point_simplex_squared_distance<3>(q,V,F,f,sqr_d,c);
+            if(sqr_d < expected_sqr_d)
+            {
+              expected_sqr_d = sqr_d;
+              expected_c = c;
+            }
+          }
+          Scalar sqr_d;
+          int i;
+          RowVector3S c;
+          igl::point_triangle_cluster_squared_distance(
+            q.data(),cluster,sqr_d,i,c.data());
+          REQUIRE(i >= first);
+          REQUIRE(i < first+size);
+          REQUIRE(sqr_d == Approx(expected_sqr_d).margin(tol));
+          REQUIRE((c-expected_c).norm() <= std::sqrt(tol));
+          // Reported primitive is consistent with the distance
+          Scalar sqr_d_i;
+          RowVector3S c_i;
+          igl::point_simplex_squared_distance<3>(q,V,F,i,sqr_d_i,c_i);
+          REQUIRE(sqr_d_i == Approx(sqr_d).margin(tol));
+        }
+      }
+    }
+  }
+}
+
+TEST_CASE("point_triangle_cluster_squared_distance: double", "[igl]")
+{
+  check_against_point_simplex_squared_distance<double>(1e-14);
+}
+
+TEST_CASE("point_triangle_cluster_squared_distance: float", "[igl]")
+{
+  check_against_point_simplex_squared_distance<float>(1e-5f);
+}
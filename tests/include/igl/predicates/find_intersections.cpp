@@ -1,5 +1,7 @@
 #include "test_common.h"
 #include <igl/predicates/find_intersections.h>
+#include <igl/AABB.h>
+#include <igl/predicates/triangle_triangle_intersect.h>
 #include <igl/combine.h>
 #include <igl/triangle_triangle_intersect.h>
 #include <igl/unique.h>
@@ -80,3 +82,74 @@ TEST_CASE("find_intersections: extract", "[igl/predicates]")
   test_common::assert_near_rows(EV,EV_gt,0);
   REQUIRE( EE.rows() == 2);
 }
+
+TEST_CASE("find_intersections: soup", "[igl/predicates]")
+{
+  // Two random soups of small triangles against brute force
+  const auto random_soup = [](const int n, Eigen::MatrixXd & V, Eigen::MatrixXi & F)
+  {
+    V.resize(3*n,3);
+    F.resize(n,3);
+    for(int f = 0;f<n;f++)
+    {
+      const Eigen::RowVector3d c = Eigen::RowVector3d::Random();
+      for(int k = 0;k<3;k++)
+      {
+        V.row(3*f+k) = c + 0.2*Eigen::RowVector3d::Random();
+      }
+      F.row(f) << 3*f,3*f+1,3*f+2;
+    }
+  };
+  Eigen::MatrixXd V1,V2;
+  Eigen::MatrixXi F1,F2;
+  random_soup(200,V1,F1);
+  random_soup(150,V2,F2);
+  std::vector<std::pair<int,int> > gt;
+  for(int f1 = 0;f1<F1.rows();f1++)
+  {
+    for(int f2 = 0;f2<F2.rows();f2++)
+    {
+      bool coplanar;
+      if(igl::predicates::triangle_triangle_intersect(
+        Eigen::RowVector3d(V2.row(F2(f2,0))),
+        Eigen::RowVector3d(V2.row(F2(f2,1))),
+        Eigen::RowVector3d(V2.row(F2(f2,2))),
+        Eigen::RowVector3d(V1.row(F1(f1,0))),
+        Eigen::RowVector3d(V1.row(F1(f1,1))),
+        Eigen::RowVector3d(V1.row(F1(f1,2))),
+        coplanar))
+      {
+        gt.emplace_back(f1,f2);
+      }
+    }
+  }
+  REQUIRE(gt.size() > 0);
+
+  Eigen::MatrixXi IF;
+  Eigen::Array<bool,Eigen::Dynamic,1> CP;
+  REQUIRE( igl::predicates::find_intersections(V1,F1,V2,F2,false,IF,CP) );
+  REQUIRE( IF.rows() == gt.size() );
+  std::vector<std::pair<int,int> > found;
+  for(int i = 0;i<IF.rows();i++) { found.emplace_back(IF(i,0),IF(i,1)); }
+  std::sort(found.begin(),found.end());
+  REQUIRE( found == gt );
+
+  REQUIRE( igl::predicates::find_intersections(V1,F1,V2,F2,true,IF,CP) );
+  REQUIRE( IF.rows() == 1 );
+
+  // Prebuilt trees (reusable across calls) give the same result
+  igl::AABB<Eigen::MatrixXd,3> tree1,tree2;
+  tree1.init(V1,F1);
+  tree2.init(V2,F2);
+  Eigen::MatrixXi IF_trees;
+  REQUIRE( igl::predicates::find_intersections(
+    tree1,tree2,V1,F1,V2,F2,false,IF_trees,CP) );
+  REQUIRE( IF_trees.rows() == gt.size() );
+  found.clear();
+  for(int i = 0;i<IF_trees.rows();i++)
+  {
+    found.emplace_back(IF_trees(i,0),IF_trees(i,1));
+  }
+  std::sort(found.begin(),found.end());
+  REQUIRE( found == gt );
+}
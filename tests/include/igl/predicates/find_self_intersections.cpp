@@ -1,5 +1,6 @@
 #include "test_common.h"
 #include <igl/predicates/find_self_intersections.h>
+#include <igl/predicates/triangle_triangle_intersect.h>
 #include <igl/upsample.h>
 #include <igl/triangle_triangle_intersect.h>
 #include <igl/combine.h>
@@ -226,3 +227,54 @@ TEST_CASE("find_self_intersections: extract", "[igl/predicates]")
   REQUIRE( EE.rows() == 2);
   
 }
+
+TEST_CASE("find_self_intersections: soup", "[igl/predicates]")
+{
+  // Random soup of small triangles (no shared vertices) against brute force
+  const int n = 300;
+  Eigen::MatrixXd C = Eigen::MatrixXd::Random(n,3);
+  Eigen::MatrixXd V(3*n,3);
+  Eigen::MatrixXi F(n,3);
+  for(int f = 0;f<n;f++)
+  {
+    for(int c = 0;c<3;c++)
+    {
+      V.row(3*f+c) = C.row(f) + 0.2*Eigen::RowVector3d::Random();
+    }
+    F.row(f) << 3*f,3*f+1,3*f+2;
+  }
+  std::vector<std::pair<int,int> > gt;
+  for(int f = 0;f<n;f++)
+  {
+    for(int g = f+1;g<n;g++)
+    {
+      bool coplanar;
+      if(igl::predicates::triangle_triangle_intersect(
+        Eigen::RowVector3d(V.row(F(g,0))),
+        Eigen::RowVector3d(V.row(F(g,1))),
+        Eigen::RowVector3d(V.row(F(g,2))),
+        Eigen::RowVector3d(V.row(F(f,0))),
+        Eigen::RowVector3d(V.row(F(f,1))),
+        Eigen::RowVector3d(V.row(F(f,2))),
+        coplanar))
+      {
+        gt.emplace_back(f,g);
+      }
+    }
+  }
+  REQUIRE(gt.size() > 0);
+
+  Eigen::MatrixXi IF;
+  Eigen::Array<bool,Eigen::Dynamic,1> CP;
+  REQUIRE( igl::predicates::find_self_intersections(V,F,false,IF,CP));
+  REQUIRE( IF.rows() == gt.size() );
+  REQUIRE( CP.rows() == gt.size() );
+  std::vector<std::pair<int,int> > found;
+  for(int i = 0;i<IF.rows();i++) { found.emplace_back(IF(i,0),IF(i,1)); }
+  std::sort(found.begin(),found.end());
+  REQUIRE( found == gt );
+
+  REQUIRE( igl::predicates::find_self_intersections(V,F,true,IF,CP));
+  REQUIRE( IF.rows() == 1 );
+  REQUIRE( std::binary_search(gt.begin(),gt.end(),std::make_pair(IF(0,0),IF(0,1))) );
+}
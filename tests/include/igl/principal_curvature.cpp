@@ -1,6 +1,8 @@
 #include <test_common.h>
 #include <igl/principal_curvature.h>
 #include <igl/cylinder.h>
+#include <igl/icosahedron.h>
+#include <igl/upsample.h>
 
 TEST_CASE("principal_curvature: cylinder", "[igl]")
 {
@@ -26,4 +28,31 @@ TEST_CASE("principal_curvature: cylinder", "[igl]")
     //max curvature is greater than or equal to min curvature
     REQUIRE (PV1[i]>=PV2[i]);
   }
-}
\ No newline at end of file
+}
+TEST_CASE("principal_curvature: sphere", "[igl]")
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  igl::icosahedron(V,F);
+  igl::upsample(Eigen::MatrixXd(V),Eigen::MatrixXi(F),V,F,4);
+  const double r = 2;
+  V.rowwise().normalize();
+  V *= r;
+  for(const bool useKring : {true,false})
+  {
+    Eigen::MatrixXd PD1,PD2;
+    Eigen::VectorXd PV1,PV2;
+    std::vector<int> bad_vertices;
+    igl::principal_curvature(V,F,PD1,PD2,PV1,PV2,bad_vertices,3,useKring);
+    REQUIRE(bad_vertices.empty());
+    for(int i = 0;i<V.rows();i++)
+    {
+      REQUIRE(std::abs(PV1(i)) == Approx(1./r).epsilon(0.05));
+      REQUIRE(std::abs(PV2(i)) == Approx(1./r).epsilon(0.05));
+      // Directions are tangent
+      const Eigen::RowVector3d N = V.row(i)/r;
+      REQUIRE(std::abs(PD1.row(i).dot(N)) < 1e-2);
+      REQUIRE(std::abs(PD2.row(i).dot(N)) < 1e-2);
+    }
+  }
+}
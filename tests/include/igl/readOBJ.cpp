@@ -1,5 +1,7 @@
 #include <igl/readOBJ.h>
 #include <test_common.h>
+#include <cstdio>
+#include <fstream>
 #include <iostream>
 #include <string>
 #include <tuple>
@@ -30,3 +32,69 @@ TEST_CASE("readOBJ: Obj with material", "[igl]")
     REQUIRE (F.size() == 6);
     REQUIRE (FM.size() == 2);
 }
+
+TEST_CASE("readOBJ: relative indices, mixed corners and materials", "[igl]")
+{
+    const std::string tmp_path = test_common::data_path("_tmp_readOBJ.obj");
+    {
+        std::ofstream out(tmp_path);
+        out<<
+          "# comment\n"
+          "mtllib foo.mtl\n"
+          "v 0 0 0\n"
+          "v 1.5 0 0\n"
+          "v 0 -2.5e1 0\n"
+          "v 0 0 1e-3 1\n"
+          "vt 0 0\n"
+          "vt 1 0\n"
+          "vt 0 1 0\n"
+          "vn 0 0 1\n"
+          "usemtl red\n"
+          "f 1/1/1 2/2/1 3/3/1\n"
+          "f -4//-1 -3//-1 -1//-1\n"
+          "usemtl blue\n"
+          "f 2/2 3/3 4/1\n";
+    }
+    std::vector<std::vector<double > > V,TC,N;
+    std::vector<std::vector<int > > F,FTC,FN;
+    std::vector<std::tuple<std::string, int, int>> FM;
+    REQUIRE(igl::readOBJ(tmp_path, V, TC, N, F, FTC, FN, FM));
+    REQUIRE(V.size() == 4);
+    REQUIRE(V[1] == std::vector<double>{1.5,0,0});
+    REQUIRE(V[2][1] == -25.0);
+    REQUIRE(V[3][2] == 1e-3);
+    REQUIRE(V[3].size() == 4);
+    REQUIRE(TC.size() == 3);
+    REQUIRE(TC[2].size() == 3);
+    REQUIRE(N.size() == 1);
+    REQUIRE(F == std::vector<std::vector<int>>{{0,1,2},{0,1,3},{1,2,3}});
+    REQUIRE(FTC == std::vector<std::vector<int>>{{0,1,2},{},{1,2,0}});
+    REQUIRE(FN == std::vector<std::vector<int>>{{0,0,0},{0,0,0},{}});
+    REQUIRE(FM.size() == 2);
+    REQUIRE(std::get<0>(FM[0]) == "red");
+    REQUIRE(std::get<1>(FM[0]) == 0);
+    REQUIRE(std::get<2>(FM[0]) == 1);
+    REQUIRE(std::get<0>(FM[1]) == "blue");
+    REQUIRE(std::get<1>(FM[1]) == 2);
+    REQUIRE(std::get<2>(FM[1]) == 2);
+    std::remove(tmp_path.c_str());
+}
+
+TEST_CASE("readOBJ: mixed polygons into matrix fail", "[igl]")
+{
+    const std::string tmp_path = test_common::data_path("_tmp_readOBJ_mixed.obj");
+    {
+        std::ofstream out(tmp_path);
+        out<<
+          "v 0 0 0\n"
+          "v 1 0 0\n"
+          "v 1 1 0\n"
+          "v 0 1 0\n"
+          "f 1 2 3\n"
+          "f 1 2 3 4\n";
+    }
+    Eigen::MatrixXd V;
+    Eigen::MatrixXi F;
+    REQUIRE(!igl::readOBJ(tmp_path, V, F));
+    std::remove(tmp_path.c_str());
+}
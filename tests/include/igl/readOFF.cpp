@@ -1,4 +1,8 @@
 #include <test_common.h>
+#include <igl/readOFF.h>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
 
 TEST_CASE("readOFF: simple", "[igl]")
 {
@@ -12,3 +16,65 @@ TEST_CASE("readOFF: simple", "[igl]")
     REQUIRE (F.rows() == 12);
     REQUIRE (F.cols() == 3);
 }
+
+TEST_CASE("readOFF: COFF with comments and polygons", "[igl]")
+{
+    const std::string tmp_path =
+      (std::filesystem::temp_directory_path() / "igl_test_readOFF.off").string();
+    {
+        std::ofstream out(tmp_path);
+        out<<
+          "COFF\n"
+          "# comment\n"
+          "4 2 0\n"
+          "0 0 0 255 0 0\n"
+          "1 0 0 0 255 0\n"
+          "# comment between vertices\n"
+          "1 1 0 0 0 255\n"
+          "0 1 0.5 51 51 51\n"
+          "4 0 1 2 3 9 9 9\n"
+          "# comment between faces\n"
+          "3 0 2\n"
+          "  3\n";
+    }
+    std::vector<std::vector<double > > V,N,C;
+    std::vector<std::vector<int > > F;
+    REQUIRE(igl::readOFF(tmp_path, V, F, N, C));
+    REQUIRE(V.size() == 4);
+    REQUIRE(V[3] == std::vector<double>{0,1,0.5});
+    REQUIRE(N.empty());
+    REQUIRE(C.size() == 4);
+    REQUIRE(C[0] == std::vector<double>{1,0,0});
+    REQUIRE(C[3][2] == 51.0/255.0);
+    REQUIRE(F == std::vector<std::vector<int>>{{0,1,2,3},{0,2,3}});
+    std::remove(tmp_path.c_str());
+}
+
+TEST_CASE("readOFF: faces continuing on following lines", "[igl]")
+{
+    const std::string tmp_path = (std::filesystem::temp_directory_path() /
+      "igl_test_readOFF_continued.off").string();
+    // Enough faces to be split into several chunks, each face spread over
+    // three lines so that chunk boundaries fall inside faces
+    const int m = 1<<19;
+    {
+        std::ofstream out(tmp_path);
+        out<<"OFF\n3 "<<m<<" 0\n0 0 0\n1 0 0\n0 1 0\n";
+        for(int f = 0;f<m;f++)
+        {
+            out<<"3 "<<f%3<<"\n"<<(f+1)%3<<"\n"<<(f+2)%3<<" 7\n";
+        }
+    }
+    Eigen::MatrixXd V;
+    Eigen::MatrixXi F;
+    const bool ok = igl::readOFF(tmp_path, V, F);
+    std::remove(tmp_path.c_str());
+    REQUIRE(ok);
+    REQUIRE(V.rows() == 3);
+    Eigen::MatrixXi G(m,3);
+    for(int f = 0;f<m;f++)
+    {
+        G.row(f) << f%3, (f+1)%3, (f+2)%3;
+    }
+    test_common::assert_eq(F,G);
+}
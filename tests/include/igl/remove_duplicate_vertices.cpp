@@ -0,0 +1,101 @@
+#include <test_common.h>
+#include <igl/remove_duplicate_vertices.h>
+#include <igl/icosahedron.h>
+#include <igl/upsample.h>
+
+TEST_CASE("remove_duplicate_vertices: weld triangle soup", "[igl]")
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  igl::icosahedron(V,F);
+  for(int l = 0;l<3;l++)
+  {
+    Eigen::MatrixXd U;
+    Eigen::MatrixXi G;
+    igl::upsample(V,F,U,G);
+    V = U.rowwise().normalized();
+    F = G;
+  }
+  // Soup with a separate, slightly perturbed copy of each corner (like STL)
+  const double epsilon = 1e-6;
+  Eigen::MatrixXd SV(F.size(),3);
+  Eigen::MatrixXi SF(F.rows(),3);
+  for(int f = 0;f<F.rows();f++)
+  {
+    for(int c = 0;c<3;c++)
+    {
+      SF(f,c) = 3*f+c;
+      SV.row(3*f+c) = 
+        V.row(F(f,c)) + 0.1*epsilon*Eigen::RowVector3d::Random();
+    }
+  }
+  Eigen::MatrixXd WV;
+  Eigen::VectorXi I,J;
+  Eigen::MatrixXi WF;
+  igl::remove_duplicate_vertices(
+    SV,SF,epsilon,igl::REMOVE_DUPLICATE_VERTICES_TYPE_WELD,WV,I,J,WF);
+  REQUIRE(WV.rows() == V.rows());
+  // Groups are numbered by first occurrence and keep their first vertex
+  for(int i = 0;i<I.size();i++)
+  {
+    REQUIRE(J(I(i)) == i);
+    if(i > 0) { REQUIRE(I(i) > I(i-1)); }
+  }
+  for(int v = 0;v<SV.rows();v++)
+  {
+    REQUIRE((SV.row(v)-WV.row(J(v))).norm() <= epsilon);
+  }
+  for(int f = 0;f<F.rows();f++)
+  {
+    for(int c = 0;c<3;c++)
+    {
+      REQUIRE(WF(f,c) == J(SF(f,c)));
+      REQUIRE((WV.row(WF(f,c))-V.row(F(f,c))).norm() <= epsilon);
+    }
+  }
+}
+
+TEST_CASE("remove_duplicate_vertices: weld is transitive", "[igl]")
+{
+  // 0-1-2 chain within epsilon of neighbors, 3 too far, 4 == 0 exactly
+  Eigen::MatrixXd V(5,2);
+  V<<
+    0.0,0.0,
+    0.6,0.0,
+    1.2,0.1,
+    3.0,0.0,
+    0.0,0.0;
+  Eigen::MatrixXd SV;
+  Eigen::VectorXi I,J;
+  igl::remove_duplicate_vertices(
+    V,1.0,igl::REMOVE_DUPLICATE_VERTICES_TYPE_WELD,SV,I,J);
+  test_common::assert_eq(I,Eigen::VectorXi((Eigen::VectorXi(2)<<0,3).finished()));
+  test_common::assert_eq(J,Eigen::VectorXi((Eigen::VectorXi(5)<<0,0,0,1,0).finished()));
+  // Exact
+  igl::remove_duplicate_vertices(
+    V,0,igl::REMOVE_DUPLICATE_VERTICES_TYPE_WELD,SV,I,J);
+  test_common::assert_eq(I,Eigen::VectorXi((Eigen::VectorXi(4)<<0,1,2,3).finished()));
+  test_common::assert_eq(J,Eigen::VectorXi((Eigen::VectorXi(5)<<0,1,2,3,0).finished()));
+  // Empty
+  for(const double epsilon : {0.0,1.0})
+  {
+    igl::remove_duplicate_vertices(
+      Eigen::MatrixXd(0,2),epsilon,igl::REMOVE_DUPLICATE_VERTICES_TYPE_WELD,
+      SV,I,J);
+    REQUIRE(SV.rows() == 0);
+    REQUIRE(I.size() == 0);
+    REQUIRE(J.size() == 0);
+  }
+
+  // Coordinates far beyond epsilon*2^63 share clamped cells
+  Eigen::MatrixXd W(4,2);
+  W<<
+    1e12,0.0,
+    1e12,0.5e-10,
+    -1e12,0.0,
+    1e12,3e-10;
+  igl::remove_duplicate_vertices(
+    W,1e-10,igl::REMOVE_DUPLICATE_VERTICES_TYPE_WELD,SV,I,J);
+  test_common::assert_eq(I,Eigen::VectorXi((Eigen::VectorXi(3)<<0,2,3).finished()));
+  test_common::assert_eq(J,Eigen::VectorXi((Eigen::VectorXi(4)<<0,0,1,2).finished()));
+}
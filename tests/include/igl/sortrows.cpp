@@ -0,0 +1,74 @@
+#include <test_common.h>
+#include <igl/sortrows.h>
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+namespace
+{
+  // Reference: stable comparison sort of row indices
+  template <typename DerivedX>
+  Eigen::VectorXi stable_sortrows(
+    const Eigen::MatrixBase<DerivedX> & X, const bool ascending)
+  {
+    std::vector<int> I(X.rows());
+    std::iota(I.begin(),I.end(),0);
+    std::stable_sort(I.begin(),I.end(),[&](const int i, const int j)
+    {
+      for(int c = 0;c<X.cols();c++)
+      {
+        if(X(i,c) != X(j,c))
+        {
+          return ascending ? X(i,c) < X(j,c) : X(i,c) > X(j,c);
+        }
+      }
+      return false;
+    });
+    return Eigen::Map<Eigen::VectorXi>(I.data(),I.size());
+  }
+
+  template <typename DerivedX>
+  void check(const Eigen::MatrixBase<DerivedX> & X)
+  {
+    for(const bool ascending : {true,false})
+    {
+      DerivedX Y;
+      Eigen::VectorXi I;
+      igl::sortrows(X,ascending,Y,I);
+      test_common::assert_eq(I,stable_sortrows(X,ascending));
+      const DerivedX XI = X(I,Eigen::placeholders::all);
+      test_common::assert_eq(Y,XI);
+    }
+  }
+}
+
+TEST_CASE("sortrows: radix sort is stable and matches comparison sort", "[igl]")
+{
+  // Large enough for the radix path and small enough for the comparison path
+  for(const int n : {100,20000})
+  {
+    // Few distinct (and negative) values so there are many ties
+    const Eigen::MatrixXi Xi = 
+      (Eigen::MatrixXd::Random(n,3)*5).cast<int>();
+    check(Xi);
+    Eigen::Matrix<unsigned char,Eigen::Dynamic,2> Xu = 
+      ((Eigen::MatrixXd::Random(n,2).array()+1)*100).cast<unsigned char>();
+    check(Xu);
+    Eigen::MatrixXd Xd = Eigen::MatrixXd::Random(n,3);
+    // Ties, large magnitudes, infinities and -0 == 0
+    Xd.col(0) = (Xd.col(0)*4).array().round();
+    Xd(0,0) = -0.0;
+    Xd(1,0) = 0.0;
+    Xd(2,1) = std::numeric_limits<double>::infinity();
+    Xd(3,1) = -std::numeric_limits<double>::infinity();
+    Xd(4,2) = -1e30;
+    Xd(5,2) = 1e-30;
+    check(Xd);
+    const Eigen::MatrixXf Xf = Xd.cast<float>();
+    check(Xf);
+    Eigen::Matrix<std::int64_t,Eigen::Dynamic,Eigen::Dynamic> Xl = 
+      (Eigen::MatrixXd::Random(n,3)*1e12).cast<std::int64_t>();
+    Xl.col(1) = Xi.col(1).cast<std::int64_t>();
+    check(Xl);
+  }
+}
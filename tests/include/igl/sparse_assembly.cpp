@@ -0,0 +1,147 @@
+#include <test_common.h>
+#include <igl/sparse_assembly.h>
+#include <igl/sparse.h>
+#include <igl/cotmatrix.h>
+#include <igl/cotmatrix_intrinsic.h>
+#include <igl/edge_lengths.h>
+#include <igl/grad.h>
+#include <igl/massmatrix.h>
+#include <igl/icosahedron.h>
+#include <igl/upsample.h>
+
+TEST_CASE("sparse_assembly: matches sparse", "[igl]")
+{
+  const int m = 37;
+  const int n = 23;
+  const int k = 2000;
+  Eigen::VectorXi I(k),J(k);
+  for(int t = 0;t<k;t++)
+  {
+    I(t) = (t*7919) % m;
+    J(t) = (t*104729 + t/3) % n;
+  }
+  // leave some empty rows and columns
+  I = (I.array() == 5).select(6,I);
+  J = (J.array() == 0).select(1,J);
+  const Eigen::VectorXd V = Eigen::VectorXd::Random(k);
+  Eigen::SparseMatrix<double> expected;
+  igl::sparse(I,J,V,m,n,expected);
+  igl::SparseAssemblyData data;
+  igl::sparse_assembly_precompute(I,J,m,n,data);
+  Eigen::SparseMatrix<double> X;
+  igl::sparse_assembly(data,[&V](const int t){ return V(t); },X);
+  test_common::assert_eq(X,expected);
+  // Refresh with new values keeps the storage
+  const Eigen::VectorXd W = Eigen::VectorXd::Random(k);
+  const double * values = X.valuePtr();
+  igl::sparse_assembly(data,[&W](const int t){ return W(t); },X);
+  REQUIRE(X.valuePtr() == values);
+  igl::sparse(I,J,W,m,n,expected);
+  test_common::assert_eq(X,expected);
+}
+
+TEST_CASE("sparse_assembly: values-only refresh", "[igl]")
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  igl::icosahedron(V,F);
+  for(int l = 0;l<3;l++)
+  {
+    Eigen::MatrixXd U;
+    Eigen::MatrixXi G;
+    igl::upsample(V,F,U,G);
+    V = U.rowwise().normalized();
+    F = G;
+  }
+  Eigen::MatrixXd TV(6,3);
+  TV<<0,0,0, 1,0,0, 0,1,0, 0,0,1, 1,1,1, 1,1,0;
+  Eigen::MatrixXi TT(3,4);
+  TT<<0,1,2,3, 1,2,3,4, 1,5,2,4;
+  const auto perturb = [](const Eigen::MatrixXd & X)->Eigen::MatrixXd
+  {
+    return X + 0.05*Eigen::MatrixXd::Random(X.rows(),X.cols());
+  };
+
+  // First call computes the pattern, second only refreshes values; both
+  // should match the one-shot version exactly
+  const auto check = [](const auto & assemble_data, const auto & assemble)
+  {
+    igl::SparseAssemblyData data;
+    Eigen::SparseMatrix<double> A,B;
+    assemble_data(0,data,A);
+    assemble(0,B);
+    test_common::assert_eq(A,B);
+    const double * values = A.valuePtr();
+    assemble_data(1,data,A);
+    REQUIRE(A.valuePtr() == values);
+    assemble(1,B);
+    test_common::assert_eq(A,B);
+  };
+  for(const auto & pair :
+    std::vector<std::pair<Eigen::MatrixXd,Eigen::MatrixXi> >{{V,F},{TV,TT}})
+  {
+    const Eigen::MatrixXi & E = pair.second;
+    const Eigen::MatrixXd X[2] = {pair.first,perturb(pair.first)};
+    check(
+      [&](int i,igl::SparseAssemblyData & d,Eigen::SparseMatrix<double> & A)
+        { igl::cotmatrix(X[i],E,d,A); },
+      [&](int i,Eigen::SparseMatrix<double> & A){ igl::cotmatrix(X[i],E,A); });
+    for(const auto type : {
+      igl::MASSMATRIX_TYPE_BARYCENTRIC,
+      igl::MASSMATRIX_TYPE_VORONOI,
+      igl::MASSMATRIX_TYPE_FULL})
+    {
+      check(
+        [&](int i,igl::SparseAssemblyData & d,Eigen::SparseMatrix<double> & A)
+          { igl::massmatrix(X[i],E,type,d,A); },
+        [&](int i,Eigen::SparseMatrix<double> & A)
+          { igl::massmatrix(X[i],E,type,A); });
+    }
+    check(
+      [&](int i,igl::SparseAssemblyData & d,Eigen::SparseMatrix<double> & A)
+        { igl::grad(X[i],E,d,A); },
+      [&](int i,Eigen::SparseMatrix<double> & A){ igl::grad(X[i],E,A); });
+  }
+  const Eigen::MatrixXd X[2] = {V,perturb(V)};
+  Eigen::MatrixXd l[2];
+  igl::edge_lengths(X[0],F,l[0]);
+  igl::edge_lengths(X[1],F,l[1]);
+  check(
+    [&](int i,igl::SparseAssemblyData & d,Eigen::SparseMatrix<double> & A)
+      { igl::cotmatrix_intrinsic(l[i],F,d,A); },
+    [&](int i,Eigen::SparseMatrix<double> & A)
+      { igl::cotmatrix_intrinsic(l[i],F,A); });
+}
+
+TEST_CASE("sparse_assembly: stale pattern is rebuilt", "[igl]")
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  igl::icosahedron(V,F);
+  Eigen::MatrixXd U;
+  Eigen::MatrixXi G;
+  igl::upsample(V,F,U,G);
+  igl::SparseAssemblyData data;
+  Eigen::SparseMatrix<double> A,B;
+  // Same data reused across meshes of different sizes
+  igl::cotmatrix(V,F,data,A);
+  igl::cotmatrix(U,G,data,A);
+  igl::cotmatrix(U,G,B);
+  test_common::assert_eq(A,B);
+  // ... and across meshes of the same size with different faces
+  const Eigen::MatrixXd W = U.colwise().reverse();
+  const Eigen::MatrixXi H = (U.rows()-1-G.array()).matrix();
+  igl::cotmatrix(W,H,data,A);
+  igl::cotmatrix(W,H,B);
+  test_common::assert_eq(A,B);
+  // ... and across mass matrix types with different patterns
+  Eigen::MatrixXd TV(6,3);
+  TV<<0,0,0, 1,0,0, 0,1,0, 0,0,1, 1,1,1, 1,1,0;
+  Eigen::MatrixXi TT(3,4);
+  TT<<0,1,2,3, 1,2,3,4, 1,5,2,4;
+  igl::SparseAssemblyData tet_data;
+  igl::massmatrix(TV,TT,igl::MASSMATRIX_TYPE_BARYCENTRIC,tet_data,A);
+  igl::massmatrix(TV,TT,igl::MASSMATRIX_TYPE_FULL,tet_data,A);
+  igl::massmatrix(TV,TT,igl::MASSMATRIX_TYPE_FULL,B);
+  test_common::assert_eq(A,B);
+}
@@ -0,0 +1,151 @@
+#include <test_common.h>
+#include <igl/write_ascii_rows.h>
+#include <igl/readDMAT.h>
+#include <igl/readMESH.h>
+#include <igl/readOBJ.h>
+#include <igl/readOFF.h>
+#include <igl/writeDMAT.h>
+#include <igl/writeMESH.h>
+#include <igl/writeOBJ.h>
+#include <igl/writeOFF.h>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <string>
+
+TEST_CASE("write_ascii_rows: numbers round-trip", "[igl]")
+{
+  const auto format = [](const auto x)
+  {
+    igl::AsciiBuffer buffer;
+    buffer.append_number(x);
+    return std::string(buffer.data(),buffer.size());
+  };
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+  // Shortest representation
+  REQUIRE(format(0.1) == "0.1");
+  REQUIRE(format(0.1f) == "0.1");
+#endif
+  REQUIRE(std::strtod(format(0.1).c_str(),nullptr) == 0.1);
+  REQUIRE(format(-7) == "-7");
+  REQUIRE(format(std::int64_t(1)<<40) == "1099511627776");
+  std::vector<double> special = {
+    0.0,-0.0,1.0,-1.0,0.1,1.0/3.0,1e300,-1e-300,
+    std::numeric_limits<double>::max(),
+    std::numeric_limits<double>::min(),
+    std::numeric_limits<double>::denorm_min(),
+    std::numeric_limits<double>::epsilon()};
+  // Random bit patterns cover all exponents
+  std::mt19937_64 gen(0);
+  for(int i = 0;i<20000;i++)
+  {
+    const std::uint64_t bits = gen();
+    // Skip inf and nan (signaling nans would trap)
+    if(((bits>>52) & 0x7ff) == 0x7ff) { continue; }
+    double x;
+    std::memcpy(&x,&bits,sizeof(x));
+    special.push_back(x);
+  }
+  for(const double x : special)
+  {
+    const std::string s = format(x);
+    const double y = std::strtod(s.c_str(),nullptr);
+    REQUIRE(std::memcmp(&x,&y,sizeof(x)) == 0);
+    if(std::abs(x) <= std::numeric_limits<float>::max())
+    {
+      const float f = float(x);
+      const float g = std::strtof(format(f).c_str(),nullptr);
+      REQUIRE(std::memcmp(&f,&g,sizeof(f)) == 0);
+    }
+  }
+}
+
+TEST_CASE("write_ascii_rows: chunks are written in order", "[igl]")
+{
+  const std::string path = test_common::data_path("_tmp_write_ascii_rows.txt");
+  FILE * fp = fopen(path.c_str(),"w");
+  REQUIRE(fp != nullptr);
+  const int n = 100000;
+  REQUIRE(igl::write_ascii_rows(fp,n,[](const int i,igl::AsciiBuffer & buffer)
+  {
+    buffer.append_number(i).append('\n');
+  }));
+  fclose(fp);
+  fp = fopen(path.c_str(),"r");
+  REQUIRE(fp != nullptr);
+  int x,count = 0;
+  bool in_order = true;
+  while(fscanf(fp,"%d",&x) == 1)
+  {
+    in_order = in_order && x == count;
+    count++;
+  }
+  fclose(fp);
+  REQUIRE(in_order);
+  REQUIRE(count == n);
+  std::remove(path.c_str());
+}
+
+TEST_CASE("write_ascii_rows: writers round-trip exactly", "[igl]")
+{
+  // More rows than one chunk
+  const int n = 40000;
+  Eigen::MatrixXd V = Eigen::MatrixXd::Random(n,3);
+  V.row(0) << 0.1,-0.0,1e-310;
+  V.row(1) << 1e30,1.0/3.0,-123456789.0;
+  Eigen::MatrixXi F(n,3),T(n,4);
+  for(int i = 0;i<n;i++)
+  {
+    F.row(i) << i,(i+1)%n,(i+7)%n;
+    T.row(i) << i,(i+1)%n,(i+7)%n,(i+13)%n;
+  }
+  const std::string base = test_common::data_path("_tmp_write_ascii_rows");
+  {
+    const std::string path = base + ".obj";
+    REQUIRE(igl::writeOBJ(path,V,F));
+    Eigen::MatrixXd rV;
+    Eigen::MatrixXi rF;
+    REQUIRE(igl::readOBJ(path,rV,rF));
+    test_common::assert_eq(V,rV);
+    test_common::assert_eq(F,rF);
+    std::remove(path.c_str());
+  }
+  {
+    const std::string path = base + ".off";
+    REQUIRE(igl::writeOFF(path,V,F));
+    Eigen::MatrixXd rV;
+    Eigen::MatrixXi rF;
+    REQUIRE(igl::readOFF(path,rV,rF));
+    test_common::assert_eq(V,rV);
+    test_common::assert_eq(F,rF);
+    std::remove(path.c_str());
+  }
+  {
+    const std::string path = base + ".mesh";
+    REQUIRE(igl::writeMESH(path,V,T,F));
+    Eigen::MatrixXd rV;
+    Eigen::MatrixXi rT,rF;
+    REQUIRE(igl::readMESH(path,rV,rT,rF));
+    test_common::assert_eq(V,rV);
+    test_common::assert_eq(T,rT);
+    test_common::assert_eq(F,rF);
+    std::remove(path.c_str());
+  }
+  {
+    const std::string path = base + ".dmat";
+    REQUIRE(igl::writeDMAT(path,V,true));
+    Eigen::MatrixXd rV;
+    REQUIRE(igl::readDMAT(path,rV));
+    test_common::assert_eq(V,rV);
+    const Eigen::MatrixXf Vf = V.cast<float>();
+    REQUIRE(igl::writeDMAT(path,Vf,true));
+    Eigen::MatrixXf rVf;
+    REQUIRE(igl::readDMAT(path,rVf));
+    test_common::assert_eq(Vf,rVf);
+    std::remove(path.c_str());
+  }
+}